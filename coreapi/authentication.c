@@ -23,6 +23,7 @@
 #include "account/account.h"
 #include "auth-info/auth-info.h"
 #include "c-wrapper/c-wrapper.h"
+#include "core/core-p.h"
 #include "linphone/api/c-auth-info.h"
 #include "linphone/core.h"
 #include "linphone/lpconfig.h"
@@ -90,11 +91,20 @@ static const LinphoneAuthInfo *find_auth_info(LinphoneCore *lc,
                                               const char *domain,
                                               const char *algorithm,
                                               bool_t ignore_realm) {
-	bctbx_list_t *elem;
 	const LinphoneAuthInfo *ret = NULL;
+	const LinphonePrivate::AuthInfoIndex &index = L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfoIndex;
 
-	for (elem = lc->auth_info; elem != NULL; elem = elem->next) {
-		LinphoneAuthInfo *pinfo = (LinphoneAuthInfo *)elem->data;
+	/* Only walk the auth infos that may match, in list order. They are checked exactly as in a walk of the whole list:
+	 * with a realm, only the ones with the same username and realm can match, with a domain only the ones with the
+	 * same username and domain. */
+	const LinphonePrivate::AuthInfoIndex::Bucket &candidates =
+	    !username ? index.getAll()
+	    : realm   ? index.findByUsernameAndRealm(username, realm)
+	    : domain  ? index.findByUsernameAndDomain(username, domain)
+	              : index.findByUsername(username);
+
+	for (const auto &candidate : candidates) {
+		LinphoneAuthInfo *pinfo = candidate.second;
 
 		if (!username || (username && linphone_auth_info_get_username(pinfo) &&
 		                  strcmp(username, linphone_auth_info_get_username(pinfo)) == 0)) {
@@ -193,22 +203,23 @@ linphone_core_find_auth_info(LinphoneCore *lc, const char *realm, const char *us
 
 /*the auth info is expected to be in the core's list*/
 void linphone_core_write_auth_info(LinphoneCore *lc, LinphoneAuthInfo *ai) {
-	int i;
-	bctbx_list_t *elem = lc->auth_info;
+	LinphonePrivate::AuthInfoIndex &index = L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfoIndex;
+
+	/* The realm or the algorithm may have been set in place, see fill_auth_info(). */
+	index.update(ai);
 
 	if (!lc->sip_conf.save_auth_info) return;
 
-	for (i = 0; elem != NULL; elem = elem->next, i++) {
-		if (ai == elem->data) {
-			linphone_auth_info_write_config(lc->config, ai, i);
-		}
-	}
+	int i = index.getPosition(ai);
+	if (i >= 0) linphone_auth_info_write_config(lc->config, ai, i);
 }
 
 static void write_auth_infos(LinphoneCore *lc) {
 	bctbx_list_t *elem;
 	int i;
+	bool &written = L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfosWritten;
 
+	written = false;
 	if (!linphone_core_ready(lc)) return;
 	if (!lc->sip_conf.save_auth_info) return;
 	for (elem = lc->auth_info, i = 0; elem != NULL; elem = bctbx_list_next(elem), i++) {
@@ -216,6 +227,22 @@ static void write_auth_infos(LinphoneCore *lc) {
 		linphone_auth_info_write_config(lc->config, ai, i);
 	}
 	linphone_auth_info_write_config(lc->config, NULL, i); /* mark the end */
+	written = true;
+}
+
+/* Writes the auth info just appended to the list. The other ones keep their place, so they only have to be written
+ * when they were not already. */
+static void write_last_auth_info(LinphoneCore *lc, LinphoneAuthInfo *ai) {
+	LinphonePrivate::CorePrivate *core = L_GET_PRIVATE_FROM_C_OBJECT(lc);
+	int i;
+
+	if (!core->authInfosWritten || !linphone_core_ready(lc) || !lc->sip_conf.save_auth_info) {
+		write_auth_infos(lc);
+		return;
+	}
+	i = core->authInfoIndex.getPosition(ai);
+	linphone_auth_info_write_config(lc->config, ai, i);
+	linphone_auth_info_write_config(lc->config, NULL, i + 1); /* mark the end */
 }
 
 LinphoneAuthInfo *linphone_core_create_auth_info(BCTBX_UNUSED(LinphoneCore *lc),
@@ -242,13 +269,17 @@ void linphone_core_add_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *info)
 	ai = (LinphoneAuthInfo *)linphone_core_find_auth_info(lc, linphone_auth_info_get_realm(info),
 	                                                      linphone_auth_info_get_username(info),
 	                                                      linphone_auth_info_get_domain(info));
+	LinphonePrivate::AuthInfoIndex &index = L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfoIndex;
 	if (ai != NULL && linphone_auth_info_get_domain(ai) && linphone_auth_info_get_domain(info) &&
 	    strcmp(linphone_auth_info_get_domain(ai), linphone_auth_info_get_domain(info)) == 0) {
 		lc->auth_info = bctbx_list_remove(lc->auth_info, ai);
+		index.remove(ai);
 		linphone_auth_info_unref(ai);
 		updating = TRUE;
 	}
-	lc->auth_info = bctbx_list_append(lc->auth_info, linphone_auth_info_clone(info));
+	LinphoneAuthInfo *added = linphone_auth_info_clone(info);
+	lc->auth_info = bctbx_list_append(lc->auth_info, added);
+	index.add(added);
 
 	/* retry pending authentication operations */
 	auto pendingAuths = lc->sal->getPendingAuths();
@@ -297,7 +328,8 @@ void linphone_core_add_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *info)
 		           linphone_auth_info_get_realm(info) ? linphone_auth_info_get_realm(info) : "",
 		           linphone_auth_info_get_domain(info) ? linphone_auth_info_get_domain(info) : "");
 	}
-	write_auth_infos(lc);
+	if (updating) write_auth_infos(lc);
+	else write_last_auth_info(lc, added);
 }
 
 void linphone_core_abort_authentication(BCTBX_UNUSED(LinphoneCore *lc), BCTBX_UNUSED(LinphoneAuthInfo *info)) {
@@ -310,6 +342,7 @@ void linphone_core_remove_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *in
 	                                                     linphone_auth_info_get_domain(info));
 	if (r) {
 		lc->auth_info = bctbx_list_remove(lc->auth_info, r);
+		L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfoIndex.remove(r);
 		linphone_auth_info_unref(r);
 		write_auth_infos(lc);
 	}
@@ -329,6 +362,8 @@ void linphone_core_clear_all_auth_info(LinphoneCore *lc) {
 	}
 	bctbx_list_free(lc->auth_info);
 	lc->auth_info = NULL;
+	L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfoIndex.clear();
+	L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfosWritten = false;
 }
 
 void linphone_auth_info_fill_belle_sip_event(const LinphoneAuthInfo *auth_info, belle_sip_auth_event *event) {
@@ -924,7 +924,8 @@ static void publish_received(SalPublishOp *op, const char *eventname, const SalB
 
 	if (ret == Core::ETagStatus::AddOrUpdateETag)
 		L_GET_CPP_PTR_FROM_C_OBJECT(lc)->addOrUpdatePublishByEtag(
-		    op, dynamic_pointer_cast<EventPublish>(Event::toCpp(lev)->getSharedFromThis()));
+		    op, dynamic_pointer_cast<EventPublish>(Event::toCpp(lev)->getSharedFromThis()), eventname ? eventname : "",
+		    body_handler);
 
 	linphone_event_set_publish_state(lev, LinphonePublishIncomingReceived);
 	LinphoneContent *ct = linphone_content_from_sal_body_handler(body_handler);
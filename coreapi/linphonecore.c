@@ -769,6 +769,16 @@ LinphoneCoreCbsAccountRemovedCb linphone_core_cbs_get_account_removed(LinphoneCo
 	return cbs->vtable->account_removed;
 }
 
+void linphone_core_cbs_set_unread_chat_message_count_changed(LinphoneCoreCbs *cbs,
+                                                             LinphoneCoreCbsUnreadChatMessageCountChangedCb cb) {
+	cbs->vtable->unread_chat_message_count_changed = cb;
+}
+
+LinphoneCoreCbsUnreadChatMessageCountChangedCb
+linphone_core_cbs_get_unread_chat_message_count_changed(LinphoneCoreCbs *cbs) {
+	return cbs->vtable->unread_chat_message_count_changed;
+}
+
 void lc_callback_obj_init(LCCallbackObj *obj, LinphoneCoreCbFunc func, void *ud) {
 	obj->_func = func;
 	obj->_user_data = ud;
@@ -1807,6 +1817,7 @@ static void sip_config_read(LinphoneCore *lc) {
 	lc->sal->useRport(!!linphone_config_get_int(lc->config, "sip", "use_rport", 1));
 
 	L_GET_CPP_PTR_FROM_C_OBJECT(lc)->setSpecs(linphone_config_get_string(lc->config, "sip", "linphone_specs", ""));
+	L_GET_CPP_PTR_FROM_C_OBJECT(lc)->readPublicationLimits();
 
 	if (!linphone_config_get_int(lc->config, "sip", "ipv6_migration_done", FALSE) &&
 	    linphone_config_has_entry(lc->config, "sip", "use_ipv6")) {
@@ -1973,6 +1984,7 @@ static void sip_config_read(LinphoneCore *lc) {
 	lc->sal->useOneMatchingCodecPolicy(!!linphone_config_get_int(lc->config, "sip", "only_one_codec", 0));
 	lc->sal->useDates(!!linphone_config_get_int(lc->config, "sip", "put_date", 0));
 	lc->sal->enableSipUpdateMethod(!!linphone_config_get_int(lc->config, "sip", "sip_update", 1));
+	lc->sal->enableIncrementalSdp(!!linphone_config_get_int(lc->config, "sip", "incremental_sdp", 0));
 	lc->sip_conf.vfu_with_info = !!linphone_config_get_int(lc->config, "sip", "vfu_with_info", 1);
 	/* The linux kernel TCP connection timeout is 63 seconds, which is fairly long.
 	 * We decide that 15 seconds is long enough to connect to a single node, given that we want
@@ -2666,11 +2678,21 @@ void linphone_configuring_terminated(LinphoneCore *lc, LinphoneConfiguringState
 			linphone_core_set_provisioning_uri(lc, NULL);
 		}
 
-		_linphone_core_read_config(lc);
+		if (lc->provisioning_unchanged) {
+			// The configuration read when the core was initialized is still the one in use.
+			ms_message("Remote provisioning did not change the configuration, nothing to reload");
+		} else {
+			// The whole configuration is read again when something changed: most readers use several sections, only
+			// the LIME reload depends on the changed ones.
+			_linphone_core_read_config(lc);
 
-		// To apply any changes to LIME configuration
-		linphone_core_reload_lime(lc);
+			// To apply any changes to LIME configuration, unless the provisioning is known not to touch it
+			if (!lc->provisioning_changed_sections ||
+			    bctbx_list_find_custom(lc->provisioning_changed_sections, (bctbx_compare_func)strcmp, "lime"))
+				linphone_core_reload_lime(lc);
+		}
 	}
+	lc->provisioning_unchanged = FALSE;
 
 	const char *contacts_vcard_list_uri = linphone_config_get_string(lc->config, "misc", "contacts-vcard-list", NULL);
 	if (contacts_vcard_list_uri) {
@@ -4680,10 +4702,11 @@ LinphoneAccount *linphone_core_lookup_account_by_conference_factory_strict(Linph
 		const LinphoneAccountParams *params = linphone_account_get_params(acc);
 		const Address *audio_video_conference_factory =
 		    bellesip::toCpp<Address>(linphone_account_params_get_audio_video_conference_factory_address(params));
-		const char *conference_factory_str = linphone_account_params_get_conference_factory_uri(params);
-		Address conference_factory(L_C_TO_STRING(conference_factory_str));
+		// Use the address kept by the account params instead of parsing the factory uri for every account.
+		const auto &conference_factory = AccountParams::toCpp(params)->getConferenceFactoryAddress();
 		if ((audio_video_conference_factory && Address::toCpp(uri)->weakEqual(*audio_video_conference_factory)) ||
-		    (conference_factory.isValid() && Address::toCpp(uri)->weakEqual(conference_factory))) {
+		    (conference_factory && conference_factory->isValid() &&
+		     Address::toCpp(uri)->weakEqual(*conference_factory))) {
 			if (linphone_account_get_state(acc) == LinphoneRegistrationOk) {
 				found_acc = acc;
 				break;
@@ -4708,10 +4731,11 @@ LinphoneAccount *linphone_core_lookup_account_by_identity_strict(LinphoneCore *l
 	LinphoneAccount *found_acc = NULL;
 	LinphoneAccount *found_reg_acc = NULL;
 	LinphoneAccount *found_noreg_acc = NULL;
-	const bctbx_list_t *elem;
+	LinphonePrivate::AccountIndex &accountIndex = L_GET_PRIVATE_FROM_C_OBJECT(lc)->accountIndex;
 
-	for (elem = linphone_core_get_account_list(lc); elem != NULL; elem = elem->next) {
-		LinphoneAccount *acc = (LinphoneAccount *)elem->data;
+	if (!uri) return NULL;
+	/* Only the accounts with the same identity username, domain and port can match. */
+	for (LinphoneAccount *acc : accountIndex.findByIdentity(lc, *Address::toCpp(uri))) {
 		const LinphoneAccountParams *params = linphone_account_get_params(acc);
 		if (linphone_address_weak_equal(uri, linphone_account_params_get_identity_address(params))) {
 			if (linphone_account_get_state(acc) == LinphoneRegistrationOk) {
@@ -4760,7 +4784,7 @@ LinphoneAccount *linphone_core_lookup_known_account(LinphoneCore *lc, const Linp
 
 LinphoneAccount *
 linphone_core_lookup_known_account_2(LinphoneCore *lc, const LinphoneAddress *uri, bool_t fallback_to_default) {
-	const bctbx_list_t *elem;
+	LinphonePrivate::AccountIndex &accountIndex = L_GET_PRIVATE_FROM_C_OBJECT(lc)->accountIndex;
 	LinphoneAccount *found_acc = NULL;
 	LinphoneAccount *found_reg_acc = NULL;
 	LinphoneAccount *found_noreg_acc = NULL;
@@ -4794,14 +4818,13 @@ linphone_core_lookup_known_account_2(LinphoneCore *lc, const LinphoneAddress *ur
 	}
 
 	/*otherwise return first registered, then first registering matching, otherwise first matching */
-	for (elem = linphone_core_get_account_list(lc); elem != NULL; elem = elem->next) {
-		LinphoneAccount *acc = (LinphoneAccount *)elem->data;
+	for (LinphoneAccount *acc : accountIndex.findByIdentity(lc, *Address::toCpp(uri))) {
 		const LinphoneAddress *identity_address =
 		    linphone_account_params_get_identity_address(linphone_account_get_params(acc));
 		if (linphone_address_weak_equal(identity_address, uri)) {
 			if (linphone_account_get_state(acc) == LinphoneRegistrationOk) {
 				found_acc = acc;
-				break;
+				goto end;
 			} else if (!found_reg_acc &&
 			           linphone_account_params_get_register_enabled(linphone_account_get_params(acc))) {
 				found_reg_acc = acc;
@@ -4809,6 +4832,9 @@ linphone_core_lookup_known_account_2(LinphoneCore *lc, const LinphoneAddress *ur
 				found_noreg_acc = acc;
 			}
 		}
+	}
+	/* The domain matches are only used when no account matches the identity. */
+	for (LinphoneAccount *acc : accountIndex.findByDomain(lc, uri_domain)) {
 		const char *domain = linphone_account_params_get_domain(linphone_account_get_params(acc));
 		if (domain && !strcmp(domain, uri_domain)) {
 			if (!found_acc_domain_match && linphone_account_get_state(acc) == LinphoneRegistrationOk) {
@@ -7458,6 +7484,7 @@ void sip_config_uninit(LinphoneCore *lc) {
 
 	elem = config->accounts;
 	config->accounts = NULL; /*to make sure accounts cannot be referenced during deletion*/
+	L_GET_PRIVATE_FROM_C_OBJECT(lc)->accountIndex.invalidate();
 	bctbx_list_free_with_data(elem, (void (*)(void *))linphone_account_unref);
 
 	elem = config->proxies;
@@ -7472,6 +7499,7 @@ void sip_config_uninit(LinphoneCore *lc) {
 	/*no longuer need to write proxy config if not changed
 	 * linphone_proxy_config_write_to_config_file(lc->config,NULL,i);*/	/*mark the end */
 
+	L_GET_PRIVATE_FROM_C_OBJECT(lc)->authInfoIndex.clear();
 	lc->auth_info = bctbx_list_free_with_data(lc->auth_info, (void (*)(void *))linphone_auth_info_unref);
 	lc->default_account = NULL;
 	lc->default_proxy = NULL;
@@ -8061,6 +8089,10 @@ void _linphone_core_stop_async_end(LinphoneCore *lc) {
 		ms_free(lc->friends_db_file);
 		lc->friends_db_file = NULL;
 	}
+	if (lc->provisioning_changed_sections) {
+		bctbx_list_free_with_data(lc->provisioning_changed_sections, (bctbx_list_free_func)bctbx_free);
+		lc->provisioning_changed_sections = NULL;
+	}
 	if (lc->tls_key) {
 		ms_free(lc->tls_key);
 		lc->tls_key = NULL;
@@ -573,7 +573,10 @@ static const char *empty_xml = "empty provisioning file";
 static const char *xml_to_lpc_failed = "xml to lpc failed";
 static const char *invalid_xml = "invalid xml";
 
-static const char *_linphone_config_xml_convert(LpConfig *lpc, xml2lpc_context *context, int result) {
+static const char *_linphone_config_xml_convert(LpConfig *lpc,
+                                                xml2lpc_context *context,
+                                                int result,
+                                                bctbx_list_t **changed_sections) {
 	const char *error_msg = NULL;
 	if (result == 0) {
 		result = xml2lpc_convert(context, lpc);
@@ -583,7 +586,13 @@ static const char *_linphone_config_xml_convert(LpConfig *lpc, xml2lpc_context *
 			    linphone_config_get_int(lpc, "sip", "default_proxy", -1) == -1) {
 				linphone_config_set_int(lpc, "sip", "default_proxy", 0);
 			}
-			linphone_config_sync(lpc);
+			if (changed_sections) {
+				const bctbx_list_t *it;
+				for (it = xml2lpc_get_changed_sections(context); it != NULL; it = it->next)
+					*changed_sections = bctbx_list_append(*changed_sections, bctbx_strdup((const char *)it->data));
+			}
+			// Do not rewrite the file when the xml only contained values that were already there.
+			if (linphone_config_needs_commit(lpc)) linphone_config_sync(lpc);
 		} else {
 			error_msg = xml_to_lpc_failed;
 		}
@@ -600,7 +609,7 @@ const char *linphone_config_load_from_xml_file(LinphoneConfig *lpc, const char *
 
 	if (path) {
 		context = xml2lpc_context_new(NULL, NULL);
-		error_msg = _linphone_config_xml_convert(lpc, context, xml2lpc_set_xml_file(context, path));
+		error_msg = _linphone_config_xml_convert(lpc, context, xml2lpc_set_xml_file(context, path), NULL);
 		bctbx_free(path);
 	}
 	if (context) xml2lpc_context_destroy(context);
@@ -636,14 +645,15 @@ const char *linphone_config_load_from_xml_file(LinphoneConfig *lpc, const char *
 
 #endif
 
-const char *_linphone_config_load_from_xml_string(LpConfig *lpc, const char *buffer) {
+const char *_linphone_config_load_from_xml_string(LpConfig *lpc, const char *buffer, bctbx_list_t **changed_sections) {
 	const char *error_msg = NULL;
 #ifdef HAVE_XML2
 	xml2lpc_context *context = NULL;
 
 	if (buffer != NULL) {
 		context = xml2lpc_context_new(xml2lpc_callback, NULL);
-		error_msg = _linphone_config_xml_convert(lpc, context, xml2lpc_set_xml_string(context, buffer));
+		error_msg =
+		    _linphone_config_xml_convert(lpc, context, xml2lpc_set_xml_string(context, buffer), changed_sections);
 	} else {
 		error_msg = empty_xml;
 	}
@@ -657,7 +667,7 @@ const char *_linphone_config_load_from_xml_string(LpConfig *lpc, const char *buf
 
 LinphoneStatus linphone_config_load_from_xml_string(LpConfig *lpc, const char *buffer) {
 	const char *status;
-	if ((status = _linphone_config_load_from_xml_string(lpc, buffer))) {
+	if ((status = _linphone_config_load_from_xml_string(lpc, buffer, NULL))) {
 		ms_error("%s", status);
 		return -1;
 	} else return 0;
@@ -864,12 +874,15 @@ void linphone_config_set_string(LpConfig *lpconfig, const char *section, const c
 				lp_section_remove_item(sec, item);
 			}
 		} else {
-			if (value != NULL && value[0] != '\0') lp_section_add_item(sec, lp_item_new(key, value));
+			if (value == NULL || value[0] == '\0') return;
+			lp_section_add_item(sec, lp_item_new(key, value));
 		}
 	} else if (value != NULL && value[0] != '\0') {
 		sec = lp_section_new(section);
 		linphone_config_add_section(lpconfig, sec);
 		lp_section_add_item(sec, lp_item_new(key, value));
+	} else {
+		return;
 	}
 	lpconfig->modified = TRUE;
 }
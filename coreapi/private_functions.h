@@ -332,6 +332,8 @@ void linphone_core_send_initial_subscribes(LinphoneCore *lc);
 void linphone_proxy_config_update(LinphoneProxyConfig *cfg);
 LinphoneAccount *linphone_proxy_config_get_account(LinphoneProxyConfig *cfg);
 void linphone_account_update(LinphoneAccount *account);
+/* Same as linphone_account_normalize_phone_number(), with the dial plan settings of an account. */
+char *_linphone_normalize_phone_number(const char *dial_prefix, bool_t dial_escape_plus, const char *username);
 
 LinphoneProxyConfig *linphone_core_lookup_known_proxy(LinphoneCore *lc, const LinphoneAddress *uri);
 LinphoneProxyConfig *
@@ -436,6 +438,9 @@ void linphone_conference_scheduler_notify_state_changed(LinphoneConferenceSchedu
                                                         LinphoneConferenceSchedulerState state);
 void linphone_conference_scheduler_notify_invitations_sent(LinphoneConferenceScheduler *conference_scheduler,
                                                            const bctbx_list_t *failed_invites);
+void linphone_conference_scheduler_notify_invitations_progress(LinphoneConferenceScheduler *conference_scheduler,
+                                                               int sent,
+                                                               int total);
 
 void _linphone_participant_device_notify_video_display_error_occurred(LinphoneParticipantDevice *participant_device,
                                                                       int error_code);
@@ -850,6 +855,9 @@ void linphone_core_notify_push_notification_received(LinphoneCore *lc, const cha
 void linphone_core_notify_default_account_changed(LinphoneCore *lc, LinphoneAccount *account);
 void linphone_core_notify_account_added(LinphoneCore *lc, LinphoneAccount *account);
 void linphone_core_notify_account_removed(LinphoneCore *lc, LinphoneAccount *account);
+void linphone_core_notify_unread_chat_message_count_changed(LinphoneCore *lc,
+                                                            const LinphoneAddress *local_address,
+                                                            int count);
 /*
  * return true if at least a registered vtable has a cb for dtmf received*/
 bool_t linphone_core_dtmf_received_has_listener(const LinphoneCore *lc);
@@ -943,7 +951,8 @@ LinphoneVideoDefinition *linphone_factory_find_supported_video_definition(const
 LinphoneVideoDefinition *linphone_factory_find_supported_video_definition_by_name(const LinphoneFactory *factory,
                                                                                   const char *name);
 
-const char *_linphone_config_load_from_xml_string(LpConfig *lpc, const char *buffer);
+/* When changed_sections is not NULL, the names of the sections whose values changed are appended to it. */
+const char *_linphone_config_load_from_xml_string(LpConfig *lpc, const char *buffer, bctbx_list_t **changed_sections);
 void _linphone_config_apply_factory_config(LpConfig *config);
 
 SalCustomHeader *linphone_info_message_get_headers(const LinphoneInfoMessage *im);
@@ -665,6 +665,7 @@ LinphoneStatus linphone_core_add_proxy_config(LinphoneCore *lc, LinphoneProxyCon
 	}
 	lc->sip_conf.proxies = bctbx_list_append(lc->sip_conf.proxies, (void *)linphone_proxy_config_ref(cfg));
 	lc->sip_conf.accounts = bctbx_list_append(lc->sip_conf.accounts, (void *)linphone_account_ref(cfg->account));
+	L_GET_PRIVATE_FROM_C_OBJECT(lc)->accountIndex.add(cfg->account);
 	linphone_proxy_config_apply(cfg, lc);
 
 	linphone_core_notify_account_added(lc, cfg->account);
@@ -707,6 +708,7 @@ void linphone_core_remove_proxy_config(LinphoneCore *lc, LinphoneProxyConfig *cf
 
 	/* we also need to update the accounts list */
 	lc->sip_conf.accounts = bctbx_list_remove(lc->sip_conf.accounts, cfg->account);
+	L_GET_PRIVATE_FROM_C_OBJECT(lc)->accountIndex.invalidate();
 	linphone_core_remove_dependent_account(lc, cfg->account);
 	/* add to the list of destroyed proxies, so that the possible unREGISTER request can succeed authentication */
 	lc->sip_conf.deleted_accounts = bctbx_list_append(lc->sip_conf.deleted_accounts, cfg->account);
@@ -824,6 +826,7 @@ LinphoneStatus linphone_core_add_account(LinphoneCore *lc, LinphoneAccount *acco
 		return 0;
 	}
 	lc->sip_conf.accounts = bctbx_list_append(lc->sip_conf.accounts, (void *)linphone_account_ref(account));
+	L_GET_PRIVATE_FROM_C_OBJECT(lc)->accountIndex.add(account);
 
 	// If there is no back pointer to a proxy config then create a proxy config that will depend on this account
 	// to ensure backward compatibility when using only proxy configs
@@ -864,6 +867,7 @@ void linphone_core_remove_account(LinphoneCore *core, LinphoneAccount *account)
 
 	/* we also need to update the accounts list */
 	core->sip_conf.accounts = bctbx_list_remove(core->sip_conf.accounts, account);
+	L_GET_PRIVATE_FROM_C_OBJECT(core)->accountIndex.invalidate();
 	linphone_core_remove_dependent_account(core, account);
 	/* add to the list of destroyed accounts, so that the possible unREGISTER request can succeed authentication */
 	core->sip_conf.deleted_accounts = bctbx_list_append(core->sip_conf.deleted_accounts, account);
@@ -18,6 +18,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <bctoolbox/crypto.h>
 #include <bctoolbox/defs.h>
 
 #include "linphone/lpconfig.h"
@@ -48,15 +49,77 @@ static void belle_request_process_auth_requested(void *ctx, belle_sip_auth_event
 	linphone_auth_info_fill_belle_sip_event(auth_info, event);
 }
 
-static void linphone_remote_provisioning_apply(LinphoneCore *lc, const char *xml) {
+static void linphone_remote_provisioning_reset_changes(LinphoneCore *lc) {
+	bctbx_list_free_with_data(lc->provisioning_changed_sections, (bctbx_list_free_func)bctbx_free);
+	lc->provisioning_changed_sections = NULL;
+	lc->provisioning_unchanged = FALSE;
+}
+
+static const char *linphone_remote_provisioning_apply_changes(LinphoneCore *lc, const char *xml) {
 	LinphoneConfig *config = linphone_core_get_config(lc);
-	const char *error_msg = _linphone_config_load_from_xml_string(config, xml);
+	bctbx_list_t *changed_sections = NULL;
+	const char *error_msg = _linphone_config_load_from_xml_string(config, xml, &changed_sections);
+
+	linphone_remote_provisioning_reset_changes(lc);
+	if (!error_msg) {
+		const bctbx_list_t *it;
+		_linphone_config_apply_factory_config(config);
+		for (it = changed_sections; it != NULL; it = it->next)
+			ms_message("Remote provisioning changed section [%s]", (const char *)it->data);
+		lc->provisioning_changed_sections = changed_sections;
+		lc->provisioning_unchanged = (changed_sections == NULL);
+	} else {
+		bctbx_list_free_with_data(changed_sections, (bctbx_list_free_func)bctbx_free);
+	}
+	return error_msg;
+}
 
-	_linphone_config_apply_factory_config(config);
+static void linphone_remote_provisioning_apply(LinphoneCore *lc, const char *xml) {
+	const char *error_msg = linphone_remote_provisioning_apply_changes(lc, xml);
 	linphone_configuring_terminated(lc, error_msg ? LinphoneConfiguringFailed : LinphoneConfiguringSuccessful,
 	                                error_msg);
 }
 
+static void linphone_remote_provisioning_terminate_unchanged(LinphoneCore *lc, const char *reason) {
+	ms_message("Remote provisioning: %s, configuration left untouched", reason);
+	linphone_remote_provisioning_reset_changes(lc);
+	lc->provisioning_unchanged = TRUE;
+	linphone_configuring_terminated(lc, LinphoneConfiguringSuccessful, NULL);
+}
+
+static char *linphone_remote_provisioning_compute_hash(const char *body) {
+	uint8_t digest[16];
+	char *hash = (char *)bctbx_malloc(2 * sizeof(digest) + 1);
+	bctbx_md5((const uint8_t *)body, strlen(body), digest);
+	for (size_t i = 0; i < sizeof(digest); i++)
+		snprintf(hash + 2 * i, 3, "%02x", digest[i]);
+	return hash;
+}
+
+static const char *linphone_remote_provisioning_get_header(belle_sip_message_t *message, const char *name) {
+	belle_sip_header_t *header = belle_sip_message_get_header(message, name);
+	return header ? belle_sip_header_get_unparsed_value(header) : NULL;
+}
+
+/*
+ * The validators of the last applied provisioning, kept in [misc] along with the URI they belong to, so that the next
+ * download is a conditional request and an identical body is not applied again.
+ */
+static bool_t linphone_remote_provisioning_validators_match(LinphoneCore *lc, const char *uri) {
+	const char *validated_uri = linphone_config_get_string(lc->config, "misc", "config-uri-validated", NULL);
+	return linphone_config_get_bool(lc->config, "misc", "config-uri-conditional", TRUE) && validated_uri && uri &&
+	       strcmp(validated_uri, uri) == 0;
+}
+
+static void linphone_remote_provisioning_store_validators(
+    LinphoneCore *lc, const char *uri, const char *etag, const char *last_modified, const char *hash) {
+	linphone_config_set_string(lc->config, "misc", "config-uri-validated", uri);
+	linphone_config_set_string(lc->config, "misc", "config-uri-etag", etag);
+	linphone_config_set_string(lc->config, "misc", "config-uri-last-modified", last_modified);
+	linphone_config_set_string(lc->config, "misc", "config-uri-hash", hash);
+	if (linphone_config_needs_commit(lc->config)) linphone_config_sync(lc->config);
+}
+
 int linphone_remote_provisioning_load_file(LinphoneCore *lc, const char *file_path) {
 	int status = -1;
 	char *provisioning = ms_load_path_content(file_path, NULL);
@@ -76,7 +139,30 @@ static void belle_request_process_response_event(void *ctx, const belle_http_res
 
 	int statusCode = belle_http_response_get_status_code(event->response);
 	if (statusCode == 200) {
-		linphone_remote_provisioning_apply(lc, body);
+		char *uri = event->request ? belle_generic_uri_to_string(belle_http_request_get_uri(event->request)) : NULL;
+		char *hash = body ? linphone_remote_provisioning_compute_hash(body) : NULL;
+		const char *stored_hash = linphone_config_get_string(lc->config, "misc", "config-uri-hash", NULL);
+		const char *error_msg = NULL;
+
+		if (hash && stored_hash && strcmp(hash, stored_hash) == 0 &&
+		    linphone_remote_provisioning_validators_match(lc, uri)) {
+			linphone_remote_provisioning_reset_changes(lc);
+			lc->provisioning_unchanged = TRUE;
+			ms_message("Remote provisioning: same content as last time, configuration left untouched");
+		} else {
+			error_msg = linphone_remote_provisioning_apply_changes(lc, body);
+		}
+		if (!error_msg && uri) {
+			const char *etag = linphone_remote_provisioning_get_header(message, "ETag");
+			const char *last_modified = linphone_remote_provisioning_get_header(message, "Last-Modified");
+			linphone_remote_provisioning_store_validators(lc, uri, etag, last_modified, hash);
+		}
+		if (hash) bctbx_free(hash);
+		if (uri) belle_sip_free(uri);
+		linphone_configuring_terminated(lc, error_msg ? LinphoneConfiguringFailed : LinphoneConfiguringSuccessful,
+		                                error_msg);
+	} else if (statusCode == 304) {
+		linphone_remote_provisioning_terminate_unchanged(lc, "not modified since last download");
 	} else if (statusCode == 401) {
 		linphone_configuring_terminated(lc, LinphoneConfiguringFailed, "http auth requested");
 	} else {
@@ -115,6 +201,21 @@ int linphone_remote_provisioning_download_and_apply(LinphoneCore *lc,
 		                                    belle_sip_header_create("User-Agent", linphone_core_get_user_agent(lc)),
 		                                    belle_sip_header_create("X-Linphone-Provisioning", "1"), NULL);
 
+		// Only ask for the content if it changed since the last time it was applied.
+		char *uri_str = belle_generic_uri_to_string(uri);
+		if (linphone_remote_provisioning_validators_match(lc, uri_str)) {
+			const char *etag = linphone_config_get_string(lc->config, "misc", "config-uri-etag", NULL);
+			const char *last_modified =
+			    linphone_config_get_string(lc->config, "misc", "config-uri-last-modified", NULL);
+			if (etag)
+				belle_sip_message_add_header(BELLE_SIP_MESSAGE(request),
+				                             belle_http_header_create("If-None-Match", etag));
+			if (last_modified)
+				belle_sip_message_add_header(BELLE_SIP_MESSAGE(request),
+				                             belle_http_header_create("If-Modified-Since", last_modified));
+		}
+		belle_sip_free(uri_str);
+
 		const bctbx_list_t *header_it = remote_provisioning_headers;
 		while (header_it) {
 			const bctbx_list_t *pair_value = (const bctbx_list_t *)bctbx_list_get_data(header_it);
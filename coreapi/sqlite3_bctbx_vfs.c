@@ -227,10 +227,140 @@ static int sqlite3bctbx_Sync(sqlite3_file *p, BCTBX_UNUSED(int flags)) {
 
 /************************ END OF PLACE HOLDER FUNCTIONS ***********************/
 
+/************************ NATIVE FILE FUNCTIONS ***********************/
+/** When the default bctbx VFS is the standard one, files are not encrypted and
+the operations are forwarded to the file opened by the native SQLite VFS, which
+brings file locking, the shared memory needed by WAL journaling and memory mapped
+reads. */
+
+#define SQLITE3_BCTBX_NATIVE_FILE(p) (((sqlite3_bctbx_file_t *)(p))->pNativeFile)
+
+static int sqlite3bctbx_nativeClose(sqlite3_file *p) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xClose(pNative);
+}
+
+static int sqlite3bctbx_nativeRead(sqlite3_file *p, void *buf, int count, sqlite_int64 offset) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xRead(pNative, buf, count, offset);
+}
+
+static int sqlite3bctbx_nativeWrite(sqlite3_file *p, const void *buf, int count, sqlite_int64 offset) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xWrite(pNative, buf, count, offset);
+}
+
+static int sqlite3bctbx_nativeTruncate(sqlite3_file *p, sqlite_int64 size) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xTruncate(pNative, size);
+}
+
+static int sqlite3bctbx_nativeSync(sqlite3_file *p, int flags) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xSync(pNative, flags);
+}
+
+static int sqlite3bctbx_nativeFileSize(sqlite3_file *p, sqlite_int64 *pSize) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xFileSize(pNative, pSize);
+}
+
+static int sqlite3bctbx_nativeLock(sqlite3_file *p, int level) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xLock(pNative, level);
+}
+
+static int sqlite3bctbx_nativeUnlock(sqlite3_file *p, int level) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xUnlock(pNative, level);
+}
+
+static int sqlite3bctbx_nativeCheckReservedLock(sqlite3_file *p, int *pResOut) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xCheckReservedLock(pNative, pResOut);
+}
+
+static int sqlite3bctbx_nativeFileControl(sqlite3_file *p, int op, void *pArg) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xFileControl(pNative, op, pArg);
+}
+
+static int sqlite3bctbx_nativeSectorSize(sqlite3_file *p) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xSectorSize(pNative);
+}
+
+static int sqlite3bctbx_nativeDeviceCharacteristics(sqlite3_file *p) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	return pNative->pMethods->xDeviceCharacteristics(pNative);
+}
+
+/**
+ * Maps a region of the shared memory holding the WAL index.
+ * @param  p        sqlite3_file file handle pointer.
+ * @param  iPg      index of the region
+ * @param  pgsz     size of the region in bytes
+ * @param  bExtend  whether the shared memory may be extended to hold the region
+ * @param  pp       set to the address of the region
+ * @return          SQLITE_OK on success, SQLITE_IOERR_SHMMAP if the native file has no shared memory support.
+ */
+static int sqlite3bctbx_nativeShmMap(sqlite3_file *p, int iPg, int pgsz, int bExtend, void volatile **pp) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	if (pNative->pMethods->iVersion < 2 || pNative->pMethods->xShmMap == NULL) return SQLITE_IOERR_SHMMAP;
+	return pNative->pMethods->xShmMap(pNative, iPg, pgsz, bExtend, pp);
+}
+
+static int sqlite3bctbx_nativeShmLock(sqlite3_file *p, int offset, int n, int flags) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	if (pNative->pMethods->iVersion < 2 || pNative->pMethods->xShmLock == NULL) return SQLITE_IOERR_SHMLOCK;
+	return pNative->pMethods->xShmLock(pNative, offset, n, flags);
+}
+
+static void sqlite3bctbx_nativeShmBarrier(sqlite3_file *p) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	if (pNative->pMethods->iVersion >= 2 && pNative->pMethods->xShmBarrier != NULL)
+		pNative->pMethods->xShmBarrier(pNative);
+}
+
+static int sqlite3bctbx_nativeShmUnmap(sqlite3_file *p, int deleteFlag) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	if (pNative->pMethods->iVersion < 2 || pNative->pMethods->xShmUnmap == NULL) return SQLITE_OK;
+	return pNative->pMethods->xShmUnmap(pNative, deleteFlag);
+}
+
+/**
+ * Gives a pointer to the memory mapped content of the file, when mmap_size allows it.
+ * @param  p       sqlite3_file file handle pointer.
+ * @param  offset  file offset of the requested content
+ * @param  count   size of the requested content in bytes
+ * @param  pp      set to the mapped content, or to NULL if SQLite must read it with xRead
+ * @return         SQLITE_OK on success.
+ */
+static int sqlite3bctbx_nativeFetch(sqlite3_file *p, sqlite_int64 offset, int count, void **pp) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	if (pNative->pMethods->iVersion < 3 || pNative->pMethods->xFetch == NULL) {
+		*pp = NULL;
+		return SQLITE_OK;
+	}
+	return pNative->pMethods->xFetch(pNative, offset, count, pp);
+}
+
+static int sqlite3bctbx_nativeUnfetch(sqlite3_file *p, sqlite_int64 offset, void *ptr) {
+	sqlite3_file *pNative = SQLITE3_BCTBX_NATIVE_FILE(p);
+	if (pNative->pMethods->iVersion < 3 || pNative->pMethods->xUnfetch == NULL) return SQLITE_OK;
+	return pNative->pMethods->xUnfetch(pNative, offset, ptr);
+}
+
+/************************ END OF NATIVE FILE FUNCTIONS ***********************/
+
 /**
  * Opens the file fName and populates the structure pointed by p
  * with the necessary io_methods
- * Methods not implemented for version 1 : xTruncate, xSectorSize.
+ * When the default bctbx VFS is the standard one, the file is opened by the native
+ * SQLite VFS, stored in the pAppData of pVfs, and all the operations are forwarded to it.
+ * Otherwise the file is opened with the default bctbx VFS, which may encrypt it, without
+ * locking, shared memory nor memory mapping: methods not implemented are then xSectorSize
+ * and all the ones of version 2 and 3.
  * Initializes some fields in the p structure, some of which where already
  * initialized by SQLite.
  * @param  pVfs      sqlite3_vfs VFS pointer.
@@ -240,8 +370,28 @@ static int sqlite3bctbx_Sync(sqlite3_file *p, BCTBX_UNUSED(int flags)) {
  * @param  pOutFlags flags used by SQLite
  * @return           SQLITE_CANTOPEN on error, SQLITE_OK on success.
  */
-static int
-sqlite3bctbx_Open(BCTBX_UNUSED(sqlite3_vfs *pVfs), const char *fName, sqlite3_file *p, int flags, int *pOutFlags) {
+static int sqlite3bctbx_Open(sqlite3_vfs *pVfs, const char *fName, sqlite3_file *p, int flags, int *pOutFlags) {
+	static const sqlite3_io_methods sqlite3_bctbx_native_io = {
+	    3,                                        /* iVersion         Structure version number */
+	    sqlite3bctbx_nativeClose,                 /* xClose */
+	    sqlite3bctbx_nativeRead,                  /* xRead */
+	    sqlite3bctbx_nativeWrite,                 /* xWrite */
+	    sqlite3bctbx_nativeTruncate,              /* xTruncate */
+	    sqlite3bctbx_nativeSync,                  /* xSync */
+	    sqlite3bctbx_nativeFileSize,              /* xFileSize */
+	    sqlite3bctbx_nativeLock,                  /* xLock */
+	    sqlite3bctbx_nativeUnlock,                /* xUnlock */
+	    sqlite3bctbx_nativeCheckReservedLock,     /* xCheckReservedLock */
+	    sqlite3bctbx_nativeFileControl,           /* xFileControl */
+	    sqlite3bctbx_nativeSectorSize,            /* xSectorSize */
+	    sqlite3bctbx_nativeDeviceCharacteristics, /* xDeviceCharacteristics */
+	    sqlite3bctbx_nativeShmMap,                /* xShmMap */
+	    sqlite3bctbx_nativeShmLock,               /* xShmLock */
+	    sqlite3bctbx_nativeShmBarrier,            /* xShmBarrier */
+	    sqlite3bctbx_nativeShmUnmap,              /* xShmUnmap */
+	    sqlite3bctbx_nativeFetch,                 /* xFetch */
+	    sqlite3bctbx_nativeUnfetch                /* xUnfetch */
+	};
 	static const sqlite3_io_methods sqlite3_bctbx_io = {
 	    1,                     /* iVersion         Structure version number */
 	    sqlite3bctbx_Close,    /* xClose */
@@ -260,11 +410,35 @@ sqlite3bctbx_Open(BCTBX_UNUSED(sqlite3_vfs *pVfs), const char *fName, sqlite3_fi
 	};
 
 	sqlite3_bctbx_file_t *pFile = (sqlite3_bctbx_file_t *)p; /*File handle sqlite3_bctbx_file_t*/
+	sqlite3_vfs *pNativeVfs = (sqlite3_vfs *)pVfs->pAppData;
 	int openFlags = 0;
 	char *wFname;
 
-	/*returns error if filename is empty or file handle not initialized*/
-	if (pFile == NULL || fName == NULL) {
+	/*returns error if file handle not initialized*/
+	if (pFile == NULL) {
+		return SQLITE_IOERR;
+	}
+	pFile->pbctbx_file = NULL;
+	pFile->pNativeFile = NULL;
+
+	/* Files are not encrypted: let the native VFS handle them, including the temporary files without name. The
+	 * native file handle is stored right after ours, see szOsFile in sqlite3_bctbx_vfs_register. */
+	if (pNativeVfs != NULL && bctbx_vfs_get_default() == bctbx_vfs_get_standard()) {
+		sqlite3_file *pNativeFile = (sqlite3_file *)(pFile + 1);
+		int ret;
+		pNativeFile->pMethods = NULL;
+		ret = pNativeVfs->xOpen(pNativeVfs, fName, pNativeFile, flags, pOutFlags);
+		if (pNativeFile->pMethods == NULL) {
+			return (ret == SQLITE_OK) ? SQLITE_CANTOPEN : ret;
+		}
+		/* Even when the open failed, SQLite calls xClose if pMethods is set: it must reach the native file. */
+		pFile->pNativeFile = pNativeFile;
+		pFile->base.pMethods = &sqlite3_bctbx_native_io;
+		return ret;
+	}
+
+	/*returns error if filename is empty*/
+	if (fName == NULL) {
 		return SQLITE_IOERR;
 	}
 
@@ -299,8 +473,8 @@ sqlite3bctbx_Open(BCTBX_UNUSED(sqlite3_vfs *pVfs), const char *fName, sqlite3_fi
 
 sqlite3_vfs *sqlite3_bctbx_vfs_create(void) {
 	static sqlite3_vfs bctbx_vfs = {
-	    1,                            /* iVersion */
-	    sizeof(sqlite3_bctbx_file_t), /* szOsFile */
+	    3,                            /* iVersion */
+	    sizeof(sqlite3_bctbx_file_t), /* szOsFile, the one of the native VFS is added on registration */
 	    MAXPATHNAME,                  /* mxPathname */
 	    NULL,                         /* pNext */
 	    BCTBX_SQLITE3_VFS,            /* zName */
@@ -359,8 +533,11 @@ void sqlite3_bctbx_vfs_register(int makeDefault) {
 #if _WIN32
 	sqlite3_vfs *pDefault = sqlite3_vfs_find("win32");
 #else
-	sqlite3_vfs *pDefault = sqlite3_vfs_find("unix-none");
+	sqlite3_vfs *pDefault = sqlite3_vfs_find("unix");
 #endif
+	/* Files that are not encrypted are opened by the native VFS, in the memory allocated by SQLite for ours. */
+	pVfsToUse->szOsFile = (int)sizeof(sqlite3_bctbx_file_t) + pDefault->szOsFile;
+	pVfsToUse->pAppData = pDefault;
 	pVfsToUse->xCurrentTime = pDefault->xCurrentTime;
 
 	pVfsToUse->xAccess = pDefault->xAccess;
@@ -370,15 +547,21 @@ void sqlite3_bctbx_vfs_register(int makeDefault) {
 	pVfsToUse->xSleep = pDefault->xSleep;
 	pVfsToUse->xRandomness = pDefault->xRandomness;
 	pVfsToUse->xGetLastError = pDefault->xGetLastError; /* Not implemented by sqlite3 :place holder */
-	/*Functions below should not be a problem sincve we are declaring ourselves
-	 in version 1 */
-
-	/* used in version 2
-	xCurrentTimeInt64;*/
-	/* used in version 3
-	xGetSystemCall
-	xSetSystemCall
-	xNextSystemCall*/
+	pVfsToUse->xDlOpen = pDefault->xDlOpen;
+	pVfsToUse->xDlError = pDefault->xDlError;
+	pVfsToUse->xDlSym = pDefault->xDlSym;
+	pVfsToUse->xDlClose = pDefault->xDlClose;
+
+	/* used in version 2 */
+	if (pDefault->iVersion >= 2) pVfsToUse->xCurrentTimeInt64 = pDefault->xCurrentTimeInt64;
+	/* used in version 3 */
+	if (pDefault->iVersion >= 3) {
+		pVfsToUse->xSetSystemCall = pDefault->xSetSystemCall;
+		pVfsToUse->xGetSystemCall = pDefault->xGetSystemCall;
+		pVfsToUse->xNextSystemCall = pDefault->xNextSystemCall;
+	} else {
+		pVfsToUse->iVersion = pDefault->iVersion;
+	}
 
 	sqlite3_vfs_register(pVfsToUse, makeDefault);
 }
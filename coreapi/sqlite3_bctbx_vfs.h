@@ -43,6 +43,7 @@ typedef struct sqlite3_bctbx_file_t sqlite3_bctbx_file_t;
 struct sqlite3_bctbx_file_t {
 	sqlite3_file base; /* Base class. Must be first. */
 	bctbx_vfs_file_t *pbctbx_file;
+	sqlite3_file *pNativeFile; /* Set when the file is handled by the native VFS, the bctbx file is then unused. */
 };
 
 /**
@@ -87,7 +88,10 @@ sqlite3_vfs *sqlite3_bctbx_vfs_create(void);
  * Registers sqlite3bctbx_vfs to SQLite VFS. If makeDefault is 1,
  * the VFS will be used by default.
  * Methods not implemented by sqlite3_bctbx_vfs_t are initialized to the one
- * used by the unix-none VFS where all locking file operations are no-ops.
+ * used by the native VFS (unix or win32). While the default bctbx VFS is the standard
+ * one, the files are opened by the native VFS too, so that they get file locking, WAL
+ * journaling and memory mapped reads. Files opened while an encrypted bctbx VFS is the
+ * default one keep going through it, without locking.
  * @param  makeDefault  set to 1 to make the newly registered VFS be the default one, set to 0 instead.
  */
 void sqlite3_bctbx_vfs_register(int makeDefault);
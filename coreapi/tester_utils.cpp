@@ -30,17 +30,22 @@
 #include "private.h"
 #include "tester_utils.h"
 
+#include "address/address-cache.h"
+#include "address/address-parser.h"
+#include "alert/alert.h"
 #include "c-wrapper/c-wrapper.h"
 #include "call/call.h"
 #include "chat/chat-room/chat-room-p.h"
 #include "chat/chat-room/client-group-chat-room-p.h"
 #include "chat/encryption/encryption-engine.h"
+#include "conference/conference-scheduler.h"
 #include "conference/session/media-session-p.h"
 #include "core/core-p.h"
 #include "event-log/conference/conference-chat-message-event.h"
 #include "friend/friend-list.h"
 #include "friend/friend.h"
 #include "mediastreamer2/msanalysedisplay.h"
+#include "sal/offeranswer.h"
 
 using namespace std;
 
@@ -62,6 +67,14 @@ belle_http_provider_t *linphone_core_get_http_provider(const LinphoneCore *lc) {
 	return lc->http_provider;
 }
 
+const bctbx_list_t *linphone_core_get_provisioning_changed_sections(const LinphoneCore *lc) {
+	return lc->provisioning_changed_sections;
+}
+
+int linphone_core_get_publication_count(LinphoneCore *lc) {
+	return (int)L_GET_CPP_PTR_FROM_C_OBJECT(lc)->getPublicationStore().size();
+}
+
 void linphone_core_enable_send_call_stats_periodical_updates(LinphoneCore *lc, bool_t enabled) {
 	lc->send_call_stats_periodical_updates = enabled;
 }
@@ -120,6 +133,67 @@ int linphone_friend_list_get_revision(const LinphoneFriendList *lfl) {
 	return FriendList::toCpp(lfl)->mRevision;
 }
 
+SalAddress *_linphone_address_parse_sip_uri(const char *uri) {
+	return AddressParser::parseSipUri(L_C_TO_STRING(uri));
+}
+
+SalAddress *_linphone_address_parse_identity(const char *address) {
+	return AddressParser::get().parseAddress(L_C_TO_STRING(address));
+}
+
+size_t _linphone_address_cache_get_size(void) {
+	return AddressCache::get().size();
+}
+
+size_t _linphone_address_cache_get_capacity(void) {
+	return AddressCache::get().getCapacity();
+}
+
+void _linphone_address_cache_set_capacity(size_t capacity) {
+	AddressCache::get().setCapacity(capacity);
+}
+
+unsigned long long _linphone_address_cache_get_hits(void) {
+	return AddressCache::get().getHits();
+}
+
+unsigned int
+_linphone_conference_scheduler_get_nb_ics_bodies_rendered(const LinphoneConferenceScheduler *conference_scheduler) {
+	return ConferenceScheduler::toCpp(conference_scheduler)->getNbIcsBodiesRendered();
+}
+
+unsigned int
+_linphone_conference_scheduler_get_nb_conference_info_stored(const LinphoneConferenceScheduler *conference_scheduler) {
+	return ConferenceScheduler::toCpp(conference_scheduler)->getNbConferenceInfoStored();
+}
+
+void _linphone_call_run_alert_checks(LinphoneCall *call, LinphoneCallStats *stats, int stream_count, int tick_count) {
+	// Video and network monitors of a stream, as in MS2Stream.
+	struct StreamAlertMonitors {
+		explicit StreamAlertMonitors(MediaSession &session) : network(session), video(session), bandwidth(session) {
+		}
+
+		NetworkQualityAlertMonitor network;
+		VideoQualityAlertMonitor video;
+		VideoBandwidthAlertMonitor bandwidth;
+	};
+
+	auto session = static_pointer_cast<MediaSession>(Call::toCpp(call)->getActiveSession());
+	if (!session) return;
+	VideoControlInterface::VideoStats sendStats = {30.0f, 640, 480};
+	VideoControlInterface::VideoStats recvStats = {30.0f, 640, 480};
+	vector<unique_ptr<StreamAlertMonitors>> monitors;
+	for (int i = 0; i < stream_count; ++i)
+		monitors.emplace_back(new StreamAlertMonitors(*session));
+	for (int tick = 0; tick < tick_count; ++tick) {
+		for (auto &monitor : monitors) {
+			monitor->network.check(stats, false);
+			monitor->video.check(&sendStats, &recvStats, 30.0f);
+			monitor->bandwidth.check(stats);
+		}
+	}
+}
+
 unsigned int _linphone_call_get_nb_audio_starts(const LinphoneCall *call) {
 	const LinphoneStreamInternalStats *st = _linphone_call_get_stream_internal_stats(call, LinphoneStreamTypeAudio);
 	return st ? st->number_of_starts : 0;
@@ -176,6 +250,81 @@ SalMediaDescription *_linphone_call_get_result_desc(const LinphoneCall *call) {
 	    .get();
 }
 
+void _linphone_call_history_cache_update(CallHistoryCache &cache,
+                                         long long id,
+                                         const std::shared_ptr<CallLog> &call_log) {
+	cache.update(id, call_log);
+}
+
+void _linphone_call_history_cache_remove(CallHistoryCache &cache, long long id) {
+	cache.remove(id);
+}
+
+std::list<long long> _linphone_call_history_cache_get_ids_for_local_address(const CallHistoryCache &cache,
+                                                                           const std::shared_ptr<const Address> &local,
+                                                                           int limit) {
+	return cache.getIdsForLocalAddress(local, limit);
+}
+
+std::list<long long> _linphone_call_history_cache_get_ids(const CallHistoryCache &cache,
+                                                          const std::shared_ptr<const Address> &peer,
+                                                          const std::shared_ptr<const Address> &local,
+                                                          int limit) {
+	return cache.getIds(peer, local, limit);
+}
+
+long long _linphone_call_history_cache_find_id(const CallHistoryCache &cache, const char *call_id, int limit) {
+	return cache.findId(L_C_TO_STRING(call_id), limit);
+}
+
+long long _linphone_call_history_cache_get_last_outgoing_call_id(const CallHistoryCache &cache) {
+	return cache.getLastOutgoingCallId();
+}
+
+CallHistoryCache::Stats
+_linphone_call_history_cache_get_stats_for_local_address(const CallHistoryCache &cache,
+                                                         const std::shared_ptr<const Address> &local) {
+	return cache.getStatsForLocalAddress(local);
+}
+
+std::shared_ptr<LdapResultCache> _linphone_ldap_result_cache_new(void) {
+	return make_shared<LdapResultCache>();
+}
+
+std::shared_ptr<const LdapResultCache::Result> _linphone_ldap_result_cache_find(LdapResultCache &cache,
+                                                                                const LdapResultCache::Query &query) {
+	return cache.find(query);
+}
+
+void _linphone_ldap_result_cache_insert(LdapResultCache &cache,
+                                        const LdapResultCache::Query &query,
+                                        const LdapResultCache::Result &result,
+                                        uint64_t ttl_ms) {
+	cache.insert(query, result, ttl_ms);
+}
+
+void _linphone_ldap_result_cache_clear(LdapResultCache &cache) {
+	cache.clear();
+}
+
+void _linphone_ldap_result_cache_set_capacity(LdapResultCache &cache, size_t capacity) {
+	cache.setCapacity(capacity);
+}
+
+bool _linphone_ldap_result_cache_match_filter(const char *filter,
+                                              const LdapResultCache::Attributes &attributes,
+                                              bool &supported) {
+	return LdapResultCache::matchFilter(L_C_TO_STRING(filter), attributes, supported);
+}
+
+std::shared_ptr<SalMediaDescription>
+_linphone_offer_answer_initiate_incoming(MSFactory *factory,
+                                         const std::shared_ptr<SalMediaDescription> &local_capabilities,
+                                         const std::shared_ptr<SalMediaDescription> &remote_offer,
+                                         bool_t one_matching_codec) {
+	return OfferAnswerEngine::initiateIncoming(factory, local_capabilities, remote_offer, !!one_matching_codec);
+}
+
 MSWebCam *_linphone_call_get_video_device(const LinphoneCall *call) {
 	return L_GET_PRIVATE(static_pointer_cast<LinphonePrivate::MediaSession>(Call::toCpp(call)->getActiveSession()))
 	    ->getVideoDevice();
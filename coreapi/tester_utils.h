@@ -40,6 +40,11 @@ typedef struct _SalOp SalOp;
 #endif
 
 #ifdef __cplusplus
+#include <memory>
+
+#include "call/call-history-cache.h"
+#include "ldap/ldap-result-cache.h"
+
 LINPHONE_BEGIN_NAMESPACE
 class SalMediaDescription;
 class SalEventOp;
@@ -48,6 +53,47 @@ LINPHONE_END_NAMESPACE
 LINPHONE_PUBLIC LinphonePrivate::SalMediaDescription *_linphone_call_get_local_desc(const LinphoneCall *call);
 LINPHONE_PUBLIC LinphonePrivate::SalMediaDescription *_linphone_call_get_remote_desc(const LinphoneCall *call);
 LINPHONE_PUBLIC LinphonePrivate::SalMediaDescription *_linphone_call_get_result_desc(const LinphoneCall *call);
+// Answer built by the offer/answer engine for a received offer, as for an incoming call.
+LINPHONE_PUBLIC std::shared_ptr<LinphonePrivate::SalMediaDescription> _linphone_offer_answer_initiate_incoming(
+    MSFactory *factory,
+    const std::shared_ptr<LinphonePrivate::SalMediaDescription> &local_capabilities,
+    const std::shared_ptr<LinphonePrivate::SalMediaDescription> &remote_offer,
+    bool_t one_matching_codec);
+// Index of the call history kept by MainDb.
+LINPHONE_PUBLIC void _linphone_call_history_cache_update(LinphonePrivate::CallHistoryCache &cache,
+                                                         long long id,
+                                                         const std::shared_ptr<LinphonePrivate::CallLog> &call_log);
+LINPHONE_PUBLIC void _linphone_call_history_cache_remove(LinphonePrivate::CallHistoryCache &cache, long long id);
+LINPHONE_PUBLIC std::list<long long>
+_linphone_call_history_cache_get_ids_for_local_address(const LinphonePrivate::CallHistoryCache &cache,
+                                                       const std::shared_ptr<const LinphonePrivate::Address> &local,
+                                                       int limit);
+LINPHONE_PUBLIC std::list<long long>
+_linphone_call_history_cache_get_ids(const LinphonePrivate::CallHistoryCache &cache,
+                                     const std::shared_ptr<const LinphonePrivate::Address> &peer,
+                                     const std::shared_ptr<const LinphonePrivate::Address> &local,
+                                     int limit);
+LINPHONE_PUBLIC long long
+_linphone_call_history_cache_find_id(const LinphonePrivate::CallHistoryCache &cache, const char *call_id, int limit);
+LINPHONE_PUBLIC long long
+_linphone_call_history_cache_get_last_outgoing_call_id(const LinphonePrivate::CallHistoryCache &cache);
+LINPHONE_PUBLIC LinphonePrivate::CallHistoryCache::Stats
+_linphone_call_history_cache_get_stats_for_local_address(const LinphonePrivate::CallHistoryCache &cache,
+                                                         const std::shared_ptr<const LinphonePrivate::Address> &local);
+// Cache of the LDAP search results, shared by the LDAP contact providers of a core.
+LINPHONE_PUBLIC std::shared_ptr<LinphonePrivate::LdapResultCache> _linphone_ldap_result_cache_new(void);
+LINPHONE_PUBLIC std::shared_ptr<const LinphonePrivate::LdapResultCache::Result>
+_linphone_ldap_result_cache_find(LinphonePrivate::LdapResultCache &cache,
+                                 const LinphonePrivate::LdapResultCache::Query &query);
+LINPHONE_PUBLIC void _linphone_ldap_result_cache_insert(LinphonePrivate::LdapResultCache &cache,
+                                                        const LinphonePrivate::LdapResultCache::Query &query,
+                                                        const LinphonePrivate::LdapResultCache::Result &result,
+                                                        uint64_t ttl_ms);
+LINPHONE_PUBLIC void _linphone_ldap_result_cache_clear(LinphonePrivate::LdapResultCache &cache);
+LINPHONE_PUBLIC void _linphone_ldap_result_cache_set_capacity(LinphonePrivate::LdapResultCache &cache,
+                                                              size_t capacity);
+LINPHONE_PUBLIC bool _linphone_ldap_result_cache_match_filter(
+    const char *filter, const LinphonePrivate::LdapResultCache::Attributes &attributes, bool &supported);
 extern "C" {
 LINPHONE_PUBLIC LinphoneEvent *linphone_event_new_subscribe_with_op(LinphoneCore *lc,
                                                                     LinphonePrivate::SalSubscribeOp *op,
@@ -108,6 +154,10 @@ LINPHONE_PUBLIC int linphone_core_get_local_ip_for(int type, const char *dest, c
 LINPHONE_PUBLIC void linphone_core_enable_forced_ice_relay(LinphoneCore *lc, bool_t enable);
 LINPHONE_PUBLIC void linphone_core_set_zrtp_not_available_simulation(LinphoneCore *lc, bool_t enabled);
 LINPHONE_PUBLIC belle_http_provider_t *linphone_core_get_http_provider(const LinphoneCore *lc);
+// Sections changed by the last remote provisioning that was applied, as const char *
+LINPHONE_PUBLIC const bctbx_list_t *linphone_core_get_provisioning_changed_sections(const LinphoneCore *lc);
+// Number of publications received and stored by the core as a PUBLISH target.
+LINPHONE_PUBLIC int linphone_core_get_publication_count(LinphoneCore *lc);
 LINPHONE_PUBLIC IceSession *linphone_call_get_ice_session(const LinphoneCall *call);
 LINPHONE_PUBLIC const struct addrinfo *linphone_core_get_stun_server_addrinfo(LinphoneCore *lc);
 LINPHONE_PUBLIC void linphone_core_enable_send_call_stats_periodical_updates(LinphoneCore *lc, bool_t enabled);
@@ -167,6 +217,10 @@ LINPHONE_PUBLIC void _linphone_call_add_local_desc_changed_flag(LinphoneCall *ca
 LINPHONE_PUBLIC int _linphone_call_get_main_audio_stream_index(const LinphoneCall *call);
 LINPHONE_PUBLIC int _linphone_call_get_main_text_stream_index(const LinphoneCall *call);
 LINPHONE_PUBLIC int _linphone_call_get_main_video_stream_index(const LinphoneCall *call);
+// Builds the alert monitors of stream_count streams of the call, then runs tick_count times the checks MS2Stream runs
+// each second, with the given stats and a 640x480 video at 30 fps sent and received.
+LINPHONE_PUBLIC void
+_linphone_call_run_alert_checks(LinphoneCall *call, LinphoneCallStats *stats, int stream_count, int tick_count);
 
 LINPHONE_PUBLIC void linphone_call_params_set_no_user_consent(LinphoneCallParams *params, bool_t value);
 LINPHONE_PUBLIC bool_t linphone_call_params_get_update_call_when_ice_completed(const LinphoneCallParams *params);
@@ -204,6 +258,19 @@ LINPHONE_PUBLIC bctbx_list_t **linphone_friend_list_get_friends_attribute(Linpho
 LINPHONE_PUBLIC const bctbx_list_t *linphone_friend_list_get_dirty_friends_to_update(const LinphoneFriendList *lfl);
 LINPHONE_PUBLIC int linphone_friend_list_get_revision(const LinphoneFriendList *lfl);
 
+// Parsers and per-thread cache used by Address, the returned SalAddress must be unreferenced by the caller.
+LINPHONE_PUBLIC SalAddress *_linphone_address_parse_sip_uri(const char *uri);
+LINPHONE_PUBLIC SalAddress *_linphone_address_parse_identity(const char *address);
+LINPHONE_PUBLIC size_t _linphone_address_cache_get_size(void);
+LINPHONE_PUBLIC size_t _linphone_address_cache_get_capacity(void);
+LINPHONE_PUBLIC void _linphone_address_cache_set_capacity(size_t capacity);
+LINPHONE_PUBLIC unsigned long long _linphone_address_cache_get_hits(void);
+
+LINPHONE_PUBLIC unsigned int
+_linphone_conference_scheduler_get_nb_ics_bodies_rendered(const LinphoneConferenceScheduler *conference_scheduler);
+LINPHONE_PUBLIC unsigned int
+_linphone_conference_scheduler_get_nb_conference_info_stored(const LinphoneConferenceScheduler *conference_scheduler);
+
 LINPHONE_PUBLIC int linphone_remote_provisioning_load_file(LinphoneCore *lc, const char *file_path);
 
 LINPHONE_PUBLIC char *linphone_core_get_device_identity(LinphoneCore *lc);
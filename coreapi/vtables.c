@@ -548,6 +548,13 @@ void linphone_core_notify_account_removed(LinphoneCore *lc, LinphoneAccount *acc
 	cleanup_dead_vtable_refs(lc);
 }
 
+void linphone_core_notify_unread_chat_message_count_changed(LinphoneCore *lc,
+                                                            const LinphoneAddress *local_address,
+                                                            int count) {
+	NOTIFY_IF_EXIST(unread_chat_message_count_changed, lc, local_address, count);
+	cleanup_dead_vtable_refs(lc);
+}
+
 static VTableReference *v_table_reference_new(LinphoneCoreCbs *cbs, bool_t internal) {
 	VTableReference *ref = ms_new0(VTableReference, 1);
 	ref->valid = TRUE;
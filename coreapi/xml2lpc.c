@@ -31,6 +31,7 @@ struct _xml2lpc_context {
 
 	xmlDoc *doc;
 	xmlDoc *xsd;
+	bctbx_list_t *changedSections;
 	char errorBuffer[XML2LPC_BZ];
 	char warningBuffer[XML2LPC_BZ];
 };
@@ -44,6 +45,7 @@ xml2lpc_context *xml2lpc_context_new(xml2lpc_function cbf, void *ctx) {
 
 		xmlCtx->doc = NULL;
 		xmlCtx->xsd = NULL;
+		xmlCtx->changedSections = NULL;
 		xmlCtx->errorBuffer[0] = '\0';
 		xmlCtx->warningBuffer[0] = '\0';
 	}
@@ -59,6 +61,7 @@ void xml2lpc_context_destroy(xml2lpc_context *ctx) {
 		xmlFreeDoc(ctx->xsd);
 		ctx->xsd = NULL;
 	}
+	bctbx_list_free_with_data(ctx->changedSections, (bctbx_list_free_func)bctbx_free);
 
 	// TODO Fix me, xml2 isn't robust for use with multiple context
 	// Unset callback to not disturb other user of the xml lib
@@ -152,8 +155,16 @@ static int processEntry(xmlElement *element, const char *sectionName, xml2lpc_co
 	if (name != NULL) {
 		const char *str = linphone_config_get_string(ctx->lpc, sectionName, name, NULL);
 		if (str == NULL || overwrite) {
+			// Setting an empty value removes the entry.
+			bool_t changed = (str == NULL) ? (value[0] != '\0') : (strcmp(str, value) != 0);
+			if (!changed) {
+				xml2lpc_log(ctx, XML2LPC_DEBUG, "Unchanged %s|%s = %s", sectionName, name, value);
+				return 0;
+			}
 			xml2lpc_log(ctx, XML2LPC_MESSAGE, "Set %s|%s = %s", sectionName, name, value);
 			linphone_config_set_string(ctx->lpc, sectionName, name, value);
+			if (!bctbx_list_find_custom(ctx->changedSections, (bctbx_compare_func)strcmp, sectionName))
+				ctx->changedSections = bctbx_list_append(ctx->changedSections, bctbx_strdup(sectionName));
 		} else {
 			xml2lpc_log(ctx, XML2LPC_MESSAGE, "Don't touch %s|%s = %s", sectionName, name, str);
 		}
@@ -258,9 +269,15 @@ int xml2lpc_convert(xml2lpc_context *xmlCtx, LpConfig *lpc) {
 		xml2lpc_log(xmlCtx, XML2LPC_ERROR, "Invalid lpc");
 	}
 	xmlCtx->lpc = lpc;
+	bctbx_list_free_with_data(xmlCtx->changedSections, (bctbx_list_free_func)bctbx_free);
+	xmlCtx->changedSections = NULL;
 	return internal_convert_xml2lpc(xmlCtx);
 }
 
+const bctbx_list_t *xml2lpc_get_changed_sections(const xml2lpc_context *xmlCtx) {
+	return xmlCtx->changedSections;
+}
+
 int xml2lpc_set_xml_file(xml2lpc_context *xmlCtx, const char *filename) {
 	xml2lpc_context_clear_logs(xmlCtx);
 	xmlSetGenericErrorFunc(xmlCtx, xml2lpc_genericxml_error);
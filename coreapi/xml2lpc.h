@@ -51,6 +51,8 @@ LINPHONE_PUBLIC int xml2lpc_set_xsd_string(xml2lpc_context *context, const char
 
 LINPHONE_PUBLIC int xml2lpc_validate(xml2lpc_context *context);
 LINPHONE_PUBLIC int xml2lpc_convert(xml2lpc_context *context, LpConfig *lpc);
+/* Names of the sections in which the last xml2lpc_convert() changed at least one entry, as const char *. */
+LINPHONE_PUBLIC const bctbx_list_t *xml2lpc_get_changed_sections(const xml2lpc_context *context);
 
 #ifdef __cplusplus
 }
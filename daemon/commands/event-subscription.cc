@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "event-subscription.h"
+
+using namespace std;
+
+class EventSubscriptionResponse : public Response {
+public:
+	EventSubscriptionResponse(const DaemonClient *client);
+};
+
+EventSubscriptionResponse::EventSubscriptionResponse(const DaemonClient *client) : Response() {
+	ostringstream ost;
+	ost << "Subscriptions:";
+	for (const auto &pattern : client->getSubscriptions())
+		ost << " " << pattern;
+	ost << "\n";
+	setBody(ost.str());
+}
+
+EventSubscribeCommand::EventSubscribeCommand()
+    : DaemonCommand("event-subscribe",
+                    "event-subscribe [<event type>|<prefix>*|all] ...",
+                    "Send the events of the given types to this client as soon as they happen, instead of waiting for "
+                    "pop-event. A type ending with '*' matches every event type starting with the prefix. Without "
+                    "parameter, list the current subscriptions. Only available to clients connected with --pipe.") {
+	addExample(make_unique<DaemonCommandExample>("event-subscribe call-* message-*",
+	                                             "Status: Ok\n\n"
+	                                             "Subscriptions: call-* message-*"));
+	addExample(make_unique<DaemonCommandExample>("event-subscribe", "Status: Ok\n\n"
+	                                                                "Subscriptions:"));
+}
+
+void EventSubscribeCommand::exec(Daemon *app, const string &args) {
+	DaemonClient *client = app->getCurrentClient();
+	if (!client) {
+		app->sendResponse(Response("Events are already printed on the standard output.", Response::Error));
+		return;
+	}
+	istringstream ist(args);
+	string pattern;
+	while (ist >> pattern)
+		client->subscribe(pattern == "all" ? "*" : pattern);
+	app->sendResponse(EventSubscriptionResponse(client));
+}
+
+EventUnsubscribeCommand::EventUnsubscribeCommand()
+    : DaemonCommand("event-unsubscribe",
+                    "event-unsubscribe [<event type>|<prefix>*|all] ...",
+                    "Stop sending the events of the given types to this client. Without parameter, or with 'all', "
+                    "remove every subscription. The patterns must be the ones given to event-subscribe.") {
+	addExample(make_unique<DaemonCommandExample>("event-unsubscribe message-*", "Status: Ok\n\n"
+	                                                                            "Subscriptions: call-*"));
+	addExample(make_unique<DaemonCommandExample>("event-unsubscribe", "Status: Ok\n\n"
+	                                                                  "Subscriptions:"));
+}
+
+void EventUnsubscribeCommand::exec(Daemon *app, const string &args) {
+	DaemonClient *client = app->getCurrentClient();
+	if (!client) {
+		app->sendResponse(Response("Events are already printed on the standard output.", Response::Error));
+		return;
+	}
+	istringstream ist(args);
+	string pattern;
+	bool empty = true;
+	while (ist >> pattern) {
+		empty = false;
+		if (pattern == "all") client->unsubscribeAll();
+		else client->unsubscribe(pattern);
+	}
+	if (empty) client->unsubscribeAll();
+	app->sendResponse(EventSubscriptionResponse(client));
+}
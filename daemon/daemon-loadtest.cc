@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Load test of the linphone-daemon control socket: several clients send framed requests, with a number of them in
+ * flight, and optionally subscribe to events. It reports the commands per second, the round trip time of the requests
+ * and the latency of the events, measured from the time the daemon queued them: the daemon must run on the same host.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+struct LoadTestOptions {
+	string pipePath;
+	string command = "version";
+	string events;
+	string eventCommand;
+	int clients = 4;
+	int requests = 10000;
+	int window = 32;
+	int eventInterval = 100;
+};
+
+struct ClientResult {
+	vector<double> roundTrips; // ms
+	vector<double> eventLatencies; // ms
+	unsigned long long droppedEvents = 0;
+	int errors = 0;
+	bool failed = false;
+};
+
+static void printHelp() {
+	printf("linphone-daemon-loadtest --pipe <path> [<options>]\n"
+	       "where options are :\n"
+	       "\t--pipe <path>              Path of the unix socket given to linphone-daemon --pipe.\n"
+	       "\t--clients <n>              Number of simultaneous clients (default 4).\n"
+	       "\t--requests <n>             Number of requests sent by each client (default 10000).\n"
+	       "\t--window <n>               Number of requests in flight per client (default 32).\n"
+	       "\t--command <command>        Command to send (default 'version').\n"
+	       "\t--events <pattern>         Subscribe to the events matching the pattern, eg. 'all' or 'call-*'.\n"
+	       "\t--event-command <command>  Command sent instead of the main one every --event-interval requests, to\n"
+	       "\t                           trigger events.\n"
+	       "\t--event-interval <n>       Default 100.\n");
+}
+
+static double percentile(vector<double> &values, double ratio) {
+	if (values.empty()) return 0;
+	sort(values.begin(), values.end());
+	size_t index = (size_t)(ratio * (double)(values.size() - 1));
+	return values[index];
+}
+
+#ifndef _WIN32
+
+static long long nowUs() {
+	return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static string getHeader(const string &headers, const string &name) {
+	size_t pos = (headers.compare(0, name.size(), name) == 0) ? 0 : headers.find("\n" + name);
+	if (pos == string::npos) return string();
+	if (pos != 0) pos++;
+	pos += name.size();
+	size_t end = headers.find('\n', pos);
+	return headers.substr(pos, end == string::npos ? string::npos : end - pos);
+}
+
+static bool sendAll(int fd, const string &data) {
+	size_t offset = 0;
+	while (offset < data.size()) {
+		ssize_t ret = send(fd, data.data() + offset, data.size() - offset, 0);
+		if (ret <= 0) return false;
+		offset += (size_t)ret;
+	}
+	return true;
+}
+
+static void runClient(const LoadTestOptions &options, ClientResult &result) {
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	struct sockaddr_un sa;
+	memset(&sa, 0, sizeof(sa));
+	sa.sun_family = AF_UNIX;
+	strncpy(sa.sun_path, options.pipePath.c_str(), sizeof(sa.sun_path) - 1);
+	if (fd == -1 || connect(fd, (struct sockaddr *)&sa, sizeof(sa)) == -1) {
+		fprintf(stderr, "Could not connect to %s: %s\n", options.pipePath.c_str(), strerror(errno));
+		if (fd != -1) close(fd);
+		result.failed = true;
+		return;
+	}
+
+	map<long long, long long> inFlight; // request id -> send time
+	long long nextId = 0;
+	int answered = 0;
+	int total = options.requests;
+	string input;
+
+	if (!options.events.empty()) {
+		inFlight[nextId] = nowUs();
+		sendAll(fd, "@" + to_string(nextId++) + " event-subscribe " + options.events + "\n");
+		total++;
+	}
+
+	while (answered < total) {
+		string requests;
+		while ((long long)inFlight.size() < options.window && nextId < total) {
+			bool eventRequest = !options.eventCommand.empty() && nextId % options.eventInterval == 0;
+			const string &command = eventRequest ? options.eventCommand : options.command;
+			inFlight[nextId] = nowUs();
+			requests += "@" + to_string(nextId++) + " " + command + "\n";
+		}
+		if (!requests.empty() && !sendAll(fd, requests)) {
+			result.failed = true;
+			break;
+		}
+
+		struct pollfd pfd = {fd, POLLIN, 0};
+		if (poll(&pfd, 1, 5000) <= 0) {
+			fprintf(stderr, "No answer from the daemon for 5 s, %zu requests in flight\n", inFlight.size());
+			result.failed = true;
+			break;
+		}
+		char buffer[65536];
+		ssize_t ret = recv(fd, buffer, sizeof(buffer), 0);
+		if (ret <= 0) {
+			result.failed = true;
+			break;
+		}
+		input.append(buffer, (size_t)ret);
+
+		// Frames are headers, an empty line, then Content-Length bytes.
+		size_t end;
+		while ((end = input.find("\n\n")) != string::npos) {
+			string headers = input.substr(0, end + 1);
+			size_t length = (size_t)atol(getHeader(headers, "Content-Length: ").c_str());
+			if (input.size() < end + 2 + length) break;
+			string body = input.substr(end + 2, length);
+			input.erase(0, end + 2 + length);
+
+			long long now = nowUs();
+			string requestId = getHeader(headers, "Request-Id: ");
+			string eventTime = getHeader(headers, "Event-Time: ");
+			if (!requestId.empty()) {
+				auto it = inFlight.find(atoll(requestId.c_str()));
+				if (it != inFlight.end()) {
+					result.roundTrips.push_back((double)(now - it->second) / 1000.0);
+					inFlight.erase(it);
+					answered++;
+				}
+				if (body.compare(0, 13, "Status: Error") == 0) result.errors++;
+			} else if (!eventTime.empty()) {
+				result.eventLatencies.push_back((double)(now - atoll(eventTime.c_str())) / 1000.0);
+				result.droppedEvents += strtoull(getHeader(headers, "Dropped-Events: ").c_str(), NULL, 10);
+			}
+		}
+	}
+	close(fd);
+}
+
+#endif
+
+int main(int argc, char *argv[]) {
+	LoadTestOptions options;
+
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg == "--help") {
+			printHelp();
+			return 0;
+		}
+		if (i + 1 >= argc) {
+			fprintf(stderr, "Missing value after %s\n", argv[i]);
+			return -1;
+		}
+		const char *value = argv[++i];
+		if (arg == "--pipe") options.pipePath = value;
+		else if (arg == "--clients") options.clients = atoi(value);
+		else if (arg == "--requests") options.requests = atoi(value);
+		else if (arg == "--window") options.window = atoi(value);
+		else if (arg == "--command") options.command = value;
+		else if (arg == "--events") options.events = value;
+		else if (arg == "--event-command") options.eventCommand = value;
+		else if (arg == "--event-interval") options.eventInterval = atoi(value);
+		else {
+			fprintf(stderr, "Unrecognized option : %s\n", argv[i - 1]);
+			return -1;
+		}
+	}
+	if (options.pipePath.empty() || options.clients <= 0 || options.requests <= 0 || options.window <= 0 ||
+	    options.eventInterval <= 0) {
+		printHelp();
+		return -1;
+	}
+
+#ifdef _WIN32
+	fprintf(stderr, "linphone-daemon-loadtest needs unix sockets.\n");
+	return -1;
+#else
+	vector<ClientResult> results((size_t)options.clients);
+	vector<thread> threads;
+	auto start = chrono::steady_clock::now();
+	for (auto &result : results)
+		threads.emplace_back(runClient, cref(options), ref(result));
+	for (auto &t : threads)
+		t.join();
+	double duration = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	ClientResult total;
+	bool failed = false;
+	for (auto &result : results) {
+		total.roundTrips.insert(total.roundTrips.end(), result.roundTrips.begin(), result.roundTrips.end());
+		total.eventLatencies.insert(total.eventLatencies.end(), result.eventLatencies.begin(),
+		                            result.eventLatencies.end());
+		total.droppedEvents += result.droppedEvents;
+		total.errors += result.errors;
+		failed = failed || result.failed;
+	}
+
+	printf("%d clients, %zu requests in %.3f s: %.0f commands/s, %d error responses\n", options.clients,
+	       total.roundTrips.size(), duration, duration > 0 ? (double)total.roundTrips.size() / duration : 0,
+	       total.errors);
+	printf("Round trip: p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", percentile(total.roundTrips, 0.5),
+	       percentile(total.roundTrips, 0.99), percentile(total.roundTrips, 1));
+	if (!options.events.empty()) {
+		printf("%zu events received, %llu dropped by the daemon\n", total.eventLatencies.size(), total.droppedEvents);
+		printf("Event latency: p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", percentile(total.eventLatencies, 0.5),
+		       percentile(total.eventLatencies, 0.99), percentile(total.eventLatencies, 1));
+	}
+	return failed ? 1 : 0;
+#endif
+}
@@ -31,6 +31,7 @@
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 #ifdef HAVE_READLINE
 #include <readline/history.h>
@@ -39,6 +40,7 @@
 
 #ifndef _WIN32
 #include <poll.h>
+#include <sys/socket.h>
 #endif
 
 #include <bctoolbox/defs.h>
@@ -66,6 +68,7 @@
 #include "commands/contact.h"
 #include "commands/dtmf.h"
 #include "commands/echo.h"
+#include "commands/event-subscription.h"
 #include "commands/firewall-policy.h"
 #include "commands/help.h"
 #include "commands/ipv6.h"
@@ -323,16 +326,147 @@ bool DaemonCommand::matches(const string &name) const {
 	return mName.compare(name) == 0;
 }
 
+DaemonClient::DaemonClient(bctbx_pipe_t fd) : mFd(fd) {
+}
+
+DaemonClient::~DaemonClient() {
+	bctbx_server_pipe_close_client(mFd);
+}
+
+void DaemonClient::appendInput(const char *data, size_t size) {
+	mInput.append(data, size);
+	if (mInput.size() > maxOutput) {
+		ms_error("Daemon client [%p] sent %zu bytes without end of line, disconnecting it", this, mInput.size());
+		mInput.clear();
+		mClosed = true;
+	}
+}
+
+bool DaemonClient::popCommand(string &command, string &requestId, bool endOfRead) {
+	size_t end = mInput.find('\n');
+	if (end == string::npos) {
+		if (mInput.empty() || mFramed || !endOfRead) return false;
+		end = mInput.size();
+	}
+	string line = mInput.substr(0, end);
+	mInput.erase(0, min(end + 1, mInput.size()));
+	if (!line.empty() && line.back() == '\r') line.pop_back();
+
+	requestId.clear();
+	if (!line.empty() && line[0] == '@') {
+		size_t space = line.find(' ');
+		requestId = line.substr(1, space == string::npos ? string::npos : space - 1);
+		line = (space == string::npos) ? string() : line.substr(space + 1);
+		mFramed = true;
+	}
+	command = line;
+	return true;
+}
+
+void DaemonClient::subscribe(const string &pattern) {
+	mSubscriptions.insert(pattern);
+}
+
+void DaemonClient::unsubscribe(const string &pattern) {
+	mSubscriptions.erase(pattern);
+}
+
+void DaemonClient::unsubscribeAll() {
+	mSubscriptions.clear();
+}
+
+bool DaemonClient::isSubscribed(const string &eventType) const {
+	for (const auto &pattern : mSubscriptions) {
+		if (!pattern.empty() && pattern.back() == '*') {
+			if (eventType.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0) return true;
+		} else if (pattern == eventType) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void DaemonClient::pushOutput(const string &buf) {
+	if (mOutputOffset > 0 && mOutputOffset == mOutput.size()) {
+		mOutput.clear();
+		mOutputOffset = 0;
+	}
+	mOutput.append(buf);
+	if (mOutput.size() - mOutputOffset > maxOutput) {
+		ms_error("Daemon client [%p] does not read its responses, disconnecting it", this);
+		mClosed = true;
+	}
+}
+
+void DaemonClient::pushResponse(const string &requestId, const string &buf) {
+	if (!mFramed) {
+		pushOutput(buf);
+		return;
+	}
+	ostringstream ostr;
+	if (!requestId.empty()) ostr << "Request-Id: " << requestId << "\n";
+	ostr << "Content-Length: " << buf.size() << "\n\n" << buf;
+	pushOutput(ostr.str());
+}
+
+void DaemonClient::pushEvent(const Event &event, unsigned long long sequence) {
+	if (mOutput.size() - mOutputOffset > maxEventOutput) {
+		mDroppedEvents++;
+		return;
+	}
+	string buf = event.toBuf();
+	if (!mFramed) {
+		pushOutput("\n" + buf + "\n");
+		return;
+	}
+	ostringstream ostr;
+	ostr << "Event-Id: " << sequence << "\n";
+	ostr << "Event-Time: "
+	     << chrono::duration_cast<chrono::microseconds>(event.getQueuedAt().time_since_epoch()).count() << "\n";
+	if (mDroppedEvents) {
+		ostr << "Dropped-Events: " << mDroppedEvents << "\n";
+		mDroppedEvents = 0;
+	}
+	ostr << "Content-Length: " << buf.size() << "\n\n" << buf;
+	pushOutput(ostr.str());
+}
+
+void DaemonClient::flush() {
+	while (!mClosed && hasPendingOutput()) {
+		size_t size = mOutput.size() - mOutputOffset;
+#ifdef _WIN32
+		int ret = bctbx_pipe_write(mFd, (uint8_t *)mOutput.data() + mOutputOffset, (int)size);
+#else
+		int flags = MSG_DONTWAIT;
+#ifdef MSG_NOSIGNAL
+		flags |= MSG_NOSIGNAL;
+#endif
+		ssize_t ret = send(mFd, mOutput.data() + mOutputOffset, size, flags);
+		if (ret == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return;
+#endif
+		if (ret <= 0) {
+			ms_error("Fail to write to daemon client [%p]: %s", this, strerror(errno));
+			mClosed = true;
+			return;
+		}
+		mOutputOffset += (size_t)ret;
+	}
+	if (mOutputOffset == mOutput.size()) {
+		mOutput.clear();
+		mOutputOffset = 0;
+	}
+}
+
 Daemon::Daemon(const char *config_path,
                const char *factory_config_path,
                const char *log_file,
                const char *pipe_path,
                bool display_video,
                bool capture_video)
-    : mLSD(0), mLogFile(NULL), mAutoVideo(0), mCallIds(0), mProxyIds(0), mAudioStreamIds(0) {
+    : mLSD(0), mEventSequence(0), mDroppedEvents(0), mCurrentClient(NULL), mLogFile(NULL), mAutoVideo(0), mCallIds(0),
+      mProxyIds(0), mAudioStreamIds(0) {
 	ms_mutex_init(&mMutex, NULL);
 	mServerFd = (bctbx_pipe_t)-1;
-	mChildFd = (bctbx_pipe_t)-1;
 	if (pipe_path == NULL) {
 #ifdef HAVE_READLINE
 		const char *homedir = getenv("HOME");
@@ -345,7 +479,7 @@ Daemon::Daemon(const char *config_path,
 	} else {
 		mServerFd = bctbx_server_pipe_create_by_path(pipe_path);
 #ifndef _WIN32
-		listen(mServerFd, 2);
+		listen(mServerFd, SOMAXCONN);
 		fprintf(stdout, "Server unix socket created, path=%s fd=%i\n", pipe_path, (int)mServerFd);
 #else
 		fprintf(stdout, "Named pipe  created, path=%s fd=%p\n", pipe_path, mServerFd);
@@ -485,6 +619,8 @@ void Daemon::initCommands() {
 	mCommands.push_back(new DtmfCommand());
 	mCommands.push_back(new PlayWavCommand());
 	mCommands.push_back(new PopEventCommand());
+	mCommands.push_back(new EventSubscribeCommand());
+	mCommands.push_back(new EventUnsubscribeCommand());
 	mCommands.push_back(new AnswerCommand());
 	mCommands.push_back(new CallStatusCommand());
 	mCommands.push_back(new CallStatsCommand());
@@ -618,8 +754,7 @@ void Daemon::iterateStreamStats() {
 			OrtpEventType evt = ortp_event_get_type(ev);
 			if (evt == ORTP_EVENT_RTCP_PACKET_RECEIVED || evt == ORTP_EVENT_RTCP_PACKET_EMITTED) {
 				linphone_call_stats_fill(it->second->stats, &it->second->stream->ms, ev);
-				if (mUseStatsEvents)
-					mEventQueue.push(new AudioStreamStatsEvent(this, it->second->stream, it->second->stats));
+				if (mUseStatsEvents) queueEvent(new AudioStreamStatsEvent(this, it->second->stream, it->second->stats));
 			}
 			ortp_event_destroy(ev);
 		}
@@ -629,18 +764,29 @@ void Daemon::iterateStreamStats() {
 void Daemon::iterate() {
 	linphone_core_iterate(mLc);
 	iterateStreamStats();
-	if (mChildFd == (bctbx_pipe_t)-1) {
-		if (!mEventQueue.empty()) {
+	if (mClients.empty()) {
+		// Nobody to pop the events: print them all, a burst of events must not wait for the next iterations.
+		bool printed = false;
+		while (!mEventQueue.empty()) {
 			Event *r = mEventQueue.front();
 			mEventQueue.pop();
 			fprintf(stdout, "\n%s\n", r->toBuf().c_str());
-			fflush(stdout);
 			delete r;
+			printed = true;
 		}
+		if (printed) fflush(stdout);
+	} else {
+		flushClients();
+	}
+}
+
+void Daemon::flushClients() {
+	for (auto client : mClients) {
+		if (client->hasPendingOutput()) client->flush();
 	}
 }
 
-void Daemon::execCommand(const string &command) {
+void Daemon::execCommand(const string &command, DaemonClient *client, const string &requestId) {
 	istringstream ist(command);
 	string name;
 	ist >> name;
@@ -650,100 +796,144 @@ void Daemon::execCommand(const string &command) {
 	if (!args.empty() && (args[0] == ' ')) args.erase(0, 1);
 	list<DaemonCommand *>::iterator it =
 	    find_if(mCommands.begin(), mCommands.end(), [&name](const DaemonCommand *dc) { return dc->matches(name); });
+	ms_mutex_lock(&mMutex);
+	mCurrentClient = client;
+	mCurrentRequestId = requestId;
 	if (it != mCommands.end()) {
-		ms_mutex_lock(&mMutex);
 		(*it)->exec(this, args);
-		ms_mutex_unlock(&mMutex);
 	} else {
 		sendResponse(Response("Unknown command."));
 	}
+	// Asynchronous responses go to the client that sent the last command, without request id.
+	mCurrentRequestId.clear();
+	ms_mutex_unlock(&mMutex);
 }
 
 void Daemon::sendResponse(const Response &resp) {
 	string buf = resp.toBuf();
-	if (mChildFd != (bctbx_pipe_t)-1) {
-		if (bctbx_pipe_write(mChildFd, (uint8_t *)buf.c_str(), (int)buf.size()) == -1) {
-			ms_error("Fail to write to pipe: %s", strerror(errno));
-		}
+	if (mCurrentClient) {
+		mCurrentClient->pushResponse(mCurrentRequestId, buf);
+		mCurrentClient->flush();
 	} else {
 		cout << buf << flush;
 	}
 }
 
 void Daemon::queueEvent(Event *ev) {
+	unsigned long long sequence = ++mEventSequence;
+	for (auto client : mClients) {
+		if (client->isSubscribed(ev->getType())) client->pushEvent(*ev, sequence);
+	}
 	mEventQueue.push(ev);
+	if (mEventQueue.size() > maxQueuedEvents) {
+		delete mEventQueue.front();
+		mEventQueue.pop();
+		if (mDroppedEvents++ == 0 || mDroppedEvents % maxQueuedEvents == 0)
+			ms_warning("Event queue full, %llu events dropped so far: use pop-event or event-subscribe",
+			           mDroppedEvents);
+	}
 }
 
-string Daemon::readPipe() {
+void Daemon::processClients() {
+	struct PendingCommand {
+		DaemonClient *client;
+		string command;
+		string requestId;
+	};
+	vector<PendingCommand> commands;
 	char buffer[32768];
-	memset(buffer, '\0', sizeof(buffer));
+	string command, requestId;
+
 #ifdef _WIN32
-	if (mChildFd == (bctbx_pipe_t)-1) {
-		mChildFd = bctbx_server_pipe_accept_client(mServerFd);
+	// Named pipes are read with blocking calls: one client at a time.
+	if (mClients.empty()) {
+		bctbx_pipe_t fd = bctbx_server_pipe_accept_client(mServerFd);
+		if (fd == (bctbx_pipe_t)-1) return;
 		ms_message("Client accepted");
+		ms_mutex_lock(&mMutex);
+		mClients.push_back(new DaemonClient(fd));
+		ms_mutex_unlock(&mMutex);
 	}
-	if (mChildFd != (bctbx_pipe_t)-1) {
-		int ret = bctbx_pipe_read(mChildFd, (uint8_t *)buffer, sizeof(buffer));
-		if (ret == -1) {
-			ms_error("Fail to read from pipe: %s", strerror(errno));
-			mChildFd = (bctbx_pipe_t)-1;
-		} else {
-			if (ret == 0) {
-				ms_message("Client disconnected");
-				mChildFd = (bctbx_pipe_t)-1;
-				return "";
-			}
-			buffer[ret] = '\0';
-			return buffer;
-		}
+	DaemonClient *client = mClients.front();
+	int ret = bctbx_pipe_read(client->getFd(), (uint8_t *)buffer, sizeof(buffer));
+	ms_mutex_lock(&mMutex);
+	if (ret <= 0) {
+		if (ret == -1) ms_error("Fail to read from pipe: %s", strerror(errno));
+		else ms_message("Client disconnected");
+		client->close();
+	} else {
+		client->appendInput(buffer, (size_t)ret);
+		while (client->popCommand(command, requestId, true))
+			commands.push_back({client, command, requestId});
 	}
+	ms_mutex_unlock(&mMutex);
 #else
-	struct pollfd pfd[2];
-	int nfds = 1;
-	memset(&pfd[0], 0, sizeof(pfd));
-	if (mServerFd != (bctbx_pipe_t)-1) {
-		pfd[0].events = POLLIN;
-		pfd[0].fd = mServerFd;
+	vector<struct pollfd> pfds(1);
+	pfds[0].fd = mServerFd;
+	pfds[0].events = POLLIN;
+	pfds[0].revents = 0;
+	ms_mutex_lock(&mMutex);
+	for (auto client : mClients) {
+		struct pollfd pfd;
+		pfd.fd = client->getFd();
+		pfd.events = (short)(POLLIN | (client->hasPendingOutput() ? POLLOUT : 0));
+		pfd.revents = 0;
+		pfds.push_back(pfd);
 	}
-	if (mChildFd != (bctbx_pipe_t)-1) {
-		pfd[1].events = POLLIN;
-		pfd[1].fd = mChildFd;
-		nfds++;
-	}
-	int err = poll(pfd, (nfds_t)nfds, 50);
-	if (err > 0) {
-		if (mServerFd != (bctbx_pipe_t)-1 && (pfd[0].revents & POLLIN)) {
-			struct sockaddr_storage addr;
-			socklen_t addrlen = sizeof(addr);
-			int childfd = accept(mServerFd, (struct sockaddr *)&addr, &addrlen);
-			if (childfd != -1) {
-				if (mChildFd != (bctbx_pipe_t)-1) {
-					ms_error("Cannot accept two client at the same time");
-					close(childfd);
-				} else {
-					mChildFd = (bctbx_pipe_t)childfd;
-					return "";
-				}
-			}
+	ms_mutex_unlock(&mMutex);
+
+	if (poll(pfds.data(), (nfds_t)pfds.size(), 50) <= 0) return;
+
+	ms_mutex_lock(&mMutex);
+	// Clients are only added and removed by this thread: they are in the same order as the poll descriptors.
+	auto it = mClients.begin();
+	for (size_t i = 1; i < pfds.size() && it != mClients.end(); ++i, ++it) {
+		DaemonClient *client = *it;
+		if (pfds[i].revents & POLLOUT) client->flush();
+		if (!(pfds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+		ssize_t ret = recv(client->getFd(), buffer, sizeof(buffer), 0);
+		if (ret <= 0) {
+			if (ret == -1) ms_error("Fail to read from daemon client [%p]: %s", client, strerror(errno));
+			else ms_message("Daemon client [%p] disconnected", client);
+			client->close();
+			continue;
 		}
-		if (mChildFd != (bctbx_pipe_t)-1 && (pfd[1].revents & POLLIN)) {
-			int ret;
-			if ((ret = bctbx_pipe_read(mChildFd, (uint8_t *)buffer, sizeof(buffer))) == -1) {
-				ms_error("Fail to read from pipe: %s", strerror(errno));
-			} else {
-				if (ret == 0) {
-					ms_message("Client disconnected");
-					bctbx_server_pipe_close_client(mChildFd);
-					mChildFd = (bctbx_pipe_t)-1;
-					return "";
-				}
-				buffer[ret] = '\0';
-				return buffer;
-			}
+		client->appendInput(buffer, (size_t)ret);
+		while (client->popCommand(command, requestId, true))
+			commands.push_back({client, command, requestId});
+	}
+	if (pfds[0].revents & POLLIN) {
+		struct sockaddr_storage addr;
+		socklen_t addrlen = sizeof(addr);
+		int childfd = accept(mServerFd, (struct sockaddr *)&addr, &addrlen);
+		if (childfd != -1) {
+			mClients.push_back(new DaemonClient((bctbx_pipe_t)childfd));
+			ms_message("Daemon client [%p] accepted, %zu clients connected", mClients.back(), mClients.size());
 		}
 	}
+	ms_mutex_unlock(&mMutex);
 #endif
-	return "";
+
+	for (const auto &pending : commands) {
+		if (!pending.client->isClosed() && !pending.command.empty())
+			execCommand(pending.command, pending.client, pending.requestId);
+	}
+	removeClosedClients();
+}
+
+void Daemon::removeClosedClients() {
+	ms_mutex_lock(&mMutex);
+	for (auto it = mClients.begin(); it != mClients.end();) {
+		DaemonClient *client = *it;
+		if (client->isClosed()) {
+			if (mCurrentClient == client) mCurrentClient = NULL;
+			delete client;
+			it = mClients.erase(it);
+		} else {
+			++it;
+		}
+	}
+	ms_mutex_unlock(&mMutex);
 }
 
 void Daemon::dumpCommandsHelp() {
@@ -842,7 +1032,8 @@ static void printHelp() {
 	     << "\t--dump-commands-help       Dump the help of every available commands." << endl
 	     << "\t--dump-commands-html-help  Dump the help of every available commands." << endl
 	     << "\t--pipe <pipepath>          Create an unix server socket in the specified path to receive commands from. "
-	        "For Windows just use a name instead of a path."
+	        "For Windows just use a name instead of a path. Several clients may be connected at the same time; a "
+	        "command line prefixed with '@<id> ' gets its response framed with this request id and its length."
 	     << endl
 	     << "\t--log <path>               Supply a file where the log will be saved." << endl
 	     << "\t--factory-config <path>    Supply a readonly linphonerc style config file to start with." << endl
@@ -895,7 +1086,7 @@ int Daemon::run() {
 #endif
 			}
 		} else {
-			line = readPipe();
+			processClients();
 		}
 		if (!line.empty()) {
 			execCommand(line);
@@ -944,8 +1135,12 @@ Daemon::~Daemon() {
 
 	enableLSD(false);
 	linphone_core_unref(mLc);
-	if (mChildFd != (bctbx_pipe_t)-1) {
-		bctbx_server_pipe_close_client(mChildFd);
+	for (auto client : mClients)
+		delete client;
+	mClients.clear();
+	while (!mEventQueue.empty()) {
+		delete mEventQueue.front();
+		mEventQueue.pop();
 	}
 	if (mServerFd != (bctbx_pipe_t)-1) {
 		bctbx_server_pipe_close(mServerFd);
@@ -27,9 +27,11 @@
 #include <mediastreamer2/mediastream.h>
 #include <mediastreamer2/mscommon.h>
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -150,7 +152,14 @@ private:
  * queueEvent().*/
 class Event {
 public:
-	Event(const std::string &eventType, const std::string &body = "") : mEventType(eventType), mBody(body) {
+	Event(const std::string &eventType, const std::string &body = "")
+	    : mEventType(eventType), mBody(body), mQueuedAt(std::chrono::steady_clock::now()) {
+	}
+	const std::string &getType() const {
+		return mEventType;
+	}
+	const std::chrono::steady_clock::time_point &getQueuedAt() const {
+		return mQueuedAt;
 	}
 	const std::string &getBody() const {
 		return mBody;
@@ -173,6 +182,70 @@ public:
 protected:
 	const std::string mEventType;
 	std::string mBody;
+	const std::chrono::steady_clock::time_point mQueuedAt;
+};
+
+/*
+ * A client connected to the daemon socket. Commands are read line by line; a line starting with "@<id> " is a framed
+ * request: from then on, everything sent to the client is framed with headers giving its length, and responses carry
+ * the request id, so that several requests may be in flight. Events are pushed to the client as soon as they are
+ * queued if it subscribed to their type.
+ */
+class DaemonClient {
+public:
+	// Beyond this amount of pending output, events are dropped for this client.
+	static const size_t maxEventOutput = 1024 * 1024;
+	// Beyond this amount of pending output, or of input without end of line, the client is disconnected.
+	static const size_t maxOutput = 16 * 1024 * 1024;
+
+	DaemonClient(bctbx_pipe_t fd);
+	~DaemonClient();
+
+	bctbx_pipe_t getFd() const {
+		return mFd;
+	}
+	bool isFramed() const {
+		return mFramed;
+	}
+	bool isClosed() const {
+		return mClosed;
+	}
+	void close() {
+		mClosed = true;
+	}
+	bool hasPendingOutput() const {
+		return mOutputOffset < mOutput.size();
+	}
+
+	void appendInput(const char *data, size_t size);
+	// Extract the next complete command. Unframed clients historically sent a command per write, without end of line:
+	// with endOfRead, what remains of the input is then taken as a command.
+	bool popCommand(std::string &command, std::string &requestId, bool endOfRead);
+
+	void subscribe(const std::string &pattern);
+	void unsubscribe(const std::string &pattern);
+	void unsubscribeAll();
+	bool isSubscribed(const std::string &eventType) const;
+	const std::set<std::string> &getSubscriptions() const {
+		return mSubscriptions;
+	}
+
+	void pushResponse(const std::string &requestId, const std::string &buf);
+	void pushEvent(const Event &event, unsigned long long sequence);
+	// Write as much pending output as possible without blocking.
+	void flush();
+
+private:
+	void pushOutput(const std::string &buf);
+
+	bctbx_pipe_t mFd;
+	bool mFramed = false;
+	bool mClosed = false;
+	std::string mInput;
+	std::string mOutput;
+	size_t mOutputOffset = 0;
+	std::set<std::string> mSubscriptions;
+	unsigned long long mDroppedEvents = 0;
 };
 
 class CallEvent : public Event {
@@ -265,6 +338,10 @@ public:
 	void quit();
 	void sendResponse(const Response &resp);
 	void queueEvent(Event *resp);
+	// The client that sent the command being executed, or the last one, NULL when reading from the standard input.
+	DaemonClient *getCurrentClient() const {
+		return mCurrentClient;
+	}
 	LinphoneCore *getCore();
 	LinphoneSoundDaemon *getLSD();
 	const std::list<DaemonCommand *> &getCommandList() const;
@@ -308,9 +385,11 @@ private:
 	void dtmfReceived(LinphoneCall *call, int dtmf);
 	void messageReceived(LinphoneChatRoom *cr, LinphoneChatMessage *msg);
 
-	void execCommand(const std::string &command);
+	void execCommand(const std::string &command, DaemonClient *client = NULL, const std::string &requestId = "");
 	std::string readLine(const std::string &, bool *);
-	std::string readPipe();
+	void processClients();
+	void removeClosedClients();
+	void flushClients();
 	void iterate();
 	void iterateStreamStats();
 	void startThread();
@@ -321,8 +400,14 @@ private:
 	LinphoneSoundDaemon *mLSD;
 	std::list<DaemonCommand *> mCommands;
 	std::queue<Event *> mEventQueue;
+	// The events are kept for pop-event up to this number, the oldest ones being dropped.
+	static const size_t maxQueuedEvents = 1000;
+	unsigned long long mEventSequence;
+	unsigned long long mDroppedEvents;
 	ortp_pipe_t mServerFd;
-	ortp_pipe_t mChildFd;
+	std::list<DaemonClient *> mClients;
+	DaemonClient *mCurrentClient;
+	std::string mCurrentRequestId;
 	std::string mHistfile;
 	bool mRunning;
 	bool mUseStatsEvents;
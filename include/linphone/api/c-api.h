@@ -32,6 +32,7 @@
 #include "linphone/api/c-audio-device.h"
 #include "linphone/api/c-auth-info.h"
 #include "linphone/api/c-call-cbs.h"
+#include "linphone/api/c-call-log-iterator.h"
 #include "linphone/api/c-call-log.h"
 #include "linphone/api/c-call-stats.h"
 #include "linphone/api/c-call.h"
@@ -49,6 +50,7 @@
 #include "linphone/api/c-dictionary.h"
 #include "linphone/api/c-digest-authentication-policy.h"
 #include "linphone/api/c-event-cbs.h"
+#include "linphone/api/c-event-log-iterator.h"
 #include "linphone/api/c-event-log.h"
 #include "linphone/api/c-event.h"
 #include "linphone/api/c-friend-phone-number.h"
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_C_CALL_LOG_ITERATOR_H_
+#define _L_C_CALL_LOG_ITERATOR_H_
+
+#include "linphone/api/c-types.h"
+
+// =============================================================================
+
+#ifdef __cplusplus
+extern "C" {
+#endif // ifdef __cplusplus
+
+/**
+ * @addtogroup call_logs
+ * @{
+ */
+
+/**
+ * Increment reference count of #LinphoneCallLogIterator object.
+ * @param iterator A #LinphoneCallLogIterator object @notnil
+ * @return the same #LinphoneCallLogIterator object @notnil
+ **/
+LINPHONE_PUBLIC LinphoneCallLogIterator *linphone_call_log_iterator_ref(LinphoneCallLogIterator *iterator);
+
+/**
+ * Decrement reference count of #LinphoneCallLogIterator object. When dropped to zero, memory is freed.
+ * @param iterator A #LinphoneCallLogIterator object @notnil
+ **/
+LINPHONE_PUBLIC void linphone_call_log_iterator_unref(LinphoneCallLogIterator *iterator);
+
+/**
+ * Tells whether there is at least one more call log to walk through.
+ * The next page of call logs is fetched from the database if needed.
+ * @param iterator A #LinphoneCallLogIterator object @notnil
+ * @return TRUE if linphone_call_log_iterator_next() will return a call log, FALSE otherwise.
+ **/
+LINPHONE_PUBLIC bool_t linphone_call_log_iterator_has_next(LinphoneCallLogIterator *iterator);
+
+/**
+ * Moves to the next call log, from the most recent call to the oldest one.
+ * The returned call log is only kept referenced by the iterator until the next call.
+ * @param iterator A #LinphoneCallLogIterator object @notnil
+ * @return The next #LinphoneCallLog, or NULL if the end of the history has been reached. @maybenil
+ **/
+LINPHONE_PUBLIC LinphoneCallLog *linphone_call_log_iterator_next(LinphoneCallLogIterator *iterator);
+
+/**
+ * Returns the maximum number of call logs fetched from the database at once.
+ * @param iterator A #LinphoneCallLogIterator object @notnil
+ * @return The page size used by this iterator.
+ **/
+LINPHONE_PUBLIC int linphone_call_log_iterator_get_page_size(const LinphoneCallLogIterator *iterator);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+#endif // ifndef _L_C_CALL_LOG_ITERATOR_H_
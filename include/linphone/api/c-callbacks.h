@@ -828,6 +828,17 @@ typedef void (*LinphoneConferenceSchedulerCbsStateChangedCb)(LinphoneConferenceS
 typedef void (*LinphoneConferenceSchedulerCbsInvitationsSentCb)(LinphoneConferenceScheduler *conference_scheduler,
                                                                 const bctbx_list_t *failed_invitations);
 
+/**
+ * Callback for notifying the progress of the sending of conference invitations.
+ * Invitations are sent by chunks, this callback is called after each of them.
+ * @param conference_scheduler #LinphoneConferenceScheduler object sending the invitations. @notnil
+ * @param sent the number of invitations that have been sent so far.
+ * @param total the total number of invitations to send.
+ */
+typedef void (*LinphoneConferenceSchedulerCbsInvitationsProgressCb)(LinphoneConferenceScheduler *conference_scheduler,
+                                                                    int sent,
+                                                                    int total);
+
 /**
  * @}
  **/
@@ -325,6 +325,30 @@ LINPHONE_PUBLIC bctbx_list_t *linphone_chat_room_get_history_events(LinphoneChat
 LINPHONE_PUBLIC bctbx_list_t *
 linphone_chat_room_get_history_range_events(LinphoneChatRoom *chat_room, int begin, int end);
 
+/**
+ * Creates an iterator over the chat message events of a chat room, from the most recent to the oldest one.
+ * Events are fetched from the database one page at a time, which is the recommended way to walk through
+ * a large history instead of linphone_chat_room_get_history_range_message_events().
+ * @param chat_room The #LinphoneChatRoom object corresponding to the conversation for which events should be retrieved
+ * @notnil
+ * @param page_size The maximum number of events fetched from the database at once, 0 for the default.
+ * @return A new #LinphoneEventLogIterator. @notnil @tobefreed
+ */
+LINPHONE_PUBLIC LinphoneEventLogIterator *linphone_chat_room_create_history_iterator(LinphoneChatRoom *chat_room,
+                                                                                    int page_size);
+
+/**
+ * Creates an iterator over the events of a chat room, from the most recent to the oldest one.
+ * Events are fetched from the database one page at a time, which is the recommended way to walk through
+ * a large history instead of linphone_chat_room_get_history_range_events().
+ * @param chat_room The #LinphoneChatRoom object corresponding to the conversation for which events should be retrieved
+ * @notnil
+ * @param page_size The maximum number of events fetched from the database at once, 0 for the default.
+ * @return A new #LinphoneEventLogIterator. @notnil @tobefreed
+ */
+LINPHONE_PUBLIC LinphoneEventLogIterator *
+linphone_chat_room_create_history_events_iterator(LinphoneChatRoom *chat_room, int page_size);
+
 /**
  * Gets the number of events in a chat room.
  * @param chat_room The #LinphoneChatRoom object corresponding to the conversation for which size has to be computed
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_C_EVENT_LOG_ITERATOR_H_
+#define _L_C_EVENT_LOG_ITERATOR_H_
+
+#include "linphone/api/c-types.h"
+
+// =============================================================================
+
+#ifdef __cplusplus
+extern "C" {
+#endif // ifdef __cplusplus
+
+/**
+ * @addtogroup events
+ * @{
+ */
+
+/**
+ * Increment reference count of #LinphoneEventLogIterator object.
+ * @param iterator A #LinphoneEventLogIterator object @notnil
+ * @return the same #LinphoneEventLogIterator object @notnil
+ **/
+LINPHONE_PUBLIC LinphoneEventLogIterator *linphone_event_log_iterator_ref(LinphoneEventLogIterator *iterator);
+
+/**
+ * Decrement reference count of #LinphoneEventLogIterator object. When dropped to zero, memory is freed.
+ * @param iterator A #LinphoneEventLogIterator object @notnil
+ **/
+LINPHONE_PUBLIC void linphone_event_log_iterator_unref(LinphoneEventLogIterator *iterator);
+
+/**
+ * Tells whether there is at least one more event to walk through.
+ * The next page of events is fetched from the database if needed.
+ * @param iterator A #LinphoneEventLogIterator object @notnil
+ * @return TRUE if linphone_event_log_iterator_next() will return an event, FALSE otherwise.
+ **/
+LINPHONE_PUBLIC bool_t linphone_event_log_iterator_has_next(LinphoneEventLogIterator *iterator);
+
+/**
+ * Moves to the next event, from the most recent to the oldest one.
+ * The returned event is only kept referenced by the iterator until the next call.
+ * @param iterator A #LinphoneEventLogIterator object @notnil
+ * @return The next #LinphoneEventLog, or NULL if the end of the history has been reached. @maybenil
+ **/
+LINPHONE_PUBLIC LinphoneEventLog *linphone_event_log_iterator_next(LinphoneEventLogIterator *iterator);
+
+/**
+ * Returns the maximum number of events fetched from the database at once.
+ * @param iterator A #LinphoneEventLogIterator object @notnil
+ * @return The page size used by this iterator.
+ **/
+LINPHONE_PUBLIC int linphone_event_log_iterator_get_page_size(const LinphoneEventLogIterator *iterator);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+#endif // ifndef _L_C_EVENT_LOG_ITERATOR_H_
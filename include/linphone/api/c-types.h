@@ -325,6 +325,16 @@ typedef struct _LinphoneRecorderParams LinphoneRecorderParams;
  **/
 typedef struct _LinphoneCallLog LinphoneCallLog;
 
+/**
+ * @brief Forward-only iterator over the call history.
+ *
+ * Call logs are fetched from the database one page at a time, so that walking through a large history
+ * never keeps more than a page of #LinphoneCallLog in memory.
+ * Use linphone_core_create_call_history_iterator() to create one.
+ * @ingroup call_logs
+ **/
+typedef struct _LinphoneCallLogIterator LinphoneCallLogIterator;
+
 /**
  * @brief Object representing an RTP payload type.
  * @ingroup media_parameters
@@ -480,6 +490,17 @@ typedef struct _LinphoneEventCbs LinphoneEventCbs;
  */
 typedef struct _LinphoneEventLog LinphoneEventLog;
 
+/**
+ * @brief Forward-only iterator over the history of a #LinphoneChatRoom.
+ *
+ * Events are fetched from the database one page at a time, from the most recent to the oldest one,
+ * so that walking through a large history never keeps more than a page of #LinphoneEventLog in memory.
+ * Use linphone_chat_room_create_history_iterator() or linphone_chat_room_create_history_events_iterator()
+ * to create one.
+ * @ingroup events
+ */
+typedef struct _LinphoneEventLogIterator LinphoneEventLogIterator;
+
 // -----------------------------------------------------------------------------
 // LDAP.
 // -----------------------------------------------------------------------------
@@ -291,6 +291,17 @@ typedef void (*LinphoneCoreCbsAccountAddedCb)(LinphoneCore *core, LinphoneAccoun
  */
 typedef void (*LinphoneCoreCbsAccountRemovedCb)(LinphoneCore *core, LinphoneAccount *account);
 
+/**
+ * Unread chat message count changed callback prototype.
+ * It is called once per main loop iteration at most for each local address, muted chat rooms are not counted.
+ * @param core #LinphoneCore object @notnil
+ * @param local_address The local address of the chat rooms whose unread message count changed. @notnil
+ * @param count The number of unread messages in the chat rooms of this local address.
+ */
+typedef void (*LinphoneCoreCbsUnreadChatMessageCountChangedCb)(LinphoneCore *core,
+                                                               const LinphoneAddress *local_address,
+                                                               int count);
+
 /**
  * Chat messages callback prototype.
  * Only called when aggregation is enabled (aka [sip] chat_messages_aggregation == 1 or using
@@ -308,6 +308,7 @@ typedef struct _LinphoneCoreVTable {
 	LinphoneCoreCbsDefaultAccountChangedCb default_account_changed;
 	LinphoneCoreCbsAccountAddedCb account_added;
 	LinphoneCoreCbsAccountRemovedCb account_removed;
+	LinphoneCoreCbsUnreadChatMessageCountChangedCb unread_chat_message_count_changed;
 	void *user_data; /**<User data associated with the above callbacks */
 } LinphoneCoreVTable;
 
@@ -1340,6 +1341,23 @@ LINPHONE_PUBLIC void linphone_core_cbs_set_account_removed(LinphoneCoreCbs *cbs,
  */
 LINPHONE_PUBLIC LinphoneCoreCbsAccountRemovedCb linphone_core_cbs_get_account_removed(LinphoneCoreCbs *cbs);
 
+/**
+ * Sets the unread chat message count changed callback.
+ * @param cbs #LinphoneCoreCbs object. @notnil
+ * @param cb The new unread chat message count changed callback to be used.
+ */
+LINPHONE_PUBLIC void
+linphone_core_cbs_set_unread_chat_message_count_changed(LinphoneCoreCbs *cbs,
+                                                        LinphoneCoreCbsUnreadChatMessageCountChangedCb cb);
+
+/**
+ * Gets the unread chat message count changed callback.
+ * @param cbs #LinphoneCoreCbs object. @notnil
+ * @return The unread chat message count changed callback that will be triggered.
+ */
+LINPHONE_PUBLIC LinphoneCoreCbsUnreadChatMessageCountChangedCb
+linphone_core_cbs_get_unread_chat_message_count_changed(LinphoneCoreCbs *cbs);
+
 /**
  * Get the account registration state changed callback.
  * @param cbs #LinphoneCoreCbs object. @notnil
@@ -3636,6 +3654,17 @@ LINPHONE_PUBLIC void linphone_core_set_rtp_no_xmit_on_audio_mute(LinphoneCore *c
  **/
 LINPHONE_PUBLIC const bctbx_list_t *linphone_core_get_call_logs(LinphoneCore *core);
 
+/**
+ * Creates an iterator over the call logs (past calls), from the most recent call to the oldest one.
+ * Unlike linphone_core_get_call_logs(), call logs are fetched from the database one page at a time,
+ * which is the recommended way to walk through a large call history.
+ * @param core #LinphoneCore object @notnil
+ * @param page_size The maximum number of call logs fetched from the database at once, 0 for the default.
+ * @return A new #LinphoneCallLogIterator. @notnil @tobefreed
+ **/
+LINPHONE_PUBLIC LinphoneCallLogIterator *linphone_core_create_call_history_iterator(LinphoneCore *core,
+                                                                                   int page_size);
+
 /**
  * Get the list of call logs (past calls).
  * At the contrary of linphone_core_get_call_logs, it is your responsibility to unref the logs and free this list once
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "account-index.h"
+
+#include "account/account.h"
+#include "address/address.h"
+#include "linphone/core.h"
+#include "linphone/utils/utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+void AccountIndex::add(LinphoneAccount *account) {
+	// An invalid index is fully rebuilt on the next lookup anyway.
+	if (mValid) index(account);
+}
+
+const vector<LinphoneAccount *> &AccountIndex::findByIdentity(LinphoneCore *lc, const Address &identity) {
+	string key;
+	if (!getIdentityKey(identity, key)) return Utils::getEmptyConstRefObject<vector<LinphoneAccount *>>();
+
+	if (!mValid) rebuild(lc);
+	auto it = mByIdentity.find(key);
+	if (it == mByIdentity.end()) return Utils::getEmptyConstRefObject<vector<LinphoneAccount *>>();
+	return it->second;
+}
+
+const vector<LinphoneAccount *> &AccountIndex::findByDomain(LinphoneCore *lc, const string &domain) {
+	if (!mValid) rebuild(lc);
+	auto it = mByDomain.find(domain);
+	if (it == mByDomain.end()) return Utils::getEmptyConstRefObject<vector<LinphoneAccount *>>();
+	return it->second;
+}
+
+// -----------------------------------------------------------------------------
+
+bool AccountIndex::getIdentityKey(const Address &identity, string &key) {
+	// Addresses without SIP uri have no domain, they are never weakly equal to an account identity.
+	const char *domain = identity.getDomainCstr();
+	if (!domain) return false;
+
+	// A null username only matches a null username.
+	const char *username = identity.getUsernameCstr();
+	key = username ? string("u") + username : string("-");
+	key += '\n';
+	key += domain;
+	key += '\n';
+	key += Utils::toString(identity.getPort());
+	return true;
+}
+
+void AccountIndex::rebuild(LinphoneCore *lc) {
+	mByIdentity.clear();
+	mByDomain.clear();
+
+	for (const bctbx_list_t *elem = linphone_core_get_account_list(lc); elem != NULL; elem = elem->next)
+		index((LinphoneAccount *)elem->data);
+	mValid = true;
+}
+
+void AccountIndex::index(LinphoneAccount *account) {
+	const auto &params = Account::toCpp(account)->getAccountParams();
+	if (!params) return;
+	const auto &identity = params->getIdentityAddress();
+	if (!identity) return;
+
+	string key;
+	if (getIdentityKey(*identity, key)) mByIdentity[key].push_back(account);
+	const char *domain = identity->getDomainCstr();
+	if (domain) mByDomain[domain].push_back(account);
+}
+
+LINPHONE_END_NAMESPACE
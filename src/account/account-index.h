@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_ACCOUNT_INDEX_H_
+#define _L_ACCOUNT_INDEX_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "linphone/api/c-types.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class Address;
+
+/*
+ * Index of the accounts of a core by identity, as compared by Address::weakEqual() (username, domain and port),
+ * and by identity domain.
+ * It is invalidated whenever an account is added, removed or gets new params, and rebuilt on the next lookup.
+ * Lookups return the matching accounts in the order of the account list.
+ */
+class AccountIndex {
+public:
+	void invalidate() {
+		mValid = false;
+	}
+
+	// The account has been appended to the account list.
+	void add(LinphoneAccount *account);
+
+	const std::vector<LinphoneAccount *> &findByIdentity(LinphoneCore *lc, const Address &identity);
+	const std::vector<LinphoneAccount *> &findByDomain(LinphoneCore *lc, const std::string &domain);
+
+private:
+	static bool getIdentityKey(const Address &identity, std::string &key);
+	void index(LinphoneAccount *account);
+	void rebuild(LinphoneCore *lc);
+
+	bool mValid = false;
+	std::unordered_map<std::string, std::vector<LinphoneAccount *>> mByIdentity;
+	std::unordered_map<std::string, std::vector<LinphoneAccount *>> mByDomain;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_ACCOUNT_INDEX_H_
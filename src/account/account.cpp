@@ -37,6 +37,7 @@
 #include "db/main-db-p.h"
 #include "event/event-publish.h"
 #include "linphone/core.h"
+#include "presence/presence-model.h"
 #include "presence/presence-service.h"
 #include "private.h"
 #include "utils/custom-params.h"
@@ -183,6 +184,9 @@ LinphoneStatus Account::setAccountParams(std::shared_ptr<AccountParams> params)
 
 	// Replacing the old params by the updated one
 	mParams = params;
+	// The identity may have changed.
+	auto core = getCCore();
+	if (core) L_GET_PRIVATE_FROM_C_OBJECT(core)->accountIndex.invalidate();
 
 	// Some changes in AccountParams needs a special treatment in Account
 	applyParamsChanges();
@@ -1118,9 +1122,11 @@ int Account::sendPublish() {
 	if (mState == LinphoneRegistrationOk || mState == LinphoneRegistrationCleared) {
 		int publishExpires = mParams->getPublishExpires();
 
+		bool publicationAlive = false;
 		if (mPresencePublishEvent != nullptr) {
 			LinphonePublishState state = mPresencePublishEvent->getState();
-			if (state != LinphonePublishOk && state != LinphonePublishOutgoingProgress) {
+			publicationAlive = (state == LinphonePublishOk || state == LinphonePublishOutgoingProgress);
+			if (!publicationAlive) {
 				lInfo() << "Presence publish state is [" << linphone_publish_state_to_string(state)
 				        << "], destroying it and creating a new one instead";
 				mPresencePublishEvent->unref();
@@ -1142,8 +1148,9 @@ int Account::sendPublish() {
 		mPresencePublishEvent->setUserData(identityAddress->toC());
 
 		LinphoneConfig *config = linphone_core_get_config(getCCore());
-		if (linphone_config_get_bool(config, "sip", "update_presence_model_timestamp_before_publish_expires_refresh",
-		                             FALSE)) {
+		bool refreshTimestamps = !!linphone_config_get_bool(
+		    config, "sip", "update_presence_model_timestamp_before_publish_expires_refresh", FALSE);
+		if (refreshTimestamps) {
 			unsigned int nbServices = linphone_presence_model_get_nb_services(mPresenceModel);
 			if (nbServices > 0) {
 				LinphonePresenceService *latest_service =
@@ -1172,25 +1179,36 @@ int Account::sendPublish() {
 			linphone_presence_model_set_contact(mPresenceModel, NULL); /*it will be automatically computed*/
 		}
 
-		char *presence_body;
-		if (!(presence_body = linphone_presence_model_to_xml(mPresenceModel))) {
-			lError() << "Cannot publish presence model [" << mPresenceModel << "] for account [" << this->toC()
-			         << "] because of xml serialization error";
-			return -1;
-		}
-
-		if (!mSipEtag.empty()) {
-			mPresencePublishEvent->addCustomHeader("SIP-If-Match", mSipEtag);
-			mSipEtag = "";
-		}
+		// With publish_presence_only_when_changed, nothing is sent while the current publication already carries the
+		// content of the model, timestamps apart: it is refreshed when it expires. Otherwise, and whenever something is
+		// sent, the document is built again so that it carries the current timestamps.
+		uint64_t contentHash = PresenceModel::toCpp(mPresenceModel)->getContentHash();
+		if (publicationAlive && !refreshTimestamps && mPresenceHashPublished && contentHash == mPublishedPresenceHash &&
+		    linphone_config_get_bool(config, "sip", "publish_presence_only_when_changed", FALSE)) {
+			lInfo() << "Presence model [" << mPresenceModel << "] of account [" << this->toC()
+			        << "] is unchanged, not publishing it again";
+		} else {
+			std::string presenceBody = PresenceModel::toCpp(mPresenceModel)->toXml();
+			if (presenceBody.empty()) {
+				lError() << "Cannot publish presence model [" << mPresenceModel << "] for account [" << this->toC()
+				         << "] because of xml serialization error";
+				err = -1;
+			} else {
+				if (!mSipEtag.empty()) {
+					mPresencePublishEvent->addCustomHeader("SIP-If-Match", mSipEtag);
+					mSipEtag = "";
+				}
 
-		auto content = Content::create(nullptr, true);
-		content->setBody((const uint8_t *)presence_body, strlen(presence_body));
-		ContentType contentType("application", "pidf+xml");
-		content->setContentType(contentType);
+				auto content = Content::create(nullptr, true);
+				content->setBody((const uint8_t *)presenceBody.data(), presenceBody.size());
+				ContentType contentType("application", "pidf+xml");
+				content->setContentType(contentType);
 
-		err = mPresencePublishEvent->send(content);
-		ms_free(presence_body);
+				err = mPresencePublishEvent->send(content);
+				mPublishedPresenceHash = contentHash;
+				mPresenceHashPublished = (err == 0);
+			}
+		}
 
 		if (presentityAddress) {
 			lInfo() << "Restoring previous presentity address " << *presentityAddress << " for model ["
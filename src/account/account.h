@@ -201,6 +201,9 @@ private:
 
 	std::shared_ptr<EventPublish> mPresencePublishEvent = nullptr;
 	LinphonePresenceModel *mPresenceModel = nullptr;
+	// Content hash of the presence model of the last publication sent.
+	uint64_t mPublishedPresenceHash = 0;
+	bool mPresenceHashPublished = false;
 
 	std::shared_ptr<Account> mDependency = nullptr;
 
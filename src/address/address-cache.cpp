@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "address-cache.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+AddressCache::AddressCache(size_t capacity) : mCapacity(capacity) {
+}
+
+AddressCache::~AddressCache() {
+	clear();
+}
+
+AddressCache &AddressCache::get() {
+	static thread_local AddressCache cache;
+	return cache;
+}
+
+const SalAddress *AddressCache::find(const string &address) {
+	auto it = mIndex.find(address);
+	if (it == mIndex.end()) {
+		mMisses++;
+		return nullptr;
+	}
+
+	mHits++;
+	if (it->second != mEntries.begin()) mEntries.splice(mEntries.begin(), mEntries, it->second);
+	return it->second->second;
+}
+
+void AddressCache::insert(const string &address, SalAddress *parsedAddress) {
+	auto it = mIndex.find(address);
+	if (it != mIndex.end()) {
+		sal_address_unref(it->second->second);
+		it->second->second = parsedAddress;
+		mEntries.splice(mEntries.begin(), mEntries, it->second);
+		return;
+	}
+
+	if (mCapacity == 0) {
+		sal_address_unref(parsedAddress);
+		return;
+	}
+
+	mEntries.emplace_front(address, parsedAddress);
+	mIndex.emplace(mEntries.front().first, mEntries.begin());
+	evict();
+}
+
+void AddressCache::clear() {
+	mIndex.clear();
+	for (auto &entry : mEntries)
+		sal_address_unref(entry.second);
+	mEntries.clear();
+}
+
+void AddressCache::setCapacity(size_t capacity) {
+	mCapacity = capacity;
+	evict();
+}
+
+// -----------------------------------------------------------------------------
+
+void AddressCache::evict() {
+	while (mEntries.size() > mCapacity) {
+		mIndex.erase(mEntries.back().first);
+		sal_address_unref(mEntries.back().second);
+		mEntries.pop_back();
+	}
+}
+
+LINPHONE_END_NAMESPACE
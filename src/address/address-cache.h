@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_ADDRESS_CACHE_H_
+#define _L_ADDRESS_CACHE_H_
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "c-wrapper/internal/c-sal.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Bounded cache of parsed addresses, keyed by the string they were parsed from.
+ * The cached SalAddress are never modified: callers clone them, which is much cheaper than parsing again.
+ * Entries are evicted in least recently used order.
+ * belle-sip objects are not thread safe, so each thread owns its own cache, returned by get().
+ */
+class AddressCache {
+public:
+	static constexpr size_t DefaultCapacity = 4096;
+
+	explicit AddressCache(size_t capacity = DefaultCapacity);
+	~AddressCache();
+
+	AddressCache(const AddressCache &) = delete;
+	AddressCache &operator=(const AddressCache &) = delete;
+
+	// The cache of the calling thread.
+	static AddressCache &get();
+
+	// Returns the cached address, still owned by the cache, or nullptr.
+	const SalAddress *find(const std::string &address);
+	// Takes ownership of the parsed address.
+	void insert(const std::string &address, SalAddress *parsedAddress);
+	void clear();
+
+	size_t size() const {
+		return mEntries.size();
+	}
+
+	size_t getCapacity() const {
+		return mCapacity;
+	}
+
+	void setCapacity(size_t capacity);
+
+	unsigned long long getHits() const {
+		return mHits;
+	}
+
+	unsigned long long getMisses() const {
+		return mMisses;
+	}
+
+private:
+	using Entry = std::pair<std::string, SalAddress *>;
+
+	void evict();
+
+	size_t mCapacity;
+	unsigned long long mHits = 0;
+	unsigned long long mMisses = 0;
+	// Most recently used first.
+	std::list<Entry> mEntries;
+	// Keys are views on the strings stored in the entries.
+	std::unordered_map<std::string_view, std::list<Entry>::iterator> mIndex;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_ADDRESS_CACHE_H_
@@ -18,6 +18,9 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
+#include <vector>
+
 #include "linphone/utils/utils.h"
 
 #include "logger/logger.h"
@@ -79,4 +82,132 @@ SalAddress *AddressParser::parseAddress(const string &input) {
 	return identityAddress;
 }
 
+// -----------------------------------------------------------------------------
+
+static bool isUserChar(char c) {
+	return isalnum((unsigned char)c) || (c != '\0' && strchr("-_.!~*'()&=+$,", c));
+}
+
+static bool isParamChar(char c) {
+	return isalnum((unsigned char)c) || (c != '\0' && strchr("-_.!~*'[]/:&+$", c));
+}
+
+static bool isIpv4Address(const string &host) {
+	int parts = 0;
+	size_t start = 0;
+	while (start <= host.size()) {
+		size_t end = host.find('.', start);
+		if (end == string::npos) end = host.size();
+		size_t length = end - start;
+		if (length == 0 || length > 3) return false;
+		int value = 0;
+		for (size_t i = start; i < end; i++) {
+			if (!isdigit((unsigned char)host[i])) return false;
+			value = value * 10 + (host[i] - '0');
+		}
+		if (value > 255) return false;
+		parts++;
+		start = end + 1;
+	}
+	return parts == 4;
+}
+
+static bool isHostname(const string &host) {
+	size_t start = 0;
+	while (true) {
+		size_t end = host.find('.', start);
+		bool last = end == string::npos;
+		if (last) end = host.size();
+		// Labels are alphanumerical with inner hyphens, the top label starts with a letter.
+		if (end == start || host[start] == '-' || host[end - 1] == '-') return false;
+		for (size_t i = start; i < end; i++) {
+			if (!isalnum((unsigned char)host[i]) && host[i] != '-') return false;
+		}
+		if (last) return isalpha((unsigned char)host[start]);
+		start = end + 1;
+	}
+}
+
+SalAddress *AddressParser::parseSipUri(const string &input) {
+	size_t pos;
+	bool secure;
+	if (input.compare(0, 4, "sip:") == 0) {
+		pos = 4;
+		secure = false;
+	} else if (input.compare(0, 5, "sips:") == 0) {
+		pos = 5;
+		secure = true;
+	} else return nullptr;
+
+	size_t paramsPos = input.find(';', pos);
+	if (paramsPos == string::npos) paramsPos = input.size();
+
+	string user;
+	size_t atPos = input.find('@', pos);
+	if (atPos != string::npos && atPos < paramsPos) {
+		if (atPos == pos) return nullptr;
+		for (size_t i = pos; i < atPos; i++) {
+			if (!isUserChar(input[i])) return nullptr;
+		}
+		user = input.substr(pos, atPos - pos);
+		pos = atPos + 1;
+	}
+
+	int port = 0;
+	size_t hostEnd = paramsPos;
+	size_t colonPos = input.find(':', pos);
+	if (colonPos != string::npos && colonPos < paramsPos) {
+		size_t length = paramsPos - colonPos - 1;
+		if (length == 0 || length > 5) return nullptr;
+		for (size_t i = colonPos + 1; i < paramsPos; i++) {
+			if (!isdigit((unsigned char)input[i])) return nullptr;
+			port = port * 10 + (input[i] - '0');
+		}
+		if (port == 0 || port > 65535) return nullptr;
+		hostEnd = colonPos;
+	}
+
+	string host = input.substr(pos, hostEnd - pos);
+	if (host.empty() || (!isIpv4Address(host) && !isHostname(host))) return nullptr;
+
+	// Parameters are parsed before building the address so that nothing is allocated for rejected inputs.
+	struct Param {
+		string name;
+		string value;
+		bool hasValue;
+	};
+	vector<Param> params;
+	pos = paramsPos;
+	while (pos < input.size()) {
+		size_t start = pos + 1;
+		size_t end = input.find(';', start);
+		if (end == string::npos) end = input.size();
+		size_t equalPos = input.find('=', start);
+		size_t nameEnd = (equalPos != string::npos && equalPos < end) ? equalPos : end;
+		if (nameEnd == start || nameEnd + 1 == end) return nullptr;
+		for (size_t i = start; i < end; i++) {
+			if (i != equalPos && !isParamChar(input[i])) return nullptr;
+		}
+		string name = Utils::stringToLower(input.substr(start, nameEnd - start));
+		// Leave duplicated parameters and the ones belle-sip normalizes to the full parser.
+		if (name == "ttl" || name == "maddr") return nullptr;
+		for (const auto &param : params) {
+			if (Utils::stringToLower(param.name) == name) return nullptr;
+		}
+		params.push_back({input.substr(start, nameEnd - start),
+		                  nameEnd < end ? input.substr(nameEnd + 1, end - nameEnd - 1) : string(), nameEnd < end});
+		pos = end;
+	}
+
+	SalAddress *address = sal_address_new_empty();
+	if (secure) sal_address_set_secure(address, TRUE);
+	if (!user.empty()) sal_address_set_username(address, user.c_str());
+	sal_address_set_domain(address, host.c_str());
+	if (port) sal_address_set_port(address, port);
+	// Flag parameters like "lr" have no value.
+	for (const auto &param : params)
+		sal_address_set_uri_param(address, param.name.c_str(), param.hasValue ? param.value.c_str() : nullptr);
+	return address;
+}
+
 LINPHONE_END_NAMESPACE
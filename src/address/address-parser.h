@@ -41,6 +41,13 @@ public:
 	SalAddress *parseAddress(const std::string &input);
 	static AddressParser &get();
 
+	/*
+	 * Hand-written parser for the common "sip:user@domain:port;param=value" forms, without display name, password,
+	 * headers nor escaped characters. Returns nullptr when the input is not in one of these forms, the caller must
+	 * then use the full parser.
+	 */
+	static SalAddress *parseSipUri(const std::string &input);
+
 private:
 	AddressParser();
 	std::shared_ptr<belr::Parser<void *>> mParser;
@@ -20,6 +20,7 @@
 
 #include <bctoolbox/defs.h>
 
+#include "address-cache.h"
 #include "address-parser.h"
 #include "belle-sip/sip-uri.h"
 
@@ -33,25 +34,26 @@ using namespace std;
 
 LINPHONE_BEGIN_NAMESPACE
 
-std::unordered_map<std::string, std::unique_ptr<SalAddress, Address::SalAddressDeleter>> Address::sAddressCache;
-
 SalAddress *Address::getSalAddressFromCache(const string &address, bool assumeGrUri) {
-	auto &ptr = sAddressCache[address];
-	if (ptr) return sal_address_clone(ptr.get());
+	AddressCache &cache = AddressCache::get();
+	const SalAddress *cachedAddress = cache.find(address);
+	if (cachedAddress) return sal_address_clone(cachedAddress);
 
 	// lInfo() << "Creating SalAddress for " << address;
-	/* To optimize, use the fast uri parser from AddressParser when we can assume that it is a simple URI with
+	/* Most addresses are plain sip:user@domain;param URIs, try the hand-written parser first.
+	 * Then, to optimize, use the fast uri parser from AddressParser when we can assume that it is a simple URI with
 	 * gr param.
 	 */
-	SalAddress *parsedAddress = nullptr;
-	if (assumeGrUri) {
+	SalAddress *parsedAddress = AddressParser::parseSipUri(address);
+	if (!parsedAddress && assumeGrUri) {
 		parsedAddress = AddressParser::get().parseAddress(address);
 	}
 	if (!parsedAddress) parsedAddress = sal_address_new(L_STRING_TO_C(address));
 	if (parsedAddress) {
 		removeFromLeakDetector(parsedAddress);
-		ptr = (unique_ptr<SalAddress, SalAddressDeleter>(parsedAddress, SalAddressDeleter()));
-		return sal_address_clone(parsedAddress);
+		SalAddress *result = sal_address_clone(parsedAddress);
+		cache.insert(address, parsedAddress);
+		return result;
 	}
 	return nullptr;
 }
@@ -150,7 +152,7 @@ void Address::setImpl(SalAddress *addr) {
 }
 
 void Address::clearSipAddressesCache() {
-	sAddressCache.clear();
+	AddressCache::get().clear();
 }
 
 bool Address::isValid() const {
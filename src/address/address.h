@@ -146,6 +146,7 @@ public:
 	}
 	void setImpl(SalAddress *value);
 	void setImpl(const SalAddress *value);
+	// Clears the parsed addresses cache of the calling thread.
 	static void clearSipAddressesCache();
 
 protected:
@@ -153,14 +154,7 @@ protected:
 
 private:
 	SalAddress *mImpl = nullptr;
-	struct SalAddressDeleter {
-		void operator()(SalAddress *addr) {
-			sal_address_unref(addr);
-		}
-	};
 	static void removeFromLeakDetector(SalAddress *addr);
-
-	static std::unordered_map<std::string, std::unique_ptr<SalAddress, SalAddressDeleter>> sAddressCache;
 };
 
 inline std::ostream &operator<<(std::ostream &os, const Address &address) {
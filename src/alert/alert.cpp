@@ -21,6 +21,7 @@
 #include "alert.h"
 
 #include "conference/session/media-session-p.h"
+#include "core/core-p.h"
 #include "signal-information/signal-information.h"
 
 // =============================================================================
@@ -109,8 +110,46 @@ bool AlertTimer::isTimeout(bool autoreset) {
 	return false;
 }
 
-AlertMonitor::AlertMonitor(MediaSession &mediaSession) : mMediaSession(mediaSession) {
-	mAlertsEnabled = linphone_core_alerts_enabled(mMediaSession.getCore()->getCCore());
+AlertSettings::AlertSettings(LinphoneCore *core) {
+	LinphoneConfig *config = linphone_core_get_config(core);
+	enabled = !!linphone_core_alerts_enabled(core);
+
+	struct Interval {
+		LinphoneAlertType type;
+		const char *section;
+		const char *key;
+		int defaultDelay;
+	};
+	static const Interval defaultIntervals[] = {
+	    {LinphoneAlertQoSLowQualitySentVideo, "alerts::camera", "quality_sent_interval", 1000},
+	    {LinphoneAlertQoSCameraMisfunction, "alerts::camera", "camera_misfunction_interval", 1000},
+	    {LinphoneAlertQoSCameraLowFramerate, "alerts::camera", "low_framerate_interval", 1000},
+	    {LinphoneAlertQoSVideoStalled, "alerts::camera", "video_stalled_interval", 1000},
+	    {LinphoneAlertQoSLowQualityReceivedVideo, "alerts::video", "low_quality_received_interval", 1000},
+	    {LinphoneAlertQoSLowDownloadBandwidthEstimation, "alerts::video", "download_bandwidth_interval", 1000},
+	    {LinphoneAlertQoSHighLossLateRate, "alerts::network", "loss_rate_interval", 5000},
+	    {LinphoneAlertQoSHighRemoteLossRate, "alerts::network", "remote_loss_rate_interval", 5000},
+	    {LinphoneAlertQoSLostSignal, "alerts::network", "lost_signal_interval", 1000},
+	    {LinphoneAlertQoSBurstOccured, "alerts::network", "burst_occured_interval", 1000},
+	    {LinphoneAlertQoSRetransmissionFailures, "alerts::network", "nack_check_interval", 2000},
+	    {LinphoneAlertQoSLowSignal, "alerts::network", "low_signal_interval", 1000}};
+	intervals.fill(0);
+	for (const auto &interval : defaultIntervals)
+		intervals[interval.type] =
+		    (uint64_t)linphone_config_get_int(config, interval.section, interval.key, interval.defaultDelay);
+
+	fpsThreshold = linphone_config_get_float(config, "alerts::camera", "fps_threshold", 10.0);
+	bandwidthThreshold = linphone_config_get_float(config, "alerts::video", "bandwidth_threshold", 150000.0);
+	lossRateThreshold = linphone_config_get_float(config, "alerts::network", "loss_rate_threshold", 5.0);
+	nackPerformanceThreshold = linphone_config_get_float(config, "alerts::network", "nack_threshold", 0.5f);
+	signalThreshold = linphone_config_get_float(config, "alerts::network", "signal_threshold", -70.0f);
+}
+
+AlertMonitor::AlertMonitor(MediaSession &mediaSession)
+    : mMediaSession(mediaSession), mSettings(mediaSession.getPrivate()->getAlertSettings()) {
+	for (size_t type = 0; type < AlertSettings::TypeCount; ++type)
+		mTimers[type] = AlertTimer(mSettings->intervals[type]);
+	mAlertsEnabled = mSettings->enabled;
 }
 
 void AlertMonitor::notify(const std::shared_ptr<Dictionary> &properties, LinphoneAlertType type) {
@@ -124,37 +163,15 @@ void AlertMonitor::notify(const std::shared_ptr<Dictionary> &properties, Linphon
 
 	linphone_core_notify_alert(mMediaSession.getCore()->getCCore(), alert->toC());
 
-	lWarning() << *alert;
-}
+	mMediaSession.getCore()->getPrivate()->countAlert(type);
 
-void AlertMonitor::handleAlert(LinphoneAlertType type,
-                               bool triggerCondition,
-                               const std::function<std::shared_ptr<Dictionary>()> &getInformationFunction) {
-	if (!mTimers[type].isTimeout()) return;
-	if (!alreadyRunning(type) && triggerCondition) {
-		notify(getInformationFunction ? getInformationFunction() : nullptr, type);
-		reset();
-		return;
-	}
-	if (alreadyRunning(type) && !triggerCondition) {
-		auto alert = mRunningAlerts[type];
-		alert->setState(false);
-		linphone_alert_notify_on_terminated(alert->toC());
-		mRunningAlerts.erase(type);
-		return;
-	}
-}
-
-void AlertMonitor::getTimer(LinphoneAlertType type, const string &section, const string &key, int defaultDelay) {
-	LinphoneConfig *config = linphone_core_get_config(mMediaSession.getCore()->getCCore());
-	string completeSection = "alerts"s + "::" + section;
-	int delay = linphone_config_get_int(config, completeSection.c_str(), key.c_str(), defaultDelay);
-	mTimers[type] = AlertTimer((uint64_t)delay);
+	lWarning() << *alert;
 }
 
-bool AlertMonitor::alreadyRunning(LinphoneAlertType type) {
-	auto it = mRunningAlerts.find(type);
-	return (it != mRunningAlerts.end());
+void AlertMonitor::terminate(LinphoneAlertType type) {
+	auto alert = std::move(mRunningAlerts[type]);
+	alert->setState(false);
+	linphone_alert_notify_on_terminated(alert->toC());
 }
 
 bool AlertMonitor::getAlertsEnabled() {
@@ -163,12 +180,6 @@ bool AlertMonitor::getAlertsEnabled() {
 
 VideoQualityAlertMonitor::VideoQualityAlertMonitor(MediaSession &mediaSession)
     : AlertMonitor(mediaSession), mStalled(false) {
-	getTimer(LinphoneAlertQoSLowQualitySentVideo, "camera"s, "quality_sent_interval"s, 1000);
-	getTimer(LinphoneAlertQoSCameraMisfunction, "camera"s, "camera_misfunction_interval"s, 1000);
-	getTimer(LinphoneAlertQoSCameraLowFramerate, "camera"s, "low_framerate_interval"s, 1000);
-	getTimer(LinphoneAlertQoSVideoStalled, "camera"s, "video_stalled_interval"s, 1000);
-	auto config = linphone_core_get_config(mMediaSession.getCore()->getCCore());
-	mFpsThreshold = linphone_config_get_float(config, "alerts::camera", "fps_threshold", 10.0);
 }
 
 void VideoQualityAlertMonitor::check(const VideoControlInterface::VideoStats *sendStats,
@@ -184,7 +195,7 @@ void VideoQualityAlertMonitor::check(const VideoControlInterface::VideoStats *se
 }
 
 float VideoQualityAlertMonitor::getFpsThreshold() {
-	return mFpsThreshold;
+	return mSettings->fpsThreshold;
 }
 
 void VideoQualityAlertMonitor::videoStalledCheck(float fps) {
@@ -222,10 +233,6 @@ VideoQualityAlertMonitor::~VideoQualityAlertMonitor() {
 }
 
 VideoBandwidthAlertMonitor::VideoBandwidthAlertMonitor(MediaSession &mediaSession) : AlertMonitor(mediaSession) {
-	auto config = linphone_core_get_config(mMediaSession.getCore()->getCCore());
-	mThreshold = linphone_config_get_float(config, "alerts::video", "bandwidth_threshold", 150000.0);
-	getTimer(LinphoneAlertQoSLowQualityReceivedVideo, "video"s, "low_quality_received_interval"s, 1000);
-	getTimer(LinphoneAlertQoSLowDownloadBandwidthEstimation, "video"s, "download_bandwidth_interval"s, 1000);
 }
 
 void VideoBandwidthAlertMonitor::check(LinphoneCallStats *callStats) {
@@ -240,7 +247,7 @@ void VideoBandwidthAlertMonitor::check(LinphoneCallStats *callStats) {
 }
 
 float VideoBandwidthAlertMonitor::getBandwidthThreshold() {
-	return mThreshold;
+	return mSettings->bandwidthThreshold;
 }
 
 void VideoBandwidthAlertMonitor::checkVideoBandwidth(float bandwidth) {
@@ -264,20 +271,10 @@ void VideoBandwidthAlertMonitor::checkBandwidthEstimation(float bandwidth) {
 }
 
 NetworkQualityAlertMonitor::NetworkQualityAlertMonitor(MediaSession &mediaSession) : AlertMonitor(mediaSession) {
-	getTimer(LinphoneAlertQoSHighLossLateRate, "network"s, "loss_rate_interval"s, 5000);
-	getTimer(LinphoneAlertQoSHighRemoteLossRate, "network"s, "remote_loss_rate_interval"s, 5000);
-	getTimer(LinphoneAlertQoSLostSignal, "network"s, "lost_signal_interval"s, 1000);
-	getTimer(LinphoneAlertQoSBurstOccured, "network"s, "burst_occured_interval"s, 1000);
-	getTimer(LinphoneAlertQoSRetransmissionFailures, "network"s, "nack_check_interval"s, 2000);
-	getTimer(LinphoneAlertQoSLowSignal, "network"s, "low_signal_interval"s, 1000);
-	auto config = linphone_core_get_config(mMediaSession.getCore()->getCCore());
-	mLossRateThreshold = linphone_config_get_float(config, "alerts::network", "loss_rate_threshold", 5.0);
-	mNackPerformanceThreshold = linphone_config_get_float(config, "alerts::network", "nack_threshold", 0.5f);
-	mSignalThreshold = linphone_config_get_float(config, "alerts::network", "signal_threshold", -70.0f);
 }
 
 float NetworkQualityAlertMonitor::getLossRateThreshold() {
-	return mLossRateThreshold;
+	return mSettings->lossRateThreshold;
 }
 
 void NetworkQualityAlertMonitor::check(LinphoneCallStats *callStats, bool burstOccured) {
@@ -350,7 +347,8 @@ void NetworkQualityAlertMonitor::checkNackQuality(RtpSession *session) {
 		mNackIndicator = computeNackIndicator(currentNackLoss - mLastNackLoss, currentTotalLoss - mLastTotalLoss);
 		mLastNackLoss = currentNackLoss;
 		mLastTotalLoss = currentTotalLoss;
-		handleAlert(LinphoneAlertQoSRetransmissionFailures, mNackIndicator <= mNackPerformanceThreshold, [this]() {
+		bool condition = (mNackIndicator <= mSettings->nackPerformanceThreshold);
+		handleAlert(LinphoneAlertQoSRetransmissionFailures, condition, [this]() {
 			auto properties = (new Dictionary())->toSharedPtr();
 			properties->setProperty("nack-performance", mNackIndicator);
 			return properties;
@@ -365,9 +363,9 @@ void NetworkQualityAlertMonitor::checkSignalQuality() {
 	auto information = mMediaSession.getCore()->getSignalInformation();
 	if (information) {
 		value = information->getStrength();
-		condition = (value <= mSignalThreshold);
+		condition = (value <= mSettings->signalThreshold);
 	}
-	handleAlert(LinphoneAlertQoSLowSignal, condition, [value, information]() {
+	handleAlert(LinphoneAlertQoSLowSignal, condition, [value, &information]() {
 		auto properties = (new Dictionary())->toSharedPtr();
 		properties->setProperty("rssi-value", value);
 		properties->setProperty("network-type", SignalInformation::signalTypeToString(information->getSignalType()));
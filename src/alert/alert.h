@@ -20,8 +20,8 @@
 #ifndef ALERT_H
 #define ALERT_H
 
+#include <array>
 #include <memory>
-#include <unordered_map>
 
 #include <belle-sip/object++.hh>
 
@@ -73,8 +73,27 @@ public:
 	bool isTimeout(bool autoreset = true);
 
 private:
-	uint64_t mDelay;
-	uint64_t mLastCheck;
+	uint64_t mDelay = 0;
+	uint64_t mLastCheck = 0;
+};
+
+/*
+ * Thresholds and check intervals of the alerts, read from the "alerts::*" sections of the configuration.
+ * They are resolved once per call, and shared by the monitors of all its streams.
+ */
+struct AlertSettings {
+	static constexpr size_t TypeCount = LinphoneAlertQoSLostSignal + 1;
+
+	explicit AlertSettings(LinphoneCore *core);
+
+	bool enabled;
+	// Check intervals in milliseconds, by alert type.
+	std::array<uint64_t, TypeCount> intervals;
+	float fpsThreshold;
+	float bandwidthThreshold;
+	float lossRateThreshold;
+	float nackPerformanceThreshold;
+	float signalThreshold;
 };
 
 class AlertMonitor {
@@ -82,18 +101,33 @@ public:
 	explicit AlertMonitor(MediaSession &mediaSession);
 	virtual ~AlertMonitor() = default;
 	void notify(const std::shared_ptr<Dictionary> &properties, LinphoneAlertType);
-	bool alreadyRunning(LinphoneAlertType type);
-	void handleAlert(LinphoneAlertType type,
-	                 bool triggerCondition,
-	                 const std::function<std::shared_ptr<Dictionary>()> &getInformationFunction = nullptr);
-	void getTimer(LinphoneAlertType type, const std::string &section, const std::string &key, int delay);
+	bool alreadyRunning(LinphoneAlertType type) const {
+		return mRunningAlerts[type] != nullptr;
+	}
+	// The informations of the alert are only built when it is raised, so that the checks do not allocate anything.
+	template <typename InformationFunction>
+	void handleAlert(LinphoneAlertType type, bool triggerCondition, const InformationFunction &getInformationFunction) {
+		if (!mTimers[type].isTimeout()) return;
+		if (!alreadyRunning(type) && triggerCondition) {
+			notify(getInformationFunction(), type);
+			reset();
+		} else if (alreadyRunning(type) && !triggerCondition) {
+			terminate(type);
+		}
+	}
+	void handleAlert(LinphoneAlertType type, bool triggerCondition) {
+		handleAlert(type, triggerCondition, []() { return std::shared_ptr<Dictionary>(); });
+	}
 	virtual void reset(){};
 	bool getAlertsEnabled();
 
 protected:
+	void terminate(LinphoneAlertType type);
+
 	MediaSession &mMediaSession;
-	std::unordered_map<LinphoneAlertType, AlertTimer> mTimers;
-	std::unordered_map<LinphoneAlertType, std::shared_ptr<Alert>> mRunningAlerts;
+	std::shared_ptr<const AlertSettings> mSettings;
+	std::array<AlertTimer, AlertSettings::TypeCount> mTimers;
+	std::array<std::shared_ptr<Alert>, AlertSettings::TypeCount> mRunningAlerts;
 	bool mAlertsEnabled;
 };
 
@@ -109,7 +143,6 @@ public:
 	~VideoQualityAlertMonitor();
 
 private:
-	float mFpsThreshold;
 	bool mStalled;
 };
 class VideoBandwidthAlertMonitor : public AlertMonitor {
@@ -120,9 +153,6 @@ public:
 	void check(LinphoneCallStats *callStats);
 	void checkVideoBandwidth(float bandwidth);
 	void checkBandwidthEstimation(float bandwidth);
-
-private:
-	float mThreshold;
 };
 
 class NetworkQualityAlertMonitor : public AlertMonitor {
@@ -148,9 +178,6 @@ private:
 	uint64_t mLastTotalLoss = 0;
 	int mBurstCount = 0;
 	float mNackIndicator = 0.0f;
-	float mLossRateThreshold = 0.0f;
-	float mNackPerformanceThreshold = 0.0f;
-	float mSignalThreshold = 0.0f;
 	bool mFirstMeasureNonZero = false;
 	bool mNackSent = false;
 };
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "auth-info-index.h"
+#include "auth-info.h"
+
+#include "linphone/api/c-auth-info.h"
+#include "linphone/utils/utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+void AuthInfoIndex::add(LinphoneAuthInfo *info) {
+	if (mKeys.find(info) != mKeys.end()) return;
+
+	if (mPositionsValid) mPositions[info] = (int)mAll.size();
+	insert(info, computeKeys(info, mNextRank++));
+	AuthInfo::toCpp(info)->mIndex = this;
+}
+
+void AuthInfoIndex::remove(LinphoneAuthInfo *info) {
+	auto it = mKeys.find(info);
+	if (it == mKeys.end()) return;
+
+	AuthInfo::toCpp(info)->mIndex = nullptr;
+	mAll.erase(it->second.rank);
+	eraseKeys(it->second);
+	mKeys.erase(it);
+
+	mPositions.clear();
+	mPositionsValid = false;
+}
+
+void AuthInfoIndex::update(LinphoneAuthInfo *info) {
+	auto it = mKeys.find(info);
+	if (it == mKeys.end()) return;
+
+	// Keep the rank, the auth info stays at the same place in the list.
+	unsigned long long rank = it->second.rank;
+	Keys keys = computeKeys(info, rank);
+	if (keys == it->second) return;
+
+	eraseKeys(it->second);
+	mKeys.erase(it);
+	insert(info, std::move(keys));
+}
+
+AuthInfoIndex::~AuthInfoIndex() {
+	clear();
+}
+
+void AuthInfoIndex::clear() {
+	for (const auto &entry : mAll)
+		AuthInfo::toCpp(entry.second)->mIndex = nullptr;
+	mAll.clear();
+	mKeys.clear();
+	mByUsername.clear();
+	mByUsernameAndRealm.clear();
+	mByUsernameAndDomain.clear();
+	mPositions.clear();
+	mPositionsValid = true;
+}
+
+const AuthInfoIndex::Bucket &AuthInfoIndex::findByUsername(const char *username) const {
+	return find(mByUsername, L_C_TO_STRING(username));
+}
+
+const AuthInfoIndex::Bucket &AuthInfoIndex::findByUsernameAndRealm(const char *username, const char *realm) const {
+	return find(mByUsernameAndRealm, string(L_C_TO_STRING(username)) + '\n' + normalizeRealm(realm));
+}
+
+const AuthInfoIndex::Bucket &AuthInfoIndex::findByUsernameAndDomain(const char *username, const char *domain) const {
+	return find(mByUsernameAndDomain, string(L_C_TO_STRING(username)) + '\n' + L_C_TO_STRING(domain));
+}
+
+int AuthInfoIndex::getPosition(const LinphoneAuthInfo *info) const {
+	if (!mPositionsValid) {
+		int position = 0;
+		for (const auto &entry : mAll)
+			mPositions[entry.second] = position++;
+		mPositionsValid = true;
+	}
+
+	auto it = mPositions.find(info);
+	return it == mPositions.end() ? -1 : it->second;
+}
+
+string AuthInfoIndex::normalizeRealm(const char *realm) {
+	// Same as realm_match(): the realm is truncated to 127 characters, then the quotes are removed.
+	string result = string(realm).substr(0, 127);
+	if (!result.empty() && result[0] == '"') result.erase(0, 1);
+	size_t quotePos = result.find('"');
+	if (quotePos != string::npos) result.erase(quotePos);
+	return result;
+}
+
+// -----------------------------------------------------------------------------
+
+AuthInfoIndex::Keys AuthInfoIndex::computeKeys(const LinphoneAuthInfo *info, unsigned long long rank) {
+	Keys keys;
+	keys.rank = rank;
+
+	// Auth infos without username are only found by a walk of the whole list.
+	const char *username = linphone_auth_info_get_username(info);
+	if (!username) return keys;
+
+	keys.indexed = true;
+	keys.username = username;
+	const char *realm = linphone_auth_info_get_realm(info);
+	keys.hasRealm = realm != nullptr;
+	if (realm) keys.usernameAndRealm = keys.username + '\n' + normalizeRealm(realm);
+	const char *domain = linphone_auth_info_get_domain(info);
+	keys.hasDomain = domain != nullptr;
+	if (domain) keys.usernameAndDomain = keys.username + '\n' + domain;
+	return keys;
+}
+
+const AuthInfoIndex::Bucket &AuthInfoIndex::find(const unordered_map<string, Bucket> &buckets, const string &key) {
+	auto it = buckets.find(key);
+	if (it == buckets.cend()) return Utils::getEmptyConstRefObject<Bucket>();
+	return it->second;
+}
+
+bool AuthInfoIndex::Keys::operator==(const Keys &other) const {
+	return indexed == other.indexed && hasRealm == other.hasRealm && hasDomain == other.hasDomain &&
+	       username == other.username && usernameAndRealm == other.usernameAndRealm &&
+	       usernameAndDomain == other.usernameAndDomain;
+}
+
+void AuthInfoIndex::erase(unordered_map<string, Bucket> &buckets, const string &key, unsigned long long rank) {
+	auto it = buckets.find(key);
+	if (it == buckets.end()) return;
+	it->second.erase(rank);
+	if (it->second.empty()) buckets.erase(it);
+}
+
+void AuthInfoIndex::eraseKeys(const Keys &keys) {
+	if (!keys.indexed) return;
+	erase(mByUsername, keys.username, keys.rank);
+	if (keys.hasRealm) erase(mByUsernameAndRealm, keys.usernameAndRealm, keys.rank);
+	if (keys.hasDomain) erase(mByUsernameAndDomain, keys.usernameAndDomain, keys.rank);
+}
+
+void AuthInfoIndex::insert(LinphoneAuthInfo *info, Keys &&keys) {
+	mAll[keys.rank] = info;
+	if (keys.indexed) {
+		mByUsername[keys.username][keys.rank] = info;
+		if (keys.hasRealm) mByUsernameAndRealm[keys.usernameAndRealm][keys.rank] = info;
+		if (keys.hasDomain) mByUsernameAndDomain[keys.usernameAndDomain][keys.rank] = info;
+	}
+	mKeys.emplace(info, std::move(keys));
+}
+
+LINPHONE_END_NAMESPACE
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_AUTH_INFO_INDEX_H_
+#define _L_AUTH_INFO_INDEX_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "linphone/api/c-types.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Index of the auth infos of the core (the lc->auth_info list), kept up to date by authentication.c and by the
+ * setters of the indexed auth infos.
+ * Auth infos are keyed by username, username and realm, and username and domain. Each lookup returns the matching
+ * auth infos in the order of the list, so that callers keep the first-match semantics of a list walk.
+ * Realms are compared without their quotes, as realm_match() does.
+ */
+class AuthInfoIndex {
+public:
+	AuthInfoIndex() = default;
+	AuthInfoIndex(const AuthInfoIndex &) = delete;
+	AuthInfoIndex &operator=(const AuthInfoIndex &) = delete;
+	~AuthInfoIndex();
+
+	// Auth infos sorted in list order.
+	using Bucket = std::map<unsigned long long, LinphoneAuthInfo *>;
+
+	// The auth info has been appended to the list.
+	void add(LinphoneAuthInfo *info);
+	void remove(LinphoneAuthInfo *info);
+	// The username, realm or domain of an auth info of the list may have changed.
+	void update(LinphoneAuthInfo *info);
+	void clear();
+
+	const Bucket &getAll() const {
+		return mAll;
+	}
+
+	const Bucket &findByUsername(const char *username) const;
+	const Bucket &findByUsernameAndRealm(const char *username, const char *realm) const;
+	const Bucket &findByUsernameAndDomain(const char *username, const char *domain) const;
+
+	// Position of the auth info in the list, -1 if it is not in it.
+	int getPosition(const LinphoneAuthInfo *info) const;
+
+	static std::string normalizeRealm(const char *realm);
+
+private:
+	struct Keys {
+		unsigned long long rank = 0;
+		bool indexed = false;
+		bool hasRealm = false;
+		bool hasDomain = false;
+		std::string username;
+		std::string usernameAndRealm;
+		std::string usernameAndDomain;
+
+		bool operator==(const Keys &other) const;
+	};
+
+	static Keys computeKeys(const LinphoneAuthInfo *info, unsigned long long rank);
+	static const Bucket &find(const std::unordered_map<std::string, Bucket> &buckets, const std::string &key);
+	static void
+	erase(std::unordered_map<std::string, Bucket> &buckets, const std::string &key, unsigned long long rank);
+	void eraseKeys(const Keys &keys);
+	void insert(LinphoneAuthInfo *info, Keys &&keys);
+
+	unsigned long long mNextRank = 0;
+	Bucket mAll;
+	std::unordered_map<const LinphoneAuthInfo *, Keys> mKeys;
+	std::unordered_map<std::string, Bucket> mByUsername;
+	std::unordered_map<std::string, Bucket> mByUsernameAndRealm;
+	std::unordered_map<std::string, Bucket> mByUsernameAndDomain;
+
+	// Positions are computed lazily after a removal.
+	mutable std::unordered_map<const LinphoneAuthInfo *, int> mPositions;
+	mutable bool mPositionsValid = true;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_AUTH_INFO_INDEX_H_
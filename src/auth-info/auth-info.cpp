@@ -19,6 +19,7 @@
  */
 
 #include "auth-info.h"
+#include "auth-info-index.h"
 #include "bellesip_sal/sal_impl.h"
 #include "linphone/lpconfig.h"
 #include "logger/logger.h"
@@ -197,6 +198,7 @@ void AuthInfo::setUsername(const string &username) {
 		setNeedToRenewHa1(true);
 	}
 	mUsername = username;
+	updateIndex();
 }
 
 void AuthInfo::setAlgorithm(const string &algorithm) { // Select algorithm
@@ -237,10 +239,12 @@ void AuthInfo::setRealm(const string &realm) {
 		setNeedToRenewHa1(true);
 	}
 	mRealm = realm;
+	updateIndex();
 }
 
 void AuthInfo::setDomain(const string &domain) {
 	mDomain = domain;
+	updateIndex();
 }
 
 void AuthInfo::setHa1(const string &ha1) {
@@ -252,6 +256,11 @@ void AuthInfo::setNeedToRenewHa1(const bool_t &needToRenewHa1) {
 	mNeedToRenewHa1 = needToRenewHa1;
 }
 
+void AuthInfo::updateIndex() {
+	// The auth info may be modified in place by the application, through the list of the core.
+	if (mIndex) mIndex->update(toC());
+}
+
 void AuthInfo::setTlsCert(const string &tlsCert) {
 	mTlsCert = tlsCert;
 }
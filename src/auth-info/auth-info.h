@@ -25,6 +25,8 @@
 
 LINPHONE_BEGIN_NAMESPACE
 
+class AuthInfoIndex;
+
 class AuthInfo : public bellesip::HybridObject<LinphoneAuthInfo, AuthInfo> {
 public:
 	AuthInfo(const std::string &username = "",
@@ -120,9 +122,14 @@ private:
 	std::string mTlsKeyPath;
 	std::string mTlsKeyPassword;
 	bool_t mNeedToRenewHa1;
+	// Index of the core holding this auth info, updated when a key of the index changes.
+	AuthInfoIndex *mIndex = nullptr;
 
 	void setNeedToRenewHa1(const bool_t &needToRenewHa1);
 	const bool_t &getNeedToRenewHa1() const;
+	void updateIndex();
+
+	friend class AuthInfoIndex;
 };
 
 LINPHONE_END_NAMESPACE
@@ -32,6 +32,9 @@
 #include "linphone/wrapper_utils.h"
 #include "utils/enum.h"
 
+// TODO: From coreapi. Remove me later.
+#include "private.h"
+
 // =============================================================================
 
 using namespace LinphonePrivate;
@@ -321,25 +324,30 @@ static char *replace_icp_with_plus(char *phone, const char *icp) {
 
 char *linphone_account_normalize_phone_number(const LinphoneAccount *account, const char *username) {
 	AccountLogContextualizer logContextualizer(account);
-	char *result = NULL;
-	std::shared_ptr<DialPlan> dialplan;
-	char *nationnal_significant_number = NULL;
-	int ccc = -1;
-	const char *dial_prefix;
-	bool_t dial_escape_plus;
+	char *result;
 
 	if (account) {
 		const LinphoneAccountParams *accountParams = linphone_account_get_params(account);
-		dial_prefix = linphone_account_params_get_international_prefix(accountParams);
-		dial_escape_plus = linphone_account_params_dial_escape_plus_enabled(accountParams);
+		result = _linphone_normalize_phone_number(linphone_account_params_get_international_prefix(accountParams),
+		                                          linphone_account_params_dial_escape_plus_enabled(accountParams),
+		                                          username);
 	} else {
 		LinphoneAccountParams *accountParams = linphone_account_params_new(NULL);
-		dial_prefix = linphone_account_params_get_international_prefix(accountParams);
-		dial_escape_plus = linphone_account_params_dial_escape_plus_enabled(accountParams);
+		result = _linphone_normalize_phone_number(linphone_account_params_get_international_prefix(accountParams),
+		                                          linphone_account_params_dial_escape_plus_enabled(accountParams),
+		                                          username);
 		linphone_account_params_unref(accountParams);
 	}
+	return result;
+}
+
+char *_linphone_normalize_phone_number(const char *dial_prefix, bool_t dial_escape_plus, const char *username) {
+	char *result = NULL;
+	std::shared_ptr<DialPlan> dialplan;
+	char *nationnal_significant_number = NULL;
+	int ccc = -1;
 
-	if (linphone_account_is_phone_number(account, username)) {
+	if (linphone_account_is_phone_number(NULL, username)) {
 		char *flatten = linphone_account_flatten_phone_number(username);
 		ms_debug("Flattened number is '%s' for '%s'", flatten, username);
 
@@ -373,7 +381,7 @@ char *linphone_account_normalize_phone_number(const LinphoneAccount *account, co
 				    strlen(flatten) > strlen(country_calling_code)) {
 					ms_warning("Phone number seems to start by international prefix but without '+', adding it");
 					char *e164 = ms_strdup_printf("+%s", flatten);
-					result = linphone_account_normalize_phone_number(account, e164);
+					result = _linphone_normalize_phone_number(dial_prefix, dial_escape_plus, e164);
 					ms_free(e164);
 					goto end;
 				}
@@ -382,7 +390,7 @@ char *linphone_account_normalize_phone_number(const LinphoneAccount *account, co
 				 * dial_prefix==NULL)*/
 				if (strstr(flatten, dialplan->getInternationalCallPrefix().c_str()) == flatten) {
 					char *e164 = replace_icp_with_plus(flatten, dialplan->getInternationalCallPrefix().c_str());
-					result = linphone_account_normalize_phone_number(account, e164);
+					result = _linphone_normalize_phone_number(dial_prefix, dial_escape_plus, e164);
 					ms_free(e164);
 					goto end;
 				}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "linphone/api/c-call-log-iterator.h"
+
+#include "c-wrapper/c-wrapper.h"
+#include "call/call-log-iterator.h"
+
+// =============================================================================
+
+using namespace LinphonePrivate;
+
+LinphoneCallLogIterator *linphone_call_log_iterator_ref(LinphoneCallLogIterator *iterator) {
+	CallLogIterator::toCpp(iterator)->ref();
+	return iterator;
+}
+
+void linphone_call_log_iterator_unref(LinphoneCallLogIterator *iterator) {
+	CallLogIterator::toCpp(iterator)->unref();
+}
+
+bool_t linphone_call_log_iterator_has_next(LinphoneCallLogIterator *iterator) {
+	return CallLogIterator::toCpp(iterator)->hasNext();
+}
+
+LinphoneCallLog *linphone_call_log_iterator_next(LinphoneCallLogIterator *iterator) {
+	const std::shared_ptr<CallLog> &callLog = CallLogIterator::toCpp(iterator)->next();
+	return callLog ? callLog->toC() : nullptr;
+}
+
+int linphone_call_log_iterator_get_page_size(const LinphoneCallLogIterator *iterator) {
+	return CallLogIterator::toCpp(iterator)->getPageSize();
+}
@@ -20,6 +20,7 @@
 
 #include "linphone/api/c-call-log.h"
 #include "c-wrapper/c-wrapper.h"
+#include "call/call-log-iterator.h"
 #include "call/call-log.h"
 #include "core/core-p.h"
 #include "db/main-db.h"
@@ -287,16 +288,19 @@ const bctbx_list_t *linphone_core_get_call_history(LinphoneCore *lc) {
 	}
 
 	auto list = mainDb->getCallHistory(lc->max_call_logs);
-	if (!list.empty()) {
-		for (auto &log : list) {
-			lc->call_logs = bctbx_list_append(lc->call_logs, linphone_call_log_ref(log->toC()));
-		}
+	// Prepend from the end: appending would walk the whole C list for each call log.
+	for (auto it = list.rbegin(); it != list.rend(); ++it) {
+		lc->call_logs = bctbx_list_prepend(lc->call_logs, linphone_call_log_ref((*it)->toC()));
 	}
 #endif
 
 	return lc->call_logs;
 }
 
+LinphoneCallLogIterator *linphone_core_create_call_history_iterator(LinphoneCore *lc, int page_size) {
+	return CallLogIterator::createCObject(L_GET_CPP_PTR_FROM_C_OBJECT(lc)->getSharedFromThis(), page_size);
+}
+
 void linphone_core_delete_call_history(LinphoneCore *lc) {
 	if (!lc) return;
 
@@ -404,7 +404,7 @@ void linphone_chat_message_add_file_content(LinphoneChatMessage *msg, LinphoneCo
 
 	fileContent->setFileSize(linphone_content_get_size(c_content));
 	fileContent->setFileDuration(linphone_content_get_file_duration(c_content));
-	fileContent->setBody(content->getBody());
+	fileContent->setBody(content->getBodyBuffer());
 	fileContent->setUserData(content->getUserData());
 
 	L_GET_CPP_PTR_FROM_C_OBJECT(msg)->addContent(fileContent);
@@ -439,7 +439,7 @@ void linphone_chat_message_add_content(LinphoneChatMessage *msg, LinphoneContent
 		auto content = LinphonePrivate::Content::toCpp(c_content);
 		auto cppContent = LinphonePrivate::Content::create();
 		cppContent->setContentType(content->getContentType());
-		cppContent->setBody(content->getBody());
+		cppContent->setBody(content->getBodyBuffer());
 		cppContent->setUserData(content->getUserData());
 		L_GET_CPP_PTR_FROM_C_OBJECT(msg)->addContent(cppContent);
 	}
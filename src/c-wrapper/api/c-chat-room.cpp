@@ -40,6 +40,7 @@
 #endif
 #include "conference/participant.h"
 #include "core/core-p.h"
+#include "event-log/event-log-iterator.h"
 #include "event-log/event-log.h"
 #include "linphone/utils/utils.h"
 
@@ -359,6 +360,16 @@ bctbx_list_t *linphone_chat_room_get_history_range_events(LinphoneChatRoom *cr,
 	return L_GET_RESOLVED_C_LIST_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getHistoryRange(begin, end));
 }
 
+LinphoneEventLogIterator *linphone_chat_room_create_history_iterator(LinphoneChatRoom *cr, int page_size) {
+	LinphonePrivate::ChatRoomLogContextualizer logContextualizer(cr);
+	return LinphonePrivate::EventLogIterator::createCObject(L_GET_CPP_PTR_FROM_C_OBJECT(cr), true, page_size);
+}
+
+LinphoneEventLogIterator *linphone_chat_room_create_history_events_iterator(LinphoneChatRoom *cr, int page_size) {
+	LinphonePrivate::ChatRoomLogContextualizer logContextualizer(cr);
+	return LinphonePrivate::EventLogIterator::createCObject(L_GET_CPP_PTR_FROM_C_OBJECT(cr), false, page_size);
+}
+
 int linphone_chat_room_get_history_events_size(LinphoneChatRoom *cr) {
 	LinphonePrivate::ChatRoomLogContextualizer logContextualizer(cr);
 	return L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getHistorySize();
@@ -95,6 +95,13 @@ void linphone_conference_scheduler_notify_invitations_sent(LinphoneConferenceSch
 	                                  linphone_conference_scheduler_cbs_get_invitations_sent, failed_invites);
 }
 
+void linphone_conference_scheduler_notify_invitations_progress(LinphoneConferenceScheduler *conference_scheduler,
+                                                               int sent,
+                                                               int total) {
+	LINPHONE_HYBRID_OBJECT_INVOKE_CBS(ConferenceScheduler, ConferenceScheduler::toCpp(conference_scheduler),
+	                                  linphone_conference_scheduler_cbs_get_invitations_progress, sent, total);
+}
+
 void linphone_conference_scheduler_add_callbacks(LinphoneConferenceScheduler *conference_scheduler,
                                                  LinphoneConferenceSchedulerCbs *cbs) {
 	ConferenceScheduler::toCpp(conference_scheduler)
@@ -163,3 +170,13 @@ void linphone_conference_scheduler_cbs_set_invitations_sent(LinphoneConferenceSc
                                                             LinphoneConferenceSchedulerCbsInvitationsSentCb cb) {
 	ConferenceSchedulerCbs::toCpp(cbs)->setInvitationsSent(cb);
 }
+
+LinphoneConferenceSchedulerCbsInvitationsProgressCb
+linphone_conference_scheduler_cbs_get_invitations_progress(const LinphoneConferenceSchedulerCbs *cbs) {
+	return ConferenceSchedulerCbs::toCpp(cbs)->getInvitationsProgress();
+}
+
+void linphone_conference_scheduler_cbs_set_invitations_progress(LinphoneConferenceSchedulerCbs *cbs,
+                                                                LinphoneConferenceSchedulerCbsInvitationsProgressCb cb) {
+	ConferenceSchedulerCbs::toCpp(cbs)->setInvitationsProgress(cb);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "linphone/api/c-event-log-iterator.h"
+
+#include "c-wrapper/c-wrapper.h"
+#include "event-log/event-log-iterator.h"
+#include "event-log/event-log.h"
+
+// =============================================================================
+
+using namespace LinphonePrivate;
+
+LinphoneEventLogIterator *linphone_event_log_iterator_ref(LinphoneEventLogIterator *iterator) {
+	EventLogIterator::toCpp(iterator)->ref();
+	return iterator;
+}
+
+void linphone_event_log_iterator_unref(LinphoneEventLogIterator *iterator) {
+	EventLogIterator::toCpp(iterator)->unref();
+}
+
+bool_t linphone_event_log_iterator_has_next(LinphoneEventLogIterator *iterator) {
+	return EventLogIterator::toCpp(iterator)->hasNext();
+}
+
+LinphoneEventLog *linphone_event_log_iterator_next(LinphoneEventLogIterator *iterator) {
+	const std::shared_ptr<EventLog> &event = EventLogIterator::toCpp(iterator)->next();
+	return event ? L_GET_C_BACK_PTR(event) : nullptr;
+}
+
+int linphone_event_log_iterator_get_page_size(const LinphoneEventLogIterator *iterator) {
+	return EventLogIterator::toCpp(iterator)->getPageSize();
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "call-history-cache.h"
+
+#include "address/address.h"
+#include "call/call-log.h"
+#include "linphone/utils/utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+void CallHistoryCache::invalidate() {
+	clear();
+	mLoaded = false;
+}
+
+void CallHistoryCache::clear() {
+	mEntries.clear();
+	mIdsByLocal.clear();
+	mIdsByPeer.clear();
+	mIdsByLocalAndPeer.clear();
+	mIdsByCallId.clear();
+	mStatsByLocal.clear();
+	mStatsByPeer.clear();
+}
+
+void CallHistoryCache::setLoaded() {
+	mLoaded = true;
+}
+
+void CallHistoryCache::update(long long id, const shared_ptr<CallLog> &callLog) {
+	Call call;
+	bool outgoing = callLog->getDirection() == LinphoneCallOutgoing;
+	call.localKey = getAddressKey(outgoing ? callLog->getFromAddress() : callLog->getToAddress());
+	call.peerKey = getAddressKey(outgoing ? callLog->getToAddress() : callLog->getFromAddress());
+	call.callId = callLog->getCallId();
+	call.direction = callLog->getDirection();
+	call.status = callLog->getStatus();
+	call.duration = callLog->getDuration();
+	call.startTime = callLog->getStartTime();
+	call.conference = callLog->getConferenceInfoId() >= 0;
+	update(id, std::move(call));
+}
+
+void CallHistoryCache::update(long long id, Call &&call) {
+	remove(id);
+
+	mIdsByLocal[call.localKey].insert(id);
+	mIdsByPeer[call.peerKey].insert(id);
+	mIdsByLocalAndPeer[call.localKey + " " + call.peerKey].insert(id);
+	if (!call.callId.empty()) mIdsByCallId[call.callId] = id;
+	addToStats(mStatsByLocal[call.localKey], call);
+	addToStats(mStatsByPeer[call.peerKey], call);
+
+	mEntries.emplace(id, std::move(call));
+}
+
+void CallHistoryCache::remove(long long id) {
+	auto it = mEntries.find(id);
+	if (it == mEntries.end()) return;
+
+	Call call = std::move(it->second);
+	mEntries.erase(it);
+	removeFromIndexes(id, call);
+}
+
+list<long long> CallHistoryCache::getIds(int limit) const {
+	list<long long> ids;
+	for (const auto &entry : mEntries) {
+		if (limit > 0 && ids.size() >= (size_t)limit) break;
+		ids.push_back(entry.first);
+	}
+	return ids;
+}
+
+list<long long> CallHistoryCache::getIdsForLocalAddress(const shared_ptr<const Address> &localAddress,
+                                                        int limit) const {
+	auto it = mIdsByLocal.find(getAddressKey(localAddress));
+	if (it == mIdsByLocal.cend()) return list<long long>();
+	return takeIds(it->second, limit);
+}
+
+list<long long> CallHistoryCache::getIds(const shared_ptr<const Address> &peerAddress,
+                                         const shared_ptr<const Address> &localAddress,
+                                         int limit) const {
+	auto it = mIdsByLocalAndPeer.find(getAddressKey(localAddress) + " " + getAddressKey(peerAddress));
+	if (it == mIdsByLocalAndPeer.cend()) return list<long long>();
+	return takeIds(it->second, limit);
+}
+
+long long CallHistoryCache::findId(const string &callId, int limit) const {
+	auto it = mIdsByCallId.find(callId);
+	if (it == mIdsByCallId.cend()) return -1;
+	if (limit <= 0) return it->second;
+
+	// The call must be one of the last "limit" calls.
+	int rank = 0;
+	for (auto entryIt = mEntries.cbegin(); entryIt != mEntries.cend() && rank < limit; ++entryIt, ++rank) {
+		if (entryIt->first == it->second) return it->second;
+	}
+	return -1;
+}
+
+long long CallHistoryCache::getLastOutgoingCallId() const {
+	for (const auto &entry : mEntries) {
+		if (entry.second.direction == LinphoneCallOutgoing && !entry.second.conference) return entry.first;
+	}
+	return -1;
+}
+
+const CallHistoryCache::Stats &
+CallHistoryCache::getStatsForLocalAddress(const shared_ptr<const Address> &localAddress) const {
+	auto it = mStatsByLocal.find(getAddressKey(localAddress));
+	if (it == mStatsByLocal.cend()) return Utils::getEmptyConstRefObject<Stats>();
+	return it->second;
+}
+
+const CallHistoryCache::Stats &
+CallHistoryCache::getStatsForPeerAddress(const shared_ptr<const Address> &peerAddress) const {
+	auto it = mStatsByPeer.find(getAddressKey(peerAddress));
+	if (it == mStatsByPeer.cend()) return Utils::getEmptyConstRefObject<Stats>();
+	return it->second;
+}
+
+string CallHistoryCache::getAddressKey(const shared_ptr<const Address> &address) {
+	if (!address) return string();
+	// Domains are case-insensitive, as they were for the LIKE match of the former queries.
+	return address->getUsername() + "@" + Utils::stringToLower(address->getDomain());
+}
+
+// -----------------------------------------------------------------------------
+
+void CallHistoryCache::addToStats(Stats &stats, const Call &call) {
+	stats.total++;
+	if (call.status == LinphoneCallMissed) stats.missed++;
+	else if (call.status == LinphoneCallSuccess) stats.answered++;
+	stats.totalDuration += call.duration;
+	if (call.startTime > stats.lastCallTime) stats.lastCallTime = call.startTime;
+}
+
+void CallHistoryCache::removeFromStats(unordered_map<string, Stats> &statsMap,
+                                       const string &key,
+                                       const IdSet &ids,
+                                       const Call &call) {
+	auto it = statsMap.find(key);
+	if (it == statsMap.end()) return;
+	if (ids.empty()) {
+		statsMap.erase(it);
+		return;
+	}
+
+	Stats &stats = it->second;
+	stats.total--;
+	if (call.status == LinphoneCallMissed) stats.missed--;
+	else if (call.status == LinphoneCallSuccess) stats.answered--;
+	stats.totalDuration -= call.duration;
+	if (call.startTime >= stats.lastCallTime) {
+		// The removed call may have been the last one, look for the new last call among the remaining ones.
+		stats.lastCallTime = 0;
+		for (long long id : ids) {
+			auto entryIt = mEntries.find(id);
+			if (entryIt != mEntries.end() && entryIt->second.startTime > stats.lastCallTime)
+				stats.lastCallTime = entryIt->second.startTime;
+		}
+	}
+}
+
+void CallHistoryCache::removeFromIndexes(long long id, const Call &call) {
+	static const IdSet emptyIds;
+
+	auto eraseId = [id](unordered_map<string, IdSet> &idsMap, const string &key) -> const IdSet & {
+		auto it = idsMap.find(key);
+		if (it == idsMap.end()) return emptyIds;
+		it->second.erase(id);
+		if (it->second.empty()) {
+			idsMap.erase(it);
+			return emptyIds;
+		}
+		return it->second;
+	};
+
+	removeFromStats(mStatsByLocal, call.localKey, eraseId(mIdsByLocal, call.localKey), call);
+	removeFromStats(mStatsByPeer, call.peerKey, eraseId(mIdsByPeer, call.peerKey), call);
+	eraseId(mIdsByLocalAndPeer, call.localKey + " " + call.peerKey);
+
+	auto callIdIt = mIdsByCallId.find(call.callId);
+	if (callIdIt != mIdsByCallId.end() && callIdIt->second == id) mIdsByCallId.erase(callIdIt);
+}
+
+list<long long> CallHistoryCache::takeIds(const IdSet &ids, int limit) {
+	list<long long> result;
+	for (long long id : ids) {
+		if (limit > 0 && result.size() >= (size_t)limit) break;
+		result.push_back(id);
+	}
+	return result;
+}
+
+LINPHONE_END_NAMESPACE
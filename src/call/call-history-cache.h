@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_CALL_HISTORY_CACHE_H_
+#define _L_CALL_HISTORY_CACHE_H_
+
+#include <ctime>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "linphone/types.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class Address;
+class CallLog;
+
+/*
+ * Index of the call history stored in database, kept by MainDb and updated on every write so that call history
+ * queries do not have to scan the conference_call table.
+ * Only lightweight fields are kept here: call logs themselves are fetched by id, through the MainDb cache first.
+ * Addresses are compared on their username and domain.
+ */
+class CallHistoryCache {
+public:
+	struct Stats {
+		int total = 0;
+		int missed = 0;
+		int answered = 0;
+		long long totalDuration = 0;
+		time_t lastCallTime = 0;
+	};
+
+	// Lightweight description of a call of the history, the addresses are reduced to their key.
+	struct Call {
+		std::string localKey;
+		std::string peerKey;
+		std::string callId;
+		LinphoneCallDir direction = LinphoneCallOutgoing;
+		LinphoneCallStatus status = LinphoneCallSuccess;
+		int duration = 0;
+		time_t startTime = 0;
+		bool conference = false;
+	};
+
+	bool isLoaded() const {
+		return mLoaded;
+	}
+
+	// Drops everything, the history will have to be loaded again.
+	void invalidate();
+	// Empties the history and keeps it loaded.
+	void clear();
+	void setLoaded();
+
+	void update(long long id, const std::shared_ptr<CallLog> &callLog);
+	void update(long long id, Call &&call);
+	void remove(long long id);
+
+	size_t size() const {
+		return mEntries.size();
+	}
+
+	// All the lists of ids are sorted from the most recent call to the oldest one.
+	std::list<long long> getIds(int limit = -1) const;
+	std::list<long long> getIdsForLocalAddress(const std::shared_ptr<const Address> &localAddress,
+	                                           int limit = -1) const;
+	std::list<long long> getIds(const std::shared_ptr<const Address> &peerAddress,
+	                            const std::shared_ptr<const Address> &localAddress,
+	                            int limit = -1) const;
+	long long findId(const std::string &callId, int limit = -1) const;
+	long long getLastOutgoingCallId() const;
+
+	const Stats &getStatsForLocalAddress(const std::shared_ptr<const Address> &localAddress) const;
+	const Stats &getStatsForPeerAddress(const std::shared_ptr<const Address> &peerAddress) const;
+
+	static std::string getAddressKey(const std::shared_ptr<const Address> &address);
+
+private:
+	using IdSet = std::set<long long, std::greater<long long>>;
+
+	void addToStats(Stats &stats, const Call &call);
+	void removeFromStats(std::unordered_map<std::string, Stats> &statsMap,
+	                     const std::string &key,
+	                     const IdSet &ids,
+	                     const Call &call);
+	void removeFromIndexes(long long id, const Call &call);
+
+	static std::list<long long> takeIds(const IdSet &ids, int limit);
+
+	bool mLoaded = false;
+	std::map<long long, Call, std::greater<long long>> mEntries;
+	std::unordered_map<std::string, IdSet> mIdsByLocal;
+	std::unordered_map<std::string, IdSet> mIdsByPeer;
+	std::unordered_map<std::string, IdSet> mIdsByLocalAndPeer;
+	std::unordered_map<std::string, long long> mIdsByCallId;
+	std::unordered_map<std::string, Stats> mStatsByLocal;
+	std::unordered_map<std::string, Stats> mStatsByPeer;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_CALL_HISTORY_CACHE_H_
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "call-log-iterator.h"
+
+#include "core/core-p.h"
+#include "db/main-db.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+CallLogIterator::CallLogIterator(const shared_ptr<Core> &core, int pageSize)
+    : PagedIterator<CallLog>(
+          [weakCore = weak_ptr<Core>(core)](long long &cursor, int size) {
+	          shared_ptr<Core> core = weakCore.lock();
+	          if (!core || !core->getPrivate()->mainDb) return list<shared_ptr<CallLog>>();
+	          return core->getPrivate()->mainDb->getCallHistoryPage(cursor, size);
+          },
+          pageSize) {
+}
+
+LINPHONE_END_NAMESPACE
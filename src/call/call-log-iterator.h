@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_CALL_LOG_ITERATOR_H_
+#define _L_CALL_LOG_ITERATOR_H_
+
+#include <belle-sip/object++.hh>
+
+#include "call-log.h"
+#include "containers/paged-iterator.h"
+#include "core/core-accessor.h"
+#include "linphone/api/c-types.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class LINPHONE_PUBLIC CallLogIterator : public bellesip::HybridObject<LinphoneCallLogIterator, CallLogIterator>,
+                                        public PagedIterator<CallLog> {
+public:
+	// Walks through the call history of the core, from the most recent call to the oldest one.
+	CallLogIterator(const std::shared_ptr<Core> &core, int pageSize);
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_CALL_LOG_ITERATOR_H_
@@ -202,6 +202,10 @@ void CallLog::setConferenceInfoId(long long conferenceInfoId) {
 	mConferenceInfoId = conferenceInfoId;
 }
 
+long long CallLog::getConferenceInfoId() const {
+	return mConferenceInfoId;
+}
+
 // =============================================================================
 
 void CallLog::setConferenceInfo(std::shared_ptr<ConferenceInfo> conferenceInfo) {
@@ -91,6 +91,7 @@ public:
 	LinphoneQualityReporting *getQualityReporting();
 
 	void setConferenceInfoId(long long conferenceInfoId);
+	long long getConferenceInfoId() const;
 
 	void setConferenceInfo(std::shared_ptr<ConferenceInfo> conferenceInfo);
 	std::shared_ptr<ConferenceInfo> &getConferenceInfo();
@@ -583,7 +583,7 @@ const ContentType &ChatMessagePrivate::getContentType() const {
 void ChatMessagePrivate::setContentType(const ContentType &contentType) {
 	loadContentsFromDatabase();
 	if (!contents.empty() && internalContent.getContentType().isEmpty() && internalContent.isEmpty()) {
-		internalContent.setBody(contents.front()->getBody());
+		internalContent.setBody(contents.front()->getBodyBuffer());
 	}
 	internalContent.setContentType(contentType);
 
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chat-room-index.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "address/address.h"
+#include "chat/chat-room/abstract-chat-room.h"
+#include "conference/participant.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+void ChatRoomIndex::insert(const shared_ptr<AbstractChatRoom> &chatRoom) {
+	const AbstractChatRoom *key = chatRoom.get();
+	remove(key);
+
+	Entry &entry = mEntries[key];
+	entry.chatRoom = chatRoom;
+	const auto &localAddress = chatRoom->getLocalAddress();
+	if (localAddress && localAddress->isValid()) {
+		entry.localKey = getKey(*localAddress);
+		add(mByLocalAddress, entry.localKey, key);
+	}
+	const auto &peerAddress = chatRoom->getPeerAddress();
+	if (peerAddress && peerAddress->isValid()) {
+		entry.peerKey = getKey(*peerAddress);
+		add(mByPeerAddress, entry.peerKey, key);
+	}
+	indexParticipants(entry, chatRoom);
+}
+
+void ChatRoomIndex::remove(const AbstractChatRoom *chatRoom) {
+	auto it = mEntries.find(chatRoom);
+	if (it == mEntries.end()) return;
+
+	Entry &entry = it->second;
+	if (!entry.localKey.empty()) remove(mByLocalAddress, entry.localKey, chatRoom);
+	if (!entry.peerKey.empty()) remove(mByPeerAddress, entry.peerKey, chatRoom);
+	unindexParticipants(entry, chatRoom);
+	mEntries.erase(it);
+}
+
+void ChatRoomIndex::clear() {
+	mEntries.clear();
+	mByLocalAddress.clear();
+	mByPeerAddress.clear();
+	mByParticipant.clear();
+}
+
+bool ChatRoomIndex::findCandidates(const shared_ptr<const Address> &localAddress,
+                                   const shared_ptr<const Address> &peerAddress,
+                                   const list<shared_ptr<Address>> &participants,
+                                   vector<shared_ptr<AbstractChatRoom>> &candidates) const {
+	candidates.clear();
+
+	vector<const Bucket *> buckets;
+	bool usable = false;
+	bool empty = false;
+	auto addBucket = [&](const Buckets &index, const shared_ptr<const Address> &address) {
+		bool usableAddress;
+		const Bucket *bucket = find(index, address, usableAddress);
+		if (!usableAddress) return;
+		usable = true;
+		if (bucket) buckets.push_back(bucket);
+		else empty = true;
+	};
+	addBucket(mByLocalAddress, localAddress);
+	addBucket(mByPeerAddress, peerAddress);
+	for (const auto &participant : participants)
+		addBucket(mByParticipant, participant);
+
+	if (!usable) return false;
+	if (empty) return true;
+
+	// Walk the smallest bucket, and keep the chat rooms that are in all the others.
+	auto smallest = min_element(buckets.cbegin(), buckets.cend(),
+	                            [](const Bucket *a, const Bucket *b) { return a->size() < b->size(); });
+	for (const AbstractChatRoom *chatRoom : **smallest) {
+		bool inAll = true;
+		for (const Bucket *bucket : buckets) {
+			if (bucket != *smallest && bucket->find(chatRoom) == bucket->cend()) {
+				inAll = false;
+				break;
+			}
+		}
+		if (!inAll) continue;
+		auto it = mEntries.find(chatRoom);
+		if (it == mEntries.cend()) continue;
+		auto candidate = it->second.chatRoom.lock();
+		if (candidate) candidates.push_back(std::move(candidate));
+	}
+	return true;
+}
+
+string ChatRoomIndex::getKey(const Address &address) {
+	const char *username = address.getUsernameCstr();
+	const char *domain = address.getDomainCstr();
+	string key;
+	key.reserve((username ? strlen(username) : 0) + (domain ? strlen(domain) : 0) + 1);
+	if (username) key.append(username);
+	key.push_back('@');
+	if (domain) key.append(domain);
+	for (auto &c : key)
+		c = (char)tolower((unsigned char)c);
+	return key;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChatRoomIndex::indexParticipants(Entry &entry, const shared_ptr<AbstractChatRoom> &chatRoom) {
+	for (const auto &participant : chatRoom->getParticipants()) {
+		const auto &address = participant->getAddress();
+		if (!address || !address->isValid()) continue;
+		string key = getKey(*address);
+		if (std::find(entry.participantKeys.cbegin(), entry.participantKeys.cend(), key) !=
+		    entry.participantKeys.cend())
+			continue;
+		add(mByParticipant, key, chatRoom.get());
+		entry.participantKeys.push_back(std::move(key));
+	}
+}
+
+void ChatRoomIndex::unindexParticipants(Entry &entry, const AbstractChatRoom *chatRoom) {
+	for (const auto &key : entry.participantKeys)
+		remove(mByParticipant, key, chatRoom);
+	entry.participantKeys.clear();
+}
+
+void ChatRoomIndex::add(Buckets &buckets, const string &key, const AbstractChatRoom *chatRoom) {
+	buckets[key].insert(chatRoom);
+}
+
+void ChatRoomIndex::remove(Buckets &buckets, const string &key, const AbstractChatRoom *chatRoom) {
+	auto it = buckets.find(key);
+	if (it == buckets.end()) return;
+	it->second.erase(chatRoom);
+	if (it->second.empty()) buckets.erase(it);
+}
+
+const ChatRoomIndex::Bucket *
+ChatRoomIndex::find(const Buckets &buckets, const shared_ptr<const Address> &address, bool &usable) {
+	usable = address && address->isValid();
+	if (!usable) return nullptr;
+	auto it = buckets.find(getKey(*address));
+	return (it == buckets.cend()) ? nullptr : &it->second;
+}
+
+LINPHONE_END_NAMESPACE
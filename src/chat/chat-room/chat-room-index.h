@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_CHAT_ROOM_INDEX_H_
+#define _L_CHAT_ROOM_INDEX_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class AbstractChatRoom;
+class Address;
+
+/*
+ * Secondary indexes of the chat rooms of a core, by local address, peer address and participant.
+ * Addresses are keyed by their lowercase username and domain, which is looser than both the comparison of URIs
+ * without GRUU and the weak comparison of addresses: the chat rooms found must still be checked against the
+ * searched addresses, but no matching chat room is missed.
+ */
+class ChatRoomIndex {
+public:
+	// Indexes the chat room, or indexes it again if its addresses or participants changed.
+	void insert(const std::shared_ptr<AbstractChatRoom> &chatRoom);
+	void remove(const AbstractChatRoom *chatRoom);
+	void clear();
+
+	// Fills the chat rooms that may have these local address, peer address and participants. Returns false when none
+	// of them can narrow the search, and all the chat rooms have to be checked.
+	bool findCandidates(const std::shared_ptr<const Address> &localAddress,
+	                    const std::shared_ptr<const Address> &peerAddress,
+	                    const std::list<std::shared_ptr<Address>> &participants,
+	                    std::vector<std::shared_ptr<AbstractChatRoom>> &candidates) const;
+
+	static std::string getKey(const Address &address);
+
+private:
+	using Bucket = std::unordered_set<const AbstractChatRoom *>;
+	using Buckets = std::unordered_map<std::string, Bucket>;
+
+	struct Entry {
+		std::weak_ptr<AbstractChatRoom> chatRoom;
+		std::string localKey;
+		std::string peerKey;
+		std::vector<std::string> participantKeys;
+	};
+
+	void indexParticipants(Entry &entry, const std::shared_ptr<AbstractChatRoom> &chatRoom);
+	void unindexParticipants(Entry &entry, const AbstractChatRoom *chatRoom);
+
+	static void add(Buckets &buckets, const std::string &key, const AbstractChatRoom *chatRoom);
+	static void remove(Buckets &buckets, const std::string &key, const AbstractChatRoom *chatRoom);
+	static const Bucket *find(const Buckets &buckets, const std::shared_ptr<const Address> &address, bool &usable);
+
+	std::unordered_map<const AbstractChatRoom *, Entry> mEntries;
+	Buckets mByLocalAddress;
+	Buckets mByPeerAddress;
+	Buckets mByParticipant;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_CHAT_ROOM_INDEX_H_
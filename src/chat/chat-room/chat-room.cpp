@@ -916,6 +916,7 @@ void ChatRoom::setIsMuted(const bool muted) {
 	if (muted != d->isMuted) {
 		d->setIsMuted(muted);
 		getCore()->getPrivate()->mainDb->updateChatRoomMutedState(getConferenceId(), muted);
+		getCore()->getPrivate()->invalidateUnreadChatMessageCount(getConferenceId());
 	}
 }
 
@@ -200,6 +200,7 @@ void ClientGroupChatRoomPrivate::confirmJoining(SalCallOp *op) {
 				q->getConference()->participants.push_back(participant);
 			}
 		}
+		q->getConference()->updateChatRoomIndex(q->getConferenceId());
 	}
 
 	acceptSession(session);
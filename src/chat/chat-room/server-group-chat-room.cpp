@@ -126,6 +126,7 @@ shared_ptr<Participant> ServerGroupChatRoomPrivate::addParticipant(const std::sh
 	 * removed previously OR a totally new participant. */
 	if (q->findParticipant(addr) == nullptr) {
 		q->getConference()->participants.push_back(participant);
+		q->getConference()->updateChatRoomIndex(q->getConferenceId());
 		shared_ptr<ConferenceParticipantEvent> event =
 		    q->getConference()->notifyParticipantAdded(time(nullptr), false, participant);
 		q->getCore()->getPrivate()->mainDb->addEvent(event);
@@ -1819,6 +1820,7 @@ void ServerGroupChatRoom::setState(ConferenceInterface::State state) {
 				}
 			}
 		}
+		getConference()->updateChatRoomIndex(getConferenceId());
 		d->updateParticipantsSessions();
 		// Subscribe to the registration events from the proxy
 		d->subscribeRegistrationForParticipants(participantAddresses, false);
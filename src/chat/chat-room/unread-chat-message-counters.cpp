@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unread-chat-message-counters.h"
+
+#include "address/address.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+void UnreadChatMessageCounters::invalidate(const ConferenceId &conferenceId) {
+	mInvalidated.insert(conferenceId);
+}
+
+vector<ConferenceId> UnreadChatMessageCounters::takeInvalidated() {
+	vector<ConferenceId> conferenceIds(mInvalidated.begin(), mInvalidated.end());
+	mInvalidated.clear();
+	return conferenceIds;
+}
+
+void UnreadChatMessageCounters::set(const ConferenceId &conferenceId,
+                                    const shared_ptr<const Address> &localAddress,
+                                    int count) {
+	string localKey = getKey(*localAddress);
+	auto it = mRooms.find(conferenceId);
+	if (it != mRooms.end() && it->second.localKey == localKey) {
+		add(localKey, count - it->second.count);
+		it->second.count = count;
+		return;
+	}
+	if (it != mRooms.end()) {
+		add(it->second.localKey, -it->second.count);
+		release(it->second.localKey);
+		it->second.localKey = localKey;
+		it->second.count = count;
+	} else {
+		mRooms[conferenceId] = Room{localKey, count};
+	}
+	Local &local = mLocals[localKey];
+	if (!local.address) local.address = localAddress;
+	local.nbChatRooms++;
+	add(localKey, count);
+}
+
+void UnreadChatMessageCounters::remove(const ConferenceId &conferenceId) {
+	mInvalidated.erase(conferenceId);
+	auto it = mRooms.find(conferenceId);
+	if (it == mRooms.end()) return;
+	add(it->second.localKey, -it->second.count);
+	release(it->second.localKey);
+	mRooms.erase(it);
+}
+
+void UnreadChatMessageCounters::clear() {
+	for (auto it = mLocals.begin(); it != mLocals.end();) {
+		if (it->second.count != 0) mChanged.insert(it->first);
+		it->second.count = 0;
+		it->second.nbChatRooms = 0;
+		if (mChanged.find(it->first) == mChanged.end()) it = mLocals.erase(it);
+		else ++it;
+	}
+	mRooms.clear();
+	mInvalidated.clear();
+}
+
+int UnreadChatMessageCounters::get(const Address &localAddress) const {
+	auto it = mLocals.find(getKey(localAddress));
+	return it == mLocals.end() ? 0 : it->second.count;
+}
+
+vector<pair<shared_ptr<const Address>, int>> UnreadChatMessageCounters::takeChanges() {
+	vector<pair<shared_ptr<const Address>, int>> changes;
+	for (const auto &localKey : mChanged) {
+		auto it = mLocals.find(localKey);
+		if (it == mLocals.end()) continue;
+		changes.emplace_back(it->second.address, it->second.count);
+		// Forget the local addresses without chat rooms once their last change is reported.
+		if (it->second.nbChatRooms == 0) mLocals.erase(it);
+	}
+	mChanged.clear();
+	return changes;
+}
+
+string UnreadChatMessageCounters::getKey(const Address &address) {
+	const char *username = address.getUsernameCstr();
+	const char *domain = address.getDomainCstr();
+	string key;
+	if (username) {
+		key.append(username);
+		key.push_back('@');
+	}
+	if (domain) key.append(domain);
+	key.push_back(':');
+	key.append(to_string(address.getPort()));
+	return key;
+}
+
+void UnreadChatMessageCounters::add(const string &localKey, int count) {
+	if (count == 0) return;
+	mLocals[localKey].count += count;
+	mChanged.insert(localKey);
+}
+
+void UnreadChatMessageCounters::release(const string &localKey) {
+	auto it = mLocals.find(localKey);
+	if (it == mLocals.end() || --it->second.nbChatRooms > 0) return;
+	// Otherwise it is forgotten once its last change is reported.
+	if (mChanged.find(localKey) == mChanged.end()) mLocals.erase(it);
+}
+
+LINPHONE_END_NAMESPACE
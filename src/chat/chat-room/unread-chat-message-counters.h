@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_UNREAD_CHAT_MESSAGE_COUNTERS_H_
+#define _L_UNREAD_CHAT_MESSAGE_COUNTERS_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "conference/conference-id.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class Address;
+
+/*
+ * Unread chat message totals of the chat rooms of a core, by local address. The chat rooms whose count or mute state
+ * may have changed are invalidated, and their count is read again by the core on the next update: the totals are
+ * then adjusted by difference, without scanning all the chat rooms.
+ * Local addresses are keyed on their username, domain and port, like Address::weakEqual().
+ */
+class UnreadChatMessageCounters {
+public:
+	void invalidate(const ConferenceId &conferenceId);
+	bool hasInvalidated() const {
+		return !mInvalidated.empty();
+	}
+	std::vector<ConferenceId> takeInvalidated();
+
+	// Sets the number of unread messages of a chat room, 0 if it is muted.
+	void set(const ConferenceId &conferenceId, const std::shared_ptr<const Address> &localAddress, int count);
+	void remove(const ConferenceId &conferenceId);
+	void clear();
+
+	int get(const Address &localAddress) const;
+
+	// The local addresses whose total changed since the last call, with their new total.
+	std::vector<std::pair<std::shared_ptr<const Address>, int>> takeChanges();
+
+	static std::string getKey(const Address &address);
+
+private:
+	struct Room {
+		std::string localKey;
+		int count = 0;
+	};
+
+	struct Local {
+		std::shared_ptr<const Address> address;
+		int count = 0;
+		int nbChatRooms = 0;
+	};
+
+	void add(const std::string &localKey, int count);
+	void release(const std::string &localKey);
+
+	std::unordered_map<ConferenceId, Room> mRooms;
+	std::unordered_map<std::string, Local> mLocals;
+	std::unordered_set<ConferenceId> mInvalidated;
+	std::unordered_set<std::string> mChanged;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_UNREAD_CHAT_MESSAGE_COUNTERS_H_
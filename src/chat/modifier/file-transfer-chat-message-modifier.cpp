@@ -289,7 +289,7 @@ FileTransferChatMessageModifier::prepare_upload_body_handler(shared_ptr<ChatMess
 	} else if (!currentFileContentToTransfer->isEmpty()) {
 		size_t buf_size = currentFileContentToTransfer->getSize();
 		uint8_t *buf = (uint8_t *)ms_malloc(buf_size);
-		memcpy(buf, currentFileContentToTransfer->getBody().data(), buf_size);
+		memcpy(buf, currentFileContentToTransfer->getBodyBuffer().data(), buf_size);
 
 		imee = message->getCore()->getEncryptionEngine();
 		if (imee) {
@@ -589,7 +589,7 @@ ChatMessageModifier::Result FileTransferChatMessageModifier::decode(const shared
 	if (internalContent.getContentType() == ContentType::FileTransfer) {
 		auto fileTransferContent = FileTransferContent::create<FileTransferContent>();
 		fileTransferContent->setContentType(internalContent.getContentType());
-		fileTransferContent->setBody(internalContent.getBody());
+		fileTransferContent->setBody(internalContent.getBodyBuffer());
 		string xml_body = fileTransferContent->getBodyAsUtf8String();
 		parseFileTransferXmlIntoContent(xml_body.c_str(), fileTransferContent);
 		message->addContent(fileTransferContent);
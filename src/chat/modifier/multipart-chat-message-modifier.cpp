@@ -60,7 +60,7 @@ ChatMessageModifier::Result MultipartChatMessageModifier::decode(const shared_pt
 				for (const Header &header : c.getHeaders()) {
 					content->addHeader(header);
 				}
-				content->setBody(c.getBody());
+				content->setBody(c.getBodyBuffer());
 			} else {
 				content = Content::create(c);
 			}
@@ -48,6 +48,7 @@ ConferenceScheduler::ConferenceScheduler(const shared_ptr<Core> &core) : CoreAcc
 }
 
 ConferenceScheduler::~ConferenceScheduler() {
+	stopInvitationsTimer();
 	if (mSession != nullptr) {
 		mSession->setListener(nullptr);
 	}
@@ -81,6 +82,14 @@ void ConferenceScheduler::setState(State newState) {
 	}
 }
 
+unsigned int ConferenceScheduler::getNbIcsBodiesRendered() const {
+	return mNbIcsBodiesRendered;
+}
+
+unsigned int ConferenceScheduler::getNbConferenceInfoStored() const {
+	return mNbConferenceInfoStored;
+}
+
 const std::shared_ptr<ConferenceInfo> ConferenceScheduler::getInfo() const {
 	return mConferenceInfo;
 }
@@ -260,10 +269,7 @@ void ConferenceScheduler::setInfo(const std::shared_ptr<ConferenceInfo> &info) {
 
 	if (getState() != State::Error) {
 		// Update conference info in database with updated conference information
-#ifdef HAVE_DB_STORAGE
-		auto &mainDb = getCore()->getPrivate()->mainDb;
-		mainDb->insertConferenceInfo(mConferenceInfo);
-#endif // HAVE_DB_STORAGE
+		storeConferenceInfo();
 	}
 }
 
@@ -314,11 +320,7 @@ void ConferenceScheduler::onChatMessageStateChanged(const shared_ptr<ChatMessage
 		return;
 	}
 
-	if (mInvitationsSent + mInvitationsInError.size() == mInvitationsToSend.size()) {
-		ListHolder<Address> erroredInvitations;
-		erroredInvitations.mList = mInvitationsInError;
-		linphone_conference_scheduler_notify_invitations_sent(toC(), erroredInvitations.getCList());
-	}
+	notifyInvitationsSentIfDone();
 }
 
 void ConferenceScheduler::setConferenceAddress(const std::shared_ptr<Address> &conferenceAddress) {
@@ -413,10 +415,7 @@ void ConferenceScheduler::onCallSessionStateChanged(const shared_ptr<CallSession
 	}
 }
 
-shared_ptr<ChatMessage> ConferenceScheduler::createInvitationChatMessage(shared_ptr<AbstractChatRoom> chatRoom,
-                                                                         const std::shared_ptr<Address> participant,
-                                                                         bool cancel) {
-	shared_ptr<LinphonePrivate::ChatMessage> message;
+int ConferenceScheduler::getInvitationSequence(const std::shared_ptr<Address> &participant) const {
 	int sequence = -1;
 	if (participant && participant->isValid()) {
 		const auto cancelParticipant =
@@ -431,24 +430,42 @@ shared_ptr<ChatMessage> ConferenceScheduler::createInvitationChatMessage(shared_
 			sequence = (*cancelParticipant).second;
 		}
 	}
+	return sequence;
+}
+
+const std::string *ConferenceScheduler::getInvitationBody(bool cancel, int sequence) {
+	auto it = mInvitationBodies.find(make_pair(cancel, sequence));
+	if (it == mInvitationBodies.end()) {
+		it = mInvitationBodies.emplace(make_pair(cancel, sequence), mConferenceInfo->toIcsString(cancel, sequence))
+		         .first;
+		mNbIcsBodiesRendered++;
+	}
+	return &it->second;
+}
+
+shared_ptr<ChatMessage> ConferenceScheduler::createInvitationChatMessage(shared_ptr<AbstractChatRoom> chatRoom,
+                                                                         const std::string &body) {
+	shared_ptr<LinphonePrivate::ChatMessage> message;
 	if (linphone_core_conference_ics_in_message_body_enabled(chatRoom->getCore()->getCCore())) {
-		message = chatRoom->createChatMessageFromUtf8(mConferenceInfo->toIcsString(cancel, sequence));
+		message = chatRoom->createChatMessageFromUtf8(body);
 		message->getPrivate()->setContentType(ContentType::Icalendar);
 	} else {
 		auto content = FileContent::create<FileContent>(); // content will be deleted by ChatMessage
 		content->setContentType(ContentType::Icalendar);
 		content->setFileName("conference.ics");
-		content->setBodyFromUtf8(mConferenceInfo->toIcsString(cancel, sequence));
+		content->setBodyFromUtf8(body);
 		message = chatRoom->createFileTransferMessage(content);
 	}
+	message->addListener(getSharedFromThis());
+	return message;
+}
 
-	// Update conference info in database with new sequence and uid
+void ConferenceScheduler::storeConferenceInfo() {
 #ifdef HAVE_DB_STORAGE
 	auto &mainDb = getCore()->getPrivate()->mainDb;
 	mainDb->insertConferenceInfo(mConferenceInfo);
+	mNbConferenceInfoStored++;
 #endif // HAVE_DB_STORAGE
-	message->addListener(getSharedFromThis());
-	return message;
 }
 
 void ConferenceScheduler::sendInvitations(shared_ptr<ChatRoomParams> chatRoomParams) {
@@ -520,7 +537,14 @@ void ConferenceScheduler::sendInvitations(shared_ptr<ChatRoomParams> chatRoomPar
 #pragma GCC diagnostic pop
 #endif //  __GNUC__ == 7
 
+	// Abort the dispatch of the previous invitations, if still in progress.
+	stopInvitationsTimer();
+	mPendingInvitations.clear();
+	mInvitationBodies.clear();
+
 	mInvitationsToSend.clear();
+	// Sequence numbers of the invitations, as the lookup in the participants of a large conference is costly.
+	std::map<std::shared_ptr<Address>, int> sequences;
 	for (auto participant : invitees) {
 		if (!sender->weakEqual(*participant)) {
 			mInvitationsToSend.push_back(participant);
@@ -549,6 +573,12 @@ void ConferenceScheduler::sendInvitations(shared_ptr<ChatRoomParams> chatRoomPar
 			const auto newSequence = (sequence < 0) ? 0 : sequence + 1;
 			newParticipantInfo->setSequenceNumber(newSequence);
 			mConferenceInfo->updateParticipant(newParticipantInfo);
+			sequences[participant] = newSequence;
+		}
+
+		const auto cancelParticipant = mCancelToSend.find(participant);
+		if (cancelParticipant != mCancelToSend.cend()) {
+			sequences[participant] = cancelParticipant->second;
 		}
 	}
 
@@ -581,25 +611,68 @@ void ConferenceScheduler::sendInvitations(shared_ptr<ChatRoomParams> chatRoomPar
 
 	mInvitationsInError.clear();
 	mInvitationsSent = 0;
+	mInvitationsSentNotified = false;
+
+	// Participants sharing the same sequence number get the same ICS: render it once for all of them.
+	for (const auto &participant : mInvitationsToSend) {
+		const bool cancel = (mCancelToSend.find(participant) != mCancelToSend.cend()) ||
+		                    (mConferenceInfo->getState() == ConferenceInfo::State::Cancelled);
+		const auto sequence = sequences.find(participant);
+		const int invitationSequence =
+		    (sequence == sequences.cend()) ? getInvitationSequence(participant) : sequence->second;
+		mPendingInvitations.push_back({participant, getInvitationBody(cancel, invitationSequence)});
+	}
+	// Update conference info in database with new sequence and uid, assigned when the ICS is rendered.
+	storeConferenceInfo();
+
+	mInvitationsChatRoomParams = chatRoomParams;
+	mInvitationsSender = sender;
+	LinphoneConfig *config = linphone_core_get_config(getCore()->getCCore());
+	mInvitationsBatchSize =
+	    (size_t)std::max(1, linphone_config_get_int(config, "misc", "conference_invitations_batch_size", 50));
+	int interval = std::max(0, linphone_config_get_int(config, "misc", "conference_invitations_batch_interval", 100));
+
+	sendNextInvitations();
+	if (!mPendingInvitations.empty()) {
+		lInfo() << "[Conference Scheduler] [" << this << "] Sending " << mPendingInvitations.size()
+		        << " remaining invitations by chunks of " << mInvitationsBatchSize << " every " << interval << " ms";
+		mInvitationsTimer = getCore()->createTimer(
+		    [this]() {
+			    // Keep the scheduler alive, the callbacks may release it.
+			    auto ref = getSharedFromThis();
+			    sendNextInvitations();
+			    return !mPendingInvitations.empty();
+		    },
+		    (unsigned int)interval, "Conference invitations");
+	}
+}
 
+void ConferenceScheduler::sendNextInvitations() {
 	// Sending the ICS once for each participant in a separated chat room each time.
-	for (auto participant : mInvitationsToSend) {
+	for (size_t count = 0; (count < mInvitationsBatchSize) && !mPendingInvitations.empty(); count++) {
+		const auto invitation = mPendingInvitations.front();
+		mPendingInvitations.pop_front();
+		const auto &participant = invitation.address;
+		const auto &sender = mInvitationsSender;
+
 		list<std::shared_ptr<Address>> chatRoomParticipantList;
 		chatRoomParticipantList.push_back(participant);
 		list<std::shared_ptr<Address>> participantList;
 		std::shared_ptr<Address> remoteAddress = nullptr;
-		if (chatRoomParams->getChatRoomBackend() == LinphonePrivate::ChatRoomParams::ChatRoomBackend::FlexisipChat) {
+		if (mInvitationsChatRoomParams->getChatRoomBackend() ==
+		    LinphonePrivate::ChatRoomParams::ChatRoomBackend::FlexisipChat) {
 			participantList.push_back(participant);
 		} else {
 			remoteAddress = participant;
 		}
 		shared_ptr<AbstractChatRoom> chatRoom =
-		    getCore()->getPrivate()->searchChatRoom(chatRoomParams, sender, remoteAddress, participantList);
+		    getCore()->getPrivate()->searchChatRoom(mInvitationsChatRoomParams, sender, remoteAddress, participantList);
 
 		if (!chatRoom) {
 			lInfo() << "[Conference Scheduler] [" << this << "] Existing chat room between [" << *sender << "] and ["
 			        << *participant << "] wasn't found, creating it.";
-			chatRoom = getCore()->getPrivate()->createChatRoom(chatRoomParams, sender, chatRoomParticipantList);
+			chatRoom =
+			    getCore()->getPrivate()->createChatRoom(mInvitationsChatRoomParams, sender, chatRoomParticipantList);
 		} else {
 			lInfo() << "[Conference Scheduler] [" << this << "] Found existing chat room ["
 			        << *chatRoom->getPeerAddress() << "] between [" << *sender << "] and [" << *participant
@@ -613,13 +686,39 @@ void ConferenceScheduler::sendInvitations(shared_ptr<ChatRoomParams> chatRoomPar
 			continue;
 		}
 
-		const bool cancel = (mCancelToSend.find(participant) != mCancelToSend.cend()) ||
-		                    (mConferenceInfo->getState() == ConferenceInfo::State::Cancelled);
-
-		shared_ptr<ChatMessage> message = createInvitationChatMessage(chatRoom, participant, cancel);
+		shared_ptr<ChatMessage> message = createInvitationChatMessage(chatRoom, *invitation.body);
 		message->getPrivate()->setRecipientAddress(participant);
 		message->send();
 	}
+
+	const auto total = mInvitationsToSend.size();
+	if (total > 0) {
+		linphone_conference_scheduler_notify_invitations_progress(toC(), (int)(total - mPendingInvitations.size()),
+		                                                          (int)total);
+	}
+	if (mPendingInvitations.empty()) {
+		mInvitationBodies.clear();
+		notifyInvitationsSentIfDone();
+	}
+}
+
+void ConferenceScheduler::stopInvitationsTimer() {
+	if (mInvitationsTimer) {
+		// Not through the core: the scheduler may be destroyed after it.
+		belle_sip_source_cancel(mInvitationsTimer);
+		belle_sip_object_unref(mInvitationsTimer);
+		mInvitationsTimer = nullptr;
+	}
+}
+
+void ConferenceScheduler::notifyInvitationsSentIfDone() {
+	if (mInvitationsSentNotified || mInvitationsToSend.empty() || !mPendingInvitations.empty() ||
+	    (mInvitationsSent + mInvitationsInError.size() < mInvitationsToSend.size()))
+		return;
+	mInvitationsSentNotified = true;
+	ListHolder<Address> erroredInvitations;
+	erroredInvitations.mList = mInvitationsInError;
+	linphone_conference_scheduler_notify_invitations_sent(toC(), erroredInvitations.getCList());
 }
 
 string ConferenceScheduler::stateToString(ConferenceScheduler::State state) {
@@ -670,4 +769,12 @@ void ConferenceSchedulerCbs::setInvitationsSent(LinphoneConferenceSchedulerCbsIn
 	mInvitationsSent = cb;
 }
 
+LinphoneConferenceSchedulerCbsInvitationsProgressCb ConferenceSchedulerCbs::getInvitationsProgress() const {
+	return mInvitationsProgress;
+}
+
+void ConferenceSchedulerCbs::setInvitationsProgress(LinphoneConferenceSchedulerCbsInvitationsProgressCb cb) {
+	mInvitationsProgress = cb;
+}
+
 LINPHONE_END_NAMESPACE
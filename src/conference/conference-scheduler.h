@@ -34,6 +34,8 @@
 
 // =============================================================================
 
+typedef struct belle_sip_source belle_sip_source_t;
+
 LINPHONE_BEGIN_NAMESPACE
 
 class ConferenceSchedulerCbs;
@@ -71,19 +73,37 @@ public:
 
 	void setConferenceAddress(const std::shared_ptr<Address> &conferenceAddress);
 
+	/*
+	 * Sends the invitations in chunks of [misc] "conference_invitations_batch_size" (50 by default), one chunk
+	 * every "conference_invitations_batch_interval" ms (100 by default). The first chunk is sent right away.
+	 */
 	void sendInvitations(std::shared_ptr<ChatRoomParams> chatRoomParams);
 
 	const std::shared_ptr<Account> &getAccount() const;
 	void setAccount(std::shared_ptr<Account> account);
 
+	// For testing purposes.
+	unsigned int getNbIcsBodiesRendered() const;
+	unsigned int getNbConferenceInfoStored() const;
+
 private:
+	struct Invitation {
+		std::shared_ptr<Address> address;
+		const std::string *body; // Points into mInvitationBodies.
+	};
+
 	void setState(State newState);
 	std::string stateToString(State state);
 
 	std::shared_ptr<Address> createParticipantAddress(const ConferenceInfo::participant_list_t::value_type &p) const;
+	int getInvitationSequence(const std::shared_ptr<Address> &participant) const;
+	const std::string *getInvitationBody(bool cancel, int sequence);
 	std::shared_ptr<ChatMessage> createInvitationChatMessage(std::shared_ptr<AbstractChatRoom> chatRoom,
-	                                                         const std::shared_ptr<Address> participant,
-	                                                         bool cancel);
+	                                                         const std::string &body);
+	void storeConferenceInfo();
+	void sendNextInvitations();
+	void stopInvitationsTimer();
+	void notifyInvitationsSentIfDone();
 	void fillCancelList(const ConferenceInfo::participant_list_t &oldList,
 	                    const ConferenceInfo::participant_list_t &newList);
 
@@ -96,6 +116,17 @@ private:
 	std::list<std::shared_ptr<Address>> mInvitationsToSend;
 	std::map<std::shared_ptr<Address>, int> mCancelToSend;
 	std::list<std::shared_ptr<Address>> mInvitationsInError;
+
+	std::list<Invitation> mPendingInvitations;
+	// ICS bodies of the invitations being sent, by cancel flag and sequence number.
+	std::map<std::pair<bool, int>, std::string> mInvitationBodies;
+	std::shared_ptr<ChatRoomParams> mInvitationsChatRoomParams;
+	std::shared_ptr<Address> mInvitationsSender;
+	belle_sip_source_t *mInvitationsTimer = nullptr;
+	size_t mInvitationsBatchSize = 50;
+	bool mInvitationsSentNotified = false;
+	unsigned int mNbIcsBodiesRendered = 0;
+	unsigned int mNbConferenceInfoStored = 0;
 };
 
 class ConferenceSchedulerCbs : public bellesip::HybridObject<LinphoneConferenceSchedulerCbs, ConferenceSchedulerCbs>,
@@ -105,10 +136,13 @@ public:
 	void setStateChanged(LinphoneConferenceSchedulerCbsStateChangedCb cb);
 	LinphoneConferenceSchedulerCbsInvitationsSentCb getInvitationsSent() const;
 	void setInvitationsSent(LinphoneConferenceSchedulerCbsInvitationsSentCb cb);
+	LinphoneConferenceSchedulerCbsInvitationsProgressCb getInvitationsProgress() const;
+	void setInvitationsProgress(LinphoneConferenceSchedulerCbsInvitationsProgressCb cb);
 
 private:
 	LinphoneConferenceSchedulerCbsStateChangedCb mStateChangedCb = nullptr;
 	LinphoneConferenceSchedulerCbsInvitationsSentCb mInvitationsSent = nullptr;
+	LinphoneConferenceSchedulerCbsInvitationsProgressCb mInvitationsProgress = nullptr;
 };
 
 std::ostream &operator<<(std::ostream &lhs, ConferenceScheduler::State s);
@@ -82,6 +82,7 @@ shared_ptr<Participant> Conference::getActiveParticipant() const {
 void Conference::clearParticipants() {
 	me->clearDevices();
 	participants.clear();
+	updateChatRoomIndex(conferenceId);
 }
 
 // -----------------------------------------------------------------------------
@@ -111,6 +112,7 @@ bool Conference::addParticipant(const std::shared_ptr<Address> &participantAddre
 	participant->setPreserveSession(false);
 	participants.push_back(participant);
 	if (!activeParticipant) activeParticipant = participant;
+	updateChatRoomIndex(conferenceId);
 	return true;
 }
 
@@ -263,6 +265,7 @@ bool Conference::removeParticipant(const shared_ptr<Participant> &participant) {
 	for (const auto &p : participants) {
 		if (*participant->getAddress() == *p->getAddress()) {
 			participants.remove(p);
+			updateChatRoomIndex(conferenceId);
 			return true;
 		}
 	}
@@ -484,13 +487,22 @@ void Conference::setLastNotify(unsigned int lastNotify) {
 }
 
 void Conference::setConferenceId(const ConferenceId &conferenceId) {
+	const ConferenceId oldConferenceId = this->conferenceId;
 	this->conferenceId = conferenceId;
+	updateChatRoomIndex(oldConferenceId);
 }
 
 const ConferenceId &Conference::getConferenceId() const {
 	return conferenceId;
 }
 
+void Conference::updateChatRoomIndex(const ConferenceId &conferenceId) const {
+	try {
+		getCore()->getPrivate()->updateChatRoomIndex(conferenceId);
+	} catch (const bad_weak_ptr &) {
+	}
+}
+
 void Conference::resetLastNotify() {
 	setLastNotify(0);
 }
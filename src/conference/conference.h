@@ -164,6 +164,8 @@ public:
 	}
 
 	const ConferenceId &getConferenceId() const override;
+	// Keeps the chat room index of the core up to date, after a change of the participants or of the conference ID.
+	void updateChatRoomIndex(const ConferenceId &conferenceId) const;
 	inline unsigned int getLastNotify() const {
 		return lastNotify;
 	};
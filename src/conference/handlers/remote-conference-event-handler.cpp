@@ -605,6 +605,8 @@ void RemoteConferenceEventHandler::conferenceInfoNotifyReceived(const string &xm
 		}
 	}
 
+	conf->updateChatRoomIndex(conf->getConferenceId());
+
 	if (isFullState) {
 		auto currentParticipants = conf->getParticipants();
 		auto currentMeDevices = conf->getMe()->getDevices();
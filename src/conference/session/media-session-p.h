@@ -197,6 +197,8 @@ public:
 	void validateVideoStreamDirection(SalStreamConfiguration &cfg) const;
 	bool mandatoryRtpBundleEnabled() const;
 	const std::string &getMediaLocalIp() const;
+	// Resolved on first use, then shared by the alert monitors of all the streams of the call.
+	const std::shared_ptr<const AlertSettings> &getAlertSettings();
 
 private:
 	/* IceServiceListener methods:*/
@@ -248,7 +250,8 @@ private:
 	                                     PayloadTypeHandler &pth,
 	                                     const std::list<LinphoneMediaEncryption> &encs,
 	                                     SalStreamType type,
-	                                     const std::string &mid);
+	                                     const std::string &mid,
+	                                     const SalMediaDescription::StreamIndex *oldMdIndex = nullptr);
 	void addConferenceLocalParticipantStreams(bool add,
 	                                          std::shared_ptr<SalMediaDescription> &md,
 	                                          const std::shared_ptr<SalMediaDescription> &oldMd,
@@ -364,6 +367,7 @@ private:
 	mutable LinphoneMediaEncryption negotiatedEncryption = LinphoneMediaEncryptionNone;
 
 	std::shared_ptr<NatPolicy> natPolicy = nullptr;
+	std::shared_ptr<const AlertSettings> alertSettings;
 	std::unique_ptr<StunClient> stunClient;
 
 	std::queue<std::function<LinphoneStatus()>> iceDeferedGatheringTasks;
@@ -1357,6 +1357,12 @@ const std::string &MediaSessionPrivate::getMediaLocalIp() const {
 	return mediaLocalIp;
 }
 
+const shared_ptr<const AlertSettings> &MediaSessionPrivate::getAlertSettings() {
+	L_Q();
+	if (!alertSettings) alertSettings = make_shared<const AlertSettings>(q->getCore()->getCCore());
+	return alertSettings;
+}
+
 int MediaSessionPrivate::portFromStreamIndex(int index) {
 	if (index != -1) {
 		auto stream = getStreamsGroup().getStream(index);
@@ -1599,7 +1605,8 @@ void MediaSessionPrivate::fillConferenceParticipantStream(SalStreamDescription &
                                                           PayloadTypeHandler &pth,
                                                           const std::list<LinphoneMediaEncryption> &encs,
                                                           SalStreamType type,
-                                                          const std::string &mid) {
+                                                          const std::string &mid,
+                                                          const SalMediaDescription::StreamIndex *oldMdIndex) {
 	L_Q();
 
 	// Declare here an empty list to give to the makeCodecsList if there is no valid already assigned payloads
@@ -1615,8 +1622,14 @@ void MediaSessionPrivate::fillConferenceParticipantStream(SalStreamDescription &
 	bool success = false;
 	if (dev) {
 		const auto &label = dev->getLabel(sal_stream_type_to_linphone(type));
+		const auto previousParticipantStreamIdx =
+		    !oldMd ? -1
+		           : (oldMdIndex ? oldMdIndex->findIdxStreamWithLabel(type, label)
+		                         : oldMd->findIdxStreamWithLabel(type, label));
 		const auto &previousParticipantStream =
-		    oldMd ? oldMd->findStreamWithLabel(type, label) : Utils::getEmptyConstRefObject<SalStreamDescription>();
+		    (previousParticipantStreamIdx >= 0)
+		        ? oldMd->getStreamIdx(static_cast<unsigned int>(previousParticipantStreamIdx))
+		        : Utils::getEmptyConstRefObject<SalStreamDescription>();
 		const auto alreadyAssignedPayloads =
 		    ((previousParticipantStream != Utils::getEmptyConstRefObject<SalStreamDescription>())
 		         ? previousParticipantStream.already_assigned_payloads
@@ -1848,7 +1861,7 @@ SalStreamDescription &MediaSessionPrivate::addStreamToMd(std::shared_ptr<SalMedi
 	for (size_t mdStreamIdx = 0; mdStreamIdx < currentMdSize; mdStreamIdx++) {
 		const auto &protectedIdx = (std::find(protectedStreamNumbers.cbegin(), protectedStreamNumbers.cend(),
 		                                      mdStreamIdx) != protectedStreamNumbers.cend());
-		auto stream = md->getStreamIdx(static_cast<unsigned int>(mdStreamIdx));
+		const auto &stream = md->getStreamIdx(static_cast<unsigned int>(mdStreamIdx));
 		if (!protectedIdx && (stream.getDirection() == SalStreamInactive)) {
 			freeSlot = static_cast<int>(mdStreamIdx);
 			break;
@@ -1875,7 +1888,7 @@ SalStreamDescription &MediaSessionPrivate::addStreamToMd(std::shared_ptr<SalMedi
 					const auto &protectedIdx =
 					    (std::find(protectedStreamNumbersOldMd.cbegin(), protectedStreamNumbersOldMd.cend(),
 					               mdStreamIdx) != protectedStreamNumbersOldMd.cend());
-					auto oldStream = oldMd->getStreamIdx(static_cast<unsigned int>(mdStreamIdx));
+					const auto &oldStream = oldMd->getStreamIdx(static_cast<unsigned int>(mdStreamIdx));
 					if (conference && !protectedIdx && (oldStream.getLabel() == stream.getLabel())) {
 						idxOldMd = static_cast<int>(mdStreamIdx);
 						break;
@@ -2058,6 +2071,8 @@ void MediaSessionPrivate::addConferenceParticipantStreams(std::shared_ptr<SalMed
 				    MediaSessionPrivate::EncryptedActiveSpeakerVideoContentAttribute);
 				const std::string bundleNameStreamPrefix((type == SalVideo) ? "vs" : "as");
 				const std::string bundleNameHDStreamPrefix("vsHD");
+				// One lookup per participant device: index the previous media description once.
+				const auto oldMdIndex = oldMd ? oldMd->buildStreamIndex() : SalMediaDescription::StreamIndex();
 
 				for (const auto &p : conference->getParticipants()) {
 					for (const auto &dev : p->getDevices()) {
@@ -2074,13 +2089,14 @@ void MediaSessionPrivate::addConferenceParticipantStreams(std::shared_ptr<SalMed
 							const auto &devLabel = dev->getLabel(sal_stream_type_to_linphone(type));
 							// main stream has the same label as one of the minature streams
 							const auto &foundStreamIdx =
-							    devLabel.empty() ? -1 : oldMd->findIdxStreamWithContent(participantContent, devLabel);
+							    devLabel.empty() ? -1 : oldMdIndex.findIdxStreamWithContent(participantContent, devLabel);
 							SalStreamDescription &newParticipantStream = addStreamToMd(md, foundStreamIdx, oldMd);
 							if (isConferenceLayoutActiveSpeaker || (type == SalAudio)) {
 								newParticipantStream.setContent(participantContent);
 							}
 							const auto mid(bundleNameStreamPrefix + devLabel);
-							fillConferenceParticipantStream(newParticipantStream, oldMd, md, dev, pth, encs, type, mid);
+							fillConferenceParticipantStream(newParticipantStream, oldMd, md, dev, pth, encs, type, mid,
+							                                &oldMdIndex);
 						}
 					}
 				}
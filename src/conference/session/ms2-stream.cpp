@@ -468,7 +468,7 @@ void MS2Stream::fillPotentialCfgGraph(OfferAnswerContext &ctx) {
 					}
 				}
 			}
-			localMediaDesc->createPotentialConfigurationsForStream(streamIndex, false, false);
+			localMediaDesc->createPotentialConfigurationsForStream(streamIndex, false, false, &mPotentialCfgCache);
 		}
 	}
 }
@@ -1134,33 +1134,32 @@ bool MS2Stream::canIgnorePtimeChange(const OfferAnswerContext &params) {
 }
 
 void MS2Stream::startTimers() {
-	if (!mTimer) {
-		mTimer = getCore().createTimer(
-		    [this]() {
-			    handleEvents();
-			    return true;
-		    },
-		    sEventPollIntervalMs, "Stream event processing timer");
-	}
-	if (!mMonitorTimer) {
-		mMonitorTimer = getCore().createTimer(
-		    [this]() {
-			    runAlertMonitors();
-			    return true;
-		    },
-		    sMonitorRunIntervalMs, "Stream monitor check");
-	}
+	if (mInEventPump) return;
+	getCore().getPrivate()->getStreamEventPump().add(this);
+	mInEventPump = true;
 }
 
 void MS2Stream::stopTimers() {
-	if (mTimer) {
-		getCore().destroyTimer(mTimer);
-		mTimer = nullptr;
-	}
-	if (mMonitorTimer) {
-		getCore().destroyTimer(mMonitorTimer);
-		mMonitorTimer = nullptr;
+	if (!mInEventPump) return;
+	mInEventPump = false;
+	shared_ptr<Core> core;
+	try {
+		core = getMediaSession().getCore();
+	} catch (const bad_weak_ptr &) {
+		// The stream is destroyed after the core, whose pump is gone with it.
+		return;
 	}
+	StreamEventPump *pump = core->getPrivate()->findStreamEventPump();
+	if (pump) pump->remove(this);
+}
+
+void MS2Stream::pumpEvents() {
+	handleEvents();
+}
+
+void MS2Stream::pumpMonitors() {
+	runAlertMonitors();
+	updateMetrics();
 }
 
 bool MS2Stream::prepare() {
@@ -1317,6 +1316,7 @@ void MS2Stream::stop() {
 	updateStats();
 	handleEvents();
 	stopTimers();
+	removeMetrics();
 	media_stream_reclaim_sessions(getMediaStream(), &mSessions);
 	rtp_session_set_profile(mSessions.rtp_session, &av_profile);
 	Stream::stop();
@@ -1426,6 +1426,53 @@ void MS2Stream::runAlertMonitors() {
 	mNetworkMonitor.check(getStats(), false);
 }
 
+void MS2Stream::updateMetrics() {
+	const auto &registry = getCore().getPrivate()->metricsRegistry;
+	if (!registry) return;
+
+	if (!mMetrics) {
+		// The series are kept by the stream so that updating them does not need to look them up each time.
+		mMetrics = makeUnique<Metrics>();
+		mMetrics->labels = {{"call_id", getMediaSession().getLog()->getCallId()},
+		                    {"stream", sal_stream_type_to_string(getType())},
+		                    {"index", to_string(getIndex())}};
+		const auto &labels = mMetrics->labels;
+		mMetrics->jitter = registry->getGauge("linphone_stream_jitter_ms", "Receiver interarrival jitter.", labels);
+		mMetrics->senderLossRate = registry->getGauge("linphone_stream_sender_loss_rate_percent",
+		                                              "Loss rate reported by the remote end.", labels);
+		mMetrics->receiverLossRate = registry->getGauge("linphone_stream_receiver_loss_rate_percent",
+		                                                "Loss rate of the received stream.", labels);
+		mMetrics->roundTripDelay =
+		    registry->getGauge("linphone_stream_round_trip_delay_seconds", "Round trip delay, from RTCP.", labels);
+		mMetrics->qualityRating = registry->getGauge(
+		    "linphone_stream_quality_rating", "Mean opinion score estimate, from 0 (worst) to 5 (best).", labels);
+		mMetrics->downloadBandwidth =
+		    registry->getGauge("linphone_stream_download_bandwidth_kbps", "Download bandwidth.", labels);
+		mMetrics->uploadBandwidth =
+		    registry->getGauge("linphone_stream_upload_bandwidth_kbps", "Upload bandwidth.", labels);
+		mMetrics->jitterBufferSize =
+		    registry->getGauge("linphone_stream_jitter_buffer_size_ms", "Size of the jitter buffer.", labels);
+	}
+
+	// The stats have just been refreshed by the alert monitors.
+	mMetrics->jitter->set(linphone_call_stats_get_receiver_interarrival_jitter(mStats));
+	mMetrics->senderLossRate->set(linphone_call_stats_get_sender_loss_rate(mStats));
+	mMetrics->receiverLossRate->set(linphone_call_stats_get_receiver_loss_rate(mStats));
+	mMetrics->roundTripDelay->set(linphone_call_stats_get_round_trip_delay(mStats));
+	mMetrics->downloadBandwidth->set(linphone_call_stats_get_download_bandwidth(mStats));
+	mMetrics->uploadBandwidth->set(linphone_call_stats_get_upload_bandwidth(mStats));
+	mMetrics->jitterBufferSize->set(linphone_call_stats_get_jitter_buffer_size_ms(mStats));
+	float quality = getMediaStream() ? media_stream_get_quality_rating(getMediaStream()) : -1;
+	if (quality >= 0) mMetrics->qualityRating->set(quality);
+}
+
+void MS2Stream::removeMetrics() {
+	if (!mMetrics) return;
+	const auto &registry = getCore().getPrivate()->metricsRegistry;
+	if (registry) registry->removeSeries(mMetrics->labels);
+	mMetrics.reset();
+}
+
 void MS2Stream::handleEvents() {
 	MediaStream *ms = getMediaStream();
 	if (ms) {
@@ -1638,6 +1685,7 @@ float MS2Stream::getCpuUsage() const {
 }
 
 void MS2Stream::finish() {
+	stopTimers();
 	if (mRtpBundle && mOwnsBundle) {
 		rtp_bundle_delete(mRtpBundle);
 		mRtpBundle = nullptr;
@@ -23,6 +23,8 @@
 
 #include "alert/alert.h"
 #include "call/video-source/video-source-descriptor.h"
+#include "metrics/metrics-registry.h"
+#include "stream-event-pump.h"
 #include "streams.h"
 
 struct _MSAudioEndpoint;
@@ -36,7 +38,7 @@ class MS2VideoMixer;
 /**
  * Derived class for streams commonly handly through mediastreamer2 library.
  */
-class MS2Stream : public Stream, public RtpInterface {
+class MS2Stream : public Stream, public RtpInterface, public StreamEventPump::Client {
 public:
 	enum class ZrtpState { Off = 0, Started = 1, TurnedOff = 2, Restarted = 3 };
 
@@ -86,8 +88,9 @@ public:
 protected:
 	virtual void handleEvent(const OrtpEvent *ev) = 0;
 	virtual void zrtpStarted(Stream *mainZrtpStream) override;
-	virtual void runAlertMonitors(); // called from a timer each second.
+	virtual void runAlertMonitors(); // called by the core stream event pump each second.
 	MS2Stream(StreamsGroup &sm, const OfferAnswerContext &params);
+	// Register to, or unregister from, the stream event pump of the core.
 	void startTimers();
 	void stopTimers();
 	std::string getBindIp();
@@ -132,8 +135,12 @@ private:
 	RtpBundle *createOrGetRtpBundle(const SalStreamDescription &sd);
 	void removeFromBundle();
 	void notifyStatsUpdated();
+	virtual void pumpEvents() override;
+	virtual void pumpMonitors() override;
 	void handleEvents();
 	void updateStats();
+	void updateMetrics(); // called from the monitor sweep, when the core exports its metrics.
+	void removeMetrics();
 	void initMulticast(const OfferAnswerContext &params);
 	void configureRtpSession(RtpSession *session);
 	void configureRtpTransport(RtpSession *session);
@@ -152,19 +159,30 @@ private:
 	                     const std::string &attrValue);
 	bool encryptionFound(const SalStreamDescription::tcap_map_t &caps, const LinphoneMediaEncryption encEnum) const;
 	void startDtls();
-	belle_sip_source_t *mTimer = nullptr;
-	belle_sip_source_t *mMonitorTimer = nullptr;
+	struct Metrics {
+		MetricsRegistry::Labels labels;
+		std::shared_ptr<MetricsRegistry::Series> jitter;
+		std::shared_ptr<MetricsRegistry::Series> senderLossRate;
+		std::shared_ptr<MetricsRegistry::Series> receiverLossRate;
+		std::shared_ptr<MetricsRegistry::Series> roundTripDelay;
+		std::shared_ptr<MetricsRegistry::Series> qualityRating;
+		std::shared_ptr<MetricsRegistry::Series> downloadBandwidth;
+		std::shared_ptr<MetricsRegistry::Series> uploadBandwidth;
+		std::shared_ptr<MetricsRegistry::Series> jitterBufferSize;
+	};
+	std::unique_ptr<Metrics> mMetrics;
+	// Whether the stream is registered in the event pump of the core.
+	bool mInEventPump = false;
 	IceCheckList *mIceCheckList = nullptr;
 	RtpBundle *mRtpBundle = nullptr;
 	MS2Stream *mBundleOwner = nullptr;
 	ZrtpState mZrtpState = ZrtpState::Off;
 	std::string mSendMasterKey;
 	std::string mReceiveMasterKey;
+	SalMediaDescription::PotentialCfgCache mPotentialCfgCache;
 	bool mOwnsBundle = false;
 	bool mStunAllowed = true;
 	static OrtpJitterBufferAlgorithm jitterBufferNameToAlgo(const std::string &name);
-	static constexpr const int sEventPollIntervalMs = 20;
-	static constexpr const int sMonitorRunIntervalMs = 1000;
 };
 
 class BandwithControllerService : public SharedService {
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stream-event-pump.h"
+#include "core/core.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+StreamEventPump::StreamEventPump(Core &core, unsigned int eventIntervalMs, unsigned int monitorIntervalMs)
+    : mCore(core), mEventIntervalMs(eventIntervalMs), mMonitorIntervalMs(monitorIntervalMs) {
+}
+
+StreamEventPump::~StreamEventPump() {
+	stopTimers();
+}
+
+void StreamEventPump::add(Client *client) {
+	if (mIndexes.find(client) != mIndexes.end()) return;
+	mIndexes[client] = mClients.size();
+	mClients.push_back(client);
+	startTimers();
+}
+
+void StreamEventPump::remove(Client *client) {
+	auto it = mIndexes.find(client);
+	if (it == mIndexes.end()) return;
+	size_t index = it->second;
+	mIndexes.erase(it);
+	if (mDispatching > 0) {
+		mClients[index] = nullptr;
+		mNeedsCompaction = true;
+	} else {
+		if (index != mClients.size() - 1) {
+			mClients[index] = mClients.back();
+			mIndexes[mClients[index]] = index;
+		}
+		mClients.pop_back();
+	}
+	if (mIndexes.empty()) stopTimers();
+}
+
+bool StreamEventPump::contains(const Client *client) const {
+	return mIndexes.find(client) != mIndexes.end();
+}
+
+void StreamEventPump::dispatch(void (Client::*callback)()) {
+	mDispatching++;
+	// Clients added by a callback wait for the next tick.
+	size_t count = mClients.size();
+	for (size_t i = 0; i < count; i++) {
+		Client *client = mClients[i];
+		if (client) (client->*callback)();
+	}
+	mDispatching--;
+	if (mDispatching == 0 && mNeedsCompaction) compact();
+}
+
+void StreamEventPump::compact() {
+	size_t count = 0;
+	for (size_t i = 0; i < mClients.size(); i++) {
+		Client *client = mClients[i];
+		if (!client) continue;
+		mClients[count] = client;
+		mIndexes[client] = count;
+		count++;
+	}
+	mClients.resize(count);
+	mNeedsCompaction = false;
+}
+
+void StreamEventPump::startTimers() {
+	if (!mEventTimer) {
+		mEventTimer = mCore.createTimer(
+		    [this]() {
+			    dispatch(&Client::pumpEvents);
+			    return true;
+		    },
+		    mEventIntervalMs, "Stream event pump");
+	}
+	if (!mMonitorTimer) {
+		mMonitorTimer = mCore.createTimer(
+		    [this]() {
+			    dispatch(&Client::pumpMonitors);
+			    return true;
+		    },
+		    mMonitorIntervalMs, "Stream monitor sweep");
+	}
+}
+
+void StreamEventPump::stopTimers() {
+	if (mEventTimer) {
+		mCore.destroyTimer(mEventTimer);
+		mEventTimer = nullptr;
+	}
+	if (mMonitorTimer) {
+		mCore.destroyTimer(mMonitorTimer);
+		mMonitorTimer = nullptr;
+	}
+}
+
+LINPHONE_END_NAMESPACE
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_STREAM_EVENT_PUMP_H_
+#define _L_STREAM_EVENT_PUMP_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "belle-sip/belle-sip.h"
+
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class Core;
+
+/*
+ * Drives the periodic work of all the media streams of a Core from two shared main loop timers: one iterating the
+ * streams and draining their event queues, one running their monitors each second. Each stream used to have its own
+ * pair of timers, which the main loop has to walk on every iteration, busy or not.
+ * The timers only exist while at least one client is registered.
+ */
+class StreamEventPump {
+public:
+	class Client {
+	public:
+		virtual ~Client() = default;
+		virtual void pumpEvents() = 0;
+		virtual void pumpMonitors() = 0;
+	};
+
+	StreamEventPump(Core &core, unsigned int eventIntervalMs = 20, unsigned int monitorIntervalMs = 1000);
+	StreamEventPump(const StreamEventPump &other) = delete;
+	~StreamEventPump();
+
+	// Clients may be added or removed from their own callbacks.
+	void add(Client *client);
+	void remove(Client *client);
+	bool contains(const Client *client) const;
+	size_t size() const {
+		return mIndexes.size();
+	}
+
+private:
+	void dispatch(void (Client::*callback)());
+	void compact();
+	void startTimers();
+	void stopTimers();
+
+	Core &mCore;
+	const unsigned int mEventIntervalMs;
+	const unsigned int mMonitorIntervalMs;
+	// Removed clients are nulled while dispatching, and compacted afterwards.
+	std::vector<Client *> mClients;
+	std::unordered_map<const Client *, size_t> mIndexes;
+	belle_sip_source_t *mEventTimer = nullptr;
+	belle_sip_source_t *mMonitorTimer = nullptr;
+	int mDispatching = 0;
+	bool mNeedsCompaction = false;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_STREAM_EVENT_PUMP_H_
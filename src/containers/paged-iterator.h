@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_PAGED_ITERATOR_H_
+#define _L_PAGED_ITERATOR_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Forward-only iterator over a result set that is fetched page by page.
+ * Only one page is kept in memory at a time; the fetcher is responsible for remembering where the previous page
+ * stopped through the opaque cursor (for instance the last database row id that was returned).
+ */
+template <typename T>
+class PagedIterator {
+public:
+	using PageFetcher = std::function<std::list<std::shared_ptr<T>>(long long &cursor, int pageSize)>;
+
+	PagedIterator(const PageFetcher &fetcher, int pageSize) : mFetcher(fetcher) {
+		mPageSize = pageSize < MinPageSize ? DefaultPageSize : pageSize;
+	}
+
+	bool hasNext() {
+		while (mPage.empty() && !mExhausted)
+			fetchPage();
+		return !mPage.empty();
+	}
+
+	// The returned element stays referenced by the iterator until the next call.
+	const std::shared_ptr<T> &next() {
+		if (!hasNext()) {
+			mCurrent = nullptr;
+			return mCurrent;
+		}
+		mCurrent = std::move(mPage.front());
+		mPage.pop_front();
+		return mCurrent;
+	}
+
+	int getPageSize() const {
+		return mPageSize;
+	}
+
+	static constexpr int MinPageSize = 1;
+	static constexpr int DefaultPageSize = 100;
+
+private:
+	void fetchPage() {
+		long long previousCursor = mCursor;
+		mPage = mFetcher(mCursor, mPageSize);
+		// The cursor only stands still once the underlying result set has been fully walked through.
+		if (mCursor == previousCursor) mExhausted = true;
+	}
+
+	PageFetcher mFetcher;
+	int mPageSize;
+	long long mCursor = 0;
+	bool mExhausted = false;
+	std::list<std::shared_ptr<T>> mPage;
+	std::shared_ptr<T> mCurrent;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_PAGED_ITERATOR_H_
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <belle-sip/belle-sip.h>
+
+#include "content-buffer.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+ContentBuffer::ContentBuffer(vector<char> &&data) {
+	if (data.empty()) return;
+
+	// Fills the body with zeros before releasing since it may contain private data like cipher keys or decoded
+	// messages.
+	auto storage = shared_ptr<vector<char>>(new vector<char>(std::move(data)), [](vector<char> *buffer) {
+		fill(buffer->begin(), buffer->end(), 0);
+		delete buffer;
+	});
+	mVector = storage.get();
+	mData = storage->data();
+	mSize = storage->size();
+	mStorage = std::move(storage);
+}
+
+ContentBuffer::ContentBuffer(string &&data) {
+	if (data.empty()) return;
+
+	auto storage = shared_ptr<string>(new string(std::move(data)), [](string *buffer) {
+		fill(buffer->begin(), buffer->end(), 0);
+		delete buffer;
+	});
+	mData = storage->data();
+	mSize = storage->size();
+	mStorage = std::move(storage);
+}
+
+ContentBuffer::ContentBuffer(const void *data, size_t size)
+    : ContentBuffer(data ? vector<char>(static_cast<const char *>(data), static_cast<const char *>(data) + size)
+                         : vector<char>()) {
+}
+
+ContentBuffer ContentBuffer::fromBelleSipBuffer(char *data, size_t size) {
+	ContentBuffer buffer;
+	if (data == nullptr) return buffer;
+
+	buffer.mStorage = shared_ptr<char>(data, [size](char *p) {
+		memset(p, 0, size);
+		belle_sip_free(p);
+	});
+	buffer.mData = data;
+	buffer.mSize = size;
+	return buffer;
+}
+
+ContentBuffer ContentBuffer::fromBodyHandler(const SalBodyHandler *bodyHandler) {
+	ContentBuffer buffer;
+	if (bodyHandler == nullptr) return buffer;
+
+	const char *data = static_cast<const char *>(sal_body_handler_get_data(bodyHandler));
+	if (data == nullptr) return buffer;
+
+	buffer.mStorage = shared_ptr<SalBodyHandler>(sal_body_handler_ref(const_cast<SalBodyHandler *>(bodyHandler)),
+	                                             [](SalBodyHandler *bh) { sal_body_handler_unref(bh); });
+	buffer.mData = data;
+	// Memory body handlers are always null terminated, bodies are read up to the first null character.
+	buffer.mSize = strlen(data);
+	return buffer;
+}
+
+bool ContentBuffer::operator==(const ContentBuffer &other) const {
+	return view() == other.view();
+}
+
+bool ContentBuffer::operator!=(const ContentBuffer &other) const {
+	return !(*this == other);
+}
+
+ContentBuffer ContentBuffer::slice(size_t offset, size_t length) const {
+	ContentBuffer buffer;
+	if (offset >= mSize) return buffer;
+
+	buffer.mStorage = mStorage;
+	buffer.mVector = mVector;
+	buffer.mData = mData + offset;
+	buffer.mSize = min(length, mSize - offset);
+	return buffer;
+}
+
+const vector<char> *ContentBuffer::getVector() const {
+	if (mVector && mData == mVector->data() && mSize == mVector->size()) return mVector;
+	return nullptr;
+}
+
+bool ContentBuffer::sharesStorageWith(const ContentBuffer &other) const {
+	return mStorage && mStorage == other.mStorage;
+}
+
+LINPHONE_END_NAMESPACE
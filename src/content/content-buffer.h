@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_CONTENT_BUFFER_H_
+#define _L_CONTENT_BUFFER_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "c-wrapper/internal/c-sal.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Immutable, reference-counted view on the bytes of a Content body.
+ * Copying a ContentBuffer or taking a slice of it never copies the bytes: all views share the same storage, which
+ * is released (and zeroed when owned by the buffer, as it may hold private data) with the last view.
+ */
+class LINPHONE_PUBLIC ContentBuffer {
+public:
+	ContentBuffer() = default;
+	explicit ContentBuffer(std::vector<char> &&data);
+	explicit ContentBuffer(std::string &&data);
+	ContentBuffer(const void *data, size_t size);
+
+	// Takes ownership of a buffer allocated by belle-sip, it is released with belle_sip_free().
+	static ContentBuffer fromBelleSipBuffer(char *data, size_t size);
+
+	// References the data of a memory body handler without copying it, the handler is kept alive by the view.
+	static ContentBuffer fromBodyHandler(const SalBodyHandler *bodyHandler);
+
+	bool operator==(const ContentBuffer &other) const;
+	bool operator!=(const ContentBuffer &other) const;
+
+	const char *data() const {
+		return mData;
+	}
+
+	size_t size() const {
+		return mSize;
+	}
+
+	bool empty() const {
+		return mSize == 0;
+	}
+
+	std::string_view view() const {
+		return std::string_view(mData, mSize);
+	}
+
+	ContentBuffer slice(size_t offset, size_t length) const;
+
+	// Returns the backing vector when this view covers it entirely, nullptr otherwise.
+	const std::vector<char> *getVector() const;
+
+	bool sharesStorageWith(const ContentBuffer &other) const;
+
+private:
+	std::shared_ptr<const void> mStorage;
+	const std::vector<char> *mVector = nullptr;
+	const char *mData = nullptr;
+	size_t mSize = 0;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_CONTENT_BUFFER_H_
@@ -50,13 +50,14 @@ Content::Content(const SalBodyHandler *bodyHandler, bool parseMultipart) {
 		mContentType.addParameter(paramName, paramValue);
 	}
 
+	mIsDirty = true;
 	if (mContentType.isMultipart() && parseMultipart) {
 		belle_sip_multipart_body_handler_t *mpbh = BELLE_SIP_MULTIPART_BODY_HANDLER(bodyHandler);
 		char *body = belle_sip_object_to_string(mpbh);
-		setBodyFromUtf8(body);
-		belle_sip_free(body);
+		resetBody(ContentBuffer::fromBelleSipBuffer(body, body ? strlen(body) : 0));
 	} else {
-		setBodyFromUtf8(reinterpret_cast<char *>(sal_body_handler_get_data(bodyHandler)));
+		// The body handler stays immutable once received, share its buffer instead of copying it.
+		resetBody(ContentBuffer::fromBodyHandler(bodyHandler));
 	}
 
 	auto headers = reinterpret_cast<const belle_sip_list_t *>(sal_body_handler_get_headers(bodyHandler));
@@ -93,10 +94,10 @@ Content::Content(Content &&other) noexcept : HybridObject(std::move(other)) {
 
 Content::~Content() {
 	/*
-	 * Fills the body with zeros before releasing since it may contain
-	 * private data like cipher keys or decoded messages.
+	 * The body storage is filled with zeros by ContentBuffer when its last
+	 * user releases it since it may contain private data like cipher keys
+	 * or decoded messages.
 	 */
-	mBody.assign(mBody.size(), 0);
 	if (mBodyHandler != nullptr) sal_body_handler_unref(mBodyHandler);
 }
 
@@ -109,7 +110,7 @@ Content &Content::operator=(const Content &other) {
 }
 
 Content &Content::operator=(Content &&other) noexcept {
-	mBody = std::move(other.mBody);
+	resetBody(std::move(other.mBody));
 	mContentType = std::move(other.mContentType);
 	mContentDisposition = std::move(other.mContentDisposition);
 	mContentEncoding = std::move(other.mContentEncoding);
@@ -124,13 +125,13 @@ Content &Content::operator=(Content &&other) noexcept {
 }
 
 bool Content::operator==(const Content &other) const {
-	return mContentType == other.getContentType() && mBody == other.getBody() &&
+	return mContentType == other.getContentType() && mBody == other.getBodyBuffer() &&
 	       mContentDisposition == other.getContentDisposition() && mContentEncoding == other.getContentEncoding() &&
 	       mHeaders == other.getHeaders();
 }
 
 void Content::copy(const Content &other) {
-	mBody = other.getBody();
+	mBody = other.getBodyBuffer();
 	mContentType = other.getContentType();
 	mContentDisposition = other.getContentDisposition();
 	mContentEncoding = other.getContentEncoding();
@@ -168,44 +169,71 @@ void Content::setContentEncoding(const string &contentEncoding) {
 	mContentEncoding = contentEncoding;
 }
 
-const vector<char> &Content::getBody() const {
+const vector<char> &Content::getBody() {
+	if (mBody.empty()) return Utils::getEmptyConstRefObject<vector<char>>();
+
+	const vector<char> *body = mBody.getVector();
+	if (!body) {
+		// The body is a slice or references a buffer owned by someone else, keep an owned copy from now on.
+		mBody = ContentBuffer(mBody.data(), mBody.size());
+		body = mBody.getVector();
+	}
+	return *body;
+}
+
+const ContentBuffer &Content::getBodyBuffer() const {
 	return mBody;
 }
 
 string Content::getBodyAsString() const {
-	return Utils::utf8ToLocale(string(mBody.begin(), mBody.end()));
+	return Utils::utf8ToLocale(getBodyAsUtf8String());
 }
 
 const string &Content::getBodyAsUtf8String() const {
-	mCache.buffer = string(mBody.begin(), mBody.end());
+	if (!mCache.bufferUpToDate) {
+		mCache.buffer.assign(mBody.data(), mBody.size());
+		mCache.bufferUpToDate = true;
+	}
 	return mCache.buffer;
 }
 
+void Content::resetBody(ContentBuffer &&body) {
+	mBody = std::move(body);
+	mCache.bufferUpToDate = false;
+}
+
 void Content::setBody(const vector<char> &body) {
-	mBody = body;
+	resetBody(ContentBuffer(body.data(), body.size()));
 }
 
 void Content::setBody(vector<char> &&body) {
-	mBody = std::move(body);
+	resetBody(ContentBuffer(std::move(body)));
+}
+
+void Content::setBody(const ContentBuffer &body) {
+	resetBody(ContentBuffer(body));
 }
 
 void Content::setBodyFromLocale(const string &body) {
-	string toUtf8 = Utils::localeToUtf8(body);
-	mBody = vector<char>(toUtf8.cbegin(), toUtf8.cend());
+	resetBody(ContentBuffer(Utils::localeToUtf8(body)));
 }
 
 void Content::setBody(const void *buffer, size_t size) {
 	mIsDirty = true;
 
-	const char *start = static_cast<const char *>(buffer);
-	if (start != nullptr) mBody = vector<char>(start, start + size);
-	else mBody.clear();
+	resetBody(ContentBuffer(buffer, size));
 }
 
 void Content::setBodyFromUtf8(const string &body) {
 	mIsDirty = true;
 
-	mBody = vector<char>(body.cbegin(), body.cend());
+	resetBody(ContentBuffer(body.data(), body.size()));
+}
+
+void Content::setBodyFromUtf8(string &&body) {
+	mIsDirty = true;
+
+	resetBody(ContentBuffer(std::move(body)));
 }
 
 const std::string &Content::getName() const {
@@ -327,9 +355,10 @@ SalBodyHandler *Content::getBodyHandlerFromContent(const Content &content, bool
 
 	SalBodyHandler *bodyHandler = nullptr;
 	ContentType contentType = content.mContentType;
+	const ContentBuffer &body = content.getBodyBuffer();
 	if (contentType.isMultipart() && parseMultipart) {
 		size_t size = content.getSize();
-		char *buffer = bctbx_strdup(content.getBodyAsUtf8String().c_str());
+		char *buffer = body.empty() ? bctbx_strdup("") : bctbx_strndup(body.data(), (int)body.size());
 		const char *boundary = L_STRING_TO_C(contentType.getParameter("boundary").getValue());
 		belle_sip_multipart_body_handler_t *bh = nullptr;
 		if (boundary) bh = belle_sip_multipart_body_handler_new_from_buffer(buffer, size, boundary);
@@ -356,7 +385,11 @@ SalBodyHandler *Content::getBodyHandlerFromContent(const Content &content, bool
 		bctbx_free(buffer);
 	} else {
 		bodyHandler = sal_body_handler_new();
-		sal_body_handler_set_data(bodyHandler, belle_sip_strdup(content.getBodyAsUtf8String().c_str()));
+		// Single copy straight into the buffer owned by the body handler.
+		char *data = static_cast<char *>(belle_sip_malloc(body.size() + 1));
+		if (!body.empty()) memcpy(data, body.data(), body.size());
+		data[body.size()] = '\0';
+		sal_body_handler_set_data(bodyHandler, data);
 	}
 
 	for (const auto &header : content.getHeaders()) {
@@ -27,6 +27,7 @@
 #include "belle-sip/object++.hh"
 
 #include "c-wrapper/internal/c-sal.h"
+#include "content-buffer.h"
 #include "content-disposition.h"
 #include "content-type.h"
 #include "header/header.h"
@@ -68,15 +69,19 @@ public:
 	const std::string &getContentEncoding() const;
 	void setContentEncoding(const std::string &contentEncoding);
 
-	const std::vector<char> &getBody() const;
+	// Not const: a body that is a slice or a view on foreign storage is copied into an owned vector.
+	const std::vector<char> &getBody();
+	const ContentBuffer &getBodyBuffer() const;
 	std::string getBodyAsString() const;
 	const std::string &getBodyAsUtf8String() const;
 
 	void setBody(const std::vector<char> &body);
 	void setBody(std::vector<char> &&body);
+	void setBody(const ContentBuffer &body);
 	void setBodyFromLocale(const std::string &body);
 	void setBody(const void *buffer, size_t size);
 	void setBodyFromUtf8(const std::string &body);
+	void setBodyFromUtf8(std::string &&body);
 
 	const std::string &getName() const;
 	void setName(const std::string &name);
@@ -118,7 +123,9 @@ protected:
 	const std::string exportPlainFileFromEncryptedFile(const std::string &filePath) const;
 
 private:
-	std::vector<char> mBody;
+	void resetBody(ContentBuffer &&body);
+
+	ContentBuffer mBody;
 	ContentType mContentType;
 	ContentDisposition mContentDisposition;
 	std::string mContentEncoding;
@@ -131,6 +138,7 @@ private:
 	struct Cache {
 		std::string name;
 		std::string buffer;
+		bool bufferUpToDate = false;
 		std::string filePath;
 		std::string headerValue;
 	} mutable mCache;
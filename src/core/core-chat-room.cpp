@@ -18,6 +18,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <iterator>
 
 #include <bctoolbox/defs.h>
@@ -235,58 +236,74 @@ shared_ptr<AbstractChatRoom> CorePrivate::createBasicChatRoom(const ConferenceId
 	return chatRoom;
 }
 
-shared_ptr<AbstractChatRoom>
-CorePrivate::searchChatRoom(const shared_ptr<ChatRoomParams> &params,
-                            const std::shared_ptr<const Address> &localAddress,
-                            const std::shared_ptr<const Address> &remoteAddress,
-                            const std::list<std::shared_ptr<Address>> &participants) const {
-	for (auto it = chatRoomsById.begin(); it != chatRoomsById.end(); it++) {
-		const auto &chatRoom = it->second;
-		if (params) {
-			ChatRoom::CapabilitiesMask capabilities = chatRoom->getCapabilities();
-			if (params->getChatRoomBackend() != chatRoom->getCurrentParams()->getChatRoomBackend()) continue;
+namespace {
+bool chatRoomMatches(const shared_ptr<AbstractChatRoom> &chatRoom,
+                     const shared_ptr<ChatRoomParams> &params,
+                     const Address &localAddressWithoutGruu,
+                     const Address &remoteAddressWithoutGruu,
+                     const std::list<std::shared_ptr<Address>> &participants) {
+	if (params) {
+		ChatRoom::CapabilitiesMask capabilities = chatRoom->getCapabilities();
+		if (params->getChatRoomBackend() != chatRoom->getCurrentParams()->getChatRoomBackend()) return false;
 
-			if (!params->isGroup() && !(capabilities & ChatRoom::Capabilities::OneToOne)) continue;
+		if (!params->isGroup() && !(capabilities & ChatRoom::Capabilities::OneToOne)) return false;
 
-			if (params->isGroup() && !(capabilities & ChatRoom::Capabilities::Conference)) continue;
+		if (params->isGroup() && !(capabilities & ChatRoom::Capabilities::Conference)) return false;
 
-			if (params->isEncrypted() != bool(capabilities & ChatRoom::Capabilities::Encrypted)) continue;
+		if (params->isEncrypted() != bool(capabilities & ChatRoom::Capabilities::Encrypted)) return false;
 
-			// Subject doesn't make any sense for basic chat room
-			if ((params->getChatRoomBackend() == LinphonePrivate::ChatRoomParams::ChatRoomBackend::FlexisipChat) &&
-			    (!params->getSubject().empty() && params->getSubject() != chatRoom->getSubject()))
-				continue;
-		}
+		// Subject doesn't make any sense for basic chat room
+		if ((params->getChatRoomBackend() == LinphonePrivate::ChatRoomParams::ChatRoomBackend::FlexisipChat) &&
+		    (!params->getSubject().empty() && params->getSubject() != chatRoom->getSubject()))
+			return false;
+	}
 
-		std::shared_ptr<Address> curLocalAddress = chatRoom->getLocalAddress();
-		const auto localAddressWithoutGruu =
-		    (localAddress && localAddress->isValid()) ? localAddress->getUriWithoutGruu() : Address();
-		const auto curLocalAddressWithoutGruu = curLocalAddress->getUriWithoutGruu();
-		if (localAddressWithoutGruu.isValid() && (localAddressWithoutGruu != curLocalAddressWithoutGruu)) continue;
+	if (localAddressWithoutGruu.isValid() &&
+	    (localAddressWithoutGruu != chatRoom->getLocalAddress()->getUriWithoutGruu()))
+		return false;
 
-		std::shared_ptr<Address> curRemoteAddress = chatRoom->getPeerAddress();
-		const auto remoteAddressWithoutGruu =
-		    (remoteAddress && remoteAddress->isValid()) ? remoteAddress->getUriWithoutGruu() : Address();
-		const auto curRemoteAddressWithoutGruu = curRemoteAddress->getUriWithoutGruu();
-		if (remoteAddressWithoutGruu.isValid() && (remoteAddressWithoutGruu != curRemoteAddressWithoutGruu)) continue;
+	if (remoteAddressWithoutGruu.isValid() &&
+	    (remoteAddressWithoutGruu != chatRoom->getPeerAddress()->getUriWithoutGruu()))
+		return false;
 
-		bool allFound = true;
-		for (const auto &participant : participants) {
-			bool found = false;
-			for (const auto &p : chatRoom->getParticipants()) {
-				if (participant->weakEqual(*(p->getAddress()))) {
-					found = true;
-					break;
-				}
-			}
-			if (!found) {
-				allFound = false;
+	for (const auto &participant : participants) {
+		bool found = false;
+		for (const auto &p : chatRoom->getParticipants()) {
+			if (participant->weakEqual(*(p->getAddress()))) {
+				found = true;
 				break;
 			}
 		}
-		if (!allFound) continue;
+		if (!found) return false;
+	}
+	return true;
+}
+} // namespace
 
-		return chatRoom;
+shared_ptr<AbstractChatRoom>
+CorePrivate::searchChatRoom(const shared_ptr<ChatRoomParams> &params,
+                            const std::shared_ptr<const Address> &localAddress,
+                            const std::shared_ptr<const Address> &remoteAddress,
+                            const std::list<std::shared_ptr<Address>> &participants) const {
+	const auto localAddressWithoutGruu =
+	    (localAddress && localAddress->isValid()) ? localAddress->getUriWithoutGruu() : Address();
+	const auto remoteAddressWithoutGruu =
+	    (remoteAddress && remoteAddress->isValid()) ? remoteAddress->getUriWithoutGruu() : Address();
+
+	// Only check the chat rooms that have the searched addresses, when there are some.
+	std::vector<std::shared_ptr<AbstractChatRoom>> candidates;
+	if (chatRoomIndex.findCandidates(localAddress, remoteAddress, participants, candidates)) {
+		for (const auto &chatRoom : candidates) {
+			if (chatRoomMatches(chatRoom, params, localAddressWithoutGruu, remoteAddressWithoutGruu, participants))
+				return chatRoom;
+		}
+		return nullptr;
+	}
+
+	for (auto it = chatRoomsById.begin(); it != chatRoomsById.end(); it++) {
+		const auto &chatRoom = it->second;
+		if (chatRoomMatches(chatRoom, params, localAddressWithoutGruu, remoteAddressWithoutGruu, participants))
+			return chatRoom;
 	}
 	return nullptr;
 }
@@ -434,6 +451,8 @@ void CorePrivate::insertChatRoom(const shared_ptr<AbstractChatRoom> &chatRoom) {
 			lInfo() << "Insert chat room " << conferenceId << " to core map";
 		}
 		chatRoomsById[conferenceId] = chatRoom;
+		chatRoomIndex.insert(chatRoom);
+		invalidateUnreadChatMessageCount(conferenceId);
 	}
 }
 
@@ -444,6 +463,8 @@ void CorePrivate::insertChatRoomWithDb(const shared_ptr<AbstractChatRoom> &chatR
 
 void CorePrivate::loadChatRooms() {
 	chatRoomsById.clear();
+	chatRoomIndex.clear();
+	unreadChatMessageCounters.clear();
 #ifdef HAVE_ADVANCED_IM
 	if (remoteListEventHandler) remoteListEventHandler->clearHandlers();
 #endif
@@ -454,54 +475,81 @@ void CorePrivate::loadChatRooms() {
 	sendDeliveryNotifications();
 }
 
+bool CorePrivate::ephemeralMessageExpiresLater(const EphemeralMessage &a, const EphemeralMessage &b) {
+	return a.expireTime > b.expireTime;
+}
+
 void CorePrivate::handleEphemeralMessages(time_t currentTime) {
-	if (!ephemeralMessages.empty()) {
-		shared_ptr<ChatMessage> msg = ephemeralMessages.front();
-		time_t expireTime = msg->getEphemeralExpireTime();
-		if (currentTime > expireTime) {
-			shared_ptr<LinphonePrivate::EventLog> event =
-			    LinphonePrivate::MainDb::getEvent(mainDb, msg->getStorageId());
+	if (ephemeralMessages.empty()) {
+		initEphemeralMessages();
+		return;
+	}
+
+	// Collect every expired message first so that they are all deleted from database in a single transaction.
+	list<pair<shared_ptr<ChatMessage>, shared_ptr<EventLog>>> expiredMessages;
+	while (!ephemeralMessages.empty() && currentTime > ephemeralMessages.front().expireTime) {
+		pop_heap(ephemeralMessages.begin(), ephemeralMessages.end(), ephemeralMessageExpiresLater);
+		shared_ptr<ChatMessage> msg = std::move(ephemeralMessages.back().message);
+		// Delete message from this list even when chatroom is gone.
+		ephemeralMessages.pop_back();
+
+		if (msg->getStorageId() < 0 || !msg->getChatRoom()) continue;
+		shared_ptr<EventLog> event = MainDb::getEvent(mainDb, msg->getStorageId());
+		if (event) expiredMessages.emplace_back(msg, event);
+	}
+
+	if (!expiredMessages.empty()) {
+		list<shared_ptr<const EventLog>> events;
+		for (const auto &expiredMessage : expiredMessages)
+			events.push_back(expiredMessage.second);
+		MainDb::deleteEvents(events);
+		lInfo() << "[Ephemeral] " << expiredMessages.size() << " message(s) deleted from database";
+
+		for (const auto &expiredMessage : expiredMessages) {
+			const shared_ptr<ChatMessage> &msg = expiredMessage.first;
+			const shared_ptr<EventLog> &event = expiredMessage.second;
 			shared_ptr<AbstractChatRoom> chatRoom = msg->getChatRoom();
-			if (chatRoom && event) {
-				LinphonePrivate::EventLog::deleteFromDatabase(event);
-				lInfo() << "[Ephemeral] Message deleted from database";
-
-				// Notify ephemeral message deleted to message if exists.
-				LinphoneChatMessage *message = L_GET_C_BACK_PTR(msg.get());
-				if (message) {
-					LinphoneChatMessageCbs *cbs = linphone_chat_message_get_callbacks(message);
-					if (cbs && linphone_chat_message_cbs_get_ephemeral_message_deleted(cbs)) {
-						linphone_chat_message_cbs_get_ephemeral_message_deleted(cbs)(message);
-					}
-					_linphone_chat_message_notify_ephemeral_message_deleted(message);
+			if (!chatRoom) continue;
+
+			// Notify ephemeral message deleted to message if exists.
+			LinphoneChatMessage *message = L_GET_C_BACK_PTR(msg.get());
+			if (message) {
+				LinphoneChatMessageCbs *cbs = linphone_chat_message_get_callbacks(message);
+				if (cbs && linphone_chat_message_cbs_get_ephemeral_message_deleted(cbs)) {
+					linphone_chat_message_cbs_get_ephemeral_message_deleted(cbs)(message);
 				}
-
-				// Notify ephemeral message deleted to chat room & core.
-				LinphoneChatRoom *cr = L_GET_C_BACK_PTR(chatRoom);
-				_linphone_chat_room_notify_ephemeral_message_deleted(cr, L_GET_C_BACK_PTR(event));
-				linphone_core_notify_chat_room_ephemeral_message_deleted(linphone_chat_room_get_core(cr), cr);
+				_linphone_chat_message_notify_ephemeral_message_deleted(message);
 			}
 
-			// Delete message from this list even when chatroom is gone.
-			ephemeralMessages.pop_front();
-			handleEphemeralMessages(currentTime);
-		} else {
-			startEphemeralMessageTimer(expireTime);
+			// Notify ephemeral message deleted to chat room & core.
+			LinphoneChatRoom *cr = L_GET_C_BACK_PTR(chatRoom);
+			_linphone_chat_room_notify_ephemeral_message_deleted(cr, L_GET_C_BACK_PTR(event));
+			linphone_core_notify_chat_room_ephemeral_message_deleted(linphone_chat_room_get_core(cr), cr);
 		}
-	} else {
-		initEphemeralMessages();
 	}
+
+	if (ephemeralMessages.empty()) initEphemeralMessages();
+	else startEphemeralMessageTimer(ephemeralMessages.front().expireTime);
 }
 
 void CorePrivate::initEphemeralMessages() {
 	L_Q();
 	if (mainDb && mainDb->isInitialized()) {
 		ephemeralMessages.clear();
-		ephemeralMessages = mainDb->getEphemeralMessages();
+		ephemeralMessagesHorizon = 0;
+
+		// Messages come sorted by expire time, a full batch means more of them may remain in database.
+		list<shared_ptr<ChatMessage>> messages = mainDb->getEphemeralMessages();
+		if (messages.size() >= (size_t)MainDb::EphemeralMessagesBatchSize)
+			ephemeralMessagesHorizon = messages.back()->getEphemeralExpireTime();
+		ephemeralMessages.reserve(messages.size());
+		for (const auto &msg : messages)
+			ephemeralMessages.push_back({msg->getEphemeralExpireTime(), msg});
+		make_heap(ephemeralMessages.begin(), ephemeralMessages.end(), ephemeralMessageExpiresLater);
+
 		if (!ephemeralMessages.empty()) {
 			lInfo() << "[Ephemeral] list initiated on core " << linphone_core_get_identity(q->getCCore());
-			shared_ptr<ChatMessage> msg = ephemeralMessages.front();
-			startEphemeralMessageTimer(msg->getEphemeralExpireTime());
+			startEphemeralMessageTimer(ephemeralMessages.front().expireTime);
 		}
 	}
 }
@@ -510,29 +558,19 @@ void CorePrivate::updateEphemeralMessages(const shared_ptr<ChatMessage> &message
 	if (ephemeralMessages.empty()) {
 		// Can not determine this message will expire most quickly, so init this list.
 		initEphemeralMessages();
-	} else {
-		shared_ptr<ChatMessage> lastmsg = ephemeralMessages.back();
-		if (lastmsg->getEphemeralLifetime() < message->getEphemeralLifetime()) {
-			// The last message of this list will expire more quickly than this message, can not determine this message
-			// will expire most quickly in the remaining messages.
-			return;
-		}
-		for (std::list<shared_ptr<ChatMessage>>::iterator it = ephemeralMessages.begin(); it != ephemeralMessages.end();
-		     ++it) {
-			shared_ptr<ChatMessage> msg = *it;
-			if (msg->getEphemeralExpireTime() > message->getEphemeralExpireTime()) {
-				// This message will expire more quickly than the last message of this list, add it.
-				if (it == ephemeralMessages.begin()) {
-					ephemeralMessages.push_front(message);
-					startEphemeralMessageTimer(message->getEphemeralExpireTime());
-				} else {
-					it = --it;
-					ephemeralMessages.insert(it, message);
-				}
-				return;
-			}
-		}
+	} else if (ephemeralMessagesHorizon == 0 || message->getEphemeralExpireTime() <= ephemeralMessagesHorizon) {
+		scheduleEphemeralMessage(message);
 	}
+	// Otherwise the message is loaded from database once the ones expiring before it are handled.
+}
+
+void CorePrivate::scheduleEphemeralMessage(const shared_ptr<ChatMessage> &message) {
+	time_t expireTime = message->getEphemeralExpireTime();
+	ephemeralMessages.push_back({expireTime, message});
+	push_heap(ephemeralMessages.begin(), ephemeralMessages.end(), ephemeralMessageExpiresLater);
+
+	// The single timer only needs to be re-armed when this message is the next one to expire.
+	if (ephemeralMessages.front().message == message) startEphemeralMessageTimer(expireTime);
 }
 
 void CorePrivate::sendDeliveryNotifications() {
@@ -551,13 +589,19 @@ void CorePrivate::replaceChatRoom(const shared_ptr<AbstractChatRoom> &replacedCh
 	const ConferenceId &replacedConferenceId = replacedChatRoom->getConferenceId();
 	const ConferenceId &newConferenceId = newChatRoom->getConferenceId();
 
+	chatRoomIndex.remove(replacedChatRoom.get());
+	chatRoomIndex.remove(newChatRoom.get());
 	if (replacedChatRoom->getCapabilities() & ChatRoom::Capabilities::Proxy) {
 		chatRoomsById.erase(replacedConferenceId);
 		chatRoomsById[newConferenceId] = replacedChatRoom;
+		chatRoomIndex.insert(replacedChatRoom);
 	} else {
 		chatRoomsById.erase(replacedConferenceId);
 		chatRoomsById[newConferenceId] = newChatRoom;
+		chatRoomIndex.insert(newChatRoom);
 	}
+	unreadChatMessageCounters.remove(replacedConferenceId);
+	invalidateUnreadChatMessageCount(newConferenceId);
 }
 
 #ifndef _MSC_VER
@@ -642,6 +686,9 @@ void CorePrivate::updateChatRoomConferenceId(const shared_ptr<AbstractChatRoom>
 
 	chatRoomsById.erase(oldConferenceId);
 	chatRoomsById[newConferenceId] = chatRoom;
+	chatRoomIndex.insert(chatRoom);
+	unreadChatMessageCounters.remove(oldConferenceId);
+	invalidateUnreadChatMessageCount(newConferenceId);
 
 	mainDb->updateChatRoomConferenceId(oldConferenceId, newConferenceId);
 #endif
@@ -650,6 +697,11 @@ void CorePrivate::updateChatRoomConferenceId(const shared_ptr<AbstractChatRoom>
 #pragma GCC diagnostic pop
 #endif // _MSC_VER
 
+void CorePrivate::updateChatRoomIndex(const ConferenceId &conferenceId) {
+	const auto it = chatRoomsById.find(conferenceId);
+	if (it != chatRoomsById.end()) chatRoomIndex.insert(it->second);
+}
+
 // -----------------------------------------------------------------------------
 
 static bool compare_chat_room(const shared_ptr<AbstractChatRoom> &first, const shared_ptr<AbstractChatRoom> &second) {
@@ -853,7 +905,9 @@ void Core::deleteChatRoom(const shared_ptr<const AbstractChatRoom> &chatRoom) {
 	d->noCreatedClientGroupChatRooms.erase(chatRoom.get());
 	auto chatRoomsByIdIt = d->chatRoomsById.find(conferenceId);
 	if (chatRoomsByIdIt != d->chatRoomsById.end()) {
+		d->chatRoomIndex.remove(chatRoomsByIdIt->second.get());
 		d->chatRoomsById.erase(chatRoomsByIdIt);
+		d->unreadChatMessageCounters.remove(conferenceId);
 		if (d->mainDb->isInitialized()) d->mainDb->deleteChatRoom(conferenceId);
 	} else {
 		lError() << "Unable to delete chat room with conference ID " << conferenceId << " because it cannot be found.";
@@ -21,16 +21,25 @@
 #ifndef _L_CORE_P_H_
 #define _L_CORE_P_H_
 
+#include <array>
 #include <stdexcept>
 
 #include "linphone/utils/utils.h"
 
+#include "account/account-index.h"
+#include "auth-info/auth-info-index.h"
 #include "auth-info/auth-stack.h"
 #include "call/audio-device/audio-device.h"
 #include "chat/chat-room/abstract-chat-room.h"
+#include "chat/chat-room/chat-room-index.h"
+#include "chat/chat-room/unread-chat-message-counters.h"
+#include "conference/session/stream-event-pump.h"
 #include "conference/session/tone-manager.h"
 #include "core.h"
 #include "db/main-db.h"
+#include "ldap/ldap-result-cache.h"
+#include "metrics/metrics-exporter.h"
+#include "metrics/metrics-registry.h"
 #include "object/object-p.h"
 #include "sal/call-op.h"
 #include "utils/background-task.h"
@@ -96,6 +105,7 @@ public:
 	void handleEphemeralMessages(time_t currentTime);
 	void initEphemeralMessages();
 	void updateEphemeralMessages(const std::shared_ptr<ChatMessage> &message);
+	void scheduleEphemeralMessage(const std::shared_ptr<ChatMessage> &message);
 	void sendDeliveryNotifications();
 	void insertChatRoom(const std::shared_ptr<AbstractChatRoom> &chatRoom);
 	void insertChatRoomWithDb(const std::shared_ptr<AbstractChatRoom> &chatRoom, unsigned int notifyId = 0);
@@ -104,6 +114,11 @@ public:
 	                                                      const std::shared_ptr<ChatRoomParams> &params);
 
 	ToneManager &getToneManager();
+	StreamEventPump &getStreamEventPump();
+	// Unlike getStreamEventPump(), does not create the pump: nullptr if no stream ever registered.
+	StreamEventPump *findStreamEventPump() const {
+		return streamEventPump.get();
+	}
 
 	void reloadLdapList();
 
@@ -155,6 +170,13 @@ public:
 	                     const std::shared_ptr<AbstractChatRoom> &newChatRoom);
 
 	void updateChatRoomConferenceId(const std::shared_ptr<AbstractChatRoom> &chatRoom, ConferenceId newConferenceId);
+	// To be called when the participants or the conference ID of a chat room change, with the ID it is stored with.
+	void updateChatRoomIndex(const ConferenceId &conferenceId);
+	// To be called when the unread chat message count or the mute state of a chat room may have changed.
+	void invalidateUnreadChatMessageCount(const ConferenceId &conferenceId);
+	// Reads again the counts of the invalidated chat rooms, and notifies the totals that changed if asked to.
+	void updateUnreadChatMessageCounts(bool notify) const;
+
 	std::shared_ptr<AbstractChatRoom> findExhumableOneToOneChatRoom(const std::shared_ptr<Address> &localAddress,
 	                                                                const std::shared_ptr<Address> &participantAddress,
 	                                                                bool encrypted) const;
@@ -174,6 +196,31 @@ public:
 	AuthStack &getAuthStack() {
 		return authStack;
 	}
+	// Indexes of lc->auth_info and of the account list, used by the lookups of authentication.c and linphonecore.c.
+	AuthInfoIndex authInfoIndex;
+	AccountIndex accountIndex;
+	// Whether the whole lc->auth_info list is written in the configuration.
+	bool authInfosWritten = false;
+	// Entries found by the LDAP contact providers, which are created for each search.
+	LdapResultCache ldapResultCache;
+	// Only created when the [metrics] section of the configuration asks for an export.
+	std::unique_ptr<MetricsRegistry> metricsRegistry;
+	std::unique_ptr<MetricsExporter> metricsExporter;
+	// Series of the core events, kept so that the events do not look them up in the registry. The labelled ones are
+	// resolved the first time their label value is seen.
+	struct Metrics {
+		using SeriesPtr = std::shared_ptr<MetricsRegistry::Series>;
+		SeriesPtr calls;
+		SeriesPtr publications;
+		SeriesPtr publicationsBytes;
+		SeriesPtr publicationsExpired;
+		SeriesPtr publicationsRejected;
+		std::array<SeriesPtr, LinphoneCallStateEarlyUpdating + 1> callStateChanges;
+		std::array<SeriesPtr, LinphoneRegistrationRefreshing + 1> registrationStateChanges;
+		std::array<SeriesPtr, LinphoneAlertQoSLostSignal + 1> alerts;
+	};
+	std::unique_ptr<Metrics> metrics;
+	void countAlert(LinphoneAlertType type);
 	Sal *getSal();
 	LinphoneCore *getCCore() const;
 
@@ -203,19 +250,36 @@ private:
 	std::shared_ptr<Call> currentCall;
 
 	std::unordered_map<ConferenceId, std::shared_ptr<AbstractChatRoom>> chatRoomsById;
+	// Must be kept in sync with chatRoomsById.
+	ChatRoomIndex chatRoomIndex;
+	// Unread chat message totals by local address, updated lazily from the invalidated chat rooms.
+	mutable UnreadChatMessageCounters unreadChatMessageCounters;
+	mutable bool unreadChatMessageCountsUpdateScheduled = false;
 
 	std::unique_ptr<EncryptionEngine> imee;
 
 	std::map<std::string, std::string> specs;
 
 	std::unique_ptr<ToneManager> toneManager;
+	// Like the toneManager, kept until destructor: streams may unregister during linphone_core_destroy().
+	std::unique_ptr<StreamEventPump> streamEventPump;
 
 	// This is to keep a ref on a clientGroupChatRoom while it is being created
 	// Otherwise the chatRoom will be freed() before it is inserted
 	std::unordered_map<const AbstractChatRoom *, std::shared_ptr<const AbstractChatRoom>> noCreatedClientGroupChatRooms;
 	AuthStack authStack;
 
-	std::list<std::shared_ptr<ChatMessage>> ephemeralMessages;
+	struct EphemeralMessage {
+		time_t expireTime;
+		std::shared_ptr<ChatMessage> message;
+	};
+	static bool ephemeralMessageExpiresLater(const EphemeralMessage &a, const EphemeralMessage &b);
+
+	// Min-heap on the expire time, the front is the next message to expire.
+	std::vector<EphemeralMessage> ephemeralMessages;
+	// Expire time of the last message of a full batch loaded from database, messages expiring after it are still
+	// only in database. 0 when every pending message is in the heap.
+	time_t ephemeralMessagesHorizon = 0;
 	belle_sip_source_t *ephemeralTimer = nullptr;
 
 	belle_sip_source_t *chatMessagesAggregationTimer = nullptr;
@@ -61,6 +61,7 @@
 #include "chat/chat-room/chat-room-p.h"
 #include "core/core-listener.h"
 #include "core/core-p.h"
+#include "event/event-publish.h"
 #include "factory/factory.h"
 #include "ldap/ldap.h"
 #include "linphone/lpconfig.h"
@@ -105,6 +106,7 @@
 #endif
 
 #define ETAG_SIZE 8
+#define PUBLICATION_EXPIRY_INTERVAL_MS 250
 
 // =============================================================================
 
@@ -127,6 +129,20 @@ void CorePrivate::init() {
 
 	mainDb.reset(new MainDb(q->getSharedFromThis()));
 	getToneManager(); // Forces instanciation of the ToneManager.
+	if (MetricsExporter::isConfigured(q->getSharedFromThis())) {
+		metricsRegistry = makeUnique<MetricsRegistry>();
+		metrics = makeUnique<Metrics>();
+		metrics->calls = metricsRegistry->getGauge("linphone_calls", "Number of calls.");
+		metrics->publications =
+		    metricsRegistry->getGauge("linphone_publications", "Number of publications stored by the core.");
+		metrics->publicationsBytes =
+		    metricsRegistry->getGauge("linphone_publications_bytes", "Approximate memory used by the publications.");
+		metrics->publicationsExpired =
+		    metricsRegistry->getCounter("linphone_publications_expired_total", "Number of publications that expired.");
+		metrics->publicationsRejected = metricsRegistry->getCounter(
+		    "linphone_publications_rejected_total", "Number of publications rejected by the limits.");
+		metricsExporter = makeUnique<MetricsExporter>(q->getSharedFromThis(), *metricsRegistry);
+	}
 #ifdef HAVE_ADVANCED_IM
 	remoteListEventHandler = makeUnique<RemoteConferenceListEventHandler>(q->getSharedFromThis());
 	localListEventHandler = makeUnique<LocalConferenceListEventHandler>(q->getSharedFromThis());
@@ -168,10 +184,22 @@ void CorePrivate::init() {
 				lInfo() << "Setting sqlite3 synchronous mode to OFF.";
 				uri += " synchronous=OFF";
 			}
+			LinphoneConfig *config = linphone_core_get_config(lc);
+			AbstractDb::DurabilityProfile durabilityProfile = AbstractDb::DurabilityProfile::fromName(
+			    L_C_TO_STRING(linphone_config_get_string(config, "storage", "durability_profile", "default")));
+			durabilityProfile.journalMode = L_C_TO_STRING(
+			    linphone_config_get_string(config, "storage", "journal_mode", durabilityProfile.journalMode.c_str()));
+			durabilityProfile.synchronous = L_C_TO_STRING(
+			    linphone_config_get_string(config, "storage", "synchronous", durabilityProfile.synchronous.c_str()));
+			durabilityProfile.cacheSize =
+			    linphone_config_get_int(config, "storage", "cache_size", durabilityProfile.cacheSize);
+			durabilityProfile.mmapSize =
+			    linphone_config_get_int64(config, "storage", "mmap_size", durabilityProfile.mmapSize);
+
 			lInfo() << "Opening linphone database " << uri << " with backend " << backend;
 			uri = LinphonePrivate::Utils::localeToUtf8(uri); // `mainDb->connect` take a UTF8 string.
 			auto startMs = bctbx_get_cur_time_ms();
-			if (!mainDb->connect(backend, uri)) {
+			if (!mainDb->connect(backend, uri, durabilityProfile)) {
 				ostringstream os;
 				os << "Unable to open linphone database with uri " << uri << " and backend " << backend;
 				throw DatabaseConnectionFailure(os.str());
@@ -335,6 +363,7 @@ void CorePrivate::shutdown() {
 
 	stopEphemeralMessageTimer();
 	ephemeralMessages.clear();
+	ephemeralMessagesHorizon = 0;
 
 	stopChatMessagesAggregationTimer();
 
@@ -392,6 +421,9 @@ void CorePrivate::uninit() {
 	}
 
 	chatRoomsById.clear();
+	chatRoomIndex.clear();
+	unreadChatMessageCounters.clear();
+	unreadChatMessageCounters.takeChanges();
 
 	for (const auto &audioVideoConference : q->audioVideoConferenceById) {
 		// Terminate audio video conferences just before core is stopped
@@ -405,7 +437,11 @@ void CorePrivate::uninit() {
 	static_cast<PlatformHelpers *>(getCCore()->platform_helper)->stopPushService();
 	mLdapServers.clear();
 
-	q->mPublishByEtag.clear();
+	q->clearPublications();
+
+	metricsExporter.reset();
+	metrics.reset();
+	metricsRegistry.reset();
 
 #ifdef HAVE_ADVANCED_IM
 	remoteListEventHandler.reset();
@@ -445,6 +481,17 @@ void CorePrivate::notifyNetworkReachable(bool sipNetworkReachable, bool mediaNet
 }
 
 void CorePrivate::notifyCallStateChanged(LinphoneCall *call, LinphoneCallState state, const string &message) {
+	L_Q();
+	if (metrics && (size_t)state < metrics->callStateChanges.size()) {
+		auto &series = metrics->callStateChanges[(size_t)state];
+		if (!series)
+			series = metricsRegistry->getCounter("linphone_call_state_changes_total",
+			                                     "Number of call state changes, by state.",
+			                                     {{"state", linphone_call_state_to_string(state)}});
+		series->increment();
+		metrics->calls->set(q->getCallCount());
+	}
+
 	auto listenersCopy = listeners; // Allow removal of a listener in its own call
 	for (const auto &listener : listenersCopy)
 		listener->onCallStateChanged(call, state, message);
@@ -453,11 +500,29 @@ void CorePrivate::notifyCallStateChanged(LinphoneCall *call, LinphoneCallState s
 void CorePrivate::notifyRegistrationStateChanged(std::shared_ptr<Account> account,
                                                  LinphoneRegistrationState state,
                                                  const string &message) {
+	if (metrics && (size_t)state < metrics->registrationStateChanges.size()) {
+		auto &series = metrics->registrationStateChanges[(size_t)state];
+		if (!series)
+			series = metricsRegistry->getCounter("linphone_registration_state_changes_total",
+			                                     "Number of account registration state changes, by state.",
+			                                     {{"state", linphone_registration_state_to_string(state)}});
+		series->increment();
+	}
+
 	auto listenersCopy = listeners; // Allow removal of a listener in its own call
 	for (const auto &listener : listenersCopy)
 		listener->onAccountRegistrationStateChanged(account, state, message);
 }
 
+void CorePrivate::countAlert(LinphoneAlertType type) {
+	if (!metrics || (size_t)type >= metrics->alerts.size()) return;
+	auto &series = metrics->alerts[(size_t)type];
+	if (!series)
+		series = metricsRegistry->getCounter("linphone_alerts_total", "Number of alerts raised, by type.",
+		                                     {{"type", linphone_alert_type_to_string(type)}});
+	series->increment();
+}
+
 void CorePrivate::notifyRegistrationStateChanged(LinphoneProxyConfig *cfg,
                                                  LinphoneRegistrationState state,
                                                  const string &message) {
@@ -557,6 +622,38 @@ ToneManager &CorePrivate::getToneManager() {
 	return *toneManager.get();
 }
 
+StreamEventPump &CorePrivate::getStreamEventPump() {
+	if (!streamEventPump) streamEventPump = makeUnique<StreamEventPump>(*getPublic());
+	return *streamEventPump.get();
+}
+
+void CorePrivate::invalidateUnreadChatMessageCount(const ConferenceId &conferenceId) {
+	unreadChatMessageCounters.invalidate(conferenceId);
+	// Without the main loop, the invalidated chat rooms are only read again on the next query of the totals.
+	if (unreadChatMessageCountsUpdateScheduled || !getCCore()->sal) return;
+	// Coalesce the changes of a main loop iteration, a batch of received messages is notified once.
+	unreadChatMessageCountsUpdateScheduled = true;
+	doLater([this]() { updateUnreadChatMessageCounts(true); });
+}
+
+void CorePrivate::updateUnreadChatMessageCounts(bool notify) const {
+	for (const auto &conferenceId : unreadChatMessageCounters.takeInvalidated()) {
+		const auto it = chatRoomsById.find(conferenceId);
+		if (it == chatRoomsById.end() || !it->second->getLocalAddress()) {
+			unreadChatMessageCounters.remove(conferenceId);
+			continue;
+		}
+		const auto &chatRoom = it->second;
+		unreadChatMessageCounters.set(conferenceId, chatRoom->getLocalAddress(),
+		                              chatRoom->getIsMuted() ? 0 : chatRoom->getUnreadChatMessageCount());
+	}
+	if (!notify) return;
+
+	unreadChatMessageCountsUpdateScheduled = false;
+	for (const auto &change : unreadChatMessageCounters.takeChanges())
+		linphone_core_notify_unread_chat_message_count_changed(getCCore(), change.first->toC(), change.second);
+}
+
 int CorePrivate::ephemeralMessageTimerExpired(void *data, BCTBX_UNUSED(unsigned int revents)) {
 	CorePrivate *d = static_cast<CorePrivate *>(data);
 	d->stopEphemeralMessageTimer();
@@ -1470,33 +1567,20 @@ int Core::getUnreadChatMessageCount() const {
 
 int Core::getUnreadChatMessageCount(const std::shared_ptr<Address> &localAddress) const {
 	L_D();
-	int count = 0;
-	for (auto it = d->chatRoomsById.begin(); it != d->chatRoomsById.end(); it++) {
-		const auto &chatRoom = it->second;
-		if (localAddress->weakEqual(*chatRoom->getLocalAddress())) {
-			if (!chatRoom->getIsMuted()) {
-				count += chatRoom->getUnreadChatMessageCount();
-			}
-		}
-	}
-	return count;
+	d->updateUnreadChatMessageCounts(false);
+	return d->unreadChatMessageCounters.get(*localAddress);
 }
 
 int Core::getUnreadChatMessageCountFromActiveLocals() const {
 	L_D();
+	d->updateUnreadChatMessageCounts(false);
 
+	// Like before the totals were kept, an identity used by two proxy configs counts twice.
 	int count = 0;
-	for (auto it = d->chatRoomsById.begin(); it != d->chatRoomsById.end(); it++) {
-		const auto &chatRoom = it->second;
-		for (auto it = linphone_core_get_proxy_config_list(getCCore()); it != NULL; it = it->next) {
-			LinphoneProxyConfig *cfg = (LinphoneProxyConfig *)it->data;
-			const LinphoneAddress *identityAddr = linphone_proxy_config_get_identity_address(cfg);
-			if (Address::toCpp(identityAddr)->weakEqual(*chatRoom->getLocalAddress())) {
-				if (!chatRoom->getIsMuted()) {
-					count += chatRoom->getUnreadChatMessageCount();
-				}
-			}
-		}
+	for (auto it = linphone_core_get_proxy_config_list(getCCore()); it != NULL; it = it->next) {
+		LinphoneProxyConfig *cfg = (LinphoneProxyConfig *)it->data;
+		const LinphoneAddress *identityAddr = linphone_proxy_config_get_identity_address(cfg);
+		if (identityAddr) count += d->unreadChatMessageCounters.get(*Address::toCpp(identityAddr));
 	}
 	return count;
 }
@@ -1713,13 +1797,16 @@ Core::searchAudioVideoConference(const shared_ptr<ConferenceParams> &params,
 		const auto &audioVideoConference = p.second;
 		const ConferenceId &conferenceId = audioVideoConference->getConferenceId();
 
-		auto curLocalAddress =
-		    (conferenceId.getLocalAddress()) ? conferenceId.getLocalAddress()->getUriWithoutGruu() : Address();
-		if (localAddressUri.isValid() && (localAddressUri != curLocalAddress)) return false;
+		// Only copy the addresses of the conference when they have to be compared.
+		if (localAddressUri.isValid()) {
+			const auto &curLocalAddress = conferenceId.getLocalAddress();
+			if (!curLocalAddress || (localAddressUri != curLocalAddress->getUriWithoutGruu())) return false;
+		}
 
-		auto curPeerAddress =
-		    (conferenceId.getPeerAddress()) ? conferenceId.getPeerAddress()->getUriWithoutGruu() : Address();
-		if (remoteAddressUri.isValid() && (remoteAddressUri != curPeerAddress)) return false;
+		if (remoteAddressUri.isValid()) {
+			const auto &curPeerAddress = conferenceId.getPeerAddress();
+			if (!curPeerAddress || (remoteAddressUri != curPeerAddress->getUriWithoutGruu())) return false;
+		}
 
 		// Check parameters only if pointer provided as argument is not null
 		if (params) {
@@ -2156,22 +2243,59 @@ bool Core::isPluginLoaded(const std::string name) const {
 	return (std::find(plugins.cbegin(), plugins.cend(), name) != plugins.cend());
 }
 
-void Core::addOrUpdatePublishByEtag(SalPublishOp *op, shared_ptr<LinphonePrivate::EventPublish> event) {
+void Core::addOrUpdatePublishByEtag(SalPublishOp *op,
+                                    shared_ptr<LinphonePrivate::EventPublish> event,
+                                    const string &eventName,
+                                    const SalBodyHandler *body) {
 	char generatedETag_char[ETAG_SIZE] = {0};
 	do {
 		belle_sip_random_token(generatedETag_char, sizeof(generatedETag_char));
-	} while (mPublishByEtag.find(generatedETag_char) != mPublishByEtag.end());
-	mPublishByEtag.erase(op->getETag());
-	mPublishByEtag.insert_or_assign(generatedETag_char, event);
+	} while (mPublications.find(generatedETag_char) != nullptr);
+
+	const string previousETag = op->getETag();
+	const PublicationStore::Publication *previous = previousETag.empty() ? nullptr : mPublications.find(previousETag);
+	shared_ptr<EventPublish> previousEvent = previous ? previous->publish : nullptr;
+
+	PublicationStore::Publication publication;
+	publication.eTag = generatedETag_char;
+	publication.entity = Address(op->getTo()).asStringUriOnly();
+	publication.event = eventName;
+	if (body) {
+		const char *type = sal_body_handler_get_type(body);
+		const char *subtype = sal_body_handler_get_subtype(body);
+		if (type && subtype) publication.contentType = string(type) + "/" + subtype;
+		const char *data = static_cast<const char *>(sal_body_handler_get_data(body));
+		if (data) publication.body.assign(data, sal_body_handler_get_size(body));
+	}
+	publication.expiresAt = bctbx_get_cur_time_ms() + static_cast<uint64_t>(max(op->getExpires(), 0)) * 1000;
+	publication.publish = event;
+	if (!mPublications.put(std::move(publication), previousETag, body != nullptr)) {
+		// The limits were checked by eTagHandler().
+		lError() << "Publication of [" << eventName << "] could not be stored";
+		updatePublicationMetrics();
+		return;
+	}
 	op->setETag(generatedETag_char);
+
+	// The previous ETag is no longer valid, but the publication lives on in the new event: it is not cleared.
+	if (previousEvent && previousEvent != event) previousEvent->supersede();
+
+	if (!mPublicationExpiryTimer) {
+		mPublicationExpiryTimer = createTimer(
+		    [this]() {
+			    expirePublications();
+			    return true;
+		    },
+		    PUBLICATION_EXPIRY_INTERVAL_MS, "Publication expiry");
+	}
+	updatePublicationMetrics();
 }
 
 Core::ETagStatus Core::eTagHandler(SalPublishOp *op, const SalBodyHandler *body) {
 	string eTag(op->getETag());
 
 	if (!eTag.empty()) {
-		auto it = mPublishByEtag.find(eTag);
-		if (it == mPublishByEtag.end()) {
+		if (mPublications.find(eTag) == nullptr) {
 			lWarning() << "Unknown eTag [" << eTag << "]";
 			op->replyMessage(SalReasonConditionalRequestFailed);
 			op->release();
@@ -2180,22 +2304,18 @@ Core::ETagStatus Core::eTagHandler(SalPublishOp *op, const SalBodyHandler *body)
 	}
 
 	if (body) {
-		if (eTag.empty()) {
-			return Core::ETagStatus::AddOrUpdateETag;
-		} else {
-			auto it = mPublishByEtag.find(eTag);
-			if (it != mPublishByEtag.end()) {
-				return Core::ETagStatus::AddOrUpdateETag;
-			}
-		}
+		return acceptPublication(op, eTag, body);
 	} else {
-		auto it = mPublishByEtag.find(eTag);
 		if (op->getExpires() == 0) {
-			if (it != mPublishByEtag.end()) mPublishByEtag.erase(it);
+			auto previousEvent = mPublications.remove(eTag);
 			// else already expired
+			if (previousEvent) {
+				previousEvent->terminate();
+				updatePublicationMetrics();
+			}
 		} else {
-			if (it != mPublishByEtag.end()) {
-				return Core::ETagStatus::AddOrUpdateETag;
+			if (mPublications.find(eTag) != nullptr) {
+				return acceptPublication(op, eTag, body);
 			} else {
 				lWarning() << "Unknown eTag [" << eTag << "]";
 				op->replyMessage(SalReasonUnknown);
@@ -2207,6 +2327,59 @@ Core::ETagStatus Core::eTagHandler(SalPublishOp *op, const SalBodyHandler *body)
 	return Core::ETagStatus::None;
 }
 
+PublicationStore &Core::getPublicationStore() {
+	return mPublications;
+}
+
+void Core::clearPublications() {
+	if (mPublicationExpiryTimer) {
+		destroyTimer(mPublicationExpiryTimer);
+		mPublicationExpiryTimer = nullptr;
+	}
+	mPublications.clear();
+}
+
+void Core::readPublicationLimits() {
+	LinphoneConfig *config = linphone_core_get_config(getCCore());
+	mPublications.setLimits(
+	    static_cast<size_t>(linphone_config_get_int(config, "sip", "publish_store_max_publications", 100000)),
+	    static_cast<size_t>(linphone_config_get_int(config, "sip", "publish_store_max_bytes", 64 * 1024 * 1024)));
+}
+
+Core::ETagStatus Core::acceptPublication(SalPublishOp *op, const string &eTag, const SalBodyHandler *body) {
+	if (!mPublications.accepts(eTag, body ? sal_body_handler_get_size(body) : 0)) {
+		lWarning() << "Too many publications stored, rejecting PUBLISH" << (eTag.empty() ? "" : " for eTag ") << eTag;
+		op->replyMessage(SalReasonServiceUnavailable);
+		op->release();
+		updatePublicationMetrics();
+		return Core::ETagStatus::Error;
+	}
+	return Core::ETagStatus::AddOrUpdateETag;
+}
+
+void Core::expirePublications() {
+	auto expired = mPublications.removeExpired(bctbx_get_cur_time_ms());
+	for (const auto &event : expired) {
+		lInfo() << "Publish event [" << event.get() << "] has expired";
+		event->terminate();
+	}
+	if (mPublications.empty() && mPublicationExpiryTimer) {
+		destroyTimer(mPublicationExpiryTimer);
+		mPublicationExpiryTimer = nullptr;
+	}
+	if (!expired.empty()) updatePublicationMetrics();
+}
+
+void Core::updatePublicationMetrics() {
+	L_D();
+	if (!d->metrics) return;
+	const auto &stats = mPublications.getStats();
+	d->metrics->publications->set(static_cast<double>(stats.publications));
+	d->metrics->publicationsBytes->set(static_cast<double>(stats.bytes));
+	d->metrics->publicationsExpired->set(static_cast<double>(stats.expired));
+	d->metrics->publicationsRejected->set(static_cast<double>(stats.rejected));
+}
+
 void Core::setLabel(const std::string &label) {
 	L_D();
 	d->logLabel = label;
@@ -33,6 +33,7 @@
 #include "call/call-log.h"
 #include "conference/conference-id.h"
 #include "event-log/event-log.h"
+#include "event/publication-store.h"
 #include "linphone/types.h"
 #include "object/object.h"
 #include "sal/event-op.h"
@@ -81,6 +82,7 @@ class LINPHONE_PUBLIC Core : public Object {
 	friend class BasicToClientGroupChatRoom;
 	friend class BasicToClientGroupChatRoomPrivate;
 	friend class Call;
+	friend class CallLogIterator;
 	friend class CallSession;
 	friend class ChatMessage;
 	friend class ChatMessagePrivate;
@@ -105,6 +107,7 @@ class LINPHONE_PUBLIC Core : public Object {
 	friend class CallSessionPrivate;
 	friend class ToneManager;
 	friend class EventLog;
+	friend class EventLogIterator;
 
 	friend class MediaConference::Conference;
 	friend class MediaConference::LocalConference;
@@ -375,8 +378,14 @@ public:
 	// Publish.
 	// ---------------------------------------------------------------------------
 
-	void addOrUpdatePublishByEtag(SalPublishOp *op, std::shared_ptr<LinphonePrivate::EventPublish>);
+	void addOrUpdatePublishByEtag(SalPublishOp *op,
+	                              std::shared_ptr<LinphonePrivate::EventPublish>,
+	                              const std::string &eventName,
+	                              const SalBodyHandler *body);
 	Core::ETagStatus eTagHandler(SalPublishOp *op, const SalBodyHandler *body);
+	PublicationStore &getPublicationStore();
+	void clearPublications();
+	void readPublicationLimits();
 
 	void setLabel(const std::string &label);
 	const std::string &getLabel() const;
@@ -403,7 +412,12 @@ private:
 	int loadPlugins(const std::string &dir);
 	bool_t dlopenPlugin(const std::string &plugin_path, const std::string plugin_name);
 
-	std::map<std::string, std::shared_ptr<LinphonePrivate::EventPublish>> mPublishByEtag;
+	Core::ETagStatus acceptPublication(SalPublishOp *op, const std::string &eTag, const SalBodyHandler *body);
+	void expirePublications();
+	void updatePublicationMetrics();
+
+	PublicationStore mPublications;
+	belle_sip_source_t *mPublicationExpiryTimer = nullptr;
 
 	L_DECLARE_PRIVATE(Core);
 	L_DISABLE_COPY(Core);
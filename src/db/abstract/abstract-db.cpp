@@ -84,13 +84,13 @@ void AbstractDb::registerBackend(Backend backend) {
 #endif
 }
 
-bool AbstractDb::connect(Backend backend, const string &nameParams) {
+bool AbstractDb::connect(Backend backend, const string &nameParams, const DurabilityProfile &durabilityProfile) {
 #ifdef HAVE_DB_STORAGE
 	L_D();
 	registerBackend(backend);
 
 	d->backend = backend;
-	d->dbSession = DbSession((backend == Mysql ? "mysql://" : "sqlite3://") + nameParams);
+	d->dbSession = DbSession((backend == Mysql ? "mysql://" : "sqlite3://") + nameParams, durabilityProfile);
 
 	if (d->dbSession) {
 		try {
@@ -142,6 +142,7 @@ bool AbstractDb::forceReconnect() {
 			try {
 				lInfo() << "Reconnect... Try: " << i;
 				d->dbSession.getBackendSession()->reconnect(); // Equivalent to close and connect.
+				d->dbSession.applyDurabilityProfile();
 				d->safeInit();
 				lInfo() << "Database reconnection successful!";
 				return true;
@@ -169,6 +170,32 @@ bool AbstractDb::import(Backend, const string &) {
 	return false;
 }
 
+AbstractDb::DurabilityProfile AbstractDb::DurabilityProfile::fromName(const string &name) {
+	DurabilityProfile profile;
+	if (name.empty() || name == "default") return profile;
+
+	if (name == "safe") {
+		// A crash or a power loss never loses a committed transaction.
+		profile.journalMode = "DELETE";
+		profile.synchronous = "FULL";
+	} else if (name == "balanced") {
+		// Write-ahead log: a power loss may roll back the last transactions but never corrupts the database.
+		profile.journalMode = "WAL";
+		profile.synchronous = "NORMAL";
+		profile.cacheSize = -8192;
+	} else if (name == "fast") {
+		// No fsync at all: an OS crash or a power loss may corrupt the database.
+		profile.journalMode = "MEMORY";
+		profile.synchronous = "OFF";
+		profile.cacheSize = -16384;
+		profile.mmapSize = 64 * 1024 * 1024;
+	} else {
+		lWarning() << "Unknown database durability profile `" << name << "`, using SQLite defaults.";
+	}
+
+	return profile;
+}
+
 // -----------------------------------------------------------------------------
 
 void AbstractDb::init() {
@@ -21,6 +21,8 @@
 #ifndef _L_ABSTRACT_DB_H_
 #define _L_ABSTRACT_DB_H_
 
+#include <string>
+
 #include "object/object.h"
 #include "utils/general-internal.h"
 
@@ -34,6 +36,20 @@ class LINPHONE_INTERNAL_PUBLIC AbstractDb : public Object {
 public:
 	enum Backend { Mysql, Sqlite3 };
 
+	/*
+	 * SQLite settings trading write cost against crash safety, applied each time the database is opened.
+	 * Empty or negative values keep the SQLite defaults. The MySQL backend ignores them.
+	 */
+	struct DurabilityProfile {
+		std::string journalMode; // DELETE, TRUNCATE, PERSIST, MEMORY, WAL or OFF.
+		std::string synchronous; // OFF, NORMAL, FULL or EXTRA.
+		int cacheSize = 0;       // As PRAGMA cache_size: pages if positive, KiB if negative, 0 for the default.
+		long long mmapSize = -1; // In bytes.
+
+		// Predefined profiles: "default" (SQLite defaults), "safe", "balanced" and "fast".
+		static DurabilityProfile fromName(const std::string &name);
+	};
+
 	virtual ~AbstractDb() = default;
 
 	/*
@@ -45,7 +61,9 @@ public:
 	 * The meaning of these optional parameters is implementation dependant, refer to SOCI documentation for more
 	 * details.
 	 */
-	bool connect(Backend backend, const std::string &nameParams);
+	bool connect(Backend backend,
+	             const std::string &nameParams,
+	             const DurabilityProfile &durabilityProfile = DurabilityProfile());
 	void disconnect();
 
 	bool forceReconnect();
@@ -26,6 +26,7 @@
 #include "linphone/utils/utils.h"
 
 #include "abstract/abstract-db-p.h"
+#include "call/call-history-cache.h"
 #include "conference/participant-info.h"
 #include "containers/lru-cache.h"
 #include "event-log/event-log.h"
@@ -44,6 +45,7 @@ public:
 	mutable std::unordered_map<long long, ConferenceId> storageIdToConferenceId;
 	mutable std::unordered_map<long long, std::weak_ptr<CallLog>> storageIdToCallLog;
 	mutable std::unordered_map<long long, std::weak_ptr<ConferenceInfo>> storageIdToConferenceInfo;
+	mutable CallHistoryCache callHistoryCache;
 
 private:
 	// ---------------------------------------------------------------------------
@@ -52,6 +54,8 @@ private:
 
 	std::shared_ptr<AbstractChatRoom> findChatRoom(const ConferenceId &conferenceId) const;
 	std::shared_ptr<MediaConference::Conference> findAudioVideoConference(const ConferenceId &conferenceId) const;
+	// The unread chat message count of the chat room changed, the totals of the core must read it again.
+	void invalidateUnreadChatMessageCount(const ConferenceId &conferenceId) const;
 
 	// ---------------------------------------------------------------------------
 	// Low level API.
@@ -69,7 +73,6 @@ private:
 	                                     const std::string &deviceName);
 	void
 	insertChatMessageParticipant(long long chatMessageId, long long sipAddressId, int state, time_t stateChangeTime);
-	ParticipantInfo::participant_params_t selectConferenceInfoParticipantParams(const long long participantId) const;
 	ParticipantInfo::participant_params_t
 	migrateConferenceInfoParticipantParams(const ParticipantInfo::participant_params_t &unprocessedParticipantParams,
 	                                       const long long participantId) const;
@@ -169,7 +172,7 @@ private:
 
 	long long insertEvent(const std::shared_ptr<EventLog> &eventLog);
 	long long insertConferenceEvent(const std::shared_ptr<EventLog> &eventLog, long long *chatRoomId = nullptr);
-	long long insertConferenceCallEvent(const std::shared_ptr<EventLog> &eventLog);
+	long long insertConferenceCallEvent(const std::shared_ptr<EventLog> &eventLog, long long &conferenceCallId);
 	long long insertConferenceChatMessageEvent(const std::shared_ptr<EventLog> &eventLog);
 	long long insertConferenceChatMessageReactionEvent(const std::shared_ptr<EventLog> &eventLog);
 	void updateConferenceChatMessageEvent(const std::shared_ptr<EventLog> &eventLog);
@@ -197,6 +200,11 @@ private:
 
 #ifdef HAVE_DB_STORAGE
 	std::shared_ptr<CallLog> selectCallLog(const soci::row &row) const;
+
+	void loadCallHistoryCache() const;
+	// To be called once the call history changes are committed.
+	void updateCallHistoryCache(long long conferenceCallId, const std::shared_ptr<CallLog> &callLog) const;
+	std::list<std::shared_ptr<CallLog>> getCallLogs(const std::list<long long> &ids) const;
 #endif
 
 	// ---------------------------------------------------------------------------
@@ -204,7 +212,10 @@ private:
 	// ---------------------------------------------------------------------------
 
 #ifdef HAVE_DB_STORAGE
-	std::shared_ptr<ConferenceInfo> selectConferenceInfo(const soci::row &row);
+	// Loads the conference infos of the rows with a fixed number of queries, whatever their number of participants.
+	std::list<std::shared_ptr<ConferenceInfo>> selectConferenceInfos(soci::rowset<soci::row> &rows);
+	std::shared_ptr<ConferenceInfo> selectConferenceInfo(soci::rowset<soci::row> &rows);
+	void migrateConferenceInfos();
 #endif
 
 	// ---------------------------------------------------------------------------
@@ -29,6 +29,7 @@
 #endif
 
 #include <ctime>
+#include <limits>
 
 #include <bctoolbox/defs.h>
 
@@ -75,7 +76,7 @@ LINPHONE_BEGIN_NAMESPACE
 
 #ifdef HAVE_DB_STORAGE
 namespace {
-constexpr unsigned int ModuleVersionEvents = makeVersion(1, 0, 29);
+constexpr unsigned int ModuleVersionEvents = makeVersion(1, 0, 30);
 constexpr unsigned int ModuleVersionFriends = makeVersion(1, 0, 1);
 constexpr unsigned int ModuleVersionLegacyFriendsImport = makeVersion(1, 0, 0);
 constexpr unsigned int ModuleVersionLegacyHistoryImport = makeVersion(1, 0, 0);
@@ -154,6 +155,29 @@ static T getValueFromRow(const soci::row &row, int index, bool &isNull) {
 	}
 	return row.get<T>(size_t(index));
 }
+
+// Runs a query ending with an "IN (" list of bound ids, by batches that stay below the backends parameter limits.
+template <typename Function>
+static void forEachRowWithIds(soci::session *session,
+                              const string &queryBegin,
+                              const string &queryEnd,
+                              const vector<long long> &ids,
+                              Function &&onRow) {
+	constexpr size_t maxIdsPerQuery = 500;
+	for (size_t offset = 0; offset < ids.size(); offset += maxIdsPerQuery) {
+		const size_t count = min(maxIdsPerQuery, ids.size() - offset);
+		string placeholders;
+		for (size_t i = 0; i < count; i++)
+			placeholders += (i ? ",:id" : ":id") + to_string(i);
+
+		soci::details::prepare_temp_type statement = (session->prepare << queryBegin + placeholders + queryEnd);
+		for (size_t i = 0; i < count; i++)
+			statement, soci::use(ids[offset + i]);
+		soci::rowset<soci::row> rows(statement);
+		for (const auto &row : rows)
+			onRow(row);
+	}
+}
 #endif
 
 // -----------------------------------------------------------------------------
@@ -299,6 +323,11 @@ MainDbPrivate::findAudioVideoConference(const ConferenceId &conferenceId) const
 	if (!conference) lError() << "Unable to find audio video conference: " << conferenceId << ".";
 	return conference;
 }
+
+void MainDbPrivate::invalidateUnreadChatMessageCount(const ConferenceId &conferenceId) const {
+	L_Q();
+	q->getCore()->getPrivate()->invalidateUnreadChatMessageCount(conferenceId);
+}
 // -----------------------------------------------------------------------------
 // Low level API.
 // -----------------------------------------------------------------------------
@@ -314,16 +343,15 @@ long long MainDbPrivate::insertSipAddress(BCTBX_UNUSED(const std::shared_ptr<Add
 		lInfo() << "Insert new sip address in database: `" << sipAddress << "`.";
 		soci::indicator displayNameInd = displayName.empty() ? soci::i_null : soci::i_ok;
 
-		*dbSession.getBackendSession()
-		    << "INSERT INTO sip_address (value, display_name) VALUES (:sipAddress, :displayName)",
-		    soci::use(sipAddress), soci::use(displayName, displayNameInd);
+		dbSession.execute("INSERT INTO sip_address (value, display_name) VALUES (:sipAddress, :displayName)",
+		                  soci::use(sipAddress), soci::use(displayName, displayNameInd));
 
 		return dbSession.getLastInsertId();
 	} else if (sipAddressId >= 0 && !displayName.empty()) {
 		lInfo() << "Updating sip address display name in database: `" << sipAddress << "`.";
 
-		*dbSession.getBackendSession() << "UPDATE sip_address SET display_name = :displayName WHERE id = :id",
-		    soci::use(displayName), soci::use(sipAddressId);
+		dbSession.execute("UPDATE sip_address SET display_name = :displayName WHERE id = :id", soci::use(displayName),
+		                  soci::use(sipAddressId));
 	}
 
 	return sipAddressId;
@@ -334,13 +362,11 @@ long long MainDbPrivate::insertSipAddress(BCTBX_UNUSED(const std::shared_ptr<Add
 
 void MainDbPrivate::insertContent(long long chatMessageId, const Content &content) {
 #ifdef HAVE_DB_STORAGE
-	soci::session *session = dbSession.getBackendSession();
-
 	const long long &contentTypeId = insertContentType(content.getContentType().getMediaType());
 	const string &body = content.getBodyAsUtf8String();
-	*session << "INSERT INTO chat_message_content (event_id, content_type_id, body, body_encoding_type) VALUES"
-	            " (:chatMessageId, :contentTypeId, :body, 1)",
-	    soci::use(chatMessageId), soci::use(contentTypeId), soci::use(body);
+	dbSession.execute("INSERT INTO chat_message_content (event_id, content_type_id, body, body_encoding_type) VALUES"
+	                  " (:chatMessageId, :contentTypeId, :body, 1)",
+	                  soci::use(chatMessageId), soci::use(contentTypeId), soci::use(body));
 
 	const long long &chatMessageContentId = dbSession.getLastInsertId();
 	if (content.isFile()) {
@@ -349,30 +375,30 @@ void MainDbPrivate::insertContent(long long chatMessageId, const Content &conten
 		const size_t &size = fileContent.getFileSize();
 		const string &path = fileContent.getFilePath();
 		int duration = fileContent.getFileDuration();
-		*session << "INSERT INTO chat_message_file_content (chat_message_content_id, name, size, path, duration) VALUES"
-		            " (:chatMessageContentId, :name, :size, :path, :duration)",
-		    soci::use(chatMessageContentId), soci::use(name), soci::use(size), soci::use(path), soci::use(duration);
+		dbSession.execute(
+		    "INSERT INTO chat_message_file_content (chat_message_content_id, name, size, path, duration) VALUES"
+		    " (:chatMessageContentId, :name, :size, :path, :duration)",
+		    soci::use(chatMessageContentId), soci::use(name), soci::use(size), soci::use(path), soci::use(duration));
 	}
 
 	for (const auto &property : content.getProperties()) {
-		*session << "INSERT INTO chat_message_content_app_data (chat_message_content_id, name, data) VALUES"
-		            " (:chatMessageContentId, :name, :data)",
-		    soci::use(chatMessageContentId), soci::use(property.first), soci::use(property.second.getValue<string>());
+		const string &data = property.second.getValue<string>();
+		dbSession.execute("INSERT INTO chat_message_content_app_data (chat_message_content_id, name, data) VALUES"
+		                  " (:chatMessageContentId, :name, :data)",
+		                  soci::use(chatMessageContentId), soci::use(property.first), soci::use(data));
 	}
 #endif
 }
 
 long long MainDbPrivate::insertContentType(const string &contentType) {
 #ifdef HAVE_DB_STORAGE
-	soci::session *session = dbSession.getBackendSession();
-
 	long long contentTypeId;
-	*session << "SELECT id FROM content_type WHERE value = :contentType", soci::use(contentType),
-	    soci::into(contentTypeId);
-	if (session->got_data()) return contentTypeId;
+	if (dbSession.execute("SELECT id FROM content_type WHERE value = :contentType", soci::use(contentType),
+	                      soci::into(contentTypeId)))
+		return contentTypeId;
 
 	lInfo() << "Insert new content type in database: `" << contentType << "`.";
-	*session << "INSERT INTO content_type (value) VALUES (:contentType)", soci::use(contentType);
+	dbSession.execute("INSERT INTO content_type (value) VALUES (:contentType)", soci::use(contentType));
 	return dbSession.getLastInsertId();
 #else
 	return -1;
@@ -563,11 +589,11 @@ void MainDbPrivate::insertChatMessageParticipant(long long chatMessageId,
 	L_Q();
 	if (q->isInitialized()) {
 		auto stateChangeTm = dbSession.getTimeWithSociIndicator(stateChangeTime);
-		*dbSession.getBackendSession()
-		    << "INSERT INTO chat_message_participant (event_id, participant_sip_address_id, state, state_change_time)"
-		       " VALUES (:chatMessageId, :sipAddressId, :state, :stateChangeTm)",
+		dbSession.execute(
+		    "INSERT INTO chat_message_participant (event_id, participant_sip_address_id, state, state_change_time)"
+		    " VALUES (:chatMessageId, :sipAddressId, :state, :stateChangeTm)",
 		    soci::use(chatMessageId), soci::use(sipAddressId), soci::use(state),
-		    soci::use(stateChangeTm.first, stateChangeTm.second);
+		    soci::use(stateChangeTm.first, stateChangeTm.second));
 	}
 #endif
 }
@@ -957,10 +983,10 @@ long long MainDbPrivate::selectSipAddressId(const string &sipAddress) const {
 #ifdef HAVE_DB_STORAGE
 	long long sipAddressId;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectSipAddressId), soci::use(sipAddress), soci::into(sipAddressId);
-
-	return session->got_data() ? sipAddressId : -1;
+	return dbSession.execute(Statements::get(Statements::SelectSipAddressId), soci::use(sipAddress),
+	                         soci::into(sipAddressId))
+	           ? sipAddressId
+	           : -1;
 #else
 	return -1;
 #endif
@@ -970,10 +996,10 @@ std::string MainDbPrivate::selectSipAddressFromId(long long sipAddressId) const
 #ifdef HAVE_DB_STORAGE
 	std::string sipAddress;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectSipAddressFromId), soci::use(sipAddressId), soci::into(sipAddress);
-
-	return session->got_data() ? sipAddress : std::string();
+	return dbSession.execute(Statements::get(Statements::SelectSipAddressFromId), soci::use(sipAddressId),
+	                         soci::into(sipAddress))
+	           ? sipAddress
+	           : std::string();
 #else
 	return std::string();
 #endif
@@ -983,11 +1009,10 @@ long long MainDbPrivate::selectChatRoomId(long long peerSipAddressId, long long
 #ifdef HAVE_DB_STORAGE
 	long long chatRoomId;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectChatRoomId), soci::use(peerSipAddressId),
-	    soci::use(localSipAddressId), soci::into(chatRoomId);
-
-	return session->got_data() ? chatRoomId : -1;
+	return dbSession.execute(Statements::get(Statements::SelectChatRoomId), soci::use(peerSipAddressId),
+	                         soci::use(localSipAddressId), soci::into(chatRoomId))
+	           ? chatRoomId
+	           : -1;
 #else
 	return -1;
 #endif
@@ -1018,9 +1043,8 @@ ConferenceId MainDbPrivate::selectConferenceId(const long long chatRoomId) const
 	string peerSipAddress;
 	string localSipAddress;
 
-	string query = "SELECT peer_sip_address_id, local_sip_address_id FROM chat_room WHERE id = :1";
-	soci::session *session = dbSession.getBackendSession();
-	*session << query, soci::use(chatRoomId), soci::into(peerSipAddress), soci::into(localSipAddress);
+	static const string query = "SELECT peer_sip_address_id, local_sip_address_id FROM chat_room WHERE id = :1";
+	dbSession.execute(query, soci::use(chatRoomId), soci::into(peerSipAddress), soci::into(localSipAddress));
 
 	ConferenceId conferenceId = ConferenceId(Address::create(peerSipAddress), Address::create(localSipAddress));
 
@@ -1038,11 +1062,10 @@ long long MainDbPrivate::selectChatRoomParticipantId(long long chatRoomId, long
 #ifdef HAVE_DB_STORAGE
 	long long chatRoomParticipantId;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectChatRoomParticipantId), soci::use(chatRoomId),
-	    soci::use(participantSipAddressId), soci::into(chatRoomParticipantId);
-
-	return session->got_data() ? chatRoomParticipantId : -1;
+	return dbSession.execute(Statements::get(Statements::SelectChatRoomParticipantId), soci::use(chatRoomId),
+	                         soci::use(participantSipAddressId), soci::into(chatRoomParticipantId))
+	           ? chatRoomParticipantId
+	           : -1;
 #else
 	return -1;
 #endif
@@ -1055,12 +1078,11 @@ MainDbPrivate::selectOneToOneChatRoomId(long long sipAddressIdA, long long sipAd
 	const int encryptedCapability = int(ChatRoom::Capabilities::Encrypted);
 	const int expectedCapabilities = encrypted ? encryptedCapability : 0;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectOneToOneChatRoomId), soci::use(sipAddressIdA, "1"),
-	    soci::use(sipAddressIdB, "2"), soci::use(encryptedCapability, "3"), soci::use(expectedCapabilities, "4"),
-	    soci::into(chatRoomId);
-
-	return session->got_data() ? chatRoomId : -1;
+	return dbSession.execute(Statements::get(Statements::SelectOneToOneChatRoomId), soci::use(sipAddressIdA, "1"),
+	                         soci::use(sipAddressIdB, "2"), soci::use(encryptedCapability, "3"),
+	                         soci::use(expectedCapabilities, "4"), soci::into(chatRoomId))
+	           ? chatRoomId
+	           : -1;
 #else
 	return -1;
 #endif
@@ -1070,11 +1092,10 @@ long long MainDbPrivate::selectConferenceInfoId(long long uriSipAddressId) {
 #ifdef HAVE_DB_STORAGE
 	long long conferenceInfoId;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectConferenceInfoId), soci::use(uriSipAddressId),
-	    soci::into(conferenceInfoId);
-
-	return session->got_data() ? conferenceInfoId : -1;
+	return dbSession.execute(Statements::get(Statements::SelectConferenceInfoId), soci::use(uriSipAddressId),
+	                         soci::into(conferenceInfoId))
+	           ? conferenceInfoId
+	           : -1;
 #else
 	return -1;
 #endif
@@ -1085,11 +1106,10 @@ long long MainDbPrivate::selectConferenceInfoParticipantId(long long conferenceI
 #ifdef HAVE_DB_STORAGE
 	long long conferenceInfoParticipantId;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectConferenceInfoParticipantId), soci::use(conferenceInfoId),
-	    soci::use(participantSipAddressId), soci::into(conferenceInfoParticipantId);
-
-	return session->got_data() ? conferenceInfoParticipantId : -1;
+	return dbSession.execute(Statements::get(Statements::SelectConferenceInfoParticipantId), soci::use(conferenceInfoId),
+	                         soci::use(participantSipAddressId), soci::into(conferenceInfoParticipantId))
+	           ? conferenceInfoParticipantId
+	           : -1;
 #else
 	return -1;
 #endif
@@ -1099,10 +1119,10 @@ long long MainDbPrivate::selectConferenceCallId(const std::string &callId) {
 #ifdef HAVE_DB_STORAGE
 	long long conferenceCallId;
 
-	soci::session *session = dbSession.getBackendSession();
-	*session << Statements::get(Statements::SelectConferenceCall), soci::use(callId), soci::into(conferenceCallId);
-
-	return session->got_data() ? conferenceCallId : -1;
+	return dbSession.execute(Statements::get(Statements::SelectConferenceCall), soci::use(callId),
+	                         soci::into(conferenceCallId))
+	           ? conferenceCallId
+	           : -1;
 #else
 	return -1;
 #endif
@@ -1355,8 +1375,8 @@ long long MainDbPrivate::insertEvent(const shared_ptr<EventLog> &eventLog) {
 #ifdef HAVE_DB_STORAGE
 	const int &type = int(eventLog->getType());
 	auto creationTime = dbSession.getTimeWithSociIndicator(eventLog->getCreationTime());
-	*dbSession.getBackendSession() << "INSERT INTO event (type, creation_time) VALUES (:type, :creationTime)",
-	    soci::use(type), soci::use(creationTime.first, creationTime.second);
+	dbSession.execute("INSERT INTO event (type, creation_time) VALUES (:type, :creationTime)", soci::use(type),
+	                  soci::use(creationTime.first, creationTime.second));
 
 	return dbSession.getLastInsertId();
 #else
@@ -1379,9 +1399,8 @@ long long MainDbPrivate::insertConferenceEvent(const shared_ptr<EventLog> &event
 		eventId = insertEvent(eventLog);
 
 		soci::session *session = dbSession.getBackendSession();
-		*session << "INSERT INTO conference_event (event_id, chat_room_id)"
-		            " VALUES (:eventId, :chatRoomId)",
-		    soci::use(eventId), soci::use(curChatRoomId);
+		dbSession.execute("INSERT INTO conference_event (event_id, chat_room_id) VALUES (:eventId, :chatRoomId)",
+		                  soci::use(eventId), soci::use(curChatRoomId));
 
 		if (eventLog->getType() == EventLog::Type::ConferenceTerminated)
 			*session << "UPDATE chat_room SET flags = 1, last_notify_id = 0 WHERE id = :chatRoomId",
@@ -1398,14 +1417,14 @@ long long MainDbPrivate::insertConferenceEvent(const shared_ptr<EventLog> &event
 #endif
 }
 
-long long MainDbPrivate::insertConferenceCallEvent(const shared_ptr<EventLog> &eventLog) {
+long long MainDbPrivate::insertConferenceCallEvent(const shared_ptr<EventLog> &eventLog, long long &conferenceCallId) {
 #ifdef HAVE_DB_STORAGE
 	shared_ptr<ConferenceCallEvent> conferenceCallEvent = static_pointer_cast<ConferenceCallEvent>(eventLog);
 
 	long long eventId = -1;
 	auto callLog = conferenceCallEvent->getCallLog();
 	auto conferenceInfo = conferenceCallEvent->getConferenceInfo();
-	long long conferenceCallId = selectConferenceCallId(callLog->getCallId());
+	conferenceCallId = selectConferenceCallId(callLog->getCallId());
 
 	EventLog::Type type = conferenceCallEvent->getType();
 	switch (type) {
@@ -1476,23 +1495,22 @@ long long MainDbPrivate::insertConferenceChatMessageEvent(const shared_ptr<Event
 	}
 	const long long &replyToSipAddressId = sipAddressId;
 
-	*dbSession.getBackendSession()
-	    << "INSERT INTO conference_chat_message_event ("
-	       "  event_id, from_sip_address_id, to_sip_address_id,"
-	       "  time, state, direction, imdn_message_id, is_secured,"
-	       "  delivery_notification_required, display_notification_required,"
-	       "  marked_as_read, forward_info, call_id, reply_message_id, reply_sender_address_id"
-	       ") VALUES ("
-	       "  :eventId, :localSipaddressId, :remoteSipaddressId,"
-	       "  :time, :state, :direction, :imdnMessageId, :isSecured,"
-	       "  :deliveryNotificationRequired, :displayNotificationRequired,"
-	       "  :markedAsRead, :forwardInfo, :callId, :replyMessageId, :replyToSipAddressId"
-	       ")",
-	    soci::use(eventId), soci::use(fromSipAddressId), soci::use(toSipAddressId),
-	    soci::use(messageTime.first, messageTime.second), soci::use(state), soci::use(direction),
-	    soci::use(imdnMessageId), soci::use(isSecured), soci::use(deliveryNotificationRequired),
-	    soci::use(displayNotificationRequired), soci::use(markedAsRead), soci::use(forwardInfo), soci::use(callId),
-	    soci::use(replyMessageId), soci::use(replyToSipAddressId);
+	dbSession.execute("INSERT INTO conference_chat_message_event ("
+	                  "  event_id, from_sip_address_id, to_sip_address_id,"
+	                  "  time, state, direction, imdn_message_id, is_secured,"
+	                  "  delivery_notification_required, display_notification_required,"
+	                  "  marked_as_read, forward_info, call_id, reply_message_id, reply_sender_address_id"
+	                  ") VALUES ("
+	                  "  :eventId, :localSipaddressId, :remoteSipaddressId,"
+	                  "  :time, :state, :direction, :imdnMessageId, :isSecured,"
+	                  "  :deliveryNotificationRequired, :displayNotificationRequired,"
+	                  "  :markedAsRead, :forwardInfo, :callId, :replyMessageId, :replyToSipAddressId"
+	                  ")",
+	                  soci::use(eventId), soci::use(fromSipAddressId), soci::use(toSipAddressId),
+	                  soci::use(messageTime.first, messageTime.second), soci::use(state), soci::use(direction),
+	                  soci::use(imdnMessageId), soci::use(isSecured), soci::use(deliveryNotificationRequired),
+	                  soci::use(displayNotificationRequired), soci::use(markedAsRead), soci::use(forwardInfo),
+	                  soci::use(callId), soci::use(replyMessageId), soci::use(replyToSipAddressId));
 
 	if (isEphemeral) {
 		long ephemeralLifetime = chatMessage->getEphemeralLifetime();
@@ -1515,12 +1533,13 @@ long long MainDbPrivate::insertConferenceChatMessageEvent(const shared_ptr<Event
 	}
 
 	const long long &dbChatRoomId = selectChatRoomId(chatRoom->getConferenceId());
-	*dbSession.getBackendSession() << "UPDATE chat_room SET last_message_id = :1 WHERE id = :2", soci::use(eventId),
-	    soci::use(dbChatRoomId);
+	dbSession.execute("UPDATE chat_room SET last_message_id = :1 WHERE id = :2", soci::use(eventId),
+	                  soci::use(dbChatRoomId));
 
 	if (direction == int(ChatMessage::Direction::Incoming) && !markedAsRead) {
 		int *count = unreadChatMessageCountCache[chatRoom->getConferenceId()];
 		if (count) ++*count;
+		invalidateUnreadChatMessageCount(chatRoom->getConferenceId());
 	}
 	return eventId;
 #else
@@ -1599,6 +1618,7 @@ void MainDbPrivate::updateConferenceChatMessageEvent(const shared_ptr<EventLog>
 			L_ASSERT(*count > 0);
 			--*count;
 		}
+		if (!dbMarkedAsRead) invalidateUnreadChatMessageCount(chatRoom->getConferenceId());
 	}
 
 	// 3. Update chat message event.
@@ -1977,30 +1997,94 @@ std::shared_ptr<CallLog> MainDbPrivate::selectCallLog(const soci::row &row) cons
 
 	return callLog;
 }
+
+void MainDbPrivate::loadCallHistoryCache() const {
+	if (callHistoryCache.isLoaded()) return;
+
+	static const string query =
+	    "SELECT conference_call.id, from_sip_address_id, from_sip_address.value, to_sip_address_id, "
+	    "to_sip_address.value, direction, duration, start_time, status, call_id, conference_info_id"
+	    " FROM conference_call, sip_address AS from_sip_address, sip_address AS to_sip_address"
+	    " WHERE conference_call.from_sip_address_id = from_sip_address.id AND "
+	    "conference_call.to_sip_address_id = to_sip_address.id";
+
+	DurationLogger durationLogger("Load call history cache.");
+
+	// The same addresses are found in many calls, parse each of them only once.
+	unordered_map<long long, string> addressKeys;
+	auto getAddressKey = [this, &addressKeys](const soci::row &row, int col) -> const string & {
+		const long long &sipAddressId = dbSession.resolveId(row, col);
+		auto it = addressKeys.find(sipAddressId);
+		if (it == addressKeys.end())
+			it = addressKeys
+			         .emplace(sipAddressId,
+			                  CallHistoryCache::getAddressKey(Address::create(row.get<string>(col + 1))))
+			         .first;
+		return it->second;
+	};
+
+	callHistoryCache.clear();
+
+	soci::rowset<soci::row> rows = (dbSession.getBackendSession()->prepare << query);
+	for (const auto &row : rows) {
+		CallHistoryCache::Call call;
+		call.direction = static_cast<LinphoneCallDir>(row.get<int>(5));
+		const string &fromKey = getAddressKey(row, 1);
+		const string &toKey = getAddressKey(row, 3);
+		call.localKey = call.direction == LinphoneCallOutgoing ? fromKey : toKey;
+		call.peerKey = call.direction == LinphoneCallOutgoing ? toKey : fromKey;
+		call.duration = row.get<int>(6);
+		call.startTime = dbSession.getTime(row, 7);
+		call.status = static_cast<LinphoneCallStatus>(row.get<int>(8));
+		if (row.get_indicator(9) == soci::i_ok) call.callId = row.get<string>(9);
+		call.conference = row.get_indicator(10) == soci::i_ok;
+
+		callHistoryCache.update(dbSession.resolveId(row, 0), std::move(call));
+	}
+
+	callHistoryCache.setLoaded();
+}
+
+void MainDbPrivate::updateCallHistoryCache(long long conferenceCallId, const shared_ptr<CallLog> &callLog) const {
+	if (conferenceCallId < 0) return;
+	if (callHistoryCache.isLoaded()) callHistoryCache.update(conferenceCallId, callLog);
+}
+
+list<shared_ptr<CallLog>> MainDbPrivate::getCallLogs(const list<long long> &ids) const {
+	// Call logs are usually still alive in memory, only fetch the missing ones from the database.
+	unordered_map<long long, shared_ptr<CallLog>> callLogs;
+	vector<long long> missingIds;
+	for (long long id : ids) {
+		auto callLog = getCallLogFromCache(id);
+		if (callLog) callLogs[id] = callLog;
+		else missingIds.push_back(id);
+	}
+
+	static const string query = "SELECT conference_call.id, from_sip_address.value, from_sip_address.display_name, "
+	                            "to_sip_address.value, to_sip_address.display_name,"
+	                            "  direction, duration, start_time, connected_time, status, video_enabled, quality, "
+	                            "call_id, refkey, conference_info_id"
+	                            " FROM conference_call, sip_address AS from_sip_address, sip_address AS to_sip_address"
+	                            " WHERE conference_call.from_sip_address_id = from_sip_address.id AND "
+	                            "conference_call.to_sip_address_id = to_sip_address.id"
+	                            "  AND conference_call.id IN (";
+	forEachRowWithIds(dbSession.getBackendSession(), query, ")", missingIds, [this, &callLogs](const soci::row &row) {
+		callLogs[dbSession.resolveId(row, 0)] = selectCallLog(row);
+	});
+
+	list<shared_ptr<CallLog>> clList;
+	for (long long id : ids) {
+		auto it = callLogs.find(id);
+		if (it != callLogs.end()) clList.push_back(it->second);
+	}
+	return clList;
+}
 #endif
 
 // ---------------------------------------------------------------------------
 // Conference Info API.
 // ---------------------------------------------------------------------------
 
-ParticipantInfo::participant_params_t
-MainDbPrivate::selectConferenceInfoParticipantParams(BCTBX_UNUSED(const long long participantId)) const {
-	ParticipantInfo::participant_params_t participantParams;
-#ifdef HAVE_DB_STORAGE
-	soci::session *session = dbSession.getBackendSession();
-	static const string participantParamsQuery = "SELECT name, value FROM conference_info_participant_params WHERE "
-	                                             "conference_info_participant_id = :participantId";
-	soci::rowset<soci::row> participantParamsRows =
-	    (session->prepare << participantParamsQuery, soci::use(participantId));
-	for (const auto &participantParamsRow : participantParamsRows) {
-		const auto name = participantParamsRow.get<string>(0);
-		const auto value = participantParamsRow.get<string>(1);
-		participantParams.insert(std::make_pair(name, value));
-	}
-#endif // HAVE_DB_STORAGE
-	return participantParams;
-}
-
 ParticipantInfo::participant_params_t MainDbPrivate::migrateConferenceInfoParticipantParams(
     BCTBX_UNUSED(const ParticipantInfo::participant_params_t &unprocessedParticipantParams),
     BCTBX_UNUSED(const long long participantId)) const {
@@ -2036,136 +2120,195 @@ ParticipantInfo::participant_params_t MainDbPrivate::migrateConferenceInfoPartic
 }
 
 #ifdef HAVE_DB_STORAGE
-shared_ptr<ConferenceInfo> MainDbPrivate::selectConferenceInfo(const soci::row &row) {
-	const long long &dbConferenceInfoId = dbSession.resolveId(row, 0);
+list<shared_ptr<ConferenceInfo>> MainDbPrivate::selectConferenceInfos(soci::rowset<soci::row> &rows) {
+	list<shared_ptr<ConferenceInfo>> conferenceInfos;
 
-	auto conferenceInfo = getConferenceInfoFromCache(dbConferenceInfoId);
-	if (conferenceInfo) {
-		return conferenceInfo;
-	}
+	// The conference infos that are not in the cache, by id, with the organizer stored in table conference_info.
+	struct LoadedConferenceInfo {
+		shared_ptr<ConferenceInfo> conferenceInfo;
+		string organizer;
+		unsigned int icsSequence;
+		shared_ptr<ParticipantInfo> organizerInfo;
+	};
+	map<long long, LoadedConferenceInfo> loadedConferenceInfos;
 
-	conferenceInfo = ConferenceInfo::create();
-	const std::string uriString = row.get<string>(2);
-	std::shared_ptr<Address> uri = Address::create(uriString);
-	conferenceInfo->setUri(uri);
-	const auto &uriStringOrdered = uri->toStringUriOnlyOrdered();
-	if (uriStringOrdered != uriString) {
-		// Update conference address to ensure that a conference info can be successfully searched by its address
-		const long long &uriSipAddressId = insertSipAddress(uri);
-		*dbSession.getBackendSession()
-		    << "UPDATE conference_info SET uri_sip_address_id = :uriSipAddressId WHERE id = :conferenceInfoId",
-		    soci::use(uriSipAddressId), soci::use(dbConferenceInfoId);
-	}
-
-	conferenceInfo->setDateTime(dbSession.getTime(row, 3));
-	conferenceInfo->setDuration(dbSession.getUnsignedInt(row, 4, 0));
-	conferenceInfo->setUtf8Subject(row.get<string>(5));
-	conferenceInfo->setUtf8Description(row.get<string>(6));
-	conferenceInfo->setState(
-	    ConferenceInfo::State(row.get<int>(7))); // state is a TinyInt in database, don't cast it to unsigned, otherwise
-	                                             // you'll get a std::bad_cast from soci.
-	unsigned int icsSequence = dbSession.getUnsignedInt(row, 8, 0);
-	conferenceInfo->setIcsSequence(icsSequence);
-
-	conferenceInfo->setIcsUid(row.get<string>(9));
-	conferenceInfo->setSecurityLevel(
-	    static_cast<ConferenceParams::SecurityLevel>(dbSession.getUnsignedInt(row, 10, 0)));
-
-	// For backward compability purposes, get the organizer from conference_info table and set the sequence number to
-	// that of the conference info stored in the db It may be overridden if the conference organizer has been stored in
-	// table conference_info_organizer.
-	std::shared_ptr<Address> organizerAddress = Address::create(row.get<string>(1));
-	ParticipantInfo::participant_params_t organizerParams;
-	organizerParams.insert(std::make_pair(ParticipantInfo::sequenceParameter, std::to_string(icsSequence)));
-	static const string organizerQuery =
-	    "SELECT sip_address.id, sip_address.value, conference_info_organizer.params, conference_info_organizer.id"
-	    " FROM sip_address, conference_info, conference_info_organizer"
-	    " WHERE conference_info.id = :conferenceInfoId"
-	    " AND sip_address.id = conference_info_organizer.organizer_sip_address_id"
-	    " AND conference_info_organizer.conference_info_id = conference_info.id";
+	for (const auto &row : rows) {
+		const long long &dbConferenceInfoId = dbSession.resolveId(row, 0);
+
+		auto conferenceInfo = getConferenceInfoFromCache(dbConferenceInfoId);
+		if (!conferenceInfo) {
+			conferenceInfo = ConferenceInfo::create();
+			conferenceInfo->setUri(Address::create(row.get<string>(2)));
+			conferenceInfo->setDateTime(dbSession.getTime(row, 3));
+			conferenceInfo->setDuration(dbSession.getUnsignedInt(row, 4, 0));
+			conferenceInfo->setUtf8Subject(row.get<string>(5));
+			conferenceInfo->setUtf8Description(row.get<string>(6));
+			conferenceInfo->setState(ConferenceInfo::State(
+			    row.get<int>(7))); // state is a TinyInt in database, don't cast it to unsigned, otherwise
+			                       // you'll get a std::bad_cast from soci.
+			unsigned int icsSequence = dbSession.getUnsignedInt(row, 8, 0);
+			conferenceInfo->setIcsSequence(icsSequence);
+			conferenceInfo->setIcsUid(row.get<string>(9));
+			conferenceInfo->setSecurityLevel(
+			    static_cast<ConferenceParams::SecurityLevel>(dbSession.getUnsignedInt(row, 10, 0)));
+			loadedConferenceInfos[dbConferenceInfoId] = {conferenceInfo, row.get<string>(1), icsSequence, nullptr};
+		}
+		conferenceInfos.push_back(conferenceInfo);
+	}
 
-	soci::session *session = dbSession.getBackendSession();
-	soci::rowset<soci::row> organizerRows = (session->prepare << organizerQuery, soci::use(dbConferenceInfoId));
-	const auto &organizerRowIt = organizerRows.begin();
-	if (organizerRowIt != organizerRows.end()) {
-		const auto &organizerRow = (*organizerRowIt);
-		const long long &organizerSipAddressId = dbSession.resolveId(organizerRow, 0);
-		organizerAddress = Address::create(organizerRow.get<string>(1));
-		const string organizerParamsStr = organizerRow.get<string>(2);
-		const long long &organizerId = dbSession.resolveId(organizerRow, 3);
+	if (loadedConferenceInfos.empty()) return conferenceInfos;
 
-		// The flag is_participant is set to true here as by default the organizer is also a participant
-		const long long organizerIdInParticipantTable =
-		    insertOrUpdateConferenceInfoOrganizer(dbConferenceInfoId, organizerSipAddressId, organizerParams, true);
-		const auto unprocessedOrganizerParams = ParticipantInfo::stringToMemberParameters(organizerParamsStr);
-		organizerParams =
-		    migrateConferenceInfoParticipantParams(unprocessedOrganizerParams, organizerIdInParticipantTable);
-
-		// Delete entry from conference info organizer
-		*session << "DELETE FROM conference_info_organizer WHERE id = :organizerId", soci::use(organizerId);
-	} else {
-		static const string organizerInParticipantTableQuery =
-		    "SELECT sip_address.value, conference_info_participant.id"
-		    " FROM sip_address, conference_info, conference_info_participant"
-		    " WHERE conference_info.id = :conferenceInfoId"
-		    " AND sip_address.id = conference_info_participant.participant_sip_address_id"
-		    " AND conference_info_participant.conference_info_id = conference_info.id AND "
-		    "conference_info_participant.is_organizer = 1";
-
-		soci::rowset<soci::row> organizerInParticipantTableRows =
-		    (session->prepare << organizerInParticipantTableQuery, soci::use(dbConferenceInfoId));
-		const auto &organizerInParticipantTableRowIt = organizerInParticipantTableRows.begin();
-		if (organizerInParticipantTableRowIt != organizerInParticipantTableRows.end()) {
-			const auto &organizerInParticipantTableRow = (*organizerInParticipantTableRowIt);
-			organizerAddress = Address::create(organizerInParticipantTableRow.get<string>(0));
-
-			const long long &organizerId = dbSession.resolveId(organizerInParticipantTableRow, 1);
-			organizerParams = selectConferenceInfoParticipantParams(organizerId);
+	// Fetch the organizers and participants of all the conference infos at once, by lists of bound ids short enough
+	// for every backend. Members are sorted by id, which is their insertion order.
+	struct Member {
+		long long conferenceInfoId;
+		shared_ptr<Address> address;
+		bool isOrganizer;
+		bool isParticipant;
+		ParticipantInfo::participant_params_t params;
+	};
+	map<long long, Member> members;
+	// Many conferences share the same participants: parse each address once.
+	unordered_map<long long, shared_ptr<Address>> addresses;
+
+	vector<long long> ids;
+	ids.reserve(loadedConferenceInfos.size());
+	for (const auto &entry : loadedConferenceInfos)
+		ids.push_back(entry.first);
+
+	static const string membersQuery =
+	    "SELECT conference_info_participant.id, conference_info_participant.conference_info_id, sip_address.id,"
+	    " sip_address.value, conference_info_participant.is_organizer, conference_info_participant.is_participant,"
+	    " conference_info_participant.deleted"
+	    " FROM conference_info_participant, sip_address"
+	    " WHERE sip_address.id = conference_info_participant.participant_sip_address_id"
+	    " AND conference_info_participant.conference_info_id IN (";
+	forEachRowWithIds(dbSession.getBackendSession(), membersQuery, ")", ids,
+	                  [this, &members, &addresses](const soci::row &memberRow) {
+		                  const long long &sipAddressId = dbSession.resolveId(memberRow, 2);
+		                  auto &address = addresses[sipAddressId];
+		                  if (!address) address = Address::create(memberRow.get<string>(3));
+		                  members[dbSession.resolveId(memberRow, 0)] = {
+		                      dbSession.resolveId(memberRow, 1), address, memberRow.get<int>(4) != 0,
+		                      (memberRow.get<int>(5) != 0) && (memberRow.get<int>(6) == 0),
+		                      ParticipantInfo::participant_params_t()};
+	                  });
+
+	static const string paramsQuery =
+	    "SELECT conference_info_participant_params.conference_info_participant_id,"
+	    " conference_info_participant_params.name, conference_info_participant_params.value"
+	    " FROM conference_info_participant_params, conference_info_participant"
+	    " WHERE conference_info_participant.id = conference_info_participant_params.conference_info_participant_id"
+	    " AND conference_info_participant.conference_info_id IN (";
+	forEachRowWithIds(dbSession.getBackendSession(), paramsQuery, ")", ids, [this, &members](const soci::row &row) {
+		auto member = members.find(dbSession.resolveId(row, 0));
+		if (member != members.end()) member->second.params.insert(make_pair(row.get<string>(1), row.get<string>(2)));
+	});
+
+	// The organizer must be known before adding the participants, as it may be one of them.
+	for (const auto &member : members) {
+		if (!member.second.isOrganizer) continue;
+		auto &loadedConferenceInfo = loadedConferenceInfos[member.second.conferenceInfoId];
+		if (loadedConferenceInfo.organizerInfo) continue;
+		loadedConferenceInfo.organizerInfo = ParticipantInfo::create(member.second.address);
+		loadedConferenceInfo.organizerInfo->setParameters(member.second.params);
+	}
+	for (auto &entry : loadedConferenceInfos) {
+		auto &loadedConferenceInfo = entry.second;
+		if (!loadedConferenceInfo.organizerInfo) {
+			// For backward compability purposes, get the organizer from conference_info table and set the sequence
+			// number to that of the conference info stored in the db.
+			ParticipantInfo::participant_params_t organizerParams;
+			organizerParams.insert(
+			    make_pair(ParticipantInfo::sequenceParameter, to_string(loadedConferenceInfo.icsSequence)));
+			loadedConferenceInfo.organizerInfo =
+			    ParticipantInfo::create(Address::create(loadedConferenceInfo.organizer));
+			loadedConferenceInfo.organizerInfo->setParameters(organizerParams);
 		}
+		loadedConferenceInfo.conferenceInfo->setOrganizer(loadedConferenceInfo.organizerInfo);
+	}
+	for (const auto &member : members) {
+		if (!member.second.isParticipant) continue;
+		auto participantInfo = ParticipantInfo::create(member.second.address);
+		participantInfo->setParameters(member.second.params);
+		loadedConferenceInfos[member.second.conferenceInfoId].conferenceInfo->addParticipant(participantInfo);
 	}
 
-	auto organizerInfo = ParticipantInfo::create(organizerAddress);
-	organizerInfo->setParameters(organizerParams);
-	conferenceInfo->setOrganizer(organizerInfo);
+	for (const auto &[id, loadedConferenceInfo] : loadedConferenceInfos) {
+		cache(loadedConferenceInfo.conferenceInfo, id);
+	}
 
-	static const string participantQuery =
-	    "SELECT sip_address.value, conference_info_participant.deleted, conference_info_participant.params, "
-	    "conference_info_participant.id"
-	    " FROM sip_address, conference_info, conference_info_participant"
-	    " WHERE conference_info.id = :conferenceInfoId"
-	    " AND sip_address.id = conference_info_participant.participant_sip_address_id"
-	    " AND conference_info_participant.conference_info_id = conference_info.id AND "
-	    "conference_info_participant.is_participant = 1";
+	return conferenceInfos;
+}
 
-	soci::rowset<soci::row> participantRows = (session->prepare << participantQuery, soci::use(dbConferenceInfoId));
-	std::string emptyString;
-	for (const auto &participantRow : participantRows) {
-		int deleted = participantRow.get<int>(1);
-		if (deleted == 0) {
-			std::shared_ptr<Address> participantAddress = Address::create(participantRow.get<string>(0));
-			const string participantParamsStr = participantRow.get<string>(2);
-			const long long &participantId = dbSession.resolveId(participantRow, 3);
-			ParticipantInfo::participant_params_t participantParams;
-			auto participantInfo = ParticipantInfo::create(participantAddress);
-			if (participantParamsStr.empty()) {
-				participantParams = selectConferenceInfoParticipantParams(participantId);
-			} else {
-				const auto unprocessedParticipantParams =
-				    ParticipantInfo::stringToMemberParameters(participantParamsStr);
-				participantParams = migrateConferenceInfoParticipantParams(unprocessedParticipantParams, participantId);
-				// Set parameter string to an empty string
-				*session << "UPDATE conference_info_participant SET params = :paramsStr  WHERE conference_info_id  = "
-				            ":conferenceInfoId",
-				    soci::use(emptyString), soci::use(dbConferenceInfoId);
-			}
-			participantInfo->setParameters(participantParams);
-			conferenceInfo->addParticipant(participantInfo);
-		}
+shared_ptr<ConferenceInfo> MainDbPrivate::selectConferenceInfo(soci::rowset<soci::row> &rows) {
+	auto conferenceInfos = selectConferenceInfos(rows);
+	return conferenceInfos.empty() ? nullptr : conferenceInfos.front();
+}
+
+void MainDbPrivate::migrateConferenceInfos() {
+	soci::session *session = dbSession.getBackendSession();
+
+	// Conference addresses used to be stored with their parameters in any order, so that they could not be found by
+	// their address.
+	soci::rowset<soci::row> uriRows =
+	    (session->prepare << "SELECT conference_info.id, sip_address.value FROM conference_info, sip_address"
+	                         " WHERE conference_info.uri_sip_address_id = sip_address.id");
+	list<pair<long long, shared_ptr<Address>>> uris;
+	for (const auto &uriRow : uriRows) {
+		const string uriString = uriRow.get<string>(1);
+		auto uri = Address::create(uriString);
+		if (uri->toStringUriOnlyOrdered() != uriString) uris.push_back(make_pair(dbSession.resolveId(uriRow, 0), uri));
+	}
+	for (const auto &[conferenceInfoId, uri] : uris) {
+		const long long &uriSipAddressId = insertSipAddress(uri);
+		*session << "UPDATE conference_info SET uri_sip_address_id = :uriSipAddressId WHERE id = :conferenceInfoId",
+		    soci::use(uriSipAddressId), soci::use(conferenceInfoId);
 	}
 
-	cache(conferenceInfo, dbConferenceInfoId);
+	// Organizers used to be stored in table conference_info_organizer, with their parameters as a string.
+	struct Organizer {
+		long long id;
+		long long conferenceInfoId;
+		long long sipAddressId;
+		string params;
+		unsigned int icsSequence;
+	};
+	soci::rowset<soci::row> organizerRows =
+	    (session->prepare << "SELECT conference_info_organizer.id, conference_info_organizer.conference_info_id,"
+	                         " conference_info_organizer.organizer_sip_address_id, conference_info_organizer.params,"
+	                         " conference_info.ics_sequence"
+	                         " FROM conference_info_organizer, conference_info"
+	                         " WHERE conference_info_organizer.conference_info_id = conference_info.id");
+	list<Organizer> organizers;
+	for (const auto &organizerRow : organizerRows) {
+		organizers.push_back({dbSession.resolveId(organizerRow, 0), dbSession.resolveId(organizerRow, 1),
+		                      dbSession.resolveId(organizerRow, 2), organizerRow.get<string>(3, ""),
+		                      dbSession.getUnsignedInt(organizerRow, 4, 0)});
+	}
+	for (const auto &organizer : organizers) {
+		ParticipantInfo::participant_params_t organizerParams;
+		organizerParams.insert(make_pair(ParticipantInfo::sequenceParameter, to_string(organizer.icsSequence)));
+		// The flag is_participant is set to true here as by default the organizer is also a participant
+		const long long organizerIdInParticipantTable = insertOrUpdateConferenceInfoOrganizer(
+		    organizer.conferenceInfoId, organizer.sipAddressId, organizerParams, true);
+		migrateConferenceInfoParticipantParams(ParticipantInfo::stringToMemberParameters(organizer.params),
+		                                       organizerIdInParticipantTable);
+		*session << "DELETE FROM conference_info_organizer WHERE id = :organizerId", soci::use(organizer.id);
+	}
 
-	return conferenceInfo;
+	// Participant parameters used to be stored as a string.
+	soci::rowset<soci::row> participantRows =
+	    (session->prepare << "SELECT id, params FROM conference_info_participant WHERE params <> ''");
+	list<pair<long long, string>> participants;
+	for (const auto &participantRow : participantRows) {
+		participants.push_back(make_pair(dbSession.resolveId(participantRow, 0), participantRow.get<string>(1, "")));
+	}
+	for (const auto &[participantId, params] : participants) {
+		migrateConferenceInfoParticipantParams(ParticipantInfo::stringToMemberParameters(params), participantId);
+		*session << "UPDATE conference_info_participant SET params = '' WHERE id = :participantId",
+		    soci::use(participantId);
+	}
 }
 #endif
 
@@ -2847,6 +2990,10 @@ void MainDbPrivate::updateSchema() {
 		*session << "ALTER TABLE friends_list ADD COLUMN type INT NOT NULL DEFAULT -1";
 	}
 
+	if (version < makeVersion(1, 0, 30)) {
+		migrateConferenceInfos();
+	}
+
 	if (getModuleVersion("friends") < makeVersion(1, 0, 1)) {
 		// The sip_address_id field needs to be nullable.
 		// Do not try to copy data from the old table because it was not used before this version (use of an other
@@ -3207,6 +3354,7 @@ void MainDbPrivate::importLegacyCallLogs(DbSession &inDbSession) {
 		}
 
 		tr.commit();
+		callHistoryCache.invalidate();
 		lInfo() << "Successful import of legacy call logs.";
 	};
 }
@@ -3231,6 +3379,12 @@ void MainDb::init() {
 	auto timestampType = bind(&DbSession::timestampType, &d->dbSession);
 	auto varcharPrimaryKeyStr = bind(&DbSession::varcharPrimaryKeyStr, &d->dbSession, _1);
 
+	// Statements prepared before the migration may refer to tables or views which are going to be altered, and
+	// SQLite refuses to drop a table while a statement reading it is still pending: do not cache any statement until
+	// the schema is up to date.
+	const bool statementCacheEnabled = d->dbSession.isStatementCacheEnabled();
+	d->dbSession.enableStatementCache(false);
+
 	initCleanup();
 
 	session->begin();
@@ -3963,11 +4117,13 @@ void MainDb::init() {
 	} catch (const soci::soci_error &e) {
 		lError() << "Exception while creating or updating the database's schema : " << e.what();
 		session->rollback();
+		d->dbSession.enableStatementCache(statementCacheEnabled);
 		// Throw exception so that it can be catched by the calling function
 		throw e;
 		return;
 	}
 	session->commit();
+	d->dbSession.enableStatementCache(statementCacheEnabled);
 
 	initCleanup();
 #endif
@@ -4011,6 +4167,7 @@ bool MainDb::addEvent(const shared_ptr<EventLog> &eventLog) {
 		L_D();
 
 		long long eventId = -1;
+		long long conferenceCallId = -1;
 
 		EventLog::Type type = eventLog->getType();
 		lInfo() << "MainDb::addEvent() of type " << type << " (value " << static_cast<int>(type) << ")";
@@ -4026,7 +4183,7 @@ bool MainDb::addEvent(const shared_ptr<EventLog> &eventLog) {
 			case EventLog::Type::ConferenceCallStarted:
 			case EventLog::Type::ConferenceCallConnected:
 			case EventLog::Type::ConferenceCallEnded:
-				eventId = d->insertConferenceCallEvent(eventLog);
+				eventId = d->insertConferenceCallEvent(eventLog, conferenceCallId);
 				break;
 
 			case EventLog::Type::ConferenceChatMessage:
@@ -4082,6 +4239,9 @@ bool MainDb::addEvent(const shared_ptr<EventLog> &eventLog) {
 
 			if (type == EventLog::Type::ConferenceChatMessage)
 				d->cache(static_pointer_cast<ConferenceChatMessageEvent>(eventLog)->getChatMessage(), eventId);
+			else if (conferenceCallId >= 0)
+				d->updateCallHistoryCache(conferenceCallId,
+				                          static_pointer_cast<ConferenceCallEvent>(eventLog)->getCallLog());
 
 			return true;
 		}
@@ -4150,15 +4310,24 @@ bool MainDb::updateEvent(const shared_ptr<EventLog> &eventLog) {
 }
 
 bool MainDb::deleteEvent(const shared_ptr<const EventLog> &eventLog) {
+	return deleteEvents({eventLog});
+}
+
+bool MainDb::deleteEvents(const list<shared_ptr<const EventLog>> &eventLogs) {
 #ifdef HAVE_DB_STORAGE
-	const EventLogPrivate *dEventLog = eventLog->getPrivate();
-	if (!dEventLog->dbKey.isValid()) {
-		lWarning() << "Unable to delete invalid event.";
-		return false;
+	list<shared_ptr<const EventLog>> validEventLogs;
+	for (const auto &eventLog : eventLogs) {
+		if (!eventLog->getPrivate()->dbKey.isValid()) {
+			lWarning() << "Unable to delete invalid event.";
+			continue;
+		}
+		validEventLogs.push_back(eventLog);
 	}
+	if (validEventLogs.empty()) return false;
 
-	MainDbKeyPrivate *dEventKey = static_cast<MainDbKey &>(dEventLog->dbKey).getPrivate();
-	shared_ptr<Core> core = dEventKey->core.lock();
+	MainDbKeyPrivate *dFirstEventKey =
+	    static_cast<MainDbKey &>(validEventLogs.front()->getPrivate()->dbKey).getPrivate();
+	shared_ptr<Core> core = dFirstEventKey->core.lock();
 	L_ASSERT(core);
 
 	MainDb &mainDb = *core->getPrivate()->mainDb.get();
@@ -4166,35 +4335,58 @@ bool MainDb::deleteEvent(const shared_ptr<const EventLog> &eventLog) {
 	return L_DB_TRANSACTION_C(&mainDb) {
 		MainDbPrivate *const d = mainDb.getPrivate();
 		soci::session *session = d->dbSession.getBackendSession();
-		*session << "DELETE FROM event WHERE id = :id", soci::use(dEventKey->storageId);
 
-		if (eventLog->getType() == EventLog::Type::ConferenceChatMessage) {
-			shared_ptr<ChatMessage> chatMessage(
-			    static_pointer_cast<const ConferenceChatMessageEvent>(eventLog)->getChatMessage());
-			shared_ptr<AbstractChatRoom> chatRoom(chatMessage->getChatRoom());
-			const long long &dbChatRoomId = d->selectChatRoomId(chatRoom->getConferenceId());
+		// All events are deleted in a single transaction with one prepared statement, and the last message of each
+		// chat room is updated only once.
+		long long storageId;
+		soci::statement deleteStatement =
+		    (session->prepare << "DELETE FROM event WHERE id = :id", soci::use(storageId));
+		unordered_map<ConferenceId, long long> dbChatRoomIds;
+		for (const auto &eventLog : validEventLogs) {
+			storageId = static_cast<MainDbKey &>(eventLog->getPrivate()->dbKey).getPrivate()->storageId;
+			deleteStatement.execute(true);
+
+			if (eventLog->getType() == EventLog::Type::ConferenceChatMessage) {
+				shared_ptr<ChatMessage> chatMessage(
+				    static_pointer_cast<const ConferenceChatMessageEvent>(eventLog)->getChatMessage());
+				shared_ptr<AbstractChatRoom> chatRoom(chatMessage->getChatRoom());
+				if (chatRoom) {
+					const ConferenceId &conferenceId = chatRoom->getConferenceId();
+					if (dbChatRoomIds.find(conferenceId) == dbChatRoomIds.end())
+						dbChatRoomIds[conferenceId] = d->selectChatRoomId(conferenceId);
+				} else {
+					lWarning() << "Deleting chat message [" << chatMessage << "] whose chat room is gone";
+				}
+				// Delete chat message from cache as the event is deleted
+				ChatMessagePrivate *dChatMessage = chatMessage->getPrivate();
+				dChatMessage->resetStorageId();
+			}
+		}
+
+		for (const auto &dbChatRoomId : dbChatRoomIds) {
 			*session << "UPDATE chat_room SET last_message_id = IFNULL((SELECT id FROM conference_event_simple_view "
 			            "WHERE chat_room_id = chat_room.id AND type = "
 			         << mapEventFilterToSql(ConferenceChatMessageFilter)
 			         << " ORDER BY id DESC LIMIT 1), 0) WHERE id = :1",
-			    soci::use(dbChatRoomId);
-			// Delete chat message from cache as the event is deleted
-			ChatMessagePrivate *dChatMessage = chatMessage->getPrivate();
-			dChatMessage->resetStorageId();
+			    soci::use(dbChatRoomId.second);
 		}
 
 		tr.commit();
 
-		// Reset storage ID as event is not valid anymore
-		const_cast<EventLogPrivate *>(dEventLog)->resetStorageId();
-
-		if (eventLog->getType() == EventLog::Type::ConferenceChatMessage) {
-			shared_ptr<ChatMessage> chatMessage(
-			    static_pointer_cast<const ConferenceChatMessageEvent>(eventLog)->getChatMessage());
-			if (chatMessage->getDirection() == ChatMessage::Direction::Incoming &&
-			    !chatMessage->getPrivate()->isMarkedAsRead()) {
-				int *count = d->unreadChatMessageCountCache[chatMessage->getChatRoom()->getConferenceId()];
-				if (count) --*count;
+		for (const auto &eventLog : validEventLogs) {
+			// Reset storage ID as event is not valid anymore
+			const_cast<EventLogPrivate *>(eventLog->getPrivate())->resetStorageId();
+
+			if (eventLog->getType() == EventLog::Type::ConferenceChatMessage) {
+				shared_ptr<ChatMessage> chatMessage(
+				    static_pointer_cast<const ConferenceChatMessageEvent>(eventLog)->getChatMessage());
+				shared_ptr<AbstractChatRoom> chatRoom(chatMessage->getChatRoom());
+				if (chatRoom && chatMessage->getDirection() == ChatMessage::Direction::Incoming &&
+				    !chatMessage->getPrivate()->isMarkedAsRead()) {
+					int *count = d->unreadChatMessageCountCache[chatRoom->getConferenceId()];
+					if (count) --*count;
+					d->invalidateUnreadChatMessageCount(chatRoom->getConferenceId());
+				}
 			}
 		}
 
@@ -4364,12 +4556,10 @@ int MainDb::getUnreadChatMessageCount(const ConferenceId &conferenceId) const {
 	return L_DB_TRANSACTION {
 		int count = 0;
 
-		soci::session *session = d->dbSession.getBackendSession();
-
-		if (!conferenceId.isValid()) *session << query, soci::into(count);
+		if (!conferenceId.isValid()) d->dbSession.execute(query, soci::into(count));
 		else {
 			const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
-			*session << query, soci::use(dbChatRoomId), soci::into(count);
+			d->dbSession.execute(query, soci::use(dbChatRoomId), soci::into(count));
 		}
 
 		d->unreadChatMessageCountCache.insert(conferenceId, count);
@@ -4406,6 +4596,7 @@ void MainDb::markChatMessagesAsRead(const ConferenceId &conferenceId) const {
 
 		tr.commit();
 		d->unreadChatMessageCountCache.insert(conferenceId, 0);
+		d->invalidateUnreadChatMessageCount(conferenceId);
 	};
 #endif
 }
@@ -4521,7 +4712,7 @@ list<shared_ptr<ChatMessage>> MainDb::getEphemeralMessages() const {
 		soci::rowset<soci::row> rows =
 		    getBackend() == MainDb::Backend::Sqlite3
 		        ? (d->dbSession.getBackendSession()->prepare << query, soci::use(epoch.first),
-		           soci::use(EPHEMERAL_MESSAGE_TASKS_MAX_NB))
+		           soci::use(MainDb::EphemeralMessagesBatchSize))
 		        : (d->dbSession.getBackendSession()->prepare << query, soci::use(epoch.first));
 		for (const auto &row : rows) {
 			const long long &dbChatRoomId = d->dbSession.resolveId(row, (int)row.size() - 1);
@@ -5009,10 +5200,12 @@ MainDb::getHistoryRange(const ConferenceId &conferenceId, int begin, int end, Fi
 	                                   mask, "AND");
 	query += " ORDER BY event_id DESC";
 
-	if (end > 0) query += " LIMIT " + Utils::toString(end - begin);
+	// The range is bound so that the statement can be prepared once for all the pages.
+	const int limit = end - begin;
+	if (end > 0) query += " LIMIT :limit";
 	else query += " LIMIT " + d->dbSession.noLimitValue();
 
-	if (begin > 0) query += " OFFSET " + Utils::toString(begin);
+	if (begin > 0) query += " OFFSET :offset";
 
 	/*
 	DurationLogger durationLogger(
@@ -5029,11 +5222,53 @@ MainDb::getHistoryRange(const ConferenceId &conferenceId, int begin, int end, Fi
 		if (!chatRoom) return events;
 
 		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
-		soci::rowset<soci::row> rows = (d->dbSession.getBackendSession()->prepare << query, soci::use(dbChatRoomId));
-		for (const auto &row : rows) {
+		auto addEvent = [&](const soci::row &row) {
 			shared_ptr<EventLog> event = d->selectGenericConferenceEvent(chatRoom, row);
 			if (event) events.push_front(event);
-		}
+		};
+		if (end > 0 && begin > 0)
+			d->dbSession.forEachRow(query, addEvent, soci::use(dbChatRoomId), soci::use(limit), soci::use(begin));
+		else if (end > 0) d->dbSession.forEachRow(query, addEvent, soci::use(dbChatRoomId), soci::use(limit));
+		else if (begin > 0) d->dbSession.forEachRow(query, addEvent, soci::use(dbChatRoomId), soci::use(begin));
+		else d->dbSession.forEachRow(query, addEvent, soci::use(dbChatRoomId));
+
+		return events;
+	};
+#else
+	return list<shared_ptr<EventLog>>();
+#endif
+}
+
+list<shared_ptr<EventLog>>
+MainDb::getHistoryPage(const ConferenceId &conferenceId, long long &cursor, int count, FilterMask mask) const {
+#ifdef HAVE_DB_STORAGE
+	list<shared_ptr<EventLog>> events;
+	if (count <= 0) return events;
+
+	// Seek on the primary key instead of using OFFSET, so that each page costs the same whatever its position.
+	// The cursor and the page size are bound so that the statement can be prepared once for all the pages.
+	string query = Statements::get(Statements::SelectConferenceEvents) +
+	               buildSqlEventFilter({ConferenceCallFilter, ConferenceChatMessageFilter, ConferenceInfoFilter,
+	                                    ConferenceInfoNoDeviceFilter, ConferenceChatMessageSecurityFilter},
+	                                   mask, "AND");
+	query += " AND conference_event_view.id < :cursor ORDER BY event_id DESC LIMIT :count";
+	const long long seek = cursor > 0 ? cursor : numeric_limits<long long>::max();
+
+	return L_DB_TRANSACTION {
+		L_D();
+
+		shared_ptr<AbstractChatRoom> chatRoom = d->findChatRoom(conferenceId);
+		if (!chatRoom) return events;
+
+		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
+		d->dbSession.forEachRow(
+		    query,
+		    [&](const soci::row &row) {
+			    cursor = d->getConferenceEventIdFromRow(row);
+			    shared_ptr<EventLog> event = d->selectGenericConferenceEvent(chatRoom, row);
+			    if (event) events.push_back(event);
+		    },
+		    soci::use(dbChatRoomId), soci::use(seek), soci::use(count));
 
 		return events;
 	};
@@ -5092,7 +5327,10 @@ void MainDb::cleanHistory(const ConferenceId &conferenceId, FilterMask mask) {
 		*d->dbSession.getBackendSession() << query2, soci::use(dbChatRoomId);
 		tr.commit();
 
-		if (!mask || (mask & ConferenceChatMessageFilter)) d->unreadChatMessageCountCache.insert(conferenceId, 0);
+		if (!mask || (mask & ConferenceChatMessageFilter)) {
+			d->unreadChatMessageCountCache.insert(conferenceId, 0);
+			d->invalidateUnreadChatMessageCount(conferenceId);
+		}
 	};
 #endif
 }
@@ -5339,6 +5577,8 @@ shared_ptr<AbstractChatRoom> MainDb::mergeChatRooms(const shared_ptr<AbstractCha
 	}
 	d->unreadChatMessageCountCache.insert(conferenceIdToAdd, unreadChatMessageCount);
 	d->unreadChatMessageCountCache.insert(conferenceIdToRemove, 0);
+	d->invalidateUnreadChatMessageCount(conferenceIdToAdd);
+	d->invalidateUnreadChatMessageCount(conferenceIdToRemove);
 
 	const long long &dbChatRoomToAddId = d->selectChatRoomId(conferenceIdToAdd);
 	const long long &dbChatRoomToRemoveId = d->selectChatRoomId(conferenceIdToRemove);
@@ -5643,6 +5883,7 @@ void MainDb::deleteChatRoom(const ConferenceId &conferenceId) {
 
 		tr.commit();
 		d->unreadChatMessageCountCache.insert(conferenceId, 0);
+		d->invalidateUnreadChatMessageCount(conferenceId);
 	};
 #endif
 }
@@ -5960,17 +6201,11 @@ std::list<std::shared_ptr<ConferenceInfo>> MainDb::getConferenceInfos(time_t aft
 			auto startTime = d->dbSession.getTimeWithSociIndicator(afterThisTime);
 			soci::rowset<soci::row> rows = (session->prepare << query, soci::use(startTime.first, startTime.second));
 
-			for (const auto &row : rows) {
-				auto confInfo = d->selectConferenceInfo(row);
-				conferenceInfos.push_back(confInfo);
-			}
+			conferenceInfos = d->selectConferenceInfos(rows);
 		} else {
 			soci::rowset<soci::row> rows = (session->prepare << query);
 
-			for (const auto &row : rows) {
-				auto confInfo = d->selectConferenceInfo(row);
-				conferenceInfos.push_back(confInfo);
-			}
+			conferenceInfos = d->selectConferenceInfos(rows);
 		}
 
 		tr.commit();
@@ -6009,10 +6244,7 @@ MainDb::getConferenceInfosForLocalAddress(const std::shared_ptr<Address> &localA
 		soci::session *session = d->dbSession.getBackendSession();
 		soci::rowset<soci::row> rows = (session->prepare << query, soci::use(sipAddressId));
 
-		for (const auto &row : rows) {
-			auto confInfo = d->selectConferenceInfo(row);
-			conferenceInfos.push_back(confInfo);
-		}
+		conferenceInfos = d->selectConferenceInfos(rows);
 
 		tr.commit();
 
@@ -6036,14 +6268,9 @@ std::shared_ptr<ConferenceInfo> MainDb::getConferenceInfo(long long conferenceIn
 	return L_DB_TRANSACTION {
 		L_D();
 
-		shared_ptr<ConferenceInfo> confInfo = nullptr;
-
 		soci::session *session = d->dbSession.getBackendSession();
 		soci::rowset<soci::row> rows = (session->prepare << query, soci::use(conferenceInfoId));
-		const auto &row = rows.begin();
-		if (row != rows.end()) {
-			confInfo = d->selectConferenceInfo(*row);
-		}
+		shared_ptr<ConferenceInfo> confInfo = d->selectConferenceInfo(rows);
 
 		tr.commit();
 
@@ -6067,13 +6294,9 @@ std::shared_ptr<ConferenceInfo> MainDb::getConferenceInfoFromURI(const std::shar
 
 		return L_DB_TRANSACTION {
 			L_D();
-			shared_ptr<ConferenceInfo> confInfo = nullptr;
 			soci::session *session = d->dbSession.getBackendSession();
 			soci::rowset<soci::row> rows = (session->prepare << query);
-			const auto &row = rows.begin();
-			if (row != rows.end()) {
-				confInfo = d->selectConferenceInfo(*row);
-			}
+			shared_ptr<ConferenceInfo> confInfo = d->selectConferenceInfo(rows);
 
 			tr.commit();
 
@@ -6115,6 +6338,9 @@ void MainDb::deleteConferenceInfo(const std::shared_ptr<ConferenceInfo> &confere
 			d->storageIdToConferenceInfo.erase(dbConferenceId);
 
 			tr.commit();
+
+			// The calls of the conference are deleted along with it.
+			d->callHistoryCache.invalidate();
 		};
 	}
 #endif
@@ -6129,6 +6355,7 @@ long long MainDb::insertCallLog(const std::shared_ptr<CallLog> &callLog) {
 
 		long long id = d->insertOrUpdateConferenceCall(callLog, nullptr);
 		tr.commit();
+		d->updateCallHistoryCache(id, callLog);
 
 		return id;
 	};
@@ -6146,9 +6373,11 @@ void MainDb::deleteCallLog(const std::shared_ptr<CallLog> &callLog) {
 
 		*d->dbSession.getBackendSession() << "DELETE FROM conference_call WHERE id = :conferenceCallId",
 		    soci::use(dbConferenceCallId);
-		d->storageIdToCallLog.erase(dbConferenceCallId),
+		d->storageIdToCallLog.erase(dbConferenceCallId);
 
-		    tr.commit();
+		tr.commit();
+
+		d->callHistoryCache.remove(dbConferenceCallId);
 	};
 #endif
 }
@@ -6156,20 +6385,6 @@ void MainDb::deleteCallLog(const std::shared_ptr<CallLog> &callLog) {
 std::shared_ptr<CallLog> MainDb::getCallLog(const std::string &callId, int limit) {
 #ifdef HAVE_DB_STORAGE
 	if (isInitialized()) {
-		string query = "SELECT c.id, from_sip_address.value, from_sip_address.display_name, to_sip_address.value, "
-		               "to_sip_address.display_name,"
-		               "  direction, duration, start_time, connected_time, status, video_enabled, quality, call_id, "
-		               "refkey, conference_info_id"
-		               " FROM (conference_call as c, sip_address AS from_sip_address, sip_address AS to_sip_address)";
-
-		if (limit > 0) {
-			query += " INNER JOIN (SELECT id from conference_call ORDER BY id DESC LIMIT " + std::to_string(limit) +
-			         ") as c2 ON c.id = c2.id";
-		}
-
-		query += " WHERE c.from_sip_address_id = from_sip_address.id AND c.to_sip_address_id = to_sip_address.id"
-		         "  AND call_id = :callId";
-
 		DurationLogger durationLogger("Get call log.");
 
 		return L_DB_TRANSACTION {
@@ -6177,13 +6392,11 @@ std::shared_ptr<CallLog> MainDb::getCallLog(const std::string &callId, int limit
 
 			std::shared_ptr<CallLog> callLog = nullptr;
 
-			soci::session *session = d->dbSession.getBackendSession();
-
-			soci::rowset<soci::row> rows = (session->prepare << query, soci::use(callId));
-
-			const auto &row = rows.begin();
-			if (row != rows.end()) {
-				callLog = d->selectCallLog(*row);
+			d->loadCallHistoryCache();
+			long long id = d->callHistoryCache.findId(callId, limit);
+			if (id >= 0) {
+				auto callLogs = d->getCallLogs({id});
+				if (!callLogs.empty()) callLog = callLogs.front();
 			}
 
 			tr.commit();
@@ -6198,33 +6411,49 @@ std::shared_ptr<CallLog> MainDb::getCallLog(const std::string &callId, int limit
 std::list<std::shared_ptr<CallLog>> MainDb::getCallHistory(int limit) {
 #ifdef HAVE_DB_STORAGE
 	if (limit == 0) return list<shared_ptr<CallLog>>();
-	string query = "SELECT conference_call.id, from_sip_address.value, from_sip_address.display_name, "
-	               "to_sip_address.value, to_sip_address.display_name,"
-	               "  direction, duration, start_time, connected_time, status, video_enabled, quality, call_id, "
-	               "refkey, conference_info_id"
-	               " FROM conference_call, sip_address AS from_sip_address, sip_address AS to_sip_address"
-	               " WHERE conference_call.from_sip_address_id = from_sip_address.id AND "
-	               "conference_call.to_sip_address_id = to_sip_address.id"
-	               " ORDER BY conference_call.id DESC";
-
-	if (limit > 0) query += " LIMIT " + to_string(limit);
 
 	DurationLogger durationLogger("Get call history.");
 
 	return L_DB_TRANSACTION {
 		L_D();
 
-		list<shared_ptr<CallLog>> clList;
+		d->loadCallHistoryCache();
+		list<shared_ptr<CallLog>> clList = d->getCallLogs(d->callHistoryCache.getIds(limit));
 
-		soci::session *session = d->dbSession.getBackendSession();
+		tr.commit();
 
-		soci::rowset<soci::row> rows = (session->prepare << query);
-		for (const auto &row : rows) {
-			auto callLog = d->selectCallLog(row);
-			clList.push_back(callLog);
-		}
+		return clList;
+	};
+#else
+	return list<shared_ptr<CallLog>>();
+#endif
+}
 
-		tr.commit();
+std::list<std::shared_ptr<CallLog>> MainDb::getCallHistoryPage(long long &cursor, int count) {
+#ifdef HAVE_DB_STORAGE
+	if (count <= 0) return list<shared_ptr<CallLog>>();
+	static const string query =
+	    "SELECT conference_call.id, from_sip_address.value, from_sip_address.display_name, "
+	    "to_sip_address.value, to_sip_address.display_name,"
+	    "  direction, duration, start_time, connected_time, status, video_enabled, quality, call_id, "
+	    "refkey, conference_info_id"
+	    " FROM conference_call, sip_address AS from_sip_address, sip_address AS to_sip_address"
+	    " WHERE conference_call.from_sip_address_id = from_sip_address.id AND "
+	    "conference_call.to_sip_address_id = to_sip_address.id"
+	    " AND conference_call.id < :cursor ORDER BY conference_call.id DESC LIMIT :count";
+	const long long seek = cursor > 0 ? cursor : numeric_limits<long long>::max();
+
+	return L_DB_TRANSACTION {
+		L_D();
+
+		list<shared_ptr<CallLog>> clList;
+		d->dbSession.forEachRow(
+		    query,
+		    [&](const soci::row &row) {
+			    cursor = d->dbSession.resolveId(row, 0);
+			    clList.push_back(d->selectCallLog(row));
+		    },
+		    soci::use(seek), soci::use(count));
 
 		return clList;
 	};
@@ -6236,37 +6465,13 @@ std::list<std::shared_ptr<CallLog>> MainDb::getCallHistory(int limit) {
 std::list<std::shared_ptr<CallLog>> MainDb::getCallHistoryForLocalAddress(const std::shared_ptr<Address> &localAddress,
                                                                           int limit) {
 #ifdef HAVE_DB_STORAGE
-	string query = "SELECT conference_call.id, from_sip_address.value, from_sip_address.display_name, "
-	               "to_sip_address.value, to_sip_address.display_name,"
-	               "  direction, duration, start_time, connected_time, status, video_enabled, quality, call_id, "
-	               "refkey, conference_info_id"
-	               " FROM conference_call, sip_address AS from_sip_address, sip_address AS to_sip_address"
-	               " WHERE conference_call.from_sip_address_id = from_sip_address.id AND "
-	               "conference_call.to_sip_address_id = to_sip_address.id"
-	               "  AND ((from_sip_address.value LIKE '%%" +
-	               localAddress->toStringUriOnlyOrdered() +
-	               "%%' AND direction = 0) OR" // 0 == outgoing
-	               "  (to_sip_address.value LIKE '%%" +
-	               localAddress->toStringUriOnlyOrdered() +
-	               "%%' AND direction = 1))" // 1 == incoming
-	               " ORDER BY conference_call.id DESC";
-
-	if (limit > 0) query += " LIMIT " + to_string(limit);
-
 	DurationLogger durationLogger("Get call history.");
 
 	return L_DB_TRANSACTION {
 		L_D();
 
-		list<shared_ptr<CallLog>> clList;
-
-		soci::session *session = d->dbSession.getBackendSession();
-
-		soci::rowset<soci::row> rows = (session->prepare << query);
-		for (const auto &row : rows) {
-			auto callLog = d->selectCallLog(row);
-			clList.push_back(callLog);
-		}
+		d->loadCallHistoryCache();
+		list<shared_ptr<CallLog>> clList = d->getCallLogs(d->callHistoryCache.getIdsForLocalAddress(localAddress, limit));
 
 		tr.commit();
 
@@ -6280,38 +6485,13 @@ std::list<std::shared_ptr<CallLog>> MainDb::getCallHistoryForLocalAddress(const
 std::list<std::shared_ptr<CallLog>>
 MainDb::getCallHistory(const std::shared_ptr<Address> &peer, const std::shared_ptr<Address> &local, int limit) {
 #ifdef HAVE_DB_STORAGE
-	string query =
-	    "SELECT conference_call.id, from_sip_address.value, from_sip_address.display_name, "
-	    "to_sip_address.value, to_sip_address.display_name,"
-	    "  direction, duration, start_time, connected_time, status, video_enabled, quality, call_id, "
-	    "refkey, conference_info_id"
-	    " FROM conference_call, sip_address AS from_sip_address, sip_address AS to_sip_address"
-	    " WHERE conference_call.from_sip_address_id = from_sip_address.id AND "
-	    "conference_call.to_sip_address_id = to_sip_address.id"
-	    "  AND ((from_sip_address.value LIKE '%%" +
-	    local->toStringUriOnlyOrdered() + "%%' AND to_sip_address.value LIKE '%%" + peer->toStringUriOnlyOrdered() +
-	    "%%' AND direction = 0) OR" // 0 == outgoing
-	    "  (from_sip_address.value LIKE '%%" +
-	    peer->toStringUriOnlyOrdered() + "%%' AND to_sip_address.value LIKE '%%" + local->toStringUriOnlyOrdered() +
-	    "%%' AND direction = 1))" // 1 == incoming
-	    " ORDER BY conference_call.id DESC";
-
-	if (limit > 0) query += " LIMIT " + to_string(limit);
-
 	DurationLogger durationLogger("Get call history 2.");
 
 	return L_DB_TRANSACTION {
 		L_D();
 
-		list<shared_ptr<CallLog>> clList;
-
-		soci::session *session = d->dbSession.getBackendSession();
-
-		soci::rowset<soci::row> rows = (session->prepare << query);
-		for (const auto &row : rows) {
-			auto callLog = d->selectCallLog(row);
-			clList.push_back(callLog);
-		}
+		d->loadCallHistoryCache();
+		list<shared_ptr<CallLog>> clList = d->getCallLogs(d->callHistoryCache.getIds(peer, local, limit));
 
 		tr.commit();
 
@@ -6324,16 +6504,6 @@ MainDb::getCallHistory(const std::shared_ptr<Address> &peer, const std::shared_p
 
 std::shared_ptr<CallLog> MainDb::getLastOutgoingCall() {
 #ifdef HAVE_DB_STORAGE
-	static const string query = "SELECT conference_call.id, from_sip_address.value, from_sip_address.display_name, "
-	                            "to_sip_address.value, to_sip_address.display_name,"
-	                            "  direction, duration, start_time, connected_time, status, video_enabled, quality, "
-	                            "call_id, refkey, conference_info_id"
-	                            " FROM conference_call, sip_address AS from_sip_address, sip_address AS to_sip_address"
-	                            " WHERE conference_call.from_sip_address_id = from_sip_address.id AND "
-	                            "conference_call.to_sip_address_id = to_sip_address.id"
-	                            "  AND direction = 0 AND conference_info_id IS NULL" // 0 == outgoing
-	                            " ORDER BY conference_call.id DESC LIMIT 1";
-
 	DurationLogger durationLogger("Get last outgoing call.");
 
 	return L_DB_TRANSACTION {
@@ -6341,13 +6511,11 @@ std::shared_ptr<CallLog> MainDb::getLastOutgoingCall() {
 
 		std::shared_ptr<CallLog> callLog = nullptr;
 
-		soci::session *session = d->dbSession.getBackendSession();
-
-		soci::rowset<soci::row> rows = (session->prepare << query);
-
-		const auto &row = rows.begin();
-		if (row != rows.end()) {
-			callLog = d->selectCallLog(*row);
+		d->loadCallHistoryCache();
+		long long id = d->callHistoryCache.getLastOutgoingCallId();
+		if (id >= 0) {
+			auto callLogs = d->getCallLogs({id});
+			if (!callLogs.empty()) callLog = callLogs.front();
 		}
 
 		tr.commit();
@@ -6369,6 +6537,9 @@ void MainDb::deleteCallHistory() {
 		*session << "DELETE FROM conference_call";
 
 		tr.commit();
+
+		d->callHistoryCache.clear();
+		d->callHistoryCache.setLoaded();
 	};
 #endif
 }
@@ -6388,6 +6559,8 @@ void MainDb::deleteCallHistoryForLocalAddress(const std::shared_ptr<Address> &lo
 		    soci::use(sipAddressId);
 
 		tr.commit();
+
+		d->callHistoryCache.invalidate();
 	};
 #endif
 }
@@ -6397,13 +6570,8 @@ int MainDb::getCallHistorySize() {
 	return L_DB_TRANSACTION {
 		L_D();
 
-		int count = 0;
-
-		soci::session *session = d->dbSession.getBackendSession();
-
-		soci::statement st = (session->prepare << "SELECT count(*) FROM conference_call", soci::into(count));
-		st.execute();
-		st.fetch();
+		d->loadCallHistoryCache();
+		int count = (int)d->callHistoryCache.size();
 
 		tr.commit();
 
@@ -6414,6 +6582,40 @@ int MainDb::getCallHistorySize() {
 #endif
 }
 
+CallHistoryCache::Stats MainDb::getCallStatsForLocalAddress(const std::shared_ptr<Address> &localAddress) {
+#ifdef HAVE_DB_STORAGE
+	return L_DB_TRANSACTION {
+		L_D();
+
+		d->loadCallHistoryCache();
+		CallHistoryCache::Stats stats = d->callHistoryCache.getStatsForLocalAddress(localAddress);
+
+		tr.commit();
+
+		return stats;
+	};
+#else
+	return CallHistoryCache::Stats();
+#endif
+}
+
+CallHistoryCache::Stats MainDb::getCallStatsForPeerAddress(const std::shared_ptr<Address> &peerAddress) {
+#ifdef HAVE_DB_STORAGE
+	return L_DB_TRANSACTION {
+		L_D();
+
+		d->loadCallHistoryCache();
+		CallHistoryCache::Stats stats = d->callHistoryCache.getStatsForPeerAddress(peerAddress);
+
+		tr.commit();
+
+		return stats;
+	};
+#else
+	return CallHistoryCache::Stats();
+#endif
+}
+
 // -----------------------------------------------------------------------------
 
 long long MainDb::insertFriend(const std::shared_ptr<Friend> &f) {
@@ -28,6 +28,7 @@
 #include "linphone/utils/enum-mask.h"
 
 #include "abstract/abstract-db.h"
+#include "call/call-history-cache.h"
 #include "call/call-log.h"
 #include "chat/chat-message/chat-message-reaction.h"
 #include "chat/chat-message/chat-message.h"
@@ -89,6 +90,7 @@ public:
 	bool addEvent(const std::shared_ptr<EventLog> &eventLog);
 	bool updateEvent(const std::shared_ptr<EventLog> &eventLog);
 	static bool deleteEvent(const std::shared_ptr<const EventLog> &eventLog);
+	static bool deleteEvents(const std::list<std::shared_ptr<const EventLog>> &eventLogs);
 	int getEventCount(FilterMask mask = NoFilter) const;
 
 	static std::shared_ptr<EventLog> getEventFromKey(const MainDbKey &dbKey);
@@ -127,6 +129,8 @@ public:
 	                                    ChatMessage::State state,
 	                                    time_t stateChangeTime);
 
+	// Maximum number of pending ephemeral messages loaded from database at once.
+	static constexpr int EphemeralMessagesBatchSize = 500;
 	std::list<std::shared_ptr<ChatMessage>> getEphemeralMessages() const;
 
 	bool isChatRoomEmpty(const ConferenceId &conferenceId) const;
@@ -153,6 +157,9 @@ public:
 	getHistory(const ConferenceId &conferenceId, int nLast, FilterMask mask = NoFilter) const;
 	std::list<std::shared_ptr<EventLog>>
 	getHistoryRange(const ConferenceId &conferenceId, int begin, int end, FilterMask mask = NoFilter) const;
+	// Keyset pagination: returns at most count events older than cursor, newest first, and moves cursor forward.
+	std::list<std::shared_ptr<EventLog>>
+	getHistoryPage(const ConferenceId &conferenceId, long long &cursor, int count, FilterMask mask = NoFilter) const;
 
 	int getHistorySize(const ConferenceId &conferenceId, FilterMask mask = NoFilter) const;
 
@@ -236,11 +243,15 @@ public:
 	                                                                  int limit = -1);
 	std::list<std::shared_ptr<CallLog>>
 	getCallHistory(const std::shared_ptr<Address> &peer, const std::shared_ptr<Address> &local, int limit = -1);
+	// Keyset pagination: returns at most count call logs older than cursor, newest first, and moves cursor forward.
+	std::list<std::shared_ptr<CallLog>> getCallHistoryPage(long long &cursor, int count);
 	std::shared_ptr<CallLog> getLastOutgoingCall();
 	void deleteCallHistory();
 	void deleteCallHistoryForLocalAddress(const std::shared_ptr<Address> &localAddress);
 
 	int getCallHistorySize();
+	CallHistoryCache::Stats getCallStatsForLocalAddress(const std::shared_ptr<Address> &localAddress);
+	CallHistoryCache::Stats getCallStatsForPeerAddress(const std::shared_ptr<Address> &peerAddress);
 
 	// ---------------------------------------------------------------------------
 	// Friend & FriendList.
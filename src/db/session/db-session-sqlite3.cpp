@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Kept apart from db-session.cpp: soci declares the SQLite API in its sqlite_api namespace, which cannot be used
+// along with the sqlite3.h included by the VFS header.
+#include <soci/sqlite3/soci-sqlite3.h>
+
+#include "db-session.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+void DbSession::resetSqlite3Statement(soci::statement &statement) {
+	auto backend = static_cast<soci::sqlite3_statement_backend *>(statement.get_backend());
+	if (backend && backend->stmt_) sqlite_api::sqlite3_reset(backend->stmt_);
+}
+
+LINPHONE_END_NAMESPACE
@@ -18,6 +18,10 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+
 #include "linphone/utils/utils.h"
 
 #include "db-session.h"
@@ -32,17 +36,31 @@ LINPHONE_BEGIN_NAMESPACE
 
 class DbSessionPrivate {
 public:
+	struct CachedStatement {
+		soci::statement statement;
+		bool inUse;
+	};
+
+	// Above this number of statements, the cache is emptied: it is only meant to hold the queries of MainDb.
+	static constexpr size_t MaxCachedStatements = 256;
+
 	enum class Backend { None, Mysql, Sqlite3 } backend = Backend::None;
 
 	std::unique_ptr<soci::session> backendSession;
+	AbstractDb::DurabilityProfile durabilityProfile;
+
+	// Declared after the backend session so that statements are released before it.
+	bool statementCacheEnabled = true;
+	mutable std::unordered_map<std::string, CachedStatement> statements;
 };
 
 DbSession::DbSession() : mPrivate(new DbSessionPrivate) {
 }
 
-DbSession::DbSession(const string &uri) : DbSession() {
+DbSession::DbSession(const string &uri, const AbstractDb::DurabilityProfile &durabilityProfile) : DbSession() {
 	try {
 		L_D();
+		d->durabilityProfile = durabilityProfile;
 		auto sqlitePos = uri.find("sqlite3://");
 		if (sqlitePos != std::string::npos) { // opening a sqlite3 db, force SOCI to use the bctbx_sqlite3_vfs
 			// uri might be just the filepath, add a db= in front of it in that case
@@ -59,11 +77,15 @@ DbSession::DbSession(const string &uri) : DbSession() {
 				}
 			}
 			uriArgs.append(" vfs=").append(BCTBX_SQLITE3_VFS);
+			// The VFS locks the files, wait for another process (e.g. an app extension) to release them rather than
+			// failing at once with SQLITE_BUSY.
+			if (uri.find("timeout=") == std::string::npos) uriArgs.append(" timeout=5");
 			d->backendSession = makeUnique<soci::session>(uriArgs);
 		} else {
 			d->backendSession = makeUnique<soci::session>(uri);
 		}
 		d->backend = !uri.find("mysql") ? DbSessionPrivate::Backend::Mysql : DbSessionPrivate::Backend::Sqlite3;
+		applyDurabilityProfile();
 	} catch (const exception &e) {
 		lWarning() << "Unable to build db session with uri: " << e.what();
 	}
@@ -215,9 +237,7 @@ long long DbSession::getLastInsertId() const {
 			break;
 	}
 
-	if (!sql.empty()) {
-		*d->backendSession << sql, soci::into(id);
-	}
+	if (!sql.empty()) execute(sql, soci::into(id));
 
 	return id;
 }
@@ -237,6 +257,54 @@ void DbSession::enableForeignKeys(bool status) {
 	}
 }
 
+void DbSession::applyDurabilityProfile() {
+	L_D();
+
+	if (d->backend != DbSessionPrivate::Backend::Sqlite3) return;
+
+	// The values end up in PRAGMA statements, which cannot be bound: only accept the documented ones.
+	static const set<string> journalModes = {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+	static const set<string> synchronousLevels = {"OFF", "NORMAL", "FULL", "EXTRA"};
+
+	const AbstractDb::DurabilityProfile &profile = d->durabilityProfile;
+	soci::session *session = d->backendSession.get();
+	try {
+		if (!profile.journalMode.empty()) {
+			string journalMode = profile.journalMode;
+			transform(journalMode.begin(), journalMode.end(), journalMode.begin(), ::toupper);
+			if (journalModes.find(journalMode) == journalModes.end()) {
+				lWarning() << "Ignoring invalid sqlite3 journal mode `" << profile.journalMode << "`.";
+			} else {
+				// SQLite keeps the current mode when the requested one is not available, e.g. WAL on a VFS without
+				// shared memory support.
+				string result;
+				*session << "PRAGMA journal_mode = " + journalMode, soci::into(result);
+				if (Utils::stringToLower(result) != Utils::stringToLower(journalMode))
+					lWarning() << "Unable to set sqlite3 journal mode to " << journalMode << ", using " << result << ".";
+			}
+		}
+
+		if (!profile.synchronous.empty()) {
+			string synchronous = profile.synchronous;
+			transform(synchronous.begin(), synchronous.end(), synchronous.begin(), ::toupper);
+			if (synchronousLevels.find(synchronous) == synchronousLevels.end())
+				lWarning() << "Ignoring invalid sqlite3 synchronous level `" << profile.synchronous << "`.";
+			else *session << "PRAGMA synchronous = " + synchronous;
+		}
+
+		if (profile.cacheSize != 0) *session << "PRAGMA cache_size = " + Utils::toString(profile.cacheSize);
+
+		if (profile.mmapSize >= 0) *session << "PRAGMA mmap_size = " + Utils::toString(profile.mmapSize);
+	} catch (const soci::soci_error &e) {
+		lWarning() << "Unable to apply database durability profile: " << e.what();
+		return;
+	}
+
+	lInfo() << "Database durability profile: journal_mode=" << profile.journalMode
+	        << " synchronous=" << profile.synchronous << " cache_size=" << profile.cacheSize
+	        << " mmap_size=" << profile.mmapSize << ".";
+}
+
 bool DbSession::checkTableExists(const string &table) const {
 	L_D();
 
@@ -328,4 +396,83 @@ pair<tm, soci::indicator> DbSession::getTimeWithSociIndicator(time_t t) const {
 	return dataInDb;
 }
 
+// -----------------------------------------------------------------------------
+
+void DbSession::clearStatementCache() {
+	L_D();
+	d->statements.clear();
+}
+
+void DbSession::enableStatementCache(bool enable) {
+	L_D();
+	d->statementCacheEnabled = enable;
+	if (!enable) d->statements.clear();
+}
+
+bool DbSession::isStatementCacheEnabled() const {
+	L_D();
+	return d->statementCacheEnabled;
+}
+
+size_t DbSession::getStatementCacheSize() const {
+	L_D();
+	return d->statements.size();
+}
+
+soci::statement DbSession::acquireStatement(const string &query, bool &cached) const {
+	L_D();
+
+	cached = false;
+	if (d->statementCacheEnabled) {
+		auto it = d->statements.find(query);
+		if (it != d->statements.end()) {
+			// A statement which is already running (a query issued while iterating over its own results) cannot be
+			// shared, a temporary one is used instead.
+			if (!it->second.inUse) {
+				it->second.inUse = true;
+				cached = true;
+				return it->second.statement;
+			}
+		}
+	}
+
+	soci::statement statement(*d->backendSession);
+	statement.alloc();
+	statement.prepare(query);
+
+	if (d->statementCacheEnabled && d->statements.find(query) == d->statements.end()) {
+		if (d->statements.size() >= DbSessionPrivate::MaxCachedStatements) {
+			lWarning() << "Too many prepared statements in cache, clearing it.";
+			for (auto it = d->statements.begin(); it != d->statements.end();) {
+				if (it->second.inUse) ++it;
+				else it = d->statements.erase(it);
+			}
+		}
+		d->statements.emplace(query, DbSessionPrivate::CachedStatement{statement, true});
+		cached = true;
+	}
+
+	return statement;
+}
+
+void DbSession::releaseStatement(const string &query, bool failed) const {
+	L_D();
+
+	auto it = d->statements.find(query);
+	if (it == d->statements.end()) return;
+
+	// A SQLite statement which is not reset keeps its read transaction, and the snapshot of the database with it,
+	// until its next execution: the writers and the WAL checkpoints of the other connections would wait for it.
+	if (d->backend == DbSessionPrivate::Backend::Sqlite3) resetSqlite3Statement(it->second.statement);
+
+	if (failed) {
+		// The statement may be left in any state, prepare it again on next use.
+		d->statements.erase(it);
+		return;
+	}
+
+	it->second.statement.bind_clean_up();
+	it->second.inUse = false;
+}
+
 LINPHONE_END_NAMESPACE
@@ -23,6 +23,7 @@
 
 #include <soci/soci.h>
 
+#include "db/abstract/abstract-db.h"
 #include "linphone/utils/general.h"
 
 // =============================================================================
@@ -34,7 +35,8 @@ class DbSessionPrivate;
 class DbSession {
 public:
 	DbSession();
-	explicit DbSession(const std::string &uri);
+	explicit DbSession(const std::string &uri,
+	                   const AbstractDb::DurabilityProfile &durabilityProfile = AbstractDb::DurabilityProfile());
 	DbSession(DbSession &&other);
 	~DbSession();
 
@@ -57,6 +59,9 @@ public:
 
 	void enableForeignKeys(bool status);
 
+	// Applies the durability profile given at construction, it has to be done again after a reconnection.
+	void applyDurabilityProfile();
+
 	bool checkTableExists(const std::string &table) const;
 
 	long long resolveId(const soci::row &row, int col) const;
@@ -66,7 +71,56 @@ public:
 
 	unsigned int getUnsignedInt(const soci::row &row, std::size_t col, const unsigned int def = 0) const;
 
+	// Executes a query and fetches its first row, if any. Parameters and results are bound with soci::use() and
+	// soci::into() like with soci::session. The statement is prepared once and reused by the next executions of the
+	// same query: its text must not embed values, they have to be bound.
+	template <typename... Bindings>
+	bool execute(const std::string &query, const Bindings &...bindings) const {
+		bool cached;
+		soci::statement statement = acquireStatement(query, cached);
+		try {
+			(statement.exchange(bindings), ...);
+			statement.define_and_bind();
+			bool gotData = statement.execute(true);
+			if (cached) releaseStatement(query, false);
+			return gotData;
+		} catch (...) {
+			if (cached) releaseStatement(query, true);
+			throw;
+		}
+	}
+
+	// Same as execute() for queries returning several rows, the function is called on each of them.
+	template <typename Function, typename... Bindings>
+	void forEachRow(const std::string &query, Function &&function, const Bindings &...bindings) const {
+		bool cached;
+		soci::statement statement = acquireStatement(query, cached);
+		try {
+			soci::row row;
+			statement.exchange(soci::into(row));
+			(statement.exchange(bindings), ...);
+			statement.define_and_bind();
+			statement.execute(false);
+			while (statement.fetch())
+				function(static_cast<const soci::row &>(row));
+			if (cached) releaseStatement(query, false);
+		} catch (...) {
+			if (cached) releaseStatement(query, true);
+			throw;
+		}
+	}
+
+	// Prepared statements depend on the schema, they must be dropped when it changes.
+	void clearStatementCache();
+	void enableStatementCache(bool enable);
+	bool isStatementCacheEnabled() const;
+	size_t getStatementCacheSize() const;
+
 private:
+	soci::statement acquireStatement(const std::string &query, bool &cached) const;
+	void releaseStatement(const std::string &query, bool failed) const;
+	static void resetSqlite3Statement(soci::statement &statement);
+
 	DbSessionPrivate *mPrivate;
 
 	L_DECLARE_PRIVATE(DbSession);
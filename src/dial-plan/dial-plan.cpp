@@ -18,7 +18,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <cstring>
+#include <array>
+#include <vector>
 
 #include "linphone/utils/utils.h"
 
@@ -31,6 +32,42 @@ using namespace std;
 
 LINPHONE_BEGIN_NAMESPACE
 
+namespace {
+// Prefix tree of the country calling codes, with the number of dial plans whose code starts with each prefix.
+struct CccTrie {
+	struct Node {
+		Node() {
+			children.fill(-1);
+		}
+
+		array<int, 10> children;
+		unsigned int count = 0;
+		int ccc = -1; // Country calling code of the dial plan below this node, when it is the only one.
+	};
+
+	explicit CccTrie(const list<shared_ptr<DialPlan>> &dialPlans) : nodes(1) {
+		for (const auto &dp : dialPlans) {
+			const string &ccc = dp->getCountryCallingCode();
+			size_t node = 0;
+			for (char c : ccc) {
+				if (c < '0' || c > '9') break;
+				int child = nodes[node].children[c - '0'];
+				if (child < 0) {
+					child = (int)nodes.size();
+					nodes[node].children[c - '0'] = child;
+					nodes.emplace_back();
+				}
+				node = (size_t)child;
+				nodes[node].count++;
+				nodes[node].ccc = Utils::stoi(ccc);
+			}
+		}
+	}
+
+	vector<Node> nodes;
+};
+} // namespace
+
 /*
  * http://en.wikipedia.org/wiki/Telephone_numbering_plan
  * http://en.wikipedia.org/wiki/Telephone_numbers_in_Europe
@@ -271,22 +308,19 @@ int DialPlan::lookupCccFromE164(const string &e164) {
 	// USA case.
 	if (e164[1] == '1') return 1;
 
-	shared_ptr<DialPlan> electedDialPlan;
-	unsigned int found;
-	unsigned int i = 0;
-
+	// Read the number digit by digit until a single dial plan has a country calling code starting with them.
+	static const CccTrie trie(sDialPlans);
+	size_t node = 0;
+	size_t i = 1;
 	do {
-		found = 0;
+		char c = e164[i];
+		if (c < '0' || c > '9') return -1;
+		int child = trie.nodes[node].children[c - '0'];
+		if (child < 0) return -1;
+		node = (size_t)child;
+		if (trie.nodes[node].count == 1) return trie.nodes[node].ccc;
 		i++;
-		for (const auto &dp : sDialPlans) {
-			if (strncmp(dp->getCountryCallingCode().c_str(), &e164[1], i) == 0) {
-				electedDialPlan = dp;
-				found++;
-			}
-		}
-	} while ((found > 1 || found == 0) && i < e164.length() - 1);
-
-	if (found == 1) return Utils::stoi(electedDialPlan->getCountryCallingCode());
+	} while (i < e164.length());
 
 	return -1;
 }
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "event-log-iterator.h"
+
+#include "chat/chat-room/abstract-chat-room.h"
+#include "core/core-p.h"
+#include "db/main-db.h"
+#include "event-log/event-log.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+EventLogIterator::EventLogIterator(const shared_ptr<AbstractChatRoom> &chatRoom, bool messagesOnly, int pageSize)
+    : PagedIterator<EventLog>(
+          [weakChatRoom = weak_ptr<AbstractChatRoom>(chatRoom),
+           mask = messagesOnly ? MainDb::FilterMask(MainDb::Filter::ConferenceChatMessageFilter)
+                               : MainDb::FilterMask({MainDb::Filter::ConferenceChatMessageFilter,
+                                                     MainDb::Filter::ConferenceInfoNoDeviceFilter})](
+              long long &cursor, int size) {
+	          shared_ptr<AbstractChatRoom> chatRoom = weakChatRoom.lock();
+	          if (!chatRoom || !chatRoom->getCore()->getPrivate()->mainDb) return list<shared_ptr<EventLog>>();
+	          return chatRoom->getCore()->getPrivate()->mainDb->getHistoryPage(chatRoom->getConferenceId(), cursor,
+	                                                                           size, mask);
+          },
+          pageSize) {
+}
+
+LINPHONE_END_NAMESPACE
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_EVENT_LOG_ITERATOR_H_
+#define _L_EVENT_LOG_ITERATOR_H_
+
+#include <belle-sip/object++.hh>
+
+#include "containers/paged-iterator.h"
+#include "linphone/api/c-types.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class AbstractChatRoom;
+class EventLog;
+
+class LINPHONE_PUBLIC EventLogIterator : public bellesip::HybridObject<LinphoneEventLogIterator, EventLogIterator>,
+                                         public PagedIterator<EventLog> {
+public:
+	// Walks through the history of the chat room, from the most recent event to the oldest one.
+	EventLogIterator(const std::shared_ptr<AbstractChatRoom> &chatRoom, bool messagesOnly, int pageSize);
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_EVENT_LOG_ITERATOR_H_
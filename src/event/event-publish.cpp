@@ -107,7 +107,6 @@ EventPublish::EventPublish(const shared_ptr<Core> &core, const std::shared_ptr<A
 }
 
 EventPublish::~EventPublish() {
-	stopTimeoutHandling();
 }
 
 string EventPublish::toString() const {
@@ -136,10 +135,8 @@ LinphoneStatus EventPublish::accept() {
 	}
 	auto publishOp = dynamic_cast<SalPublishOp *>(mOp);
 	err = publishOp->accept();
-	if (err == 0) {
-		setState(LinphonePublishOk);
-		startTimeoutHandling();
-	}
+	// Its expiry is handled by the publication store of the core.
+	if (err == 0) setState(LinphonePublishOk);
 	return err;
 }
 
@@ -209,7 +206,7 @@ void EventPublish::unpublish() {
 void EventPublish::terminate() {
 	// if event was already terminated (including on error), we should not terminate it again
 	// otherwise it will be unreffed twice.
-	if (mPublishState == LinphonePublishError || mPublishState == LinphonePublishCleared) {
+	if (mPublishState == LinphonePublishError || mPublishState == LinphonePublishCleared || mSuperseded) {
 		return;
 	}
 
@@ -225,24 +222,12 @@ void EventPublish::terminate() {
 	setState(LinphonePublishTerminating);
 }
 
-void EventPublish::startTimeoutHandling() {
-	stopTimeoutHandling();
-	if (mExpires > 0)
-		mTimer = getCore()->createTimer(
-		    [this]() {
-			    lInfo() << "Publish event [" << this << "] has expired";
-			    terminate();
-			    return true;
-		    },
-		    static_cast<unsigned int>(mExpires) * 1000, "Publish timer");
-}
-
-void EventPublish::stopTimeoutHandling() {
-	if (mTimer) {
-		lInfo() << "stopTimeoutHandling()";
-		getCore()->destroyTimer(mTimer);
-		mTimer = nullptr;
-	}
+void EventPublish::supersede() {
+	// A refresh of the publication came with a new event: this one is released without being cleared, as the
+	// publication is still alive. It must not be released again by a later terminate().
+	if (mPublishState == LinphonePublishError || mPublishState == LinphonePublishCleared || mSuperseded) return;
+	mSuperseded = true;
+	release();
 }
 
 LINPHONE_END_NAMESPACE
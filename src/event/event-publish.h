@@ -62,18 +62,15 @@ public:
 	void unpublish() override;
 
 	void terminate() override;
+	void supersede();
 
 	LinphoneStatus sendPublish(const std::shared_ptr<const Content> &body, bool notifyErr);
 
-	void startTimeoutHandling();
-	void stopTimeoutHandling();
-
 private:
-	belle_sip_source_t *mTimer = nullptr;
-
 	LinphonePublishState mPublishState = LinphonePublishNone;
 
 	bool mOneshot = false;
+	bool mSuperseded = false;
 };
 
 LINPHONE_END_NAMESPACE
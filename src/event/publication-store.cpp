@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publication-store.h"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+void PublicationStore::setLimits(size_t maxPublications, size_t maxBytes) {
+	mMaxPublications = maxPublications;
+	mMaxBytes = maxBytes;
+}
+
+void PublicationStore::setComposeHandler(const ComposeHandler &handler) {
+	mComposeHandler = handler;
+}
+
+bool PublicationStore::accepts(const string &previousETag, size_t bodySize) {
+	const Publication *previous = previousETag.empty() ? nullptr : find(previousETag);
+	size_t count = mPublications.size();
+	size_t bytes = mStats.bytes;
+	if (previous) {
+		// Refreshes without body keep the previous one.
+		if (bodySize > previous->body.size()) bytes += bodySize - previous->body.size();
+	} else {
+		count++;
+		bytes += getFootprint(Publication()) + bodySize;
+	}
+	if (count > mMaxPublications || bytes > mMaxBytes) {
+		mStats.rejected++;
+		return false;
+	}
+	return true;
+}
+
+bool PublicationStore::put(Publication publication, const string &previousETag, bool hasBody) {
+	auto previous = mPublications.end();
+	auto idIt = mIdsByETag.find(previousETag.empty() ? publication.eTag : previousETag);
+	if (idIt != mIdsByETag.end()) previous = mPublications.find(idIt->second);
+	if (previous != mPublications.end() && !hasBody) {
+		publication.contentType = previous->second.contentType;
+		publication.body = previous->second.body;
+	}
+
+	size_t footprint = getFootprint(publication);
+	size_t count = mPublications.size() + 1;
+	size_t bytes = mStats.bytes + footprint;
+	if (previous != mPublications.end()) {
+		count--;
+		bytes -= getFootprint(previous->second);
+	}
+	if (count > mMaxPublications || bytes > mMaxBytes) {
+		mStats.rejected++;
+		return false;
+	}
+
+	string previousEntity;
+	string previousEvent;
+	if (previous != mPublications.end()) {
+		previousEntity = previous->second.entity;
+		previousEvent = previous->second.event;
+		erase(previous);
+		mStats.refreshed++;
+	} else {
+		mStats.added++;
+	}
+
+	uint64_t id = mNextId++;
+	mIdsByETag[publication.eTag] = id;
+	mIdsByEntity[publication.entity].insert(id);
+	mIdsByEvent[publication.event].insert(id);
+	mStats.bytes += footprint;
+	const auto &stored = mPublications.emplace(id, std::move(publication)).first->second;
+	mStats.publications = mPublications.size();
+	pushExpiry(stored.expiresAt, id);
+
+	bool moved = !previousEntity.empty() && (previousEntity != stored.entity || previousEvent != stored.event);
+	if (moved) compose(previousEntity, previousEvent);
+	// A refresh without body leaves the state unchanged.
+	if (hasBody || previousEntity.empty() || moved) compose(stored.entity, stored.event);
+	return true;
+}
+
+shared_ptr<EventPublish> PublicationStore::remove(const string &eTag) {
+	auto idIt = mIdsByETag.find(eTag);
+	if (idIt == mIdsByETag.end()) return nullptr;
+	auto it = mPublications.find(idIt->second);
+	auto publish = it->second.publish;
+	string entity = it->second.entity;
+	string event = it->second.event;
+	erase(it);
+	mStats.removed++;
+	compose(entity, event);
+	return publish;
+}
+
+vector<shared_ptr<EventPublish>> PublicationStore::removeExpired(uint64_t now) {
+	vector<shared_ptr<EventPublish>> expired;
+	set<pair<string, string>> changed;
+	while (!mExpiries.empty() && mExpiries.front().expiresAt <= now) {
+		uint64_t id = mExpiries.front().id;
+		pop_heap(mExpiries.begin(), mExpiries.end(), laterThan);
+		mExpiries.pop_back();
+		auto it = mPublications.find(id);
+		if (it == mPublications.end()) continue;
+		if (it->second.publish) expired.push_back(it->second.publish);
+		changed.emplace(it->second.entity, it->second.event);
+		erase(it);
+		mStats.expired++;
+	}
+	for (const auto &entityEvent : changed)
+		compose(entityEvent.first, entityEvent.second);
+	return expired;
+}
+
+void PublicationStore::clear() {
+	mPublications.clear();
+	mIdsByETag.clear();
+	mIdsByEntity.clear();
+	mIdsByEvent.clear();
+	mExpiries.clear();
+	mStats.publications = 0;
+	mStats.bytes = 0;
+}
+
+const PublicationStore::Publication *PublicationStore::find(const string &eTag) const {
+	auto idIt = mIdsByETag.find(eTag);
+	if (idIt == mIdsByETag.end()) return nullptr;
+	return &mPublications.at(idIt->second);
+}
+
+vector<const PublicationStore::Publication *> PublicationStore::findByEntity(const string &entity,
+                                                                             const string &event) const {
+	vector<const Publication *> publications;
+	auto it = mIdsByEntity.find(entity);
+	if (it == mIdsByEntity.end()) return publications;
+	for (uint64_t id : it->second) {
+		const Publication &publication = mPublications.at(id);
+		if (event.empty() || publication.event == event) publications.push_back(&publication);
+	}
+	return publications;
+}
+
+vector<const PublicationStore::Publication *> PublicationStore::findByEvent(const string &event) const {
+	vector<const Publication *> publications;
+	auto it = mIdsByEvent.find(event);
+	if (it == mIdsByEvent.end()) return publications;
+	publications.reserve(it->second.size());
+	for (uint64_t id : it->second)
+		publications.push_back(&mPublications.at(id));
+	return publications;
+}
+
+size_t PublicationStore::getFootprint(const Publication &publication) {
+	// The publication, its node in each index, the ETag key and the expiry, roughly.
+	return sizeof(Publication) + 4 * 32 + sizeof(Expiry) + 2 * publication.eTag.size() + publication.entity.size() +
+	       publication.event.size() + publication.contentType.size() + publication.body.size();
+}
+
+void PublicationStore::pushExpiry(uint64_t expiresAt, uint64_t id) {
+	mExpiries.push_back({expiresAt, id});
+	push_heap(mExpiries.begin(), mExpiries.end(), laterThan);
+	if (mExpiries.size() > 2 * mPublications.size() + 1024) rebuildHeap();
+}
+
+void PublicationStore::rebuildHeap() {
+	mExpiries.clear();
+	mExpiries.reserve(mPublications.size());
+	for (const auto &entry : mPublications)
+		mExpiries.push_back({entry.second.expiresAt, entry.first});
+	make_heap(mExpiries.begin(), mExpiries.end(), laterThan);
+}
+
+void PublicationStore::erase(unordered_map<uint64_t, Publication>::iterator it) {
+	const Publication &publication = it->second;
+	mIdsByETag.erase(publication.eTag);
+	unindex(mIdsByEntity, publication.entity, it->first);
+	unindex(mIdsByEvent, publication.event, it->first);
+	mStats.bytes -= getFootprint(publication);
+	mPublications.erase(it);
+	mStats.publications = mPublications.size();
+}
+
+void PublicationStore::compose(const string &entity, const string &event) const {
+	if (mComposeHandler) mComposeHandler(entity, event, findByEntity(entity, event));
+}
+
+bool PublicationStore::laterThan(const Expiry &a, const Expiry &b) {
+	return a.expiresAt > b.expiresAt;
+}
+
+void PublicationStore::unindex(unordered_map<string, Ids> &index, const string &key, uint64_t id) {
+	auto it = index.find(key);
+	if (it == index.end()) return;
+	it->second.erase(id);
+	if (it->second.empty()) index.erase(it);
+}
+
+LINPHONE_END_NAMESPACE
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_PUBLICATION_STORE_H_
+#define _L_PUBLICATION_STORE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class EventPublish;
+
+/*
+ * Publications received by the core when it is the target of PUBLISH requests (RFC 3903), indexed by ETag, entity and
+ * event package. Expiry times are kept in a min-heap and the expired publications are removed by removeExpired(),
+ * called periodically by the core. The number of publications and the memory they use are bounded.
+ * Times are in milliseconds, on the clock of the caller.
+ */
+class PublicationStore {
+public:
+	struct Publication {
+		std::string eTag;
+		std::string entity;
+		std::string event;
+		std::string contentType;
+		std::string body;
+		uint64_t expiresAt = 0;
+		std::shared_ptr<EventPublish> publish;
+	};
+
+	struct Stats {
+		size_t publications = 0;
+		size_t bytes = 0;
+		unsigned long long added = 0;
+		unsigned long long refreshed = 0;
+		unsigned long long removed = 0;
+		unsigned long long expired = 0;
+		unsigned long long rejected = 0;
+	};
+
+	// Called with the current publications of an entity for an event package, possibly none, each time they change.
+	// It must not modify the store.
+	using ComposeHandler = std::function<void(
+	    const std::string &entity, const std::string &event, const std::vector<const Publication *> &publications)>;
+
+	void setLimits(size_t maxPublications, size_t maxBytes);
+	void setComposeHandler(const ComposeHandler &handler);
+
+	// Checks that a publication with a body of this size, replacing the one of previousETag if not empty, fits in the
+	// limits. The rejection is counted otherwise.
+	bool accepts(const std::string &previousETag, size_t bodySize);
+
+	// Stores the publication under its ETag, replacing the one of previousETag if any. A refresh, without body, keeps
+	// the content of the replaced publication. Returns false when the limits would be exceeded.
+	bool put(Publication publication, const std::string &previousETag = std::string(), bool hasBody = true);
+
+	// Returns the event of the removed publication, if any.
+	std::shared_ptr<EventPublish> remove(const std::string &eTag);
+	// Removes the publications expired at this time, and returns their events.
+	std::vector<std::shared_ptr<EventPublish>> removeExpired(uint64_t now);
+	void clear();
+
+	const Publication *find(const std::string &eTag) const;
+	// An empty event matches all the event packages.
+	std::vector<const Publication *> findByEntity(const std::string &entity,
+	                                              const std::string &event = std::string()) const;
+	std::vector<const Publication *> findByEvent(const std::string &event) const;
+
+	size_t size() const {
+		return mPublications.size();
+	}
+	bool empty() const {
+		return mPublications.empty();
+	}
+	const Stats &getStats() const {
+		return mStats;
+	}
+
+	static size_t getFootprint(const Publication &publication);
+
+private:
+	using Ids = std::unordered_set<uint64_t>;
+
+	struct Expiry {
+		uint64_t expiresAt;
+		uint64_t id;
+	};
+
+	// Removed and refreshed publications leave their expiry in the heap: they are skipped when popped, and the heap
+	// is rebuilt when they are too many.
+	void pushExpiry(uint64_t expiresAt, uint64_t id);
+	void rebuildHeap();
+	void erase(std::unordered_map<uint64_t, Publication>::iterator it);
+	void compose(const std::string &entity, const std::string &event) const;
+
+	static bool laterThan(const Expiry &a, const Expiry &b);
+	static void unindex(std::unordered_map<std::string, Ids> &index, const std::string &key, uint64_t id);
+
+	std::unordered_map<uint64_t, Publication> mPublications;
+	std::unordered_map<std::string, uint64_t> mIdsByETag;
+	std::unordered_map<std::string, Ids> mIdsByEntity;
+	std::unordered_map<std::string, Ids> mIdsByEvent;
+	std::vector<Expiry> mExpiries;
+	uint64_t mNextId = 1;
+	size_t mMaxPublications = 100000;
+	size_t mMaxBytes = 64 * 1024 * 1024;
+	Stats mStats;
+	ComposeHandler mComposeHandler;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_PUBLICATION_STORE_H_
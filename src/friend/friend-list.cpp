@@ -230,6 +230,7 @@ std::shared_ptr<Friend> FriendList::findFriendByPhoneNumber(const std::string &p
 		    Account::toCpp((LinphoneAccount *)bctbx_list_get_data(elem))->getSharedFromThis();
 		char *normalizedPhoneNumber =
 		    linphone_account_normalize_phone_number(account->toC(), L_STRING_TO_C(phoneNumber));
+		if (!normalizedPhoneNumber) continue;
 		std::shared_ptr<Friend> result = findFriendByPhoneNumber(account, normalizedPhoneNumber);
 		bctbx_free(normalizedPhoneNumber);
 		if (result) return result;
@@ -561,9 +562,105 @@ std::shared_ptr<Friend> FriendList::findFriendByOutSubscribe(SalOp *op) const {
 
 std::shared_ptr<Friend> FriendList::findFriendByPhoneNumber(const std::shared_ptr<Account> &account,
                                                             const std::string &normalizedPhoneNumber) const {
-	const auto it = std::find_if(mFriends.cbegin(), mFriends.cend(),
-	                             [&](const auto &f) { return f->hasPhoneNumber(account, normalizedPhoneNumber); });
-	return (it == mFriends.cend()) ? nullptr : *it;
+	if (normalizedPhoneNumber.empty()) return nullptr;
+	const PhoneNumberIndex &index = getPhoneNumberIndex(account);
+	const auto it = index.friendsByPhoneNumber.find(normalizedPhoneNumber);
+	return (it == index.friendsByPhoneNumber.cend()) ? nullptr : it->second.front();
+}
+
+FriendList::PhoneNumberIndex &FriendList::getPhoneNumberIndex(const std::shared_ptr<Account> &account) const {
+	const LinphoneAccountParams *params = linphone_account_get_params(account->toC());
+	const char *internationalPrefix = linphone_account_params_get_international_prefix(params);
+	bool dialEscapePlus = !!linphone_account_params_dial_escape_plus_enabled(params);
+	std::string key = std::string(internationalPrefix ? "+" : "-") + L_C_TO_STRING(internationalPrefix) +
+	                  (dialEscapePlus ? "/escape" : "");
+
+	auto it = mPhoneNumberIndexes.find(key);
+	if (it != mPhoneNumberIndexes.end()) return it->second;
+
+	PhoneNumberIndex &index = mPhoneNumberIndexes[key];
+	index.internationalPrefix = L_C_TO_STRING(internationalPrefix);
+	index.hasInternationalPrefix = (internationalPrefix != nullptr);
+	index.dialEscapePlus = dialEscapePlus;
+	for (const auto &lf : mFriends) {
+		index.positions[lf.get()] = (long long)index.positions.size();
+		indexPhoneNumbers(index, lf);
+	}
+	lInfo() << "Friend list [" << toC() << "] phone numbers indexed for international prefix ["
+	        << index.internationalPrefix << "]: " << index.friendsByPhoneNumber.size() << " numbers";
+	return index;
+}
+
+void FriendList::addToPhoneNumberIndexes(const std::shared_ptr<Friend> &lf) {
+	// The friend has just been put at the front of the list.
+	for (auto &entry : mPhoneNumberIndexes) {
+		entry.second.positions[lf.get()] = --entry.second.frontPosition;
+		indexPhoneNumbers(entry.second, lf);
+	}
+}
+
+void FriendList::removeFromPhoneNumberIndexes(const std::shared_ptr<Friend> &lf) {
+	for (auto &entry : mPhoneNumberIndexes) {
+		unindexPhoneNumbers(entry.second, lf.get());
+		entry.second.positions.erase(lf.get());
+	}
+}
+
+void FriendList::updatePhoneNumberIndexes(const std::shared_ptr<Friend> &lf) {
+	// The friend keeps its position in the list, and thus in the friends sharing its numbers.
+	for (auto &entry : mPhoneNumberIndexes) {
+		if (entry.second.positions.find(lf.get()) == entry.second.positions.end()) continue; // Not indexed yet.
+		unindexPhoneNumbers(entry.second, lf.get());
+		indexPhoneNumbers(entry.second, lf);
+	}
+}
+
+void FriendList::replaceInPhoneNumberIndexes(const std::shared_ptr<Friend> &oldFriend,
+                                             const std::shared_ptr<Friend> &newFriend) {
+	for (auto &entry : mPhoneNumberIndexes) {
+		PhoneNumberIndex &index = entry.second;
+		const auto it = index.positions.find(oldFriend.get());
+		if (it == index.positions.end()) continue;
+		long long position = it->second;
+		unindexPhoneNumbers(index, oldFriend.get());
+		index.positions.erase(it);
+		index.positions[newFriend.get()] = position;
+		indexPhoneNumbers(index, newFriend);
+	}
+}
+
+void FriendList::indexPhoneNumbers(PhoneNumberIndex &index, const std::shared_ptr<Friend> &lf) {
+	const char *internationalPrefix = index.hasInternationalPrefix ? index.internationalPrefix.c_str() : nullptr;
+	const long long position = index.positions.at(lf.get());
+	std::vector<std::string> phoneNumbers;
+	for (const auto &phoneNumber : lf->getPhoneNumbers()) {
+		char *normalizedPhoneNumber =
+		    _linphone_normalize_phone_number(internationalPrefix, index.dialEscapePlus, L_STRING_TO_C(phoneNumber));
+		if (!normalizedPhoneNumber) continue;
+		std::string normalized(normalizedPhoneNumber);
+		bctbx_free(normalizedPhoneNumber);
+		if (normalized.empty() ||
+		    std::find(phoneNumbers.cbegin(), phoneNumbers.cend(), normalized) != phoneNumbers.cend())
+			continue;
+		auto &friends = index.friendsByPhoneNumber[normalized];
+		auto next = std::find_if(friends.begin(), friends.end(),
+		                         [&index, position](const auto &f) { return index.positions.at(f.get()) > position; });
+		friends.insert(next, lf);
+		phoneNumbers.push_back(std::move(normalized));
+	}
+	if (!phoneNumbers.empty()) index.phoneNumbersByFriend[lf.get()] = std::move(phoneNumbers);
+}
+
+void FriendList::unindexPhoneNumbers(PhoneNumberIndex &index, const Friend *lf) {
+	const auto it = index.phoneNumbersByFriend.find(lf);
+	if (it == index.phoneNumbersByFriend.end()) return;
+	for (const auto &phoneNumber : it->second) {
+		const auto friendsIt = index.friendsByPhoneNumber.find(phoneNumber);
+		if (friendsIt == index.friendsByPhoneNumber.end()) continue;
+		friendsIt->second.remove_if([lf](const auto &f) { return f.get() == lf; });
+		if (friendsIt->second.empty()) index.friendsByPhoneNumber.erase(friendsIt);
+	}
+	index.phoneNumbersByFriend.erase(it);
 }
 
 std::shared_ptr<Address> FriendList::getRlsAddressWithCoreFallback() const {
@@ -596,6 +693,7 @@ LinphoneFriendListStatus FriendList::importFriend(const std::shared_ptr<Friend>
 	lf->mFriendList = this;
 	mFriends.push_front(lf);
 	lf->addAddressesAndNumbersIntoMaps(getSharedFromThis());
+	addToPhoneNumberIndexes(lf);
 	if (synchronize) {
 		mDirtyFriendsToUpdate.push_front(lf);
 		mBctbxDirtyFriendsToUpdate = bctbx_list_prepend(mBctbxDirtyFriendsToUpdate, lf->toC());
@@ -624,6 +722,7 @@ void FriendList::invalidateFriendsMaps() {
 	mFriendsMapByUri.clear();
 	for (const auto &f : mFriends)
 		f->addAddressesAndNumbersIntoMaps(getSharedFromThis());
+	mPhoneNumberIndexes.clear();
 }
 
 void FriendList::invalidateSubscriptions() {
@@ -862,6 +961,7 @@ void FriendList::deleteFriend(const std::shared_ptr<Friend> &lf, bool removeFrom
 		}
 	}
 
+	removeFromPhoneNumberIndexes(lf);
 	lf->mFriendList = nullptr;
 }
 
@@ -972,14 +1072,16 @@ void FriendList::sendListSubscriptionWithoutBody(const std::shared_ptr<Address>
 
 void FriendList::setFriends(const std::list<std::shared_ptr<Friend>> &friends) {
 	mFriends = friends;
+	mPhoneNumberIndexes.clear();
 }
 
 void FriendList::syncBctbxFriends() const {
 	if (mBctbxFriends) {
 		bctbx_list_free(mBctbxFriends), mBctbxFriends = nullptr;
 	}
-	for (const auto &f : mFriends) {
-		mBctbxFriends = bctbx_list_append(mBctbxFriends, f->toC());
+	// Prepend from the end: appending would walk the whole C list for each friend.
+	for (auto it = mFriends.rbegin(); it != mFriends.rend(); ++it) {
+		mBctbxFriends = bctbx_list_prepend(mBctbxFriends, (*it)->toC());
 	}
 }
 
@@ -1067,7 +1169,10 @@ void FriendList::carddavUpdated(const CardDAVContext *context,
                                 const std::shared_ptr<Friend> &oldFriend) {
 	auto it = std::find_if(context->mFriendList->mFriends.begin(), context->mFriendList->mFriends.end(),
 	                       [&](const auto &elem) { return elem == oldFriend; });
-	if (it != context->mFriendList->mFriends.end()) *it = newFriend;
+	if (it != context->mFriendList->mFriends.end()) {
+		*it = newFriend;
+		context->mFriendList->replaceInPhoneNumberIndexes(oldFriend, newFriend);
+	}
 	newFriend->saveInDb();
 	LINPHONE_HYBRID_OBJECT_INVOKE_CBS(FriendList, context->mFriendList, linphone_friend_list_cbs_get_contact_updated,
 	                                  newFriend->toC(), oldFriend->toC());
@@ -21,6 +21,9 @@
 #ifndef _L_FRIEND_LIST_H_
 #define _L_FRIEND_LIST_H_
 
+#include <unordered_map>
+#include <vector>
+
 #include "c-wrapper/c-wrapper.h"
 
 // =============================================================================
@@ -126,6 +129,19 @@ public:
 	void updateRevision(int revision);
 
 private:
+	// Friends by phone number, normalized with the dial plan settings of the accounts that look them up.
+	struct PhoneNumberIndex {
+		std::string internationalPrefix;
+		bool hasInternationalPrefix = false;
+		bool dialEscapePlus = false;
+		// In the order of the friend list, so that a lookup returns the same friend as a scan of the list.
+		std::unordered_map<std::string, std::list<std::shared_ptr<Friend>>> friendsByPhoneNumber;
+		std::unordered_map<const Friend *, std::vector<std::string>> phoneNumbersByFriend;
+		// Position of every friend in the friend list, numbers or not: imported friends are put before the others.
+		std::unordered_map<const Friend *, long long> positions;
+		long long frontPosition = 0;
+	};
+
 	LinphoneFriendListStatus addFriend(const std::shared_ptr<Friend> &lf, bool synchronize);
 	void closeSubscriptions();
 	std::string createResourceListXml() const;
@@ -133,11 +149,17 @@ private:
 	std::shared_ptr<Friend> findFriendByOutSubscribe(SalOp *op) const;
 	std::shared_ptr<Friend> findFriendByPhoneNumber(const std::shared_ptr<Account> &account,
 	                                                const std::string &normalizedPhoneNumber) const;
+	PhoneNumberIndex &getPhoneNumberIndex(const std::shared_ptr<Account> &account) const;
 	std::shared_ptr<Address> getRlsAddressWithCoreFallback() const;
 	bool hasSubscribeInactive() const;
 	LinphoneFriendListStatus importFriend(const std::shared_ptr<Friend> &lf, bool synchronize);
 	LinphoneStatus importFriendsFromVcard4(const std::list<std::shared_ptr<Vcard>> &vcards);
 	void invalidateFriendsMaps();
+	void addToPhoneNumberIndexes(const std::shared_ptr<Friend> &lf);
+	void removeFromPhoneNumberIndexes(const std::shared_ptr<Friend> &lf);
+	void updatePhoneNumberIndexes(const std::shared_ptr<Friend> &lf);
+	void replaceInPhoneNumberIndexes(const std::shared_ptr<Friend> &oldFriend,
+	                                 const std::shared_ptr<Friend> &newFriend);
 	void invalidateSubscriptions();
 	void notifyPresenceReceived(const std::shared_ptr<const Content> &content);
 	void parseMultipartRelatedBody(const std::shared_ptr<const Content> &content, const std::string &firstPartBody);
@@ -153,6 +175,8 @@ private:
 	void syncBctbxFriends() const;
 	void updateSubscriptions();
 
+	static void indexPhoneNumbers(PhoneNumberIndex &index, const std::shared_ptr<Friend> &lf);
+	static void unindexPhoneNumbers(PhoneNumberIndex &index, const Friend *lf);
 	static void
 	subscriptionStateChanged(LinphoneCore *lc, const std::shared_ptr<Event> event, LinphoneSubscriptionState state);
 #ifdef VCARD_ENABLED
@@ -172,6 +196,8 @@ private:
 	mutable bctbx_list_t *mBctbxFriends = nullptr; // This field must be kept in sync with mFriends
 	std::map<std::string, std::shared_ptr<Friend>> mFriendsMapByRefKey;
 	std::multimap<std::string, std::shared_ptr<Friend>> mFriendsMapByUri;
+	// Built on the first phone number lookup for each dial plan context, then kept up to date.
+	mutable std::map<std::string, PhoneNumberIndex> mPhoneNumberIndexes;
 	std::array<unsigned char, 16> *mContentDigest = nullptr;
 	int mExpectedNotificationVersion;
 	long long mStorageId = -1;
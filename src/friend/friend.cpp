@@ -193,7 +193,10 @@ void Friend::setVcard(const std::shared_ptr<Vcard> &vcard) {
 	}
 
 	mVcard = vcard;
-	if (mFriendList) saveInDb();
+	if (mFriendList) {
+		mFriendList->updatePhoneNumberIndexes(getSharedFromThis());
+		saveInDb();
+	}
 }
 
 // -----------------------------------------------------------------------------
@@ -447,6 +450,7 @@ void Friend::addPhoneNumber(const std::string &phoneNumber) {
 		if (!mVcard) createVcard(phoneNumber);
 		if (mVcard) mVcard->addPhoneNumber(phoneNumber);
 	}
+	if (mFriendList) mFriendList->updatePhoneNumberIndexes(getSharedFromThis());
 }
 
 void Friend::addPhoneNumberWithLabel(const std::shared_ptr<const FriendPhoneNumber> &phoneNumber) {
@@ -458,6 +462,7 @@ void Friend::addPhoneNumberWithLabel(const std::shared_ptr<const FriendPhoneNumb
 		if (!mVcard) createVcard(phone);
 		if (mVcard) mVcard->addPhoneNumberWithLabel(phoneNumber);
 	}
+	if (mFriendList) mFriendList->updatePhoneNumberIndexes(getSharedFromThis());
 }
 
 bool Friend::createVcard(const std::string &name) {
@@ -487,6 +492,7 @@ void Friend::done() {
 			lDebug() << "vCard's md5 has changed, mark friend as dirty and clear sip addresses list cache";
 			mVcard->cleanCache();
 			if (mFriendList) {
+				mFriendList->updatePhoneNumberIndexes(getSharedFromThis());
 				mFriendList->mDirtyFriendsToUpdate.push_back(getSharedFromThis());
 				mFriendList->mBctbxDirtyFriendsToUpdate =
 				    bctbx_list_append(mFriendList->mBctbxDirtyFriendsToUpdate, toC());
@@ -617,6 +623,7 @@ void Friend::removePhoneNumber(const std::string &phoneNumber) {
 	if (linphone_core_vcard_supported() && mVcard) {
 		mVcard->removePhoneNumber(phoneNumber);
 	}
+	if (mFriendList) mFriendList->updatePhoneNumberIndexes(getSharedFromThis());
 }
 
 void Friend::removePhoneNumberWithLabel(const std::shared_ptr<const FriendPhoneNumber> &phoneNumber) {
@@ -629,6 +636,7 @@ void Friend::removePhoneNumberWithLabel(const std::shared_ptr<const FriendPhoneN
 	if (linphone_core_vcard_supported() && mVcard) {
 		mVcard->removePhoneNumberWithLabel(phoneNumber);
 	}
+	if (mFriendList) mFriendList->updatePhoneNumberIndexes(getSharedFromThis());
 }
 
 bool Friend::subscribesEnabled() const {
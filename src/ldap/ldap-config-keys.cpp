@@ -31,6 +31,7 @@ static const std::map<std::string, LdapConfigKeys> gLdapConfigKeys = {
     {"max_results", LdapConfigKeys("5", '\0', false)},
     {"min_chars", LdapConfigKeys("0", '\0', false)},
     {"delay", LdapConfigKeys("500", '\0', false)},
+    {"cache_ttl", LdapConfigKeys("60", '\0', false)},
     {"auth_method", LdapConfigKeys(Utils::toString((int)LinphoneLdapAuthMethodSimple), '\0', false)},
     {"password", LdapConfigKeys("", '\0', false)},
     {"bind_dn", LdapConfigKeys("", '\0', false)},
@@ -66,6 +66,9 @@ public:
 	 *   - "delay" : "500".
 	 * The delay between each search in milliseconds.
 	 *
+	 *   - "cache_ttl" : "60".
+	 * How long the results of a search are kept in cache, in seconds. 0 disables the cache.
+	 *
 	 *   - "auth_method" : "SIMPLE".
 	 * Authentification method. Only "SIMPLE" and "ANONYMOUS" are supported.
 	 *
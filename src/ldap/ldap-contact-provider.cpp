@@ -20,8 +20,11 @@
 
 #include "ldap-contact-provider.h"
 
+#include "bctoolbox/defs.h"
+
 #include "../search/search-result.h"
 #include "contact_providers_priv.h"
+#include "core/core-p.h"
 #include "ldap-config-keys.h"
 #include "ldap-contact-fields.h"
 #include "ldap-contact-search.h"
@@ -31,6 +34,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 
@@ -63,7 +67,8 @@ LdapContactProvider::LdapContactProvider(const std::shared_ptr<Core> &core,
 	mSalContext = NULL;
 	const std::map<std::string, std::vector<std::string>> &config = ldap->getLdapParams()->getConfig();
 	// register our hook into iterate so that LDAP can do its magic asynchronously.
-	mIteration = mCore->createTimer(std::bind(&LdapContactProvider::iterate, this), 50, "LdapContactProvider");
+	mIteration = mCore->createTimer(std::bind(&LdapContactProvider::iterate, this), ActiveIterationPeriod,
+	                                "LdapContactProvider");
 	if (!LdapConfigKeys::validConfig(config)) {
 		ms_error("[LDAP] Invalid configuration for LDAP, aborting creation");
 		mCurrentAction = ACTION_ERROR;
@@ -82,6 +87,7 @@ LdapContactProvider::~LdapContactProvider() {
 }
 
 void LdapContactProvider::cleanLdap() {
+	unwatchLdapDescriptor();
 	if (mSalContext) {
 		belle_sip_resolver_context_cancel(mSalContext);
 		belle_sip_object_unref(mSalContext);
@@ -97,6 +103,39 @@ void LdapContactProvider::cleanLdap() {
 	mLd = nullptr;
 }
 
+void LdapContactProvider::watchLdapDescriptor() {
+	if (mFdSource || !mLd) return;
+	ber_socket_t fd = (ber_socket_t)-1;
+	// The descriptor only exists once the connection has been started.
+	if (ldap_get_option(mLd, LDAP_OPT_DESC, &fd) != LDAP_OPT_SUCCESS || fd == (ber_socket_t)-1) return;
+	mFdSource = belle_sip_socket_source_new(onLdapDescriptorEvent, this, (belle_sip_socket_t)fd,
+	                                        BELLE_SIP_EVENT_READ | BELLE_SIP_EVENT_ERROR, (unsigned int)-1);
+	belle_sip_main_loop_add_source(L_GET_PRIVATE(mCore)->getMainLoop(), mFdSource);
+	lDebug() << "[LDAP] Watching connection descriptor " << fd;
+}
+
+void LdapContactProvider::unwatchLdapDescriptor() {
+	if (!mFdSource) return;
+	belle_sip_main_loop_remove_source(L_GET_PRIVATE(mCore)->getMainLoop(), mFdSource);
+	belle_sip_object_unref(mFdSource);
+	mFdSource = nullptr;
+}
+
+void LdapContactProvider::scheduleIteration() {
+	if (!mIteration) return;
+	int period = ActiveIterationPeriod;
+	if (std::any_of(mRequests.begin(), mRequests.end(),
+	                [](const std::shared_ptr<LdapContactSearch> &r) { return r->mCachedResult != nullptr; })) {
+		period = 0; // Answer from the cache right away.
+	} else if (mFdSource && mCurrentAction == ACTION_WAIT_REQUEST &&
+	           std::none_of(mRequests.begin(), mRequests.end(),
+	                        [](const std::shared_ptr<LdapContactSearch> &r) { return r->mMsgId == 0; })) {
+		// Results are processed when the connection can be read, the iteration only checks for timeouts.
+		period = IdleIterationPeriod;
+	}
+	belle_sip_source_set_timeout_int64(mIteration, (int64_t)period);
+}
+
 std::vector<std::shared_ptr<LdapContactProvider>> LdapContactProvider::create(const std::shared_ptr<Core> &core,
                                                                               int maxResults) {
 	std::vector<std::shared_ptr<LdapContactProvider>> providers;
@@ -343,9 +382,12 @@ bool LdapContactProvider::search(const std::string &predicate,
 	if (configValueToInt("min_chars") <= (int)predicate.length()) {
 		std::shared_ptr<LdapContactSearch> request = std::make_shared<LdapContactSearch>(this, predicate, cb, cbData);
 		if (request != NULL) {
+			if (configValueToInt("cache_ttl") > 0)
+				request->mCachedResult = L_GET_PRIVATE(mCore)->ldapResultCache.find(getCacheQuery(*request));
 			mRequests.push_back(request);
 		}
 		computeLastRequestTime(requestHistory);
+		scheduleIteration();
 		return true;
 	} else return false;
 }
@@ -354,8 +396,7 @@ bool LdapContactProvider::search(const std::string &predicate,
 int LdapContactProvider::search(std::shared_ptr<LdapContactSearch> request) {
 	int ret = -1;
 	struct timeval timeout = {configValueToInt("timeout"), 0};
-	int maxResults = std::min(configValueToInt("max_results"), mMaxResults);
-	if (maxResults > 0) ++maxResults; // +1 to know if there is more than limit
+	int maxResults = getSizeLimit();
 	if (request->mMsgId == 0) {
 		ret = ldap_search_ext(mLd,
 		                      configValueToStr("base_object").c_str(), // base from which to start
@@ -399,6 +440,42 @@ std::list<std::shared_ptr<LdapContactSearch>>::iterator LdapContactProvider::can
 	return listEntry;
 }
 
+int LdapContactProvider::getSizeLimit() const {
+	int maxResults = std::min(configValueToInt("max_results"), mMaxResults);
+	if (maxResults > 0) ++maxResults; // +1 to know if there is more than limit
+	return maxResults;
+}
+
+LdapResultCache::Query LdapContactProvider::getCacheQuery(const LdapContactSearch &request) const {
+	LdapResultCache::Query query;
+	query.server = LdapConfigKeys::join("server", mConfig.at("server"));
+	// The password is only kept hashed, results obtained with former credentials are not reused.
+	query.bindIdentity = configValueToStr("auth_method") + '\n' + configValueToStr("bind_dn") + '\n' +
+	                     std::to_string(std::hash<std::string>()(configValueToStr("password")));
+	query.baseObject = configValueToStr("base_object");
+	query.attributes = "*"; // All the user attributes are requested.
+	query.sizeLimit = getSizeLimit();
+	query.filterTemplate = configValueToStr("filter");
+	query.predicate = request.getPredicate();
+	query.filter = request.mFilter;
+	return query;
+}
+
+void LdapContactProvider::serveCachedRequests() {
+	for (auto it = mRequests.begin(); it != mRequests.end();) {
+		if (!(*it) || !(*it)->mCachedResult) {
+			++it;
+			continue;
+		}
+		LdapContactSearch *request = it->get();
+		lDebug() << "[LDAP] Search for " << request->mFilter << " answered from cache";
+		for (const auto &attributes : request->mCachedResult->entries)
+			addContact(request, attributes);
+		if (request->mCachedResult->haveMoreResults) request->mHaveMoreResults = true;
+		it = cancelSearch(request);
+	}
+}
+
 LdapContactSearch *LdapContactProvider::requestSearch(int msgid) {
 	auto listEntry = std::find_if(mRequests.begin(), mRequests.end(),
 	                              [msgid](const std::shared_ptr<LdapContactSearch> &a) { return a->mMsgId == msgid; });
@@ -468,6 +545,9 @@ bool LdapContactProvider::iterate(void *data) {
 	LDAPMessage *results = NULL;
 	LdapContactProvider *provider = (LdapContactProvider *)data;
 
+	// Searches answered by the cache do not need the server, whatever its state.
+	provider->serveCachedRequests();
+
 	if (provider->mCurrentAction == ACTION_ERROR) {
 		lDebug() << "[LDAP] ACTION_ERROR";
 		provider->cleanLdap();
@@ -583,6 +663,7 @@ bool LdapContactProvider::iterate(void *data) {
 
 		if (provider->mCurrentAction == ACTION_WAIT_BIND) {
 			lDebug() << "[LDAP] ACTION_WAIT_BIND";
+			provider->watchLdapDescriptor();
 			int ret =
 			    (int)ldap_result(provider->mLd, provider->mAwaitingMessageId, LDAP_MSG_ONE, &pollTimeout, &results);
 			if (ret == LDAP_RES_BIND) {
@@ -619,47 +700,61 @@ bool LdapContactProvider::iterate(void *data) {
 				requestSize = provider->mRequests.size();
 			}
 			if (requestSize > 0) { // No need to check connectivity as it is checked before
-				// never block
-				int ret = (int)ldap_result(provider->mLd, LDAP_RES_ANY, LDAP_MSG_ONE, &pollTimeout, &results);
-				switch (ret) {
-					case -1: {
-						int lastError = errno;
-						lWarning() << "[LDAP] : Error in ldap_result : returned -1 (req_count " << requestSize
-						           << "): " << ldap_err2string(lastError);
-						break;
-					}
-					case 0:
-						break; // nothing to do
+				provider->watchLdapDescriptor();
+				// never block, but process all the messages that are already available.
+				bool readMore = true;
+				while (readMore && !provider->mRequests.empty()) {
+					results = NULL;
+					int ret = (int)ldap_result(provider->mLd, LDAP_RES_ANY, LDAP_MSG_ONE, &pollTimeout, &results);
+					switch (ret) {
+						case -1: {
+							int lastError = errno;
+							lWarning() << "[LDAP] : Error in ldap_result : returned -1 (req_count " << requestSize
+							           << "): " << ldap_err2string(lastError);
+							// Do not get woken up again by a broken connection, fall back to the iterations.
+							provider->unwatchLdapDescriptor();
+							readMore = false;
+							break;
+						}
+						case 0:
+							readMore = false;
+							break; // nothing to do
 
-					case LDAP_RES_BIND: {
-						lWarning() << "[LDAP] iterate: unexpected LDAP_RES_BIND";
-						if (results) ldap_msgfree(results);
-						break;
-					}
-					case LDAP_RES_EXTENDED:
-					case LDAP_RES_SEARCH_ENTRY:
-					case LDAP_RES_SEARCH_REFERENCE:
-					case LDAP_RES_INTERMEDIATE:
-					case LDAP_RES_SEARCH_RESULT: {
-						provider->handleSearchResult(results);
-						break;
+						case LDAP_RES_BIND: {
+							lWarning() << "[LDAP] iterate: unexpected LDAP_RES_BIND";
+							break;
+						}
+						case LDAP_RES_EXTENDED:
+						case LDAP_RES_SEARCH_ENTRY:
+						case LDAP_RES_SEARCH_REFERENCE:
+						case LDAP_RES_INTERMEDIATE:
+						case LDAP_RES_SEARCH_RESULT: {
+							provider->handleSearchResult(results);
+							break;
+						}
+						case LDAP_RES_MODIFY:
+						case LDAP_RES_ADD:
+						case LDAP_RES_DELETE:
+						case LDAP_RES_MODDN:
+						case LDAP_RES_COMPARE:
+						default:
+							lWarning() << "[LDAP] Unhandled LDAP result " << ret;
+							break;
 					}
-					case LDAP_RES_MODIFY:
-					case LDAP_RES_ADD:
-					case LDAP_RES_DELETE:
-					case LDAP_RES_MODDN:
-					case LDAP_RES_COMPARE:
-					default:
-						lWarning() << "[LDAP] Unhandled LDAP result " << ret;
-						break;
+					if (results) ldap_msgfree(results);
 				}
-				if (results) ldap_msgfree(results);
 			}
 		}
 	}
+	provider->scheduleIteration();
 	return true;
 }
 
+int LdapContactProvider::onLdapDescriptorEvent(void *data, BCTBX_UNUSED(unsigned int events)) {
+	iterate(data);
+	return BELLE_SIP_CONTINUE;
+}
+
 void LdapContactProvider::ldapServerResolved(void *data, belle_sip_resolver_results_t *results) {
 	LdapContactProvider *provider = (LdapContactProvider *)(data);
 	provider->mServerUrl.clear();
@@ -687,15 +782,13 @@ void LdapContactProvider::handleSearchResult(LDAPMessage *message) {
 	if (message) {
 		int msgtype = ldap_msgtype(message);
 		LdapContactSearch *req = requestSearch(ldap_msgid(message));
+		int ttl = configValueToInt("cache_ttl");
 		switch (msgtype) {
 			case LDAP_RES_SEARCH_ENTRY:
 			case LDAP_RES_EXTENDED: {
 				LDAPMessage *entry = ldap_first_entry(mLd, message);
-				LinphoneCore *lc = mCore->getCCore();
 				// Message can be a list. Loop on entries
 				while (entry != NULL) {
-					LdapContactFields ldapData;
-					bool contact_complete = false;
 					BerElement *ber = NULL;
 					char *attr = ldap_first_attribute(mLd, entry, &ber);
 					// Each entry is about a contact. Loop on all attributes and fill contact. We do not stop when
@@ -712,34 +805,9 @@ void LdapContactProvider::handleSearchResult(LDAPMessage *message) {
 						ldap_memfree(attr);
 						attr = ldap_next_attribute(mLd, entry, ber);
 					}
-					contact_complete = buildContact(&ldapData, attributes);
-					if (contact_complete) {
-						LinphoneFriend *lfriend = linphone_core_create_friend(lc);
-						linphone_friend_set_name(lfriend, ldapData.mName.first.c_str());
-
-						for (auto sipAddress : ldapData.mSip) {
-							LinphoneAddress *la = linphone_core_interpret_url(lc, sipAddress.first.c_str());
-							if (la) {
-								linphone_address_set_display_name(la, ldapData.mName.first.c_str());
-								linphone_friend_add_address(lfriend, la);
-								linphone_friend_add_phone_number(lfriend, L_STRING_TO_C(sipAddress.second));
-
-								int maxResults = atoi(mConfig["max_results"][0].c_str());
-								if (maxResults == 0 || req->mFoundCount < (unsigned int)maxResults) {
-									std::shared_ptr<SearchResult> searchResult =
-									    SearchResult::create((unsigned int)0, la, sipAddress.second, lfriend,
-									                         LinphoneMagicSearchSourceLdapServers);
-									req->mFoundEntries.push_back(searchResult);
-									++req->mFoundCount;
-								} else { // Have more result (requested max_results+1). Do not store this result to
-									     // avoid missunderstanding from user.
-									req->mHaveMoreResults = true;
-								}
-								linphone_address_unref(la);
-							}
-						}
-
-						linphone_friend_unref(lfriend);
+					if (req) {
+						addContact(req, attributes);
+						if (ttl > 0) req->mEntries.push_back(std::move(attributes));
 					}
 					if (ber) ber_free(ber, 0);
 					if (attr) ldap_memfree(attr);
@@ -748,6 +816,16 @@ void LdapContactProvider::handleSearchResult(LDAPMessage *message) {
 			} break;
 			case LDAP_RES_SEARCH_RESULT: {
 				// this one is received when a request is finished
+				int resultCode = LDAP_OTHER;
+				if (req && ttl > 0 &&
+				    ldap_parse_result(mLd, message, &resultCode, NULL, NULL, NULL, NULL, 0) == LDAP_SUCCESS &&
+				    (resultCode == LDAP_SUCCESS || resultCode == LDAP_SIZELIMIT_EXCEEDED)) {
+					LdapResultCache::Result result;
+					result.entries = std::move(req->mEntries);
+					result.haveMoreResults = req->mHaveMoreResults || resultCode == LDAP_SIZELIMIT_EXCEEDED;
+					L_GET_PRIVATE(mCore)->ldapResultCache.insert(getCacheQuery(*req), std::move(result),
+					                                             (uint64_t)ttl * 1000);
+				}
 				cancelSearch(req);
 			} break;
 			default:
@@ -763,6 +841,39 @@ void LdapContactProvider::handleSearchResult(LDAPMessage *message) {
 	}
 }
 
+void LdapContactProvider::addContact(LdapContactSearch *request, const LdapResultCache::Attributes &attributes) {
+	LinphoneCore *lc = mCore->getCCore();
+	LdapContactFields ldapData;
+	if (buildContact(&ldapData, attributes)) {
+		LinphoneFriend *lfriend = linphone_core_create_friend(lc);
+		linphone_friend_set_name(lfriend, ldapData.mName.first.c_str());
+
+		for (auto sipAddress : ldapData.mSip) {
+			LinphoneAddress *la = linphone_core_interpret_url(lc, sipAddress.first.c_str());
+			if (la) {
+				linphone_address_set_display_name(la, ldapData.mName.first.c_str());
+				linphone_friend_add_address(lfriend, la);
+				linphone_friend_add_phone_number(lfriend, L_STRING_TO_C(sipAddress.second));
+
+				int maxResults = atoi(mConfig["max_results"][0].c_str());
+				if (maxResults == 0 || request->mFoundCount < (unsigned int)maxResults) {
+					std::shared_ptr<SearchResult> searchResult =
+					    SearchResult::create((unsigned int)0, la, sipAddress.second, lfriend,
+					                         LinphoneMagicSearchSourceLdapServers);
+					request->mFoundEntries.push_back(searchResult);
+					++request->mFoundCount;
+				} else { // Have more result (requested max_results+1). Do not store this result to
+					     // avoid missunderstanding from user.
+					request->mHaveMoreResults = true;
+				}
+				linphone_address_unref(la);
+			}
+		}
+
+		linphone_friend_unref(lfriend);
+	}
+}
+
 bool LdapContactProvider::isReadyForStart() {
 	return mLastRequestTime + (uint64_t)configValueToInt("delay") < bctbx_get_cur_time_ms();
 }
@@ -36,6 +36,7 @@
 
 #include "../search/magic-search.h"
 #include "../search/search-request.h"
+#include "ldap-result-cache.h"
 #include "ldap.h" // Linphone
 #include <ldap.h> // OpenLDAP
 
@@ -178,9 +179,54 @@ public:
 	 */
 	static void ldapServerResolved(void *data, belle_sip_resolver_results_t *results);
 
+	/**
+	 * @brief onLdapDescriptorEvent Callback of the main loop when the LDAP connection can be read. It processes the
+	 * received messages without waiting for the next iteration.
+	 * @param data #LdapContactProvider
+	 * @param events The events of the file descriptor
+	 * @return BELLE_SIP_CONTINUE
+	 */
+	static int onLdapDescriptorEvent(void *data, unsigned int events);
+
 private:
+	// Iteration period while an action is in progress, and while only waiting for the server on a watched connection.
+	static constexpr int ActiveIterationPeriod = 50;
+	static constexpr int IdleIterationPeriod = 1000;
+
 	void cleanLdap();
 
+	/**
+	 * @brief watchLdapDescriptor Let the main loop wake the provider up when the LDAP connection can be read, once
+	 * the connection is established.
+	 */
+	void watchLdapDescriptor();
+	void unwatchLdapDescriptor();
+
+	/**
+	 * @brief scheduleIteration Set the delay of the next iteration from the current action and the pending requests.
+	 */
+	void scheduleIteration();
+
+	/**
+	 * @brief getCacheQuery Get the key of the request in the result cache of the core.
+	 */
+	LdapResultCache::Query getCacheQuery(const LdapContactSearch &request) const;
+
+	/**
+	 * @brief serveCachedRequests Give their results to the requests answered by the cache.
+	 */
+	void serveCachedRequests();
+
+	/**
+	 * @brief addContact Build a contact from the attributes of an entry and add it to the results of the request.
+	 */
+	void addContact(LdapContactSearch *request, const LdapResultCache::Attributes &attributes);
+
+	/**
+	 * @brief getSizeLimit Get the size limit to pass to the server.
+	 */
+	int getSizeLimit() const;
+
 	/**
 	 * @brief handleSearchResult Parse the LDAPMessage to get contacts and fill Search entries.
 	 * @param message LDAPMessage to parse
@@ -218,6 +264,7 @@ private:
 	bool mConnected;                           // If we are connected to server (bind)
 	int mCurrentAction;                        // Iteration action
 	belle_sip_source_t *mIteration;            // Iteration loop
+	belle_sip_source_t *mFdSource = nullptr;   // Wakes the provider up when the LDAP connection can be read
 	belle_sip_resolver_context_t *mSalContext; // Sal Context for DNS
 	std::vector<std::string> mServerUrl;       // URL to use for connection. It can be different from configuration
 	size_t mServerUrlIndex = 0;
@@ -25,6 +25,7 @@
 #include "belle-sip/object++.hh"
 #include "core/core-accessor.h"
 #include "core/core.h"
+#include "ldap-result-cache.h"
 #include "linphone/contactprovider.h"
 #include "linphone/core.h"
 #include "linphone/types.h"
@@ -47,6 +48,10 @@ public:
 
 	void callCallback();
 
+	const std::string &getPredicate() const {
+		return mPredicate;
+	}
+
 	static int entryCompareWeak(const void *a, const void *b);
 
 	int mMsgId;
@@ -55,6 +60,10 @@ public:
 	bool mHaveMoreResults = false;
 	std::list<std::shared_ptr<SearchResult>> mFoundEntries;
 	unsigned int mFoundCount;
+	// Attributes of the entries received from the server, to be cached.
+	std::vector<LdapResultCache::Attributes> mEntries;
+	// Set when the search is answered by the cache and does not need to be sent.
+	std::shared_ptr<const LdapResultCache::Result> mCachedResult;
 
 private:
 	std::string mPredicate;
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ldap-result-cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+#include "bctoolbox/port.h"
+
+#include "logger/logger.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+namespace {
+enum class MatchingRule { CaseIgnore, TelephoneNumber, Unknown };
+
+// Matching rules of the usual attributes of contact entries (RFC 4519, RFC 4524 and RFC 2798). Other attributes may
+// use stricter rules, their filters are left to the server.
+MatchingRule getMatchingRule(const string &attribute) {
+	static const unordered_set<string> caseIgnoreAttributes = {
+	    "cn", "commonname", "sn", "surname", "givenname", "gn", "displayname", "initials", "name",
+	    "o", "ou", "uid", "userid", "mail", "title", "l", "description"};
+	static const unordered_set<string> telephoneNumberAttributes = {
+	    "telephonenumber", "mobile", "mobiletelephonenumber", "homephone", "hometelephonenumber",
+	    "pager", "pagertelephonenumber", "facsimiletelephonenumber"};
+	if (caseIgnoreAttributes.count(attribute)) return MatchingRule::CaseIgnore;
+	if (telephoneNumberAttributes.count(attribute)) return MatchingRule::TelephoneNumber;
+	return MatchingRule::Unknown;
+}
+
+// Non ASCII characters are left to the server, which folds their case and normalizes them (RFC 4518).
+bool isAscii(const string &value) {
+	return std::all_of(value.begin(), value.end(), [](char c) { return (unsigned char)c < 0x80; });
+}
+
+string normalizeValue(const string &value, MatchingRule rule) {
+	string result;
+	result.reserve(value.size());
+	for (char c : value) {
+		if (c == ' ') {
+			// caseIgnoreMatch ignores leading, trailing and repeated spaces, telephoneNumberMatch all of them.
+			if (rule == MatchingRule::CaseIgnore && !result.empty() && result.back() != ' ') result.push_back(c);
+			continue;
+		}
+		// telephoneNumberMatch also ignores hyphens.
+		if (c == '-' && rule == MatchingRule::TelephoneNumber) continue;
+		result.push_back((char)tolower((unsigned char)c));
+	}
+	if (!result.empty() && result.back() == ' ') result.pop_back();
+	return result;
+}
+
+int hexValue(char c) {
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+// Splits the value of a filter item on its wildcards, and decodes the escaped characters.
+bool splitValue(const string &value, vector<string> &parts) {
+	parts.assign(1, string());
+	for (size_t i = 0; i < value.size(); ++i) {
+		char c = value[i];
+		if (c == '*') {
+			parts.emplace_back();
+		} else if (c == '\\') {
+			if (i + 2 >= value.size()) return false;
+			int high = hexValue(value[i + 1]);
+			int low = hexValue(value[i + 2]);
+			if (high < 0 || low < 0) return false;
+			parts.back().push_back((char)(high * 16 + low));
+			i += 2;
+		} else {
+			parts.back().push_back(c);
+		}
+	}
+	return true;
+}
+
+bool matchValue(const vector<string> &parts, const string &value) {
+	if (parts.size() == 1) return value == parts[0];
+
+	const string &initialPart = parts.front();
+	const string &finalPart = parts.back();
+	if (value.size() < initialPart.size() + finalPart.size()) return false;
+	if (value.compare(0, initialPart.size(), initialPart) != 0) return false;
+	if (value.compare(value.size() - finalPart.size(), finalPart.size(), finalPart) != 0) return false;
+
+	size_t pos = initialPart.size();
+	size_t end = value.size() - finalPart.size();
+	for (size_t i = 1; i + 1 < parts.size(); ++i) {
+		if (parts[i].empty()) continue;
+		size_t found = value.find(parts[i], pos);
+		if (found == string::npos || found + parts[i].size() > end) return false;
+		pos = found + parts[i].size();
+	}
+	return true;
+}
+
+bool matchItem(const string &attribute,
+               const string &value,
+               const LdapResultCache::Attributes &attributes,
+               bool &supported) {
+	vector<string> parts;
+	if (!splitValue(value, parts)) {
+		supported = false;
+		return false;
+	}
+
+	if (parts.size() == 2 && parts[0].empty() && parts[1].empty()) {
+		// Presence does not depend on the matching rule.
+		return std::any_of(attributes.begin(), attributes.end(),
+		                   [&attribute](const pair<string, string> &entry) { return entry.first == attribute; });
+	}
+
+	MatchingRule rule = getMatchingRule(attribute);
+	if (rule == MatchingRule::Unknown) {
+		supported = false;
+		return false;
+	}
+	for (auto &part : parts) {
+		// The spaces around a substring are significant, unlike the ones around a whole value.
+		if (!isAscii(part) || (rule == MatchingRule::CaseIgnore && parts.size() > 1 && !part.empty() &&
+		                       (part.front() == ' ' || part.back() == ' '))) {
+			supported = false;
+			return false;
+		}
+		part = normalizeValue(part, rule);
+	}
+
+	for (const auto &entryAttribute : attributes) {
+		if (entryAttribute.first != attribute) continue;
+		if (!isAscii(entryAttribute.second)) {
+			supported = false;
+			return false;
+		}
+		if (matchValue(parts, normalizeValue(entryAttribute.second, rule))) return true;
+	}
+	return false;
+}
+
+bool matchFilterAt(const string &filter, size_t &pos, const LdapResultCache::Attributes &attributes, bool &supported) {
+	if (pos >= filter.size() || filter[pos] != '(') {
+		supported = false;
+		return false;
+	}
+	++pos;
+	if (pos >= filter.size()) {
+		supported = false;
+		return false;
+	}
+
+	bool result;
+	char op = filter[pos];
+	if (op == '&' || op == '|') {
+		++pos;
+		result = (op == '&');
+		bool empty = true;
+		while (supported && pos < filter.size() && filter[pos] == '(') {
+			bool match = matchFilterAt(filter, pos, attributes, supported);
+			result = (op == '&') ? (result && match) : (result || match);
+			empty = false;
+		}
+		if (empty) supported = false;
+	} else if (op == '!') {
+		++pos;
+		result = !matchFilterAt(filter, pos, attributes, supported);
+	} else {
+		size_t equal = filter.find('=', pos);
+		size_t close = filter.find(')', pos);
+		if (equal == string::npos || close == string::npos || equal > close) {
+			supported = false;
+			return false;
+		}
+		string attribute = filter.substr(pos, equal - pos);
+		// Approximate, ordering and extensible matches are not supported.
+		if (attribute.empty() || attribute.find_first_of("~<>:") != string::npos) {
+			supported = false;
+			return false;
+		}
+		size_t options = attribute.find(';');
+		if (options != string::npos) attribute.erase(options);
+		for (auto &c : attribute)
+			c = (char)tolower((unsigned char)c);
+		result = matchItem(attribute, filter.substr(equal + 1, close - equal - 1), attributes, supported);
+		pos = close;
+	}
+
+	if (!supported) return false;
+	if (pos >= filter.size() || filter[pos] != ')') {
+		supported = false;
+		return false;
+	}
+	++pos;
+	return result;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+LdapResultCache::LdapResultCache(size_t capacity) : mCapacity(capacity) {
+}
+
+shared_ptr<const LdapResultCache::Result> LdapResultCache::find(const Query &query) {
+	uint64_t now = bctbx_get_cur_time_ms();
+	string scope = getScope(query);
+
+	auto it = findEntry(scope, query.filter, now);
+	if (it != mEntries.end()) {
+		mHits++;
+		return it->result;
+	}
+
+	auto result = refine(query, scope, now);
+	if (result) {
+		mRefinements++;
+		return result;
+	}
+
+	mMisses++;
+	return nullptr;
+}
+
+void LdapResultCache::insert(const Query &query, Result result, uint64_t ttlMs) {
+	if (ttlMs == 0 || mCapacity == 0) return;
+
+	Entry entry;
+	entry.scope = getScope(query);
+	entry.filter = query.filter;
+	entry.filterTemplate = query.filterTemplate;
+	entry.predicate = query.predicate;
+	entry.expirationTime = bctbx_get_cur_time_ms() + ttlMs;
+	entry.result = make_shared<const Result>(std::move(result));
+	store(std::move(entry));
+}
+
+void LdapResultCache::clear() {
+	mEntries.clear();
+}
+
+void LdapResultCache::setCapacity(size_t capacity) {
+	mCapacity = capacity;
+	evict();
+}
+
+bool LdapResultCache::matchFilter(const string &filter, const Attributes &attributes, bool &supported) {
+	size_t pos = 0;
+	supported = true;
+	bool result = matchFilterAt(filter, pos, attributes, supported);
+	if (supported && pos != filter.size()) supported = false;
+	return supported && result;
+}
+
+// -----------------------------------------------------------------------------
+
+string LdapResultCache::getScope(const Query &query) {
+	return query.server + '\n' + query.bindIdentity + '\n' + query.baseObject + '\n' + query.attributes + '\n' +
+	       to_string(query.sizeLimit);
+}
+
+bool LdapResultCache::isRefinable(const string &filterTemplate) {
+	// A longer predicate matches fewer entries, so a negated item would match more of them.
+	if (filterTemplate.find("(!") != string::npos) return false;
+	bool found = false;
+	for (size_t pos = filterTemplate.find("%s"); pos != string::npos; pos = filterTemplate.find("%s", pos + 2)) {
+		if (filterTemplate.compare(pos + 2, 1, "*") != 0) return false;
+		found = true;
+	}
+	return found;
+}
+
+list<LdapResultCache::Entry>::iterator
+LdapResultCache::findEntry(const string &scope, const string &filter, uint64_t now) {
+	for (auto it = mEntries.begin(); it != mEntries.end();) {
+		if (it->expirationTime <= now) {
+			it = mEntries.erase(it);
+			continue;
+		}
+		if (it->scope == scope && it->filter == filter) {
+			if (it != mEntries.begin()) mEntries.splice(mEntries.begin(), mEntries, it);
+			return mEntries.begin();
+		}
+		++it;
+	}
+	return mEntries.end();
+}
+
+shared_ptr<const LdapResultCache::Result>
+LdapResultCache::refine(const Query &query, const string &scope, uint64_t now) {
+	if (!isRefinable(query.filterTemplate)) return nullptr;
+
+	// Use the narrowest complete search whose predicate is a prefix of the new one.
+	const Entry *source = nullptr;
+	for (const auto &entry : mEntries) {
+		if (entry.expirationTime <= now || entry.scope != scope || entry.filterTemplate != query.filterTemplate ||
+		    entry.result->haveMoreResults || entry.predicate.size() >= query.predicate.size() ||
+		    query.predicate.compare(0, entry.predicate.size(), entry.predicate) != 0)
+			continue;
+		if (!source || entry.predicate.size() > source->predicate.size()) source = &entry;
+	}
+	if (!source) return nullptr;
+
+	Result result;
+	for (const auto &attributes : source->result->entries) {
+		bool supported;
+		bool match = matchFilter(query.filter, attributes, supported);
+		if (!supported) {
+			lInfo() << "[LDAP] Cannot refine cached results locally with filter " << query.filter;
+			return nullptr;
+		}
+		if (match) result.entries.push_back(attributes);
+	}
+
+	// The refined result set does not live longer than the one it comes from.
+	Entry entry;
+	entry.scope = scope;
+	entry.filter = query.filter;
+	entry.filterTemplate = query.filterTemplate;
+	entry.predicate = query.predicate;
+	entry.expirationTime = source->expirationTime;
+	entry.result = make_shared<const Result>(std::move(result));
+	auto refined = entry.result;
+	store(std::move(entry));
+	return refined;
+}
+
+void LdapResultCache::store(Entry &&entry) {
+	for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+		if (it->scope == entry.scope && it->filter == entry.filter) {
+			mEntries.erase(it);
+			break;
+		}
+	}
+	mEntries.push_front(std::move(entry));
+	evict();
+}
+
+void LdapResultCache::evict() {
+	while (mEntries.size() > mCapacity)
+		mEntries.pop_back();
+}
+
+LINPHONE_END_NAMESPACE
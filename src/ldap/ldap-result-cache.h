@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_LDAP_RESULT_CACHE_H_
+#define _L_LDAP_RESULT_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Bounded cache of the entries returned by LDAP searches, shared by all the LDAP contact providers of a core.
+ * Result sets are keyed by server, bind identity, base object, filter, requested attributes and size limit, and
+ * expire after the TTL given when they are inserted.
+ * When a predicate extends the predicate of a complete cached search, the cached entries are refined locally instead
+ * of asking the server again. This is only done when the filter template is monotonic for this kind of extension,
+ * that is when each '%s' is followed by a wildcard and nothing is negated.
+ */
+class LdapResultCache {
+public:
+	static constexpr size_t DefaultCapacity = 64;
+
+	// Attributes of an entry: lowercase attribute names and their values.
+	using Attributes = std::vector<std::pair<std::string, std::string>>;
+
+	struct Query {
+		std::string server;
+		// Who the server answered to: entries and attributes depend on its access rights.
+		std::string bindIdentity;
+		std::string baseObject;
+		std::string attributes; // "*" for all user attributes
+		int sizeLimit = 0;
+		std::string filterTemplate; // The configured filter, with '%s' placeholders
+		std::string predicate;
+		std::string filter; // The filter sent to the server
+	};
+
+	struct Result {
+		std::vector<Attributes> entries;
+		bool haveMoreResults = false;
+	};
+
+	explicit LdapResultCache(size_t capacity = DefaultCapacity);
+
+	// Returns the cached result set of the query, or one refined from a broader cached search, or nullptr.
+	std::shared_ptr<const Result> find(const Query &query);
+	void insert(const Query &query, Result result, uint64_t ttlMs);
+	void clear();
+
+	size_t size() const {
+		return mEntries.size();
+	}
+
+	void setCapacity(size_t capacity);
+
+	unsigned long long getHits() const {
+		return mHits;
+	}
+
+	unsigned long long getRefinements() const {
+		return mRefinements;
+	}
+
+	unsigned long long getMisses() const {
+		return mMisses;
+	}
+
+	// Searches answered without a round trip to the server.
+	unsigned long long getRoundTripsSaved() const {
+		return mHits + mRefinements;
+	}
+
+	// Evaluates an LDAP filter (RFC 4515) on the attributes of an entry. Only equality, presence and substring items
+	// are supported; supported is set to false if the filter contains anything else.
+	// Values are compared with the matching rule of their attribute, for the usual name and telephone number
+	// attributes only, and in ASCII only: supported is also set to false when the server may compare them otherwise.
+	static bool matchFilter(const std::string &filter, const Attributes &attributes, bool &supported);
+
+private:
+	struct Entry {
+		std::string scope;
+		std::string filter;
+		std::string filterTemplate;
+		std::string predicate;
+		uint64_t expirationTime;
+		std::shared_ptr<const Result> result;
+	};
+
+	static std::string getScope(const Query &query);
+	static bool isRefinable(const std::string &filterTemplate);
+
+	std::list<Entry>::iterator findEntry(const std::string &scope, const std::string &filter, uint64_t now);
+	std::shared_ptr<const Result> refine(const Query &query, const std::string &scope, uint64_t now);
+	void store(Entry &&entry);
+	void evict();
+
+	size_t mCapacity;
+	unsigned long long mHits = 0;
+	unsigned long long mRefinements = 0;
+	unsigned long long mMisses = 0;
+	// Most recently used first.
+	std::list<Entry> mEntries;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_LDAP_RESULT_CACHE_H_
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "metrics-exporter.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "bctoolbox/defs.h"
+
+#include "core/core-p.h"
+#include "logger/logger.h"
+
+// TODO: From coreapi. Remove me later.
+#include "private.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+namespace {
+// Time given to a client to read the whole export, in milliseconds.
+constexpr unsigned int ClientTimeout = 5000;
+} // namespace
+
+MetricsExporter::MetricsExporter(const shared_ptr<Core> &core, const MetricsRegistry &registry)
+    : CoreAccessor(core), mRegistry(registry) {
+	LinphoneConfig *config = linphone_core_get_config(core->getCCore());
+	string format = L_C_TO_STRING(linphone_config_get_string(config, "metrics", "format", "prometheus"));
+	if (!MetricsRegistry::parseFormat(format, mFormat))
+		lError() << "[Metrics] Unknown format [" << format << "], using prometheus";
+
+	mFilePath = L_C_TO_STRING(linphone_config_get_string(config, "metrics", "export_file", nullptr));
+	if (!mFilePath.empty()) {
+		int interval = linphone_config_get_int(config, "metrics", "export_interval", 10);
+		if (interval <= 0) interval = 10;
+		mFileTimer = core->createTimer(
+		    [this]() {
+			    writeFile();
+			    return true;
+		    },
+		    (unsigned int)interval * 1000, "Metrics export");
+		lInfo() << "[Metrics] Exporting to file [" << mFilePath << "] every " << interval << " s";
+	}
+
+	mSocketPath = L_C_TO_STRING(linphone_config_get_string(config, "metrics", "export_socket", nullptr));
+	if (!mSocketPath.empty()) openSocket();
+}
+
+MetricsExporter::~MetricsExporter() {
+	if (mFileTimer) {
+		writeFile();
+		belle_sip_source_cancel(mFileTimer);
+		belle_sip_object_unref(mFileTimer);
+		mFileTimer = nullptr;
+	}
+	closeSocket();
+}
+
+bool MetricsExporter::isConfigured(const shared_ptr<Core> &core) {
+	LinphoneConfig *config = linphone_core_get_config(core->getCCore());
+	return linphone_config_get_string(config, "metrics", "export_file", nullptr) != nullptr ||
+	       linphone_config_get_string(config, "metrics", "export_socket", nullptr) != nullptr;
+}
+
+bool MetricsExporter::writeFile() {
+	if (mFilePath.empty()) return false;
+
+	// Write a temporary file first, so that readers never see a partial export.
+	string tmpPath = mFilePath + ".tmp";
+	{
+		ofstream file(tmpPath, ios::out | ios::trunc | ios::binary);
+		if (!file) {
+			lError() << "[Metrics] Cannot open [" << tmpPath << "]: " << strerror(errno);
+			return false;
+		}
+		file << mRegistry.render(mFormat);
+	}
+#ifdef _WIN32
+	remove(mFilePath.c_str());
+#endif
+	if (rename(tmpPath.c_str(), mFilePath.c_str()) != 0) {
+		lError() << "[Metrics] Cannot write [" << mFilePath << "]: " << strerror(errno);
+		return false;
+	}
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+
+int MetricsExporter::onSocketEvent(void *data, BCTBX_UNUSED(unsigned int events)) {
+	static_cast<MetricsExporter *>(data)->acceptClients();
+	return BELLE_SIP_CONTINUE;
+}
+
+int MetricsExporter::onClientEvent(void *data, unsigned int events) {
+	Client *client = static_cast<Client *>(data);
+	MetricsExporter *exporter = client->exporter;
+	if (events & BELLE_SIP_EVENT_TIMEOUT) {
+		lWarning() << "[Metrics] Dropping a client that did not read the export in time";
+	} else if (exporter->sendToClient(*client)) {
+		return BELLE_SIP_CONTINUE;
+	}
+	exporter->closeClient(client);
+	return BELLE_SIP_STOP;
+}
+
+#ifndef _WIN32
+
+void MetricsExporter::openSocket() {
+	struct sockaddr_un address;
+	if (mSocketPath.size() >= sizeof(address.sun_path)) {
+		lError() << "[Metrics] Socket path [" << mSocketPath << "] is too long";
+		return;
+	}
+
+	mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (mSocket < 0) {
+		lError() << "[Metrics] Cannot create socket: " << strerror(errno);
+		return;
+	}
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, mSocketPath.c_str(), sizeof(address.sun_path) - 1);
+	unlink(mSocketPath.c_str()); // Left by a previous run.
+	if (bind(mSocket, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(mSocket, 8) != 0 ||
+	    fcntl(mSocket, F_SETFL, fcntl(mSocket, F_GETFL) | O_NONBLOCK) != 0) {
+		lError() << "[Metrics] Cannot listen on [" << mSocketPath << "]: " << strerror(errno);
+		close(mSocket);
+		mSocket = -1;
+		return;
+	}
+
+	mSocketSource = belle_sip_socket_source_new(onSocketEvent, this, (belle_sip_socket_t)mSocket, BELLE_SIP_EVENT_READ,
+	                                            (unsigned int)-1);
+	belle_sip_main_loop_add_source(getCore()->getPrivate()->getMainLoop(), mSocketSource);
+	lInfo() << "[Metrics] Exporting on socket [" << mSocketPath << "]";
+}
+
+void MetricsExporter::closeSocket() {
+	while (!mClients.empty())
+		closeClient(mClients.front().get());
+	if (mSocketSource) {
+		belle_sip_source_cancel(mSocketSource);
+		belle_sip_object_unref(mSocketSource);
+		mSocketSource = nullptr;
+	}
+	if (mSocket >= 0) {
+		close(mSocket);
+		mSocket = -1;
+		unlink(mSocketPath.c_str());
+	}
+}
+
+void MetricsExporter::acceptClients() {
+	int fd;
+	while ((fd = accept(mSocket, nullptr, nullptr)) >= 0) {
+		if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0) {
+			lWarning() << "[Metrics] Cannot make a client socket non-blocking: " << strerror(errno);
+			close(fd);
+			continue;
+		}
+		auto client = makeUnique<Client>();
+		client->exporter = this;
+		client->fd = fd;
+		client->data = mRegistry.render(mFormat);
+		// Most exports fit in the socket buffer and are sent right away, without waiting for the main loop.
+		if (!sendToClient(*client)) {
+			close(fd);
+			continue;
+		}
+		client->source = belle_sip_socket_source_new(onClientEvent, client.get(), (belle_sip_socket_t)fd,
+		                                             BELLE_SIP_EVENT_WRITE | BELLE_SIP_EVENT_ERROR, ClientTimeout);
+		belle_sip_main_loop_add_source(getCore()->getPrivate()->getMainLoop(), client->source);
+		mClients.push_back(std::move(client));
+	}
+}
+
+bool MetricsExporter::sendToClient(Client &client) {
+	while (client.sent < client.data.size()) {
+#ifdef MSG_NOSIGNAL
+		ssize_t ret = send(client.fd, client.data.data() + client.sent, client.data.size() - client.sent, MSG_NOSIGNAL);
+#else
+		ssize_t ret = send(client.fd, client.data.data() + client.sent, client.data.size() - client.sent, 0);
+#endif
+		if (ret < 0 && errno == EINTR) continue;
+		if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+		if (ret <= 0) {
+			lWarning() << "[Metrics] Cannot send the metrics to a client: " << strerror(errno);
+			return false;
+		}
+		client.sent += (size_t)ret;
+	}
+	return false;
+}
+
+void MetricsExporter::closeClient(Client *client) {
+	if (client->source) {
+		belle_sip_source_cancel(client->source);
+		belle_sip_object_unref(client->source);
+		client->source = nullptr;
+	}
+	close(client->fd);
+	mClients.remove_if([client](const unique_ptr<Client> &c) { return c.get() == client; });
+}
+
+#else
+
+void MetricsExporter::openSocket() {
+	lError() << "[Metrics] Exporting on a Unix socket is not supported on this platform";
+}
+
+void MetricsExporter::closeSocket() {
+}
+
+void MetricsExporter::acceptClients() {
+}
+
+bool MetricsExporter::sendToClient(BCTBX_UNUSED(Client &client)) {
+	return false;
+}
+
+void MetricsExporter::closeClient(BCTBX_UNUSED(Client *client)) {
+}
+
+#endif
+
+LINPHONE_END_NAMESPACE
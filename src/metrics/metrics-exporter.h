@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_METRICS_EXPORTER_H_
+#define _L_METRICS_EXPORTER_H_
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "core/core-accessor.h"
+#include "metrics-registry.h"
+
+// =============================================================================
+
+typedef struct belle_sip_source belle_sip_source_t;
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Exports the metrics registry of a core, configured in the [metrics] section:
+ * - "export_file": the metrics are written to this file every "export_interval" seconds (10 by default),
+ * - "export_socket": the metrics are written to each client that connects to this Unix socket, then the connection is
+ *   closed, so that a collector can scrape them at its own pace. The clients are written to without blocking, when
+ *   the main loop finds them writable, and dropped if they do not read the export in time. Not available on Windows.
+ * "format" is either "prometheus" (text exposition format, the default) or "json".
+ */
+class MetricsExporter : public CoreAccessor {
+public:
+	MetricsExporter(const std::shared_ptr<Core> &core, const MetricsRegistry &registry);
+	~MetricsExporter();
+
+	MetricsExporter(const MetricsExporter &) = delete;
+	MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+	// Whether the [metrics] section of the configuration asks for an export.
+	static bool isConfigured(const std::shared_ptr<Core> &core);
+
+	bool writeFile();
+
+private:
+	// A client that has been accepted and has not read the whole export yet.
+	struct Client {
+		MetricsExporter *exporter;
+		int fd;
+		std::string data;
+		size_t sent = 0;
+		belle_sip_source_t *source = nullptr;
+	};
+
+	static int onSocketEvent(void *data, unsigned int events);
+	static int onClientEvent(void *data, unsigned int events);
+
+	void openSocket();
+	void closeSocket();
+	void acceptClients();
+	// Returns false once the client is done with, either because it got the whole export or because of an error.
+	bool sendToClient(Client &client);
+	void closeClient(Client *client);
+
+	const MetricsRegistry &mRegistry;
+	MetricsRegistry::Format mFormat = MetricsRegistry::Format::Prometheus;
+	std::string mFilePath;
+	std::string mSocketPath;
+	belle_sip_source_t *mFileTimer = nullptr;
+	belle_sip_source_t *mSocketSource = nullptr;
+	int mSocket = -1;
+	std::list<std::unique_ptr<Client>> mClients;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_METRICS_EXPORTER_H_
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "metrics-registry.h"
+
+#include <cmath>
+#include <cstdio>
+#include <locale>
+#include <sstream>
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+namespace {
+string escape(const string &value, bool json) {
+	string result;
+	result.reserve(value.size());
+	for (char c : value) {
+		switch (c) {
+			case '\\':
+				result += "\\\\";
+				break;
+			case '"':
+				result += "\\\"";
+				break;
+			case '\n':
+				result += "\\n";
+				break;
+			default:
+				if (json && (unsigned char)c < 0x20) {
+					char buffer[8];
+					snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned)c);
+					result += buffer;
+				} else {
+					result.push_back(c);
+				}
+				break;
+		}
+	}
+	return result;
+}
+
+void writeValue(ostringstream &os, double value, bool json) {
+	if (std::isnan(value)) os << (json ? "null" : "NaN");
+	else if (std::isinf(value)) os << (json ? "null" : (value > 0 ? "+Inf" : "-Inf"));
+	else os << value;
+}
+
+ostringstream makeStream() {
+	ostringstream os;
+	os.imbue(locale::classic());
+	os.precision(15);
+	return os;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+void MetricsRegistry::Series::increment(double value) {
+	double current = mValue.load(std::memory_order_relaxed);
+	while (!mValue.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+		;
+}
+
+shared_ptr<MetricsRegistry::Series>
+MetricsRegistry::getCounter(const string &name, const string &help, const Labels &labels) {
+	return get(Type::Counter, name, help, labels);
+}
+
+shared_ptr<MetricsRegistry::Series>
+MetricsRegistry::getGauge(const string &name, const string &help, const Labels &labels) {
+	return get(Type::Gauge, name, help, labels);
+}
+
+void MetricsRegistry::removeSeries(const Labels &labels) {
+	string key = renderLabels(labels);
+	lock_guard<mutex> lock(mMutex);
+	for (auto &family : mFamilies)
+		family.second.series.erase(key);
+}
+
+void MetricsRegistry::clear() {
+	lock_guard<mutex> lock(mMutex);
+	mFamilies.clear();
+}
+
+string MetricsRegistry::render(Format format) const {
+	return format == Format::Json ? renderJson() : renderPrometheus();
+}
+
+bool MetricsRegistry::parseFormat(const string &name, Format &format) {
+	if (name == "prometheus") format = Format::Prometheus;
+	else if (name == "json") format = Format::Json;
+	else return false;
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+
+shared_ptr<MetricsRegistry::Series>
+MetricsRegistry::get(Type type, const string &name, const string &help, const Labels &labels) {
+	string key = renderLabels(labels);
+	lock_guard<mutex> lock(mMutex);
+	auto it = mFamilies.find(name);
+	if (it == mFamilies.end()) it = mFamilies.emplace(name, Family{type, help, {}}).first;
+	auto &series = it->second.series[key];
+	if (!series.second) series = make_pair(labels, make_shared<Series>());
+	return series.second;
+}
+
+string MetricsRegistry::renderPrometheus() const {
+	ostringstream os = makeStream();
+	lock_guard<mutex> lock(mMutex);
+	for (const auto &family : mFamilies) {
+		if (family.second.series.empty()) continue;
+		os << "# HELP " << family.first << " " << family.second.help << "\n";
+		os << "# TYPE " << family.first << " " << (family.second.type == Type::Counter ? "counter" : "gauge") << "\n";
+		for (const auto &series : family.second.series) {
+			os << family.first;
+			if (!series.first.empty()) os << "{" << series.first << "}";
+			os << " ";
+			writeValue(os, series.second.second->get(), false);
+			os << "\n";
+		}
+	}
+	return os.str();
+}
+
+string MetricsRegistry::renderJson() const {
+	ostringstream os = makeStream();
+	lock_guard<mutex> lock(mMutex);
+	os << "{\"metrics\":[";
+	bool firstFamily = true;
+	for (const auto &family : mFamilies) {
+		if (family.second.series.empty()) continue;
+		if (!firstFamily) os << ",";
+		firstFamily = false;
+		os << "{\"name\":\"" << escape(family.first, true) << "\",\"type\":\""
+		   << (family.second.type == Type::Counter ? "counter" : "gauge") << "\",\"help\":\""
+		   << escape(family.second.help, true) << "\",\"series\":[";
+		bool firstSeries = true;
+		for (const auto &series : family.second.series) {
+			if (!firstSeries) os << ",";
+			firstSeries = false;
+			os << "{\"labels\":{";
+			bool firstLabel = true;
+			for (const auto &label : series.second.first) {
+				if (!firstLabel) os << ",";
+				firstLabel = false;
+				os << "\"" << escape(label.first, true) << "\":\"" << escape(label.second, true) << "\"";
+			}
+			os << "},\"value\":";
+			writeValue(os, series.second.second->get(), true);
+			os << "}";
+		}
+		os << "]}";
+	}
+	os << "]}\n";
+	return os.str();
+}
+
+string MetricsRegistry::renderLabels(const Labels &labels) {
+	string result;
+	for (const auto &label : labels) {
+		if (!result.empty()) result += ",";
+		result += label.first + "=\"" + escape(label.second, false) + "\"";
+	}
+	return result;
+}
+
+LINPHONE_END_NAMESPACE
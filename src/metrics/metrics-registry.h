@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_METRICS_REGISTRY_H_
+#define _L_METRICS_REGISTRY_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Registry of the metrics of a core, read by the MetricsExporter when it is scraped.
+ * A metric is a family of series, one for each set of labels. Series are created on first use and can be kept by
+ * their users: updating them is lock-free, only the creation, the removal and the rendering of series take a lock.
+ */
+class LINPHONE_PUBLIC MetricsRegistry {
+public:
+	enum class Type { Counter, Gauge };
+	enum class Format { Prometheus, Json };
+
+	using Labels = std::vector<std::pair<std::string, std::string>>;
+
+	class Series {
+	public:
+		void increment(double value = 1.0);
+		void set(double value) {
+			mValue.store(value, std::memory_order_relaxed);
+		}
+		double get() const {
+			return mValue.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<double> mValue{0.0};
+	};
+
+	std::shared_ptr<Series> getCounter(const std::string &name, const std::string &help, const Labels &labels = {});
+	std::shared_ptr<Series> getGauge(const std::string &name, const std::string &help, const Labels &labels = {});
+
+	// Removes the series that have exactly these labels, in all the metrics.
+	void removeSeries(const Labels &labels);
+	void clear();
+
+	std::string render(Format format) const;
+
+	static bool parseFormat(const std::string &name, Format &format);
+
+private:
+	struct Family {
+		Type type;
+		std::string help;
+		// Series by rendered labels.
+		std::map<std::string, std::pair<Labels, std::shared_ptr<Series>>> series;
+	};
+
+	std::shared_ptr<Series> get(Type type, const std::string &name, const std::string &help, const Labels &labels);
+	std::string renderPrometheus() const;
+	std::string renderJson() const;
+
+	static std::string renderLabels(const Labels &labels);
+
+	mutable std::mutex mMutex;
+	std::map<std::string, Family> mFamilies;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_METRICS_REGISTRY_H_
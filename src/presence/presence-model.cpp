@@ -328,6 +328,73 @@ bool PresenceModel::isOnline() const {
 	return (mIsOnline || ((getBasicStatus() == LinphonePresenceBasicStatusOpen) && (getNbActivities() == 0)));
 }
 
+namespace {
+// 64-bit FNV-1a, fed with the fields that end up in the PIDF document.
+class ContentHasher {
+public:
+	void add(const std::string &value) {
+		add((uint64_t)value.size());
+		for (char c : value)
+			addByte((unsigned char)c);
+	}
+	void add(uint64_t value) {
+		for (int i = 0; i < 8; ++i)
+			addByte((unsigned char)(value >> (i * 8)));
+	}
+	void add(const std::shared_ptr<PresenceNote> &note) {
+		add(note->getLang());
+		add(note->getContent());
+	}
+	uint64_t get() const {
+		return mHash;
+	}
+
+private:
+	void addByte(unsigned char byte) {
+		mHash ^= byte;
+		mHash *= 0x100000001b3ULL;
+	}
+
+	uint64_t mHash = 0xcbf29ce484222325ULL;
+};
+} // namespace
+
+uint64_t PresenceModel::getContentHash() const {
+	ContentHasher hasher;
+	const auto &presentity = getPresentity();
+	const std::string contact = presentity ? presentity->asStringUriOnly() : std::string();
+	hasher.add(contact);
+	hasher.add((uint64_t)isOnline());
+
+	// Each element is prefixed by a distinct tag, so that moving content between them changes the hash.
+	hasher.add((uint64_t)mServices.size());
+	for (const auto &service : mServices) {
+		hasher.add((uint64_t)service->getBasicStatus());
+		hasher.add(service->getContact().empty() ? contact : service->getContact());
+		hasher.add((uint64_t)service->mNotes.size());
+		for (const auto &note : service->mNotes)
+			hasher.add(note);
+	}
+	hasher.add((uint64_t)mPersons.size());
+	for (const auto &person : mPersons) {
+		hasher.add((uint64_t)person->mActivitiesNotes.size());
+		for (const auto &note : person->mActivitiesNotes)
+			hasher.add(note);
+		hasher.add((uint64_t)person->mActivities.size());
+		for (const auto &activity : person->mActivities) {
+			hasher.add((uint64_t)activity->getType());
+			hasher.add(activity->getDescription());
+		}
+		hasher.add((uint64_t)person->mNotes.size());
+		for (const auto &note : person->mNotes)
+			hasher.add(note);
+	}
+	hasher.add((uint64_t)mNotes.size());
+	for (const auto &note : mNotes)
+		hasher.add(note);
+	return hasher.get();
+}
+
 #ifdef HAVE_XML2
 
 int PresenceModel::parsePidfXmlPresenceNotes(XmlParsingContext &xmlContext) {
@@ -483,7 +550,26 @@ private:
 	const char *mMessage;
 };
 
+namespace {
+// The serialization buffer is kept from one document to the next, so that its memory is reused.
+class XmlSerializationBuffer {
+public:
+	~XmlSerializationBuffer() {
+		if (mBuffer) xmlBufferFree(mBuffer);
+	}
+	xmlBufferPtr get() {
+		if (mBuffer) xmlBufferEmpty(mBuffer);
+		else mBuffer = xmlBufferCreate();
+		return mBuffer;
+	}
+
+private:
+	xmlBufferPtr mBuffer = nullptr;
+};
+} // namespace
+
 std::string PresenceModel::toXml() const {
+	static thread_local XmlSerializationBuffer serializationBuffer;
 	xmlBufferPtr buf = nullptr;
 	xmlTextWriterPtr writer = nullptr;
 	std::string content;
@@ -491,7 +577,7 @@ std::string PresenceModel::toXml() const {
 	try {
 		if (!getPresentity())
 			throw PresenceModelXmlException("Cannot convert presence model to xml because no presentity set");
-		buf = xmlBufferCreate();
+		buf = serializationBuffer.get();
 		if (!buf) throw PresenceModelXmlException("Error creating the XML buffer");
 		writer = xmlNewTextWriterMemory(buf, 0);
 		if (!writer) throw PresenceModelXmlException("Error creating the XML writer");
@@ -550,14 +636,13 @@ std::string PresenceModel::toXml() const {
 		}
 		if (err > 0) {
 			/* xmlTextWriterEndDocument returns the size of the content. */
-			content = (const char *)buf->content;
+			content.assign((const char *)xmlBufferContent(buf), (size_t)xmlBufferLength(buf));
 		}
 	} catch (PresenceModelXmlException &e) {
 		ms_error("%s", e.what());
 	}
 
 	if (writer) xmlFreeTextWriter(writer);
-	if (buf) xmlBufferFree(buf);
 	return content;
 }
 
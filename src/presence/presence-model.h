@@ -27,6 +27,7 @@
 
 LINPHONE_BEGIN_NAMESPACE
 
+class Account;
 class FriendList;
 class PresenceActivity;
 class PresenceNote;
@@ -59,6 +60,7 @@ public:
 	friend PresencePerson;
 	friend PresenceService;
 	friend char * ::linphone_presence_basic_status_to_string(LinphonePresenceBasicStatus basic_status);
+	friend Account;
 	friend char * ::linphone_presence_model_to_xml(LinphonePresenceModel *model);
 	friend void ::linphone_notify_parse_presence(const char *content_type,
 	                                             const char *content_subtype,
@@ -103,6 +105,9 @@ public:
 	bool hasCapabilityWithVersion(const LinphoneFriendCapability capability, float version) const;
 	bool hasCapabilityWithVersionOrMore(const LinphoneFriendCapability capability, float version) const;
 	bool isOnline() const;
+	// Hash of the content of the PIDF document of the model. The timestamps and the generated ids are ignored, so that
+	// models that only differ by them have the same hash.
+	uint64_t getContentHash() const;
 
 #ifdef HAVE_XML2
 	int parsePidfXmlPresenceNotes(XmlParsingContext &xmlContext);
@@ -112,6 +117,7 @@ public:
 
 private:
 	std::shared_ptr<PresenceNote> findNoteWithLang(const std::string &lang) const;
+	// PIDF document of the model, empty if it cannot be serialized.
 	std::string toXml() const;
 	static std::string basicStatusToString(const LinphonePresenceBasicStatus status);
 	static std::string generatePresenceId();
@@ -52,7 +52,20 @@ bool SalCallOp::capabilityNegotiationEnabled() const {
 
 int SalCallOp::setLocalMediaDescription(std::shared_ptr<SalMediaDescription> desc) {
 	mLocalMedia = desc;
-	if (mLocalMedia) {
+	if (mLocalMedia && mRoot->incrementalSdpEnabled()) {
+		// Only the streams that changed since the previous offer or answer are serialized again
+		string sdp;
+		if (!mLocalMedia->toSdpText(mLocalSdpCache, sdp)) return -1;
+		if (sdp.size() > SIP_MESSAGE_BODY_LIMIT) {
+			lError() << "SDP too large (" << sdp.size() << " bytes), giving up SDP";
+			return -1;
+		}
+		lDebug() << "Reused " << mLocalSdpCache.getReusedSectionCount() << " of "
+		         << mLocalSdpCache.getSectionCount() << " m= sections of the previous local SDP";
+
+		mLocalBody.setContentType(ContentType::Sdp);
+		mLocalBody.setBody(sdp.c_str(), sdp.size());
+	} else if (mLocalMedia) {
 		belle_sip_error_code error;
 		belle_sdp_session_description_t *sdp = mLocalMedia->toSdp();
 		vector<char> buffer = marshalMediaDescription(sdp, error);
@@ -62,6 +75,7 @@ int SalCallOp::setLocalMediaDescription(std::shared_ptr<SalMediaDescription> des
 		mLocalBody.setContentType(ContentType::Sdp);
 		mLocalBody.setBody(std::move(buffer));
 	} else {
+		mLocalSdpCache.clear();
 		mLocalBody = Content();
 	}
 
@@ -171,6 +171,7 @@ private:
 	bool capabilityNegotiation = false;
 	std::shared_ptr<SalMediaDescription> mLocalMedia = nullptr;
 	std::shared_ptr<SalMediaDescription> mRemoteMedia = nullptr;
+	SalMediaDescription::SdpSectionCache mLocalSdpCache;
 	Content mLocalBody;
 	Content mRemoteBody;
 	std::list<Content> mAdditionalLocalBodies;
@@ -150,20 +150,26 @@ void OfferAnswerEngine::verifyBundles(const std::shared_ptr<SalMediaDescription>
 	// It is not possible to do it while doing the offer-answer because the offerer-tagged stream may not be the first
 	// of the bundle presented in the SDP We also must ensure that the result media description is coherent with the
 	// local capabilities and the received offer
+	// The descriptions are indexed once rather than searched for each stream, the result index being kept up to date
+	// when a stream is disabled.
+	const auto localIndex = local->buildStreamIndex();
+	const auto remoteIndex = remote->buildStreamIndex();
+	auto resultIndex = result->buildStreamIndex();
 	for (size_t i = 0; i < result->streams.size(); ++i) {
 		if (local->streams.size() > i) {
 			auto &s = result->streams[i];
-			int result_owner_index = result->getIndexOfTransportOwner(s);
+			int result_owner_index = resultIndex.getIndexOfTransportOwner(s);
 			auto &ls = local->streams[i];
-			int local_owner_index = local->getIndexOfTransportOwner(ls);
+			int local_owner_index = localIndex.getIndexOfTransportOwner(ls);
 			auto &rs = remote->streams[i];
-			int remote_owner_index = remote->getIndexOfTransportOwner(rs);
+			int remote_owner_index = remoteIndex.getIndexOfTransportOwner(rs);
 			// Disable stream if
 			// - it belongs to a bundle and it is not the same as the one in local and remote SDP
 			// - it doesn't belong to a bundle but both the offer and the answer do
 			if (((result_owner_index >= 0) &&
 			     ((local_owner_index != result_owner_index) || (remote_owner_index != result_owner_index))) ||
 			    ((result_owner_index < 0) && (local_owner_index >= 0) && (remote_owner_index >= 0))) {
+				resultIndex.removeMid(s.getChosenConfiguration().getMid());
 				s.disable();
 			}
 		}
@@ -748,9 +754,19 @@ SalStreamDescription OfferAnswerEngine::initiateIncomingStream(MSFactory *factor
 	OfferAnswerEngine::optional_sal_stream_configuration resultNegCfg;
 	if (allowCapabilityNegotiation) {
 		for (const auto &remoteCfg : remote_offer.getAllCfgs()) {
+			if (OfferAnswerEngine::isRejectedByLocalPolicy(local_cap, remote_offer, remoteCfg.second)) {
+				// No local configuration can accept it, skip it before matching its payloads with each of them
+				lDebug() << "[Initiate Incoming Stream] Skipping remote offered configuration at index "
+				         << remoteCfg.first << " rejected by the local policy";
+				continue;
+			}
 			for (const auto &localCfg : local_cap.getAllCfgs()) {
 				if (resultNegCfg) {
 					break;
+				} else if (!OfferAnswerEngine::areProtoCompatibles(localCfg.second.getProto(),
+				                                                   remoteCfg.second.getProto())) {
+					// Prune the pairs that are bound to fail before matching their payloads
+					continue;
 				} else {
 					localCfgIdx = localCfg.first;
 					remoteCfgIdx = remoteCfg.first;
@@ -827,6 +843,22 @@ SalStreamDescription OfferAnswerEngine::initiateIncomingStream(MSFactory *factor
 	return result;
 }
 
+bool OfferAnswerEngine::isRejectedByLocalPolicy(const SalStreamDescription &local_cap,
+                                                const SalStreamDescription &remote_offer,
+                                                const SalStreamConfiguration &remoteCfg) {
+	// Same rejections as in initiateIncomingConfiguration(), which only depend on the remote configuration
+	if (!remote_offer.enabled()) return true;
+	if (remoteCfg.hasSrtp()) {
+		if (remote_offer.rtp_addr.empty() == false && ms_is_multicast(L_STRING_TO_C(remote_offer.rtp_addr))) {
+			return true;
+		}
+		const auto &availableEncs = local_cap.getSupportedEncryptions();
+		return std::find(availableEncs.cbegin(), availableEncs.cend(), LinphoneMediaEncryptionSRTP) ==
+		       availableEncs.cend();
+	}
+	return false;
+}
+
 OfferAnswerEngine::optional_sal_stream_configuration OfferAnswerEngine::initiateIncomingConfiguration(
     MSFactory *factory,
     const SalStreamDescription &local_cap,
@@ -1116,6 +1148,7 @@ OfferAnswerEngine::initiateIncoming(MSFactory *factory,
 	}
 
 	const bool capabilityNegotiation = result->getParams().capabilityNegotiationSupported();
+	const auto remoteIndex = remote_offer->buildStreamIndex();
 	for (auto &rs : remote_offer->streams) {
 		SalStreamDescription &ls = local_capabilities->streams[i];
 		SalStreamDescription stream;
@@ -1125,7 +1158,7 @@ OfferAnswerEngine::initiateIncoming(MSFactory *factory,
 		    OfferAnswerEngine::areProtoInStreamCompatibles(ls, rs)) {
 			std::string bundle_owner_mid;
 			if (local_capabilities->accept_bundles) {
-				int owner_index = remote_offer->getIndexOfTransportOwner(rs);
+				int owner_index = remoteIndex.getIndexOfTransportOwner(rs);
 				if (owner_index >= 0) {
 					bundle_owner_mid = remote_offer->streams[(size_t)owner_index].getChosenConfiguration().getMid();
 				}
@@ -102,6 +102,9 @@ private:
 	                                                   bool one_matching_codec,
 	                                                   const std::string &bundle_owner_mid,
 	                                                   const bool allowCapabilityNegotiation);
+	static bool isRejectedByLocalPolicy(const SalStreamDescription &local_cap,
+	                                    const SalStreamDescription &remote_offer,
+	                                    const SalStreamConfiguration &remoteCfg);
 	static OfferAnswerEngine::optional_sal_stream_configuration
 	initiateIncomingConfiguration(MSFactory *factory,
 	                              const SalStreamDescription &local_cap,
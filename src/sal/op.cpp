@@ -901,7 +901,8 @@ int SalOp::setCustomBody(belle_sip_message_t *msg, const Content &body) {
 	ContentType contentType = body.getContentType();
 	auto contentDisposition = body.getContentDisposition();
 	string contentEncoding = body.getContentEncoding();
-	size_t bodySize = body.getBody().size();
+	const ContentBuffer &bodyBuffer = body.getBodyBuffer();
+	size_t bodySize = bodyBuffer.size();
 
 	if (bodySize > SIP_MESSAGE_BODY_LIMIT) {
 		bctbx_error("trying to add a body greater than %lukB to message [%p]",
@@ -926,7 +927,7 @@ int SalOp::setCustomBody(belle_sip_message_t *msg, const Content &body) {
 
 	if (bodySize > 0) {
 		char *buffer = bctbx_new(char, bodySize + 1);
-		memcpy(buffer, body.getBody().data(), bodySize);
+		memcpy(buffer, bodyBuffer.data(), bodySize);
 		buffer[bodySize] = '\0';
 		belle_sip_message_assign_body(msg, buffer, bodySize);
 	}
@@ -18,8 +18,6 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <regex>
-
 #include "linphone/utils/utils.h"
 #include "potential_config_graph.h"
 
@@ -259,12 +257,12 @@ bool PotentialCfgGraph::processMediaPcfg(const unsigned int &idx, const belle_sd
 	belle_sip_list_t *attrs = belle_sdp_media_description_find_attributes_with_name(media_desc, "pcfg");
 	media_description_unparsed_config unparsed_config;
 	media_description_config config;
+	const auto mediaAcap = getAllAcapForStream(idx);
+	const auto mediaTcap = getAllTcapForStream(idx);
 	for (belle_sip_list_t *attr = attrs; attr != NULL; attr = attr->next) {
 		belle_sdp_pcfg_attribute_t *lAttribute = static_cast<belle_sdp_pcfg_attribute_t *>(attr->data);
 		auto id = static_cast<unsigned int>(belle_sdp_pcfg_attribute_get_id(lAttribute));
 
-		const auto mediaAcap = getAllAcapForStream(idx);
-		const auto mediaTcap = getAllTcapForStream(idx);
 		auto attr_configs = createPConfigFromAttribute(lAttribute, mediaAcap, mediaTcap);
 		if (attr_configs.acap.empty() && attr_configs.tcap.empty()) {
 			lInfo() << "Unable to build a potential config for id " << id;
@@ -447,21 +445,23 @@ capability_type_t PotentialCfgGraph::capabilityTypeFromAttrParam(const std::stri
 }
 
 unsigned int PotentialCfgGraph::getElementIdx(const std::string &index) const {
-	std::regex indexRegex("(\\d+)");
-	auto indexBegin = std::sregex_iterator(index.begin(), index.end(), indexRegex);
-	auto indexEnd = std::sregex_iterator();
-
-	if (indexBegin == indexEnd) {
+	// Called for every index of every configuration line, hence a plain scan rather than a regular expression
+	const auto isDigit = [](char c) { return (c >= '0') && (c <= '9'); };
+	const auto matchBegin = std::find_if(index.cbegin(), index.cend(), isDigit);
+	if (matchBegin == index.cend()) {
 		lDebug() << "Unable to find index in string " << index;
+		return 0;
 	}
-
-	auto noMatches = std::distance(indexBegin, indexEnd);
-	if (noMatches > 1) {
-		lError() << "Expected one match but found " << noMatches << " instead - only first match will be honored";
+	const auto matchEnd = std::find_if_not(matchBegin, index.cend(), isDigit);
+	if (std::find_if(matchEnd, index.cend(), isDigit) != index.cend()) {
+		lError() << "Expected one match but found more in " << index << " - only first match will be honored";
 	}
 
-	std::smatch match = *indexBegin;
-	return static_cast<unsigned int>(std::stoi(match.str()));
+	unsigned int idx = 0;
+	for (auto it = matchBegin; it != matchEnd; ++it) {
+		idx = idx * 10 + static_cast<unsigned int>(*it - '0');
+	}
+	return idx;
 }
 
 const PotentialCfgGraph::session_description_config &PotentialCfgGraph::getAllCfg() const {
@@ -223,6 +223,14 @@ public:
 		mEnableSipUpdate = value;
 	}
 
+	// When enabled, the m= sections of unchanged streams are reused from the previous local SDP of a call
+	void enableIncrementalSdp(bool value) {
+		mIncrementalSdpEnabled = value;
+	}
+	bool incrementalSdpEnabled() const {
+		return mIncrementalSdpEnabled;
+	}
+
 	// RFC 4028
 	void setSessionTimersEnabled(bool value) {
 		mSessionExpiresEnabled = value;
@@ -460,6 +468,7 @@ private:
 	bool mEnableTestFeatures = false;
 	bool mNoInitialRoute = false;
 	bool mEnableSipUpdate = true;
+	bool mIncrementalSdpEnabled = false;
 	SalOpSDPHandling mDefaultSdpHandling = SalOpSDPNormal;
 	bool mPendingTransactionChecking = true; // For testing purposes
 	void *mSslConfig = nullptr;
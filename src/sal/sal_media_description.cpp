@@ -303,7 +303,7 @@ void SalMediaDescription::addNewBundle(const SalStreamBundle &bundle) {
 	bundles.push_back(bundle);
 }
 
-int SalMediaDescription::lookupMid(const std::string mid) const {
+int SalMediaDescription::lookupMid(const std::string &mid) const {
 	size_t index;
 	for (index = 0; index < streams.size(); ++index) {
 		const auto &sd = streams[index];
@@ -314,7 +314,7 @@ int SalMediaDescription::lookupMid(const std::string mid) const {
 	return -1;
 }
 
-const SalStreamBundle &SalMediaDescription::getBundleFromMid(const std::string mid) const {
+const SalStreamBundle &SalMediaDescription::getBundleFromMid(const std::string &mid) const {
 	const auto &bundleIt =
 	    std::find_if(bundles.cbegin(), bundles.cend(), [&mid](const auto &bundle) { return (bundle.hasMid(mid)); });
 	if (bundleIt != bundles.cend()) {
@@ -390,7 +390,7 @@ int SalMediaDescription::findIdxStream(SalMediaProto proto, SalStreamType type)
 }
 
 std::vector<SalStreamDescription>::const_iterator
-SalMediaDescription::findStreamItWithLabel(SalStreamType type, const std::string label) const {
+SalMediaDescription::findStreamItWithLabel(SalStreamType type, const std::string &label) const {
 	const auto &streamIt = std::find_if(streams.cbegin(), streams.cend(), [&type, &label](const auto &stream) {
 		return ((stream.getLabel().compare(label) == 0) && (stream.getType() == type));
 	});
@@ -398,7 +398,7 @@ SalMediaDescription::findStreamItWithLabel(SalStreamType type, const std::string
 }
 
 const SalStreamDescription &SalMediaDescription::findStreamWithLabel(SalStreamType type,
-                                                                     const std::string label) const {
+                                                                     const std::string &label) const {
 	const auto &streamIt = findStreamItWithLabel(type, label);
 	if (streamIt != streams.end()) {
 		return *streamIt;
@@ -406,7 +406,7 @@ const SalStreamDescription &SalMediaDescription::findStreamWithLabel(SalStreamTy
 	return Utils::getEmptyConstRefObject<SalStreamDescription>();
 }
 
-int SalMediaDescription::findIdxStreamWithLabel(SalStreamType type, const std::string label) const {
+int SalMediaDescription::findIdxStreamWithLabel(SalStreamType type, const std::string &label) const {
 	const auto &streamIt = findStreamItWithLabel(type, label);
 	if (streamIt != streams.end()) {
 		return static_cast<int>(std::distance(streams.begin(), streamIt));
@@ -415,14 +415,14 @@ int SalMediaDescription::findIdxStreamWithLabel(SalStreamType type, const std::s
 }
 
 std::vector<SalStreamDescription>::const_iterator
-SalMediaDescription::findStreamItWithContent(const std::string content) const {
+SalMediaDescription::findStreamItWithContent(const std::string &content) const {
 	const auto &streamIt = std::find_if(streams.cbegin(), streams.cend(), [&content](const auto &stream) {
 		return (stream.getContent().compare(content) == 0);
 	});
 	return streamIt;
 }
 
-const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std::string content) const {
+const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std::string &content) const {
 	const auto &streamIt = findStreamItWithContent(content);
 	if (streamIt != streams.end()) {
 		return *streamIt;
@@ -430,7 +430,7 @@ const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std
 	return Utils::getEmptyConstRefObject<SalStreamDescription>();
 }
 
-int SalMediaDescription::findIdxStreamWithContent(const std::string content) const {
+int SalMediaDescription::findIdxStreamWithContent(const std::string &content) const {
 	const auto &streamIt = findStreamItWithContent(content);
 	if (streamIt != streams.end()) {
 		return static_cast<int>(std::distance(streams.begin(), streamIt));
@@ -439,7 +439,7 @@ int SalMediaDescription::findIdxStreamWithContent(const std::string content) con
 }
 
 std::vector<SalStreamDescription>::const_iterator
-SalMediaDescription::findStreamItWithContent(const std::string content, const SalStreamDir direction) const {
+SalMediaDescription::findStreamItWithContent(const std::string &content, const SalStreamDir direction) const {
 	const auto &streamIt = std::find_if(streams.cbegin(), streams.cend(), [&content, &direction](const auto &stream) {
 		return (stream.enabled() && (stream.getContent().compare(content) == 0) &&
 		        (stream.getDirection() == direction));
@@ -447,7 +447,7 @@ SalMediaDescription::findStreamItWithContent(const std::string content, const Sa
 	return streamIt;
 }
 
-const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std::string content,
+const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std::string &content,
                                                                        const SalStreamDir direction) const {
 	const auto &streamIt = findStreamItWithContent(content, direction);
 	if (streamIt != streams.end()) {
@@ -456,7 +456,7 @@ const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std
 	return Utils::getEmptyConstRefObject<SalStreamDescription>();
 }
 
-int SalMediaDescription::findIdxStreamWithContent(const std::string content, const SalStreamDir direction) const {
+int SalMediaDescription::findIdxStreamWithContent(const std::string &content, const SalStreamDir direction) const {
 	const auto &streamIt = findStreamItWithContent(content, direction);
 	if (streamIt != streams.end()) {
 		return static_cast<int>(std::distance(streams.begin(), streamIt));
@@ -465,7 +465,7 @@ int SalMediaDescription::findIdxStreamWithContent(const std::string content, con
 }
 
 std::vector<SalStreamDescription>::const_iterator
-SalMediaDescription::findStreamItWithContent(const std::string content, const std::string label) const {
+SalMediaDescription::findStreamItWithContent(const std::string &content, const std::string &label) const {
 	const auto &streamIt = std::find_if(streams.cbegin(), streams.cend(), [&content, &label](const auto &stream) {
 		return ((content.empty() && stream.getContent().empty()) || stream.getContent().compare(content) == 0) &&
 		       ((label.empty() && stream.getLabel().empty()) || (stream.getLabel().compare(label) == 0));
@@ -473,8 +473,8 @@ SalMediaDescription::findStreamItWithContent(const std::string content, const st
 	return streamIt;
 }
 
-const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std::string content,
-                                                                       const std::string label) const {
+const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std::string &content,
+                                                                       const std::string &label) const {
 	const auto &streamIt = findStreamItWithContent(content, label);
 	if (streamIt != streams.end()) {
 		return *streamIt;
@@ -482,7 +482,7 @@ const SalStreamDescription &SalMediaDescription::findStreamWithContent(const std
 	return Utils::getEmptyConstRefObject<SalStreamDescription>();
 }
 
-int SalMediaDescription::findIdxStreamWithContent(const std::string content, const std::string label) const {
+int SalMediaDescription::findIdxStreamWithContent(const std::string &content, const std::string &label) const {
 	const auto &streamIt = findStreamItWithContent(content, label);
 	if (streamIt != streams.end()) {
 		return static_cast<int>(std::distance(streams.begin(), streamIt));
@@ -534,13 +534,27 @@ const SalStreamDescription &SalMediaDescription::findBestStream(SalStreamType ty
 }
 
 int SalMediaDescription::findIdxBestStream(SalStreamType type) const {
-	auto idx = findIdxStream(SalProtoUdpTlsRtpSavpf, type);
-	if (idx == -1) idx = findIdxStream(SalProtoUdpTlsRtpSavp, type);
-	if (idx == -1) idx = findIdxStream(SalProtoRtpSavpf, type);
-	if (idx == -1) idx = findIdxStream(SalProtoRtpSavp, type);
-	if (idx == -1) idx = findIdxStream(SalProtoRtpAvpf, type);
-	if (idx == -1) idx = findIdxStream(SalProtoRtpAvp, type);
-	return idx;
+	// From the most preferred to the least preferred protocol.
+	static constexpr SalMediaProto protoPreferences[] = {SalProtoUdpTlsRtpSavpf, SalProtoUdpTlsRtpSavp,
+	                                                     SalProtoRtpSavpf,       SalProtoRtpSavp,
+	                                                     SalProtoRtpAvpf,        SalProtoRtpAvp};
+	static constexpr int nbProtoPreferences = static_cast<int>(sizeof(protoPreferences) / sizeof(protoPreferences[0]));
+
+	// Single pass over the streams, keeping the first stream having the best protocol found so far.
+	int bestIdx = -1;
+	int bestRank = nbProtoPreferences;
+	for (size_t idx = 0; (idx < streams.size()) && (bestRank > 0); idx++) {
+		const auto &stream = streams[idx];
+		if (!stream.enabled() || (stream.getType() != type)) continue;
+		for (int rank = 0; rank < bestRank; rank++) {
+			if (stream.getProto() == protoPreferences[rank]) {
+				bestRank = rank;
+				bestIdx = static_cast<int>(idx);
+				break;
+			}
+		}
+	}
+	return bestIdx;
 }
 
 int SalMediaDescription::findIdxStreamWithSdpAttribute(
@@ -636,16 +650,79 @@ int SalMediaDescription::findFirstStreamIdxOfType(SalStreamType type, int starti
 	return -1;
 }
 
-const std::list<SalStreamDescription> SalMediaDescription::findAllStreamsOfType(SalStreamType type) const {
-	std::list<SalStreamDescription> streamList;
+std::vector<std::reference_wrapper<const SalStreamDescription>>
+SalMediaDescription::findAllStreamsOfType(SalStreamType type) const {
+	std::vector<std::reference_wrapper<const SalStreamDescription>> streamList;
 	for (const auto &s : streams) {
 		if (s.getType() == type) {
-			streamList.push_back(s);
+			streamList.push_back(std::cref(s));
 		}
 	};
 	return streamList;
 }
 
+SalMediaDescription::StreamIndex SalMediaDescription::buildStreamIndex() const {
+	StreamIndex index;
+	for (size_t i = 0; i < streams.size(); i++) {
+		const auto &stream = streams[i];
+		const auto idx = static_cast<int>(i);
+		// emplace() keeps the first stream inserted for a given key, which is the one a linear search would find.
+		index.byContentAndLabel.emplace(std::make_pair(stream.getContent(), stream.getLabel()), idx);
+		index.byTypeAndLabel.emplace(std::make_pair(stream.getType(), stream.getLabel()), idx);
+		index.byMid.emplace(stream.getChosenConfiguration().getMid(), idx);
+	}
+	// Likewise the first bundle holding a mid is the one getBundleFromMid() returns.
+	for (const auto &bundle : bundles) {
+		const auto &ownerMid = bundle.getMidOfTransportOwner();
+		for (const auto &mid : bundle.mids) {
+			index.ownerMidByMid.emplace(mid, ownerMid);
+		}
+	}
+	return index;
+}
+
+int SalMediaDescription::StreamIndex::findIdxStreamWithContent(const std::string &content,
+                                                               const std::string &label) const {
+	const auto it = byContentAndLabel.find(std::make_pair(content, label));
+	return (it == byContentAndLabel.cend()) ? -1 : it->second;
+}
+
+int SalMediaDescription::StreamIndex::findIdxStreamWithLabel(SalStreamType type, const std::string &label) const {
+	const auto it = byTypeAndLabel.find(std::make_pair(type, label));
+	return (it == byTypeAndLabel.cend()) ? -1 : it->second;
+}
+
+int SalMediaDescription::StreamIndex::lookupMid(const std::string &mid) const {
+	const auto it = byMid.find(mid);
+	return (it == byMid.cend()) ? -1 : it->second;
+}
+
+// Same return values and logs as SalMediaDescription::getIndexOfTransportOwner().
+int SalMediaDescription::StreamIndex::getIndexOfTransportOwner(const SalStreamDescription &sd) const {
+	const auto &mid = sd.getChosenConfiguration().getMid();
+	if (mid.empty()) return -1; /* not part of any bundle */
+	const auto it = ownerMidByMid.find(mid);
+	if (it == ownerMidByMid.cend()) {
+		ms_warning("Orphan stream with mid '%s'", L_STRING_TO_C(mid));
+		return -2;
+	}
+	const auto &masterMid = it->second;
+	if (masterMid.empty()) {
+		ms_warning("Orphan stream with mid '%s' because the transport owner mid cannot be found", L_STRING_TO_C(mid));
+		return -2;
+	}
+	int index = lookupMid(masterMid);
+	if (index == -1) {
+		ms_error("Stream with mid '%s' has no transport owner (mid '%s') !", L_STRING_TO_C(mid),
+		         L_STRING_TO_C(masterMid));
+	}
+	return index;
+}
+
+void SalMediaDescription::StreamIndex::removeMid(const std::string &mid) {
+	if (!mid.empty()) byMid.erase(mid);
+}
+
 bool SalMediaDescription::isEmpty() const {
 	if (getNbActiveStreams() > 0) return false;
 	return true;
@@ -905,6 +982,100 @@ const SalStreamDescription &SalMediaDescription::getStreamIdx(unsigned int idx)
 }
 
 belle_sdp_session_description_t *SalMediaDescription::toSdp() const {
+	belle_sdp_session_description_t *session_desc = toSdpSessionPart();
+	for (const auto &stream : streams) {
+		auto media_desc = stream.toSdpMediaDescription(this, session_desc);
+		belle_sdp_session_description_add_media_description(session_desc, media_desc);
+	}
+	return session_desc;
+}
+
+void SalMediaDescription::SdpSectionCache::clear() {
+	sessionPart.clear();
+	capabilityNegotiation = false;
+	tcapLinesMerged = false;
+	sections.clear();
+	reusedSectionCount = 0;
+}
+
+static bool marshalSdpObject(void *object, std::string &text) {
+	char *str = belle_sip_object_to_string(object);
+	if (!str) return false;
+	text.append(str);
+	bctbx_free(str);
+	return true;
+}
+
+/*
+ * The m= sections are the last lines of a SDP, so the text is the session level lines followed by the sections of all
+ * streams, which are either taken from the cache or marshalled individually.
+ */
+bool SalMediaDescription::toSdpText(SdpSectionCache &cache, std::string &sdp) const {
+	sdp.clear();
+	cache.reusedSectionCount = 0;
+	belle_sdp_session_description_t *session_desc = toSdpSessionPart();
+	belle_sip_object_ref(session_desc);
+
+	/* A multicast stream removes the session level c= line when it is serialized, hence its section can't be
+	 * appended to the session lines marshalled beforehand. This is not worth caching. */
+	const bool hasMulticastStream = std::any_of(streams.cbegin(), streams.cend(), [](const auto &stream) {
+		return !stream.rtp_addr.empty() && ms_is_multicast(L_STRING_TO_C(stream.rtp_addr));
+	});
+	if (hasMulticastStream) {
+		cache.clear();
+		for (const auto &stream : streams) {
+			belle_sdp_session_description_add_media_description(session_desc,
+			                                                    stream.toSdpMediaDescription(this, session_desc));
+		}
+		bool ret = marshalSdpObject(session_desc, sdp);
+		belle_sip_object_unref(session_desc);
+		return ret;
+	}
+
+	if (!marshalSdpObject(session_desc, sdp)) {
+		belle_sip_object_unref(session_desc);
+		cache.clear();
+		return false;
+	}
+	if ((cache.sessionPart != sdp) || (cache.capabilityNegotiation != params.capabilityNegotiationSupported()) ||
+	    (cache.tcapLinesMerged != params.tcapLinesMerged())) {
+		cache.clear();
+		cache.sessionPart = sdp;
+		cache.capabilityNegotiation = params.capabilityNegotiationSupported();
+		cache.tcapLinesMerged = params.tcapLinesMerged();
+	}
+
+	std::vector<std::pair<SalStreamDescription, std::string>> sections;
+	sections.reserve(streams.size());
+	for (size_t idx = 0; idx < streams.size(); idx++) {
+		const auto &stream = streams[idx];
+		// Done by toSdpMediaDescription() as well, but needed before the comparison and when the section is reused.
+		stream.enableAvpfOfSerializedPayloads(params.capabilityNegotiationSupported());
+		if ((idx < cache.sections.size()) && cache.sections[idx].first.sdpEqual(stream)) {
+			sections.push_back(std::move(cache.sections[idx]));
+			cache.reusedSectionCount++;
+		} else {
+			std::string section;
+			belle_sdp_media_description_t *media_desc = stream.toSdpMediaDescription(this, session_desc);
+			belle_sip_object_ref(media_desc);
+			bool marshalled = marshalSdpObject(media_desc, section);
+			belle_sip_object_unref(media_desc);
+			if (!marshalled) {
+				belle_sip_object_unref(session_desc);
+				cache.clear();
+				return false;
+			}
+			sections.emplace_back(stream, std::move(section));
+		}
+		sdp.append(sections.back().second);
+	}
+	cache.sections = std::move(sections);
+
+	belle_sip_object_unref(session_desc);
+	return true;
+}
+
+belle_sdp_session_description_t *SalMediaDescription::toSdpSessionPart() const {
 	belle_sdp_session_description_t *session_desc = belle_sdp_session_description_new();
 	bool_t inet6;
 	belle_sdp_origin_t *origin;
@@ -1029,10 +1200,6 @@ belle_sdp_session_description_t *SalMediaDescription::toSdp() const {
 		}
 	}
 
-	for (const auto &stream : streams) {
-		auto media_desc = stream.toSdpMediaDescription(this, session_desc);
-		belle_sdp_session_description_add_media_description(session_desc, media_desc);
-	}
 	return session_desc;
 }
 
@@ -1116,26 +1283,101 @@ void SalMediaDescription::addAcapToStream(const std::size_t &streamIdx,
 	}
 }
 
+void SalMediaDescription::PotentialCfgCache::clear() {
+	entries.clear();
+	hitCount = 0;
+	missCount = 0;
+}
+
+static size_t hashCapabilities(const SalStreamDescription::acap_map_t &acaps,
+                               const SalStreamDescription::tcap_map_t &tcaps,
+                               const std::list<LinphoneMediaEncryption> &encryptions,
+                               const bool delete_session_attributes,
+                               const bool delete_media_attributes,
+                               const bool mergeCfgLines) {
+	std::hash<std::string> stringHash;
+	size_t hash = 0;
+	auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+	for (const auto &[idx, nameValue] : acaps) {
+		combine(idx);
+		combine(stringHash(nameValue.first));
+		combine(stringHash(nameValue.second));
+	}
+	for (const auto &[idx, value] : tcaps) {
+		combine(idx);
+		combine(stringHash(value));
+	}
+	for (const auto &enc : encryptions) {
+		combine(static_cast<size_t>(enc));
+	}
+	combine((delete_session_attributes ? 1 : 0) | (delete_media_attributes ? 2 : 0) | (mergeCfgLines ? 4 : 0));
+	return hash;
+}
+
+static bool areSameCfgs(const SalStreamDescription::cfg_map &cfgs1, const SalStreamDescription::cfg_map &cfgs2) {
+	if (cfgs1.size() != cfgs2.size()) return false;
+	for (auto cfg1 = cfgs1.cbegin(), cfg2 = cfgs2.cbegin(); cfg1 != cfgs1.cend(); ++cfg1, ++cfg2) {
+		if ((cfg1->first != cfg2->first) || !cfg1->second.strictEqual(cfg2->second)) return false;
+	}
+	return true;
+}
+
 void SalMediaDescription::createPotentialConfigurationsForStream(const unsigned int &streamIdx,
                                                                  const bool delete_session_attributes,
-                                                                 const bool delete_media_attributes) {
+                                                                 const bool delete_media_attributes,
+                                                                 PotentialCfgCache *cache) {
 
 	try {
 		SalStreamDescription &stream = streams.at(streamIdx);
 		const auto allStreamAcaps = getAllAcapForStream(streamIdx);
 		const auto allStreamTcaps = getAllTcapForStream(streamIdx);
 		if (!allStreamAcaps.empty() || !allStreamTcaps.empty()) {
+			const bool mergeCfgLines = params.cfgLinesMerged();
+			size_t key = 0;
+			if (cache) {
+				key = hashCapabilities(allStreamAcaps, allStreamTcaps, stream.supportedEncryption,
+				                       delete_session_attributes, delete_media_attributes, mergeCfgLines);
+				const auto entryIt = cache->entries.find(key);
+				if (entryIt != cache->entries.cend()) {
+					const auto &entry = entryIt->second;
+					if ((entry.acaps == allStreamAcaps) && (entry.tcaps == allStreamTcaps) &&
+					    (entry.supportedEncryptions == stream.supportedEncryption) &&
+					    (entry.deleteSessionAttributes == delete_session_attributes) &&
+					    (entry.deleteMediaAttributes == delete_media_attributes) &&
+					    (entry.mergeCfgLines == mergeCfgLines) && areSameCfgs(entry.inputCfgs, stream.cfgs)) {
+						stream.cfgs = entry.outputCfgs;
+						cache->hitCount++;
+						return;
+					}
+				}
+			}
+			const auto inputCfgs = cache ? stream.cfgs : SalStreamDescription::cfg_map();
+
 			if (allStreamTcaps.empty()) {
 				const SalStreamDescription::tcap_map_t proto;
 				stream.createPotentialConfiguration(proto, {allStreamAcaps}, delete_session_attributes,
-				                                    delete_media_attributes, params.cfgLinesMerged());
+				                                    delete_media_attributes, mergeCfgLines);
 			} else {
 				for (const auto &protoPair : allStreamTcaps) {
 					const SalStreamDescription::tcap_map_t proto{{protoPair}};
 					stream.createPotentialConfiguration(proto, {allStreamAcaps}, delete_session_attributes,
-					                                    delete_media_attributes, params.cfgLinesMerged());
+					                                    delete_media_attributes, mergeCfgLines);
 				}
 			}
+
+			if (cache) {
+				cache->missCount++;
+				if (cache->entries.size() >= PotentialCfgCache::MaxEntries) cache->entries.clear();
+				auto &entry = cache->entries[key];
+				entry.acaps = allStreamAcaps;
+				entry.tcaps = allStreamTcaps;
+				entry.supportedEncryptions = stream.supportedEncryption;
+				entry.deleteSessionAttributes = delete_session_attributes;
+				entry.deleteMediaAttributes = delete_media_attributes;
+				entry.mergeCfgLines = mergeCfgLines;
+				entry.inputCfgs = inputCfgs;
+				entry.outputCfgs = stream.cfgs;
+			}
 		} else {
 			lInfo() << "Unable to create potential configuration for stream " << streamIdx
 			        << " because it doesn't have acap and tcap attributes";
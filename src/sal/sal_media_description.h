@@ -21,9 +21,12 @@
 #ifndef _SAL_MEDIA_DESCRIPTION_H_
 #define _SAL_MEDIA_DESCRIPTION_H_
 
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "c-wrapper/internal/c-sal.h"
@@ -47,17 +50,110 @@ public:
 	// number of seconds: (70*365 + 17)*86400 = 2208988800
 	static constexpr long long ntpToUnix = 2208988800;
 
+	/*
+	 * Lookup tables over the streams of a media description, built by buildStreamIndex().
+	 * The index is a snapshot: it is not updated when streams are added, removed or modified afterwards, so it is meant
+	 * for loops doing one lookup per participant over a description that does not change meanwhile.
+	 * Lookups return the same index as their linear SalMediaDescription counterparts.
+	 */
+	class StreamIndex {
+	public:
+		int findIdxStreamWithContent(const std::string &content, const std::string &label) const;
+		int findIdxStreamWithLabel(SalStreamType type, const std::string &label) const;
+		int lookupMid(const std::string &mid) const;
+		int getIndexOfTransportOwner(const SalStreamDescription &sd) const;
+		// To be called when the stream having this mid is disabled, as disabling a stream clears its mid.
+		void removeMid(const std::string &mid);
+
+	private:
+		friend class SalMediaDescription;
+
+		std::map<std::pair<std::string, std::string>, int> byContentAndLabel;
+		std::map<std::pair<SalStreamType, std::string>, int> byTypeAndLabel;
+		std::unordered_map<std::string, int> byMid;
+		// Mid of the transport owner of the first bundle each mid belongs to
+		std::unordered_map<std::string, std::string> ownerMidByMid;
+	};
+
+	/*
+	 * Serialized m= sections of the last SDP generated by toSdpText(), each kept along with a copy of the stream it was
+	 * generated from. A section is reused as is by the next generation if its stream is unchanged (see
+	 * SalStreamDescription::sdpEqual()) and if the session level lines are unchanged as well, so that only the delta is
+	 * serialized again when a re-INVITE adds or modifies a few streams.
+	 */
+	class SdpSectionCache {
+	public:
+		void clear();
+		size_t getSectionCount() const {
+			return sections.size();
+		}
+		// Number of m= sections reused from the cache by the last generation
+		size_t getReusedSectionCount() const {
+			return reusedSectionCount;
+		}
+
+	private:
+		friend class SalMediaDescription;
+
+		std::string sessionPart;
+		bool capabilityNegotiation = false;
+		bool tcapLinesMerged = false;
+		std::vector<std::pair<SalStreamDescription, std::string>> sections;
+		size_t reusedSectionCount = 0;
+	};
+
+	/*
+	 * Memoization of the potential configurations expanded by createPotentialConfigurationsForStream(), keyed by a hash
+	 * of the capability attributes of the stream. An entry is reused only if the capabilities, the supported encryptions
+	 * and the configurations of the stream before the expansion are identical to the ones it was computed from, so that
+	 * a hash collision can't produce wrong configurations.
+	 */
+	class PotentialCfgCache {
+	public:
+		void clear();
+		size_t getHitCount() const {
+			return hitCount;
+		}
+		size_t getMissCount() const {
+			return missCount;
+		}
+
+	private:
+		friend class SalMediaDescription;
+
+		struct Entry {
+			SalStreamDescription::acap_map_t acaps;
+			SalStreamDescription::tcap_map_t tcaps;
+			std::list<LinphoneMediaEncryption> supportedEncryptions;
+			bool deleteSessionAttributes = false;
+			bool deleteMediaAttributes = false;
+			bool mergeCfgLines = false;
+			SalStreamDescription::cfg_map inputCfgs;
+			SalStreamDescription::cfg_map outputCfgs;
+		};
+
+		// Entries are dropped all at once when this size is reached, which only happens if the capabilities keep changing
+		static constexpr size_t MaxEntries = 16;
+
+		std::unordered_map<size_t, Entry> entries;
+		size_t hitCount = 0;
+		size_t missCount = 0;
+	};
+
 	SalMediaDescription(const SalMediaDescriptionParams &descParams);
 	SalMediaDescription(belle_sdp_session_description_t *sdp);
 	SalMediaDescription(const SalMediaDescription &other);
 	virtual ~SalMediaDescription();
 
 	belle_sdp_session_description_t *toSdp() const;
+	bool toSdpText(SdpSectionCache &cache, std::string &sdp) const;
+
+	StreamIndex buildStreamIndex() const;
 
 	void addNewBundle(const SalStreamBundle &bundle);
 
-	int lookupMid(const std::string mid) const;
-	const SalStreamBundle & getBundleFromMid(const std::string mid) const;
+	int lookupMid(const std::string &mid) const;
+	const SalStreamBundle & getBundleFromMid(const std::string &mid) const;
 	std::list<int> getTransportOwnerIndexes() const;
 	int getIndexOfTransportOwner(const SalStreamDescription & sd) const;
 
@@ -76,19 +172,19 @@ public:
 	findStreamWithSdpAttribute(const std::vector<std::pair<std::string, std::string>> &attributes) const;
 	const SalStreamDescription &findFirstStreamOfType(SalStreamType type, int startingIdx = -1) const;
 	int findFirstStreamIdxOfType(SalStreamType type, int startingIdx = -1) const;
-	const std::list<SalStreamDescription> findAllStreamsOfType(SalStreamType type) const;
+	std::vector<std::reference_wrapper<const SalStreamDescription>> findAllStreamsOfType(SalStreamType type) const;
 	int findIdxStreamWithSdpAttribute(const SalStreamType,
 									  const std::vector<std::pair<std::string, std::string>> &attributes) const;
 	int findIdxStreamWithSdpAttribute(const std::vector<std::pair<std::string, std::string>> &attributes) const;
-	const SalStreamDescription &findStreamWithLabel(SalStreamType type, const std::string label) const;
-	int findIdxStreamWithLabel(SalStreamType type, const std::string label) const;
+	const SalStreamDescription &findStreamWithLabel(SalStreamType type, const std::string &label) const;
+	int findIdxStreamWithLabel(SalStreamType type, const std::string &label) const;
 
-	const SalStreamDescription &findStreamWithContent(const std::string content) const;
-	int findIdxStreamWithContent(const std::string content) const;
-	const SalStreamDescription &findStreamWithContent(const std::string content, const SalStreamDir direction) const;
-	int findIdxStreamWithContent(const std::string content, const SalStreamDir direction) const;
-	const SalStreamDescription &findStreamWithContent(const std::string content, const std::string label) const;
-	int findIdxStreamWithContent(const std::string content, const std::string label) const;
+	const SalStreamDescription &findStreamWithContent(const std::string &content) const;
+	int findIdxStreamWithContent(const std::string &content) const;
+	const SalStreamDescription &findStreamWithContent(const std::string &content, const SalStreamDir direction) const;
+	int findIdxStreamWithContent(const std::string &content, const SalStreamDir direction) const;
+	const SalStreamDescription &findStreamWithContent(const std::string &content, const std::string &label) const;
+	int findIdxStreamWithContent(const std::string &content, const std::string &label) const;
 
 	bool isEmpty() const;
 	bool isAcceptable() const;
@@ -144,7 +240,8 @@ public:
 	// Creates potential configuration based on stored tcap and acaps
 	void createPotentialConfigurationsForStream(const unsigned int &streamIdx,
 	                                            const bool delete_session_attributes,
-	                                            const bool delete_media_attributes);
+	                                            const bool delete_media_attributes,
+	                                            PotentialCfgCache *cache = nullptr);
 
 	std::string name;
 	std::string addr;
@@ -176,6 +273,8 @@ private:
 
 	mutable SalMediaDescriptionParams params;
 
+	belle_sdp_session_description_t *toSdpSessionPart() const;
+
 	std::vector<SalStreamDescription>::const_iterator findFirstStreamItOfType(SalStreamType type,
 																			  int startingIdx = -1) const;
 	std::vector<SalStreamDescription>::const_iterator
@@ -185,12 +284,12 @@ private:
 								 const std::vector<std::pair<std::string, std::string>> &attributes) const;
 	std::vector<SalStreamDescription>::const_iterator findStreamIt(SalMediaProto proto, SalStreamType type) const;
 	std::vector<SalStreamDescription>::const_iterator findStreamItWithLabel(SalStreamType type,
-																			const std::string label) const;
-	std::vector<SalStreamDescription>::const_iterator findStreamItWithContent(const std::string content) const;
-	std::vector<SalStreamDescription>::const_iterator findStreamItWithContent(const std::string content,
+																			const std::string &label) const;
+	std::vector<SalStreamDescription>::const_iterator findStreamItWithContent(const std::string &content) const;
+	std::vector<SalStreamDescription>::const_iterator findStreamItWithContent(const std::string &content,
 																			  const SalStreamDir direction) const;
-	std::vector<SalStreamDescription>::const_iterator findStreamItWithContent(const std::string content,
-																			  const std::string label) const;
+	std::vector<SalStreamDescription>::const_iterator findStreamItWithContent(const std::string &content,
+																			  const std::string &label) const;
 
 	/*check for the presence of at least one stream with requested direction */
 	bool containsStreamWithDir(const SalStreamDir &stream_dir) const;
@@ -174,6 +174,92 @@ bool SalStreamConfiguration::operator!=(const SalStreamConfiguration &other) con
 	return !(*this == other);
 }
 
+bool SalStreamConfiguration::isSameSdpPayloadType(const PayloadType *p1, const PayloadType *p2) {
+	if (!isSamePayloadType(p1, p2)) return false;
+	if (L_C_TO_STRING(p1->recv_fmtp) != L_C_TO_STRING(p2->recv_fmtp)) return false;
+	if ((payload_type_get_flags(p1) & PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED) !=
+	    (payload_type_get_flags(p2) & PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED))
+		return false;
+	const auto avpf1 = payload_type_get_avpf_params(p1);
+	const auto avpf2 = payload_type_get_avpf_params(p2);
+	return (avpf1.features == avpf2.features) && (avpf1.rpsi_compatibility == avpf2.rpsi_compatibility) &&
+	       (avpf1.trr_interval == avpf2.trr_interval);
+}
+
+/*
+ * Unlike equal(), which only reports the changes relevant to the media streams, this compares every member that ends
+ * up in the SDP, so that two configurations comparing equal are serialized into the very same lines.
+ * Configurations carrying custom SDP attributes are never considered equal.
+ */
+bool SalStreamConfiguration::sdpEqual(const SalStreamConfiguration &other) const {
+	if ((index != other.index) || (proto != other.proto) || (proto_other != other.proto_other)) return false;
+	if ((ptime != other.ptime) || (dir != other.dir) || (max_rate != other.max_rate) || (ttl != other.ttl))
+		return false;
+
+	if (payloads.size() != other.payloads.size()) return false;
+	for (auto p1 = payloads.cbegin(), p2 = other.payloads.cbegin(); p1 != payloads.cend(); ++p1, ++p2) {
+		if (!isSameSdpPayloadType(*p1, *p2)) return false;
+	}
+
+	if (crypto.size() != other.crypto.size()) return false;
+	for (auto crypto1 = crypto.cbegin(), crypto2 = other.crypto.cbegin(); crypto1 != crypto.cend();
+	     ++crypto1, ++crypto2) {
+		if ((crypto1->tag != crypto2->tag) || (crypto1->algo != crypto2->algo) ||
+		    (crypto1->master_key != crypto2->master_key))
+			return false;
+	}
+
+	if ((bundle_only != other.bundle_only) || (mid != other.mid) ||
+	    (mid_rtp_ext_header_id != other.mid_rtp_ext_header_id))
+		return false;
+	if ((mixer_to_client_extension_id != other.mixer_to_client_extension_id) ||
+	    (client_to_mixer_extension_id != other.client_to_mixer_extension_id) ||
+	    (frame_marking_extension_id != other.frame_marking_extension_id) ||
+	    (conference_ssrc != other.conference_ssrc))
+		return false;
+	if ((set_nortpproxy != other.set_nortpproxy) || (rtcp_mux != other.rtcp_mux)) return false;
+
+	if ((rtcp_fb.generic_nack_enabled != other.rtcp_fb.generic_nack_enabled) ||
+	    (rtcp_fb.tmmbr_enabled != other.rtcp_fb.tmmbr_enabled))
+		return false;
+	if ((rtcp_xr.enabled != other.rtcp_xr.enabled) || (rtcp_xr.rcvr_rtt_mode != other.rtcp_xr.rcvr_rtt_mode) ||
+	    (rtcp_xr.rcvr_rtt_max_size != other.rtcp_xr.rcvr_rtt_max_size) ||
+	    (rtcp_xr.stat_summary_enabled != other.rtcp_xr.stat_summary_enabled) ||
+	    (rtcp_xr.stat_summary_flags != other.rtcp_xr.stat_summary_flags) ||
+	    (rtcp_xr.voip_metrics_enabled != other.rtcp_xr.voip_metrics_enabled))
+		return false;
+
+	if (haveZrtpHash != other.haveZrtpHash) return false;
+	if (haveZrtpHash && (strcmp((const char *)zrtphash, (const char *)other.zrtphash) != 0)) return false;
+	if ((dtls_role != other.dtls_role) || (dtls_fingerprint != other.dtls_fingerprint)) return false;
+
+	if ((tcapIndex != other.tcapIndex) || (acapIndexes != other.acapIndexes) ||
+	    (delete_media_attributes != other.delete_media_attributes) ||
+	    (delete_session_attributes != other.delete_session_attributes))
+		return false;
+
+	return (custom_sdp_attributes == nullptr) && (other.custom_sdp_attributes == nullptr);
+}
+
+/*
+ * Stricter than sdpEqual(): members that are not written to the SDP, such as the send fmtp, the bitrate of the
+ * payloads or the RTP SSRC, must be equal as well.
+ */
+bool SalStreamConfiguration::strictEqual(const SalStreamConfiguration &other) const {
+	if (!sdpEqual(other)) return false;
+	if ((rtp_ssrc != other.rtp_ssrc) || (rtcp_cname != other.rtcp_cname) || (maxptime != other.maxptime) ||
+	    (crypto_local_tag != other.crypto_local_tag) || (implicit_rtcp_fb != other.implicit_rtcp_fb) ||
+	    (haveLimeIk != other.haveLimeIk))
+		return false;
+	for (auto p1 = payloads.cbegin(), p2 = other.payloads.cbegin(); p1 != payloads.cend(); ++p1, ++p2) {
+		if ((L_C_TO_STRING((*p1)->send_fmtp) != L_C_TO_STRING((*p2)->send_fmtp)) ||
+		    ((*p1)->normal_bitrate != (*p2)->normal_bitrate) || ((*p1)->flags != (*p2)->flags) ||
+		    ((*p1)->bits_per_sample != (*p2)->bits_per_sample))
+			return false;
+	}
+	return true;
+}
+
 int SalStreamConfiguration::equal(const SalStreamConfiguration &other) const {
 	int result = SAL_MEDIA_DESCRIPTION_UNCHANGED;
 
@@ -84,6 +84,8 @@ public:
 	int equal(const SalStreamConfiguration &other) const;
 	bool operator==(const SalStreamConfiguration &other) const;
 	bool operator!=(const SalStreamConfiguration &other) const;
+	bool sdpEqual(const SalStreamConfiguration &other) const;
+	bool strictEqual(const SalStreamConfiguration &other) const;
 	void disable();
 
 	/*these are switch case, so that when a new proto is added we can't forget to modify this function*/
@@ -169,6 +171,7 @@ private:
 	static bool isRecvOnly(const PayloadType *p);
 	static bool isSamePayloadType(const PayloadType *p1, const PayloadType *p2);
 	static bool isSamePayloadList(const std::list<PayloadType *> &l1, const std::list<PayloadType *> &l2);
+	static bool isSameSdpPayloadType(const PayloadType *p1, const PayloadType *p2);
 	static std::string getSetupAttributeForDtlsRole(const SalDtlsRole &role);
 	static SalDtlsRole getDtlsRoleFromSetupAttribute(const std::string setupAtte);
 
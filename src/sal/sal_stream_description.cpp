@@ -570,7 +570,7 @@ SalStreamDescription::addAcapsToConfiguration(const SalStreamConfiguration &base
 	return cfgList;
 }
 
-const SalStreamDescription::cfg_map SalStreamDescription::getAllCfgs() const {
+const SalStreamDescription::cfg_map &SalStreamDescription::getAllCfgs() const {
 	return cfgs;
 }
 
@@ -908,6 +908,47 @@ int SalStreamDescription::globalEqual(const SalStreamDescription &other) const {
 	return result;
 }
 
+/*
+ * Returns true when both streams are serialized into the same m= section, provided they are serialized against the
+ * same session level description. Streams carrying custom SDP attributes are never considered equal.
+ * Any member written by toSdpMediaDescription() must be compared here: the incremental SDP tests check the output of
+ * SalMediaDescription::toSdpText() against a full serialization.
+ */
+bool SalStreamDescription::sdpEqual(const SalStreamDescription &other) const {
+	if ((type != other.type) || (typeother != other.typeother)) return false;
+	if ((rtp_addr != other.rtp_addr) || (rtp_port != other.rtp_port)) return false;
+	if ((rtcp_addr != other.rtcp_addr) || (rtcp_port != other.rtcp_port)) return false;
+	if ((bandwidth != other.bandwidth) || (multicast_role != other.multicast_role)) return false;
+	if ((label != other.label) || (content != other.content)) return false;
+	if (custom_sdp_attributes || other.custom_sdp_attributes) return false;
+
+	/* ICE */
+	if ((ice_ufrag != other.ice_ufrag) || (ice_pwd != other.ice_pwd) || (ice_mismatch != other.ice_mismatch))
+		return false;
+	if (ice_candidates.size() != other.ice_candidates.size()) return false;
+	for (auto c1 = ice_candidates.cbegin(), c2 = other.ice_candidates.cbegin(); c1 != ice_candidates.cend();
+	     ++c1, ++c2) {
+		if ((c1->addr != c2->addr) || (c1->port != c2->port) || (c1->raddr != c2->raddr) ||
+		    (c1->rport != c2->rport) || (c1->foundation != c2->foundation) || (c1->type != c2->type) ||
+		    (c1->componentID != c2->componentID) || (c1->priority != c2->priority))
+			return false;
+	}
+	if (ice_remote_candidates.size() != other.ice_remote_candidates.size()) return false;
+	for (auto c1 = ice_remote_candidates.cbegin(), c2 = other.ice_remote_candidates.cbegin();
+	     c1 != ice_remote_candidates.cend(); ++c1, ++c2) {
+		if ((c1->addr != c2->addr) || (c1->port != c2->port)) return false;
+	}
+
+	/* Capability negotiation */
+	if ((acaps != other.acaps) || (tcaps != other.tcaps)) return false;
+	if (cfgs.size() != other.cfgs.size()) return false;
+	for (auto cfg1 = cfgs.cbegin(), cfg2 = other.cfgs.cbegin(); cfg1 != cfgs.cend(); ++cfg1, ++cfg2) {
+		if ((cfg1->first != cfg2->first) || !cfg1->second.sdpEqual(cfg2->second)) return false;
+	}
+
+	return true;
+}
+
 bool SalStreamDescription::enabled() const {
 	/* When the bundle-only attribute is present, a 0 rtp port doesn't mean that the stream is disabled.*/
 	return rtp_port > 0 || (isBundleOnly() && (getDirection() != SalStreamInactive));
@@ -1066,7 +1107,7 @@ void SalStreamDescription::setCrypto(const size_t &idx, const SalSrtpCryptoAlgo
 	cfgs[getChosenConfigurationIndex()].crypto[idx] = newCrypto;
 }
 
-void SalStreamDescription::setLabel(const std::string newLabel) {
+void SalStreamDescription::setLabel(const std::string &newLabel) {
 	label = newLabel;
 }
 
@@ -1074,7 +1115,7 @@ const std::string &SalStreamDescription::getLabel() const {
 	return label;
 }
 
-void SalStreamDescription::setContent(const std::string newContent) {
+void SalStreamDescription::setContent(const std::string &newContent) {
 	content = newContent;
 }
 
@@ -1111,6 +1152,8 @@ SalStreamDescription::toSdpMediaDescription(const SalMediaDescription *salMediaD
 
 	const auto &actualCfg = getActualConfiguration();
 
+	enableAvpfOfSerializedPayloads(salMediaDesc->getParams().capabilityNegotiationSupported());
+
 	media_desc = belle_sdp_media_description_create(L_STRING_TO_C(getTypeAsString()), rtp_port, 1,
 	                                                L_STRING_TO_C(getProtoAsString()), NULL);
 	if (!actualCfg.payloads.empty()) {
@@ -1340,13 +1383,6 @@ SalStreamDescription::toSdpMediaDescription(const SalMediaDescription *salMediaD
 		}
 
 		for (const auto &[cfgKey, cfg] : cfgs) {
-			if (stream_enabled && (cfg.hasAvpf() || cfg.hasImplicitAvpf())) {
-				for (const auto &pt : cfg.payloads) {
-					/* AVPF/SAVPF profile is used so enable AVPF for all payload types. */
-					payload_type_set_flag(pt, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
-				}
-			}
-
 			const auto &cfgSdpString = cfg.getSdpString();
 			if (!cfgSdpString.empty()) {
 				const auto &cfgIdx = cfg.index;
@@ -1624,6 +1660,23 @@ bool SalStreamDescription::isRtcpFbTrrIntTheSameForAllPayloads(const SalStreamCo
 	return true;
 }
 
+/*
+ * The AVPF/SAVPF profile is used so AVPF is enabled for all payload types of the configurations written to the SDP.
+ * This is the only change the serialization makes to the stream, and it is made apart so that it is also made when the
+ * serialized section is taken from a SalMediaDescription::SdpSectionCache.
+ */
+void SalStreamDescription::enableAvpfOfSerializedPayloads(bool capabilityNegotiation) const {
+	if (!enabled()) return;
+	for (const auto &[cfgKey, cfg] : cfgs) {
+		if (!capabilityNegotiation && (cfgKey != getActualConfigurationIndex())) continue;
+		if (cfg.hasAvpf() || cfg.hasImplicitAvpf()) {
+			for (const auto &pt : cfg.payloads) {
+				payload_type_set_flag(pt, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
+			}
+		}
+	}
+}
+
 void SalStreamDescription::addRtcpFbAttributesToSdp(const SalStreamConfiguration &cfg,
                                                     belle_sdp_media_description_t *media_desc) const {
 	PayloadTypeAvpfParams avpf_params;
@@ -1642,8 +1695,6 @@ void SalStreamDescription::addRtcpFbAttributesToSdp(const SalStreamConfiguration
 	}
 
 	for (const auto &pt : cfg.payloads) {
-		/* AVPF/SAVPF profile is used so enable AVPF for all payload types. */
-		payload_type_set_flag(pt, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
 		avpf_params = payload_type_get_avpf_params(pt);
 
 		/* Add trr-int if not set generally. */
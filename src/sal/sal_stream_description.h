@@ -91,8 +91,10 @@ public:
 	int equal(const SalStreamDescription &other) const;
 	bool operator==(const SalStreamDescription &other) const;
 	bool operator!=(const SalStreamDescription &other) const;
+	bool sdpEqual(const SalStreamDescription &other) const;
 	belle_sdp_media_description_t *toSdpMediaDescription(const SalMediaDescription *salMediaDesc,
 	                                                     belle_sdp_session_description_t *session_desc) const;
+	void enableAvpfOfSerializedPayloads(bool capabilityNegotiation) const;
 	bool enabled() const;
 	bool isAcceptable() const;
 	void disable();
@@ -162,13 +164,13 @@ public:
 	const SalIceCandidate &getIceCandidateAtIndex(const std::size_t &idx) const;
 	const SalIceRemoteCandidate &getIceRemoteCandidateAtIndex(const std::size_t &idx) const;
 
-	void setLabel(const std::string newLabel);
+	void setLabel(const std::string &newLabel);
 	const std::string &getLabel() const;
 
-	void setContent(const std::string newContent);
+	void setContent(const std::string &newContent);
 	const std::string &getContent() const;
 
-	const cfg_map getAllCfgs() const;
+	const cfg_map &getAllCfgs() const;
 
 	void setZrtpHash(const uint8_t enable, uint8_t *zrtphash = NULL);
 
@@ -233,11 +233,133 @@ static void account_dependency_to_self(void) {
 	linphone_core_manager_destroy(marie);
 }
 
+static void lookups_with_a_lot_of_accounts(void) {
+	const int nb_accounts = 5000;
+	const char *domain = "sip.example.org";
+	LinphoneCoreManager *manager = linphone_core_manager_new("empty_rc");
+	LinphoneCore *lc = manager->lc;
+	char username[32];
+	char identity[64];
+	MSTimeSpec start;
+	int i;
+
+	liblinphone_tester_clock_start(&start);
+	for (i = 0; i < nb_accounts; i++) {
+		snprintf(username, sizeof(username), "user%d", i);
+		LinphoneAuthInfo *info = linphone_auth_info_new(username, NULL, "secret", NULL, domain, domain);
+		linphone_core_add_auth_info(lc, info);
+		linphone_auth_info_unref(info);
+	}
+	liblinphone_tester_benchmark_report(&start, "Auth info addition", nb_accounts);
+	liblinphone_tester_clock_start(&start);
+	for (i = 0; i < nb_accounts; i++) {
+		snprintf(identity, sizeof(identity), "sip:user%d@%s", i, domain);
+		LinphoneAccountParams *params = linphone_core_create_account_params(lc);
+		LinphoneAddress *address = linphone_address_new(identity);
+		linphone_account_params_set_identity_address(params, address);
+		linphone_account_params_set_server_addr(params, "sip:sip.example.org;transport=tcp");
+		linphone_account_params_set_register_enabled(params, FALSE);
+		LinphoneAccount *account = linphone_core_create_account(lc, params);
+		linphone_core_add_account(lc, account);
+		linphone_account_unref(account);
+		linphone_address_unref(address);
+		linphone_account_params_unref(params);
+	}
+	liblinphone_tester_benchmark_report(&start, "Account addition", nb_accounts);
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_core_get_auth_info_list(lc)), nb_accounts, int, "%d");
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_core_get_account_list(lc)), nb_accounts, int, "%d");
+
+	/* Challenges, as for REGISTER: by realm with and without quotes, then by domain. */
+	liblinphone_tester_clock_start(&start);
+	for (i = 0; i < nb_accounts; i++) {
+		snprintf(username, sizeof(username), "user%d", i);
+		const LinphoneAuthInfo *info = linphone_core_find_auth_info(lc, domain, username, domain);
+		if (BC_ASSERT_PTR_NOT_NULL(info)) BC_ASSERT_STRING_EQUAL(linphone_auth_info_get_username(info), username);
+		info = linphone_core_find_auth_info(lc, "\"sip.example.org\"", username, NULL);
+		if (BC_ASSERT_PTR_NOT_NULL(info)) BC_ASSERT_STRING_EQUAL(linphone_auth_info_get_username(info), username);
+		info = linphone_core_find_auth_info(lc, NULL, username, domain);
+		if (BC_ASSERT_PTR_NOT_NULL(info)) BC_ASSERT_STRING_EQUAL(linphone_auth_info_get_username(info), username);
+	}
+	BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, domain, "unknown", domain));
+	liblinphone_tester_benchmark_report(&start, "Auth info lookup for a challenge", nb_accounts * 3);
+
+	/* Incoming requests. */
+	liblinphone_tester_clock_start(&start);
+	for (i = 0; i < nb_accounts; i++) {
+		snprintf(identity, sizeof(identity), "sip:user%d@%s", i, domain);
+		LinphoneAddress *address = linphone_address_new(identity);
+		LinphoneAccount *account = linphone_core_lookup_known_account(lc, address);
+		if (BC_ASSERT_PTR_NOT_NULL(account)) {
+			BC_ASSERT_TRUE(linphone_address_weak_equal(
+			    address, linphone_account_params_get_identity_address(linphone_account_get_params(account))));
+		}
+		linphone_address_unref(address);
+	}
+	liblinphone_tester_benchmark_report(&start, "Known account lookup", nb_accounts);
+
+	/* Updates and removals are reflected by the lookups. */
+	LinphoneAuthInfo *updated = linphone_auth_info_new("user42", NULL, "new-secret", NULL, domain, domain);
+	linphone_core_add_auth_info(lc, updated);
+	linphone_auth_info_unref(updated);
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_core_get_auth_info_list(lc)), nb_accounts, int, "%d");
+	const LinphoneAuthInfo *info = linphone_core_find_auth_info(lc, domain, "user42", domain);
+	if (BC_ASSERT_PTR_NOT_NULL(info)) BC_ASSERT_STRING_EQUAL(linphone_auth_info_get_password(info), "new-secret");
+	linphone_core_remove_auth_info(lc, info);
+	BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, domain, "user42", domain));
+
+	LinphoneAddress *address = linphone_address_new("sip:user43@sip.example.org");
+	LinphoneAccount *account = linphone_core_lookup_known_account(lc, address);
+	BC_ASSERT_PTR_NOT_NULL(account);
+	if (account) {
+		linphone_core_remove_account(lc, account);
+		account = linphone_core_lookup_known_account(lc, address);
+		/* Another account of the same domain is found instead. */
+		if (BC_ASSERT_PTR_NOT_NULL(account)) {
+			BC_ASSERT_FALSE(linphone_address_weak_equal(
+			    address, linphone_account_params_get_identity_address(linphone_account_get_params(account))));
+		}
+	}
+	linphone_address_unref(address);
+
+	/* Auth infos of the list modified in place, without linphone_core_write_auth_info(), are found with their new
+	 * username, realm and domain. */
+	LinphoneAuthInfo *in_place = (LinphoneAuthInfo *)linphone_core_find_auth_info(lc, domain, "user44", domain);
+	if (BC_ASSERT_PTR_NOT_NULL(in_place)) {
+		linphone_auth_info_set_username(in_place, "renamed44");
+		BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, domain, "user44", domain));
+		BC_ASSERT_PTR_EQUAL(linphone_core_find_auth_info(lc, domain, "renamed44", domain), in_place);
+		linphone_auth_info_set_realm(in_place, "other.example.org");
+		linphone_auth_info_set_domain(in_place, "other.example.org");
+		BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, domain, "renamed44", domain));
+		BC_ASSERT_PTR_EQUAL(linphone_core_find_auth_info(lc, "other.example.org", "renamed44", NULL), in_place);
+		BC_ASSERT_PTR_EQUAL(linphone_core_find_auth_info(lc, NULL, "renamed44", "other.example.org"), in_place);
+
+		/* Once removed from the core, or once the core is destroyed, an auth info no longer updates its index. */
+		linphone_auth_info_ref(in_place);
+		linphone_core_remove_auth_info(lc, in_place);
+		linphone_auth_info_set_username(in_place, "user44");
+		BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, domain, "user44", domain));
+		/* The core keeps a clone of the added auth info. */
+		linphone_core_add_auth_info(lc, in_place);
+		linphone_auth_info_unref(in_place);
+		in_place = (LinphoneAuthInfo *)linphone_core_find_auth_info(lc, "other.example.org", "user44", NULL);
+		BC_ASSERT_PTR_NOT_NULL(in_place);
+		if (in_place) linphone_auth_info_ref(in_place);
+	}
+
+	linphone_core_manager_destroy(manager);
+	if (in_place) {
+		linphone_auth_info_set_username(in_place, "user45");
+		linphone_auth_info_unref(in_place);
+	}
+}
+
 test_t account_tests[] = {
     TEST_NO_TAG("Simple account creation", simple_account_creation),
     TEST_NO_TAG("Account dependency to self", account_dependency_to_self),
     TEST_NO_TAG("Registration state changed callback on account", registration_state_changed_callback_on_account),
-    TEST_NO_TAG("No unregister when changing transport", no_unregister_when_changing_transport)};
+    TEST_NO_TAG("No unregister when changing transport", no_unregister_when_changing_transport),
+    TEST_NO_TAG("Lookups with a lot of accounts", lookups_with_a_lot_of_accounts)};
 
 test_suite_t account_test_suite = {"Account",
                                    NULL,
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "bctoolbox/defs.h"
+
+#include "address/address.h"
+#include "liblinphone_tester.h"
+#include "tester_utils.h"
+#include "tools/tester.h"
+
+// =============================================================================
+
+using namespace std;
+
+using namespace LinphonePrivate;
+
+static int nbAddresses = 20000;
+
+// -----------------------------------------------------------------------------
+
+static void address_parse_throughput(void) {
+	vector<string> inputs;
+	for (int i = 0; i < nbAddresses; i++) {
+		inputs.push_back("sip:user" + to_string(i) + "@sip.example.org;gr=urn:uuid:6a6b4d1b-0ae2-4e59-b2b4-" +
+		                 to_string(100000000000 + i));
+	}
+
+	auto measure = [&](const char *name, const function<void(const string &)> &parse) {
+		MSTimeSpec start;
+		liblinphone_tester_clock_start(&start);
+		for (const auto &input : inputs)
+			parse(input);
+		liblinphone_tester_benchmark_report(&start, name, nbAddresses);
+	};
+
+	measure("belle-sip parser", [](const string &input) {
+		SalAddress *address = sal_address_new(input.c_str());
+		BC_ASSERT_PTR_NOT_NULL(address);
+		if (address) sal_address_unref(address);
+	});
+	measure("identity parser", [](const string &input) {
+		SalAddress *address = _linphone_address_parse_identity(input.c_str());
+		BC_ASSERT_PTR_NOT_NULL(address);
+		if (address) sal_address_unref(address);
+	});
+	measure("fast path", [](const string &input) {
+		SalAddress *address = _linphone_address_parse_sip_uri(input.c_str());
+		BC_ASSERT_PTR_NOT_NULL(address);
+		if (address) sal_address_unref(address);
+	});
+
+	Address::clearSipAddressesCache();
+	size_t capacity = _linphone_address_cache_get_capacity();
+	_linphone_address_cache_set_capacity((size_t)nbAddresses);
+	unsigned long long hits = _linphone_address_cache_get_hits();
+	measure("Address, cold cache", [](const string &input) { BC_ASSERT_TRUE(Address(input).isValid()); });
+	measure("Address, warm cache", [](const string &input) { BC_ASSERT_TRUE(Address(input).isValid()); });
+	BC_ASSERT_EQUAL(_linphone_address_cache_get_hits() - hits, (unsigned long long)nbAddresses, unsigned long long,
+	                "%llu");
+	_linphone_address_cache_set_capacity(capacity);
+	Address::clearSipAddressesCache();
+}
+
+// -----------------------------------------------------------------------------
+
+static void log_handler(int lev, const char *fmt, va_list args) {
+#ifdef _WIN32
+	vfprintf(lev == ORTP_ERROR ? stderr : stdout, fmt, args);
+	fprintf(lev == ORTP_ERROR ? stderr : stdout, "\n");
+#else
+	va_list cap;
+	va_copy(cap, args);
+	vfprintf(lev == ORTP_ERROR ? stderr : stdout, fmt, cap);
+	fprintf(lev == ORTP_ERROR ? stderr : stdout, "\n");
+	va_end(cap);
+#endif
+	bctbx_logv(BCTBX_LOG_DOMAIN, (BctbxLogLevel)lev, fmt, args);
+}
+
+static int silent_arg_func(BCTBX_UNUSED(const char *arg)) {
+	linphone_core_set_log_level(ORTP_FATAL);
+	return 0;
+}
+
+static int verbose_arg_func(BCTBX_UNUSED(const char *arg)) {
+	linphone_core_set_log_level(ORTP_MESSAGE);
+	return 0;
+}
+
+static const char *address_benchmark_helper =
+    "\t\t\t--addresses <nb_addresses> (Number of distinct addresses to parse)\n";
+
+int main(int argc, char *argv[]) {
+	int i;
+	int ret;
+
+	bctbx_init_logger(FALSE);
+	bc_tester_set_silent_func(silent_arg_func);
+	bc_tester_set_verbose_func(verbose_arg_func);
+	bc_tester_init(log_handler, ORTP_MESSAGE, ORTP_ERROR, "rcfiles");
+	linphone_core_set_log_level(ORTP_ERROR);
+
+	test_t tests[] = {TEST_NO_TAG("Address parse throughput", address_parse_throughput)};
+	test_suite_t test_suite = {"Address Benchmark",
+	                           NULL,
+	                           NULL,
+	                           liblinphone_tester_before_each,
+	                           liblinphone_tester_after_each,
+	                           sizeof(tests) / sizeof(tests[0]),
+	                           tests,
+	                           0};
+	bc_tester_add_suite(&test_suite);
+
+	for (i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--addresses") == 0) {
+			CHECK_ARG("--addresses", ++i, argc);
+			nbAddresses = atoi(argv[i]);
+		} else {
+			int bret = bc_tester_parse_args(argc, argv, i);
+			if (bret > 0) {
+				i += bret - 1;
+				continue;
+			} else if (bret < 0) {
+				bc_tester_helper(argv[0], address_benchmark_helper);
+			}
+			return bret;
+		}
+	}
+
+	if (nbAddresses < 1) {
+		bctbx_fatal("There must be at least 1 address!");
+		return -1;
+	}
+
+	ret = bc_tester_start(argv[0]);
+	bc_tester_uninit();
+	bctbx_uninit_logger();
+	return ret;
+}
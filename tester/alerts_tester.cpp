@@ -18,6 +18,16 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 #include "alert/alert.h"
 #include "call/call.h"
 #include "liblinphone_tester.h"
@@ -282,6 +292,163 @@ static void low_signal_test() {
 	alert_call_base(network_params, data);
 }
 
+#ifndef _WIN32
+// Connects to the metrics socket of the core and reads the export, while the cores keep running.
+static string scrape_metrics(LinphoneCoreManager *mgr1, LinphoneCoreManager *mgr2, const string &path) {
+	string result;
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (!BC_ASSERT_TRUE(fd >= 0)) return result;
+	if (BC_ASSERT_EQUAL(connect(fd, (struct sockaddr *)&address, sizeof(address)), 0, int, "%d")) {
+		fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+		uint64_t begin = bctbx_get_cur_time_ms();
+		while (bctbx_get_cur_time_ms() - begin < 5000) {
+			linphone_core_iterate(mgr1->lc);
+			linphone_core_iterate(mgr2->lc);
+			char buffer[4096];
+			ssize_t ret = recv(fd, buffer, sizeof(buffer), 0);
+			if (ret > 0) result.append(buffer, (size_t)ret);
+			else if (ret == 0) break;
+			else if (errno == EAGAIN || errno == EWOULDBLOCK) ms_usleep(20000);
+			else break;
+		}
+	}
+	close(fd);
+	return result;
+}
+#endif
+
+static void metrics_export_test(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_create("marie_rc");
+	LinphoneCoreManager *pauline = linphone_core_manager_create("pauline_rc");
+
+#ifndef _WIN32
+	// Not in the tester directory: the path of a Unix socket is limited to about a hundred characters.
+	char *socketPath = bctbx_strdup_printf("/tmp/linphone-metrics-%p.sock", marie);
+	linphone_config_set_string(linphone_core_get_config(marie->lc), "metrics", "export_socket", socketPath);
+#endif
+	char *filePath = bc_tester_file("metrics-export.json");
+	remove(filePath);
+	linphone_config_set_string(linphone_core_get_config(pauline->lc), "metrics", "export_file", filePath);
+	linphone_config_set_int(linphone_core_get_config(pauline->lc), "metrics", "export_interval", 1);
+	linphone_config_set_string(linphone_core_get_config(pauline->lc), "metrics", "format", "json");
+
+	linphone_core_manager_start(marie, TRUE);
+	linphone_core_manager_start(pauline, TRUE);
+
+	BC_ASSERT_TRUE(call(marie, pauline));
+	// Let the stream monitors publish their statistics a few times.
+	wait_for_until(marie->lc, pauline->lc, NULL, 0, 3000);
+
+#ifndef _WIN32
+	// A client that never reads its export must not hold the main loop, nor the other clients.
+	int stalledClient = socket(AF_UNIX, SOCK_STREAM, 0);
+	struct sockaddr_un stalledAddress;
+	memset(&stalledAddress, 0, sizeof(stalledAddress));
+	stalledAddress.sun_family = AF_UNIX;
+	strncpy(stalledAddress.sun_path, socketPath, sizeof(stalledAddress.sun_path) - 1);
+	BC_ASSERT_EQUAL(connect(stalledClient, (struct sockaddr *)&stalledAddress, sizeof(stalledAddress)), 0, int, "%d");
+	wait_for_until(marie->lc, pauline->lc, NULL, 0, 200);
+
+	string metrics = scrape_metrics(marie, pauline, socketPath);
+	BC_ASSERT_TRUE(metrics.find("# TYPE linphone_stream_jitter_ms gauge") != string::npos);
+	BC_ASSERT_TRUE(metrics.find("linphone_stream_quality_rating{") != string::npos);
+	BC_ASSERT_TRUE(metrics.find("stream=\"audio\"") != string::npos);
+	BC_ASSERT_TRUE(metrics.find("linphone_call_state_changes_total{state=\"LinphoneCallStreamsRunning\"}") !=
+	               string::npos);
+	BC_ASSERT_TRUE(metrics.find("linphone_registration_state_changes_total{state=\"LinphoneRegistrationOk\"}") !=
+	               string::npos);
+	BC_ASSERT_TRUE(metrics.find("linphone_calls 1") != string::npos);
+	close(stalledClient);
+#endif
+
+	{
+		ifstream file(filePath);
+		BC_ASSERT_TRUE(file.is_open());
+		stringstream content;
+		content << file.rdbuf();
+		BC_ASSERT_TRUE(content.str().find("{\"metrics\":[") == 0);
+		BC_ASSERT_TRUE(content.str().find("\"name\":\"linphone_stream_round_trip_delay_seconds\"") != string::npos);
+	}
+
+	end_call(marie, pauline);
+
+#ifndef _WIN32
+	// The series of the stopped streams are removed from the export.
+	metrics = scrape_metrics(marie, pauline, socketPath);
+	BC_ASSERT_TRUE(metrics.find("linphone_stream_jitter_ms") == string::npos);
+	BC_ASSERT_TRUE(metrics.find("linphone_call_state_changes_total{state=\"LinphoneCallReleased\"}") != string::npos);
+#endif
+
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+#ifndef _WIN32
+	bctbx_free(socketPath);
+#endif
+	remove(filePath);
+	bc_free(filePath);
+}
+
+static int benchmark_alert_count = 0;
+
+static void benchmark_alert_catch(BCTBX_UNUSED(LinphoneCore *core), BCTBX_UNUSED(LinphoneAlert *alert)) {
+	benchmark_alert_count++;
+}
+
+static void alert_check_benchmark(void) {
+	const int streamCount = 100;
+	const int tickCount = 1000;
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_rc");
+	LinphoneConfig *config = linphone_core_get_config(marie->lc);
+
+	// Evaluate every condition at each tick, and do not let the bandwidth of an audio call look like poor video.
+	static const char *intervals[][2] = {{"alerts::camera", "quality_sent_interval"},
+	                                     {"alerts::camera", "camera_misfunction_interval"},
+	                                     {"alerts::camera", "low_framerate_interval"},
+	                                     {"alerts::camera", "video_stalled_interval"},
+	                                     {"alerts::video", "low_quality_received_interval"},
+	                                     {"alerts::video", "download_bandwidth_interval"},
+	                                     {"alerts::network", "loss_rate_interval"},
+	                                     {"alerts::network", "remote_loss_rate_interval"},
+	                                     {"alerts::network", "lost_signal_interval"},
+	                                     {"alerts::network", "burst_occured_interval"},
+	                                     {"alerts::network", "low_signal_interval"}};
+	for (const auto &interval : intervals)
+		linphone_config_set_int(config, interval[0], interval[1], 0);
+	linphone_config_set_float(config, "alerts::video", "bandwidth_threshold", 0.0f);
+	linphone_core_enable_alerts(marie->lc, TRUE);
+
+	LinphoneCoreCbs *cbs = linphone_factory_create_core_cbs(linphone_factory_get());
+	linphone_core_cbs_set_new_alert_triggered(cbs, benchmark_alert_catch);
+	linphone_core_add_callbacks(marie->lc, cbs);
+	linphone_core_cbs_unref(cbs);
+
+	if (BC_ASSERT_TRUE(call(marie, pauline))) {
+		LinphoneCall *marieCall = linphone_core_get_current_call(marie->lc);
+		LinphoneCallStats *stats = linphone_call_get_audio_stats(marieCall);
+
+		benchmark_alert_count = 0;
+		const string name = "Alert checks of " + to_string(streamCount) + " streams";
+		MSTimeSpec start;
+		liblinphone_tester_clock_start(&start);
+		_linphone_call_run_alert_checks(marieCall, stats, streamCount, tickCount);
+		liblinphone_tester_benchmark_report(&start, name.c_str(), tickCount);
+		// Only the path where nothing is raised is measured.
+		BC_ASSERT_EQUAL(benchmark_alert_count, 0, int, "%d");
+
+		linphone_call_stats_unref(stats);
+		end_call(marie, pauline);
+	}
+
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+}
+
 test_t alerts_tests[] = {
     TEST_NO_TAG("High loss rate", high_loss_rate_test),
     TEST_NO_TAG("Low video bandwidth", low_video_bandwidth_test),
@@ -296,6 +463,8 @@ test_t alerts_tests[] = {
     TEST_NO_TAG("Signal informations", signal_information_test),
     TEST_NO_TAG("Signal update", signal_update_test),
     TEST_NO_TAG("Low signal", low_signal_test),
+    TEST_NO_TAG("Metrics export", metrics_export_test),
+    TEST_NO_TAG("Alert check benchmark", alert_check_benchmark),
 
 };
 
@@ -3464,6 +3464,121 @@ static void call_with_ack_not_sent(void) {
 	linphone_core_manager_destroy(pauline);
 }
 
+/* Offer of a caller proposing DTLS, ZRTP and SRTP with and without AVPF through potential configurations */
+static std::string build_capability_negotiation_offer(int nbStreams) {
+	std::string sdp = "v=0\r\n"
+	                  "o=caller 1 1 IN IP4 127.0.0.1\r\n"
+	                  "s=bench\r\n"
+	                  "c=IN IP4 127.0.0.1\r\n"
+	                  "t=0 0\r\n"
+	                  "a=tcap:1 UDP/TLS/RTP/SAVPF UDP/TLS/RTP/SAVP RTP/AVPF RTP/SAVPF RTP/SAVP\r\n"
+	                  "a=acap:1 setup:actpass\r\n"
+	                  "a=acap:2 fingerprint:SHA-256 "
+	                  "5E:E0:35:9E:8B:7A:B1:52:6B:BA:6D:63:2D:76:0E:48:43:34:0D:4A:BC:AE:05:28:64:93:80:E0:36:04:D1:0C\r\n"
+	                  "a=acap:3 zrtp-hash:1.10 "
+	                  "fcf2be53d1ee5cc0cc85b88de3bd1e2c1e7b4e0fa0d2e6c4b96c7d45a1b3e2f7\r\n";
+	for (int i = 0; i < nbStreams; i++) {
+		sdp += std::string("m=") + ((i == 0) ? "audio " : "video ") + std::to_string(7078 + 2 * i) + " RTP/AVP 96\r\n";
+		sdp += (i == 0) ? "a=rtpmap:96 opus/48000/2\r\n" : "a=rtpmap:96 VP8/90000\r\n";
+		sdp += "a=acap:" + std::to_string(10 + 2 * i) +
+		       " crypto:1 AES_CM_128_HMAC_SHA1_80 inline:WVNfX19zZW1jdGwgKCkgewkyMjA7fQp9CnVubGVzcyAoc2VjdXJl\r\n";
+		sdp += "a=acap:" + std::to_string(11 + 2 * i) +
+		       " crypto:2 AES_CM_128_HMAC_SHA1_32 inline:NzB4d1BINUAvLEw6UzF3WSJ+PSdFcGdUJShpX1Zj\r\n";
+		sdp += "a=pcfg:1 t=1 a=1,2\r\n";
+		sdp += "a=pcfg:2 t=2 a=1,2\r\n";
+		sdp += "a=pcfg:3 t=3 a=3\r\n";
+		sdp += "a=pcfg:4 t=4 a=" + std::to_string(10 + 2 * i) + "|" + std::to_string(11 + 2 * i) + "\r\n";
+		sdp += "a=pcfg:5 t=5 a=" + std::to_string(10 + 2 * i) + "|" + std::to_string(11 + 2 * i) + "\r\n";
+	}
+	return sdp;
+}
+
+/* Capabilities of a callee only accepting SRTP, so that most of the offered configurations have to be walked through */
+static std::string build_capability_negotiation_answerer_capabilities(int nbStreams) {
+	std::string sdp = "v=0\r\n"
+	                  "o=callee 1 1 IN IP4 127.0.0.1\r\n"
+	                  "s=bench\r\n"
+	                  "c=IN IP4 127.0.0.1\r\n"
+	                  "t=0 0\r\n"
+	                  "a=tcap:1 RTP/SAVP\r\n";
+	for (int i = 0; i < nbStreams; i++) {
+		sdp += std::string("m=") + ((i == 0) ? "audio " : "video ") + std::to_string(8078 + 2 * i) +
+		       " RTP/SAVPF 96\r\n";
+		sdp += (i == 0) ? "a=rtpmap:96 opus/48000/2\r\n" : "a=rtpmap:96 VP8/90000\r\n";
+		sdp += "a=crypto:1 AES_CM_128_HMAC_SHA1_80 inline:MTIzNDU2Nzg5QUJDREUwMTIzNDU2Nzg5QUJjZGVm\r\n";
+		sdp += "a=acap:1 crypto:1 AES_CM_128_HMAC_SHA1_80 inline:MTIzNDU2Nzg5QUJDREUwMTIzNDU2Nzg5QUJjZGVm\r\n";
+		sdp += "a=pcfg:1 t=1 a=1\r\n";
+	}
+	return sdp;
+}
+
+static void capability_negotiation_benchmark(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	MSFactory *factory = linphone_core_get_ms_factory(marie->lc);
+	const int nbStreams = 8;
+	const int nbIterations = 50;
+	MSTimeSpec start;
+
+	const auto offerText = build_capability_negotiation_offer(nbStreams);
+	auto offer = parse_sal_media_description(offerText);
+	auto localCapabilities =
+	    parse_sal_media_description(build_capability_negotiation_answerer_capabilities(nbStreams));
+	if (!BC_ASSERT_PTR_NOT_NULL(offer.get()) || !BC_ASSERT_PTR_NOT_NULL(localCapabilities.get())) {
+		linphone_core_manager_destroy(marie);
+		return;
+	}
+	BC_ASSERT_TRUE(offer->getParams().capabilityNegotiationSupported());
+	BC_ASSERT_TRUE(localCapabilities->getParams().capabilityNegotiationSupported());
+	BC_ASSERT_EQUAL(offer->getNbStreams(), (size_t)nbStreams, size_t, "%zu");
+
+	// Parsing of the potential configuration graph of every received offer
+	liblinphone_tester_clock_start(&start);
+	for (int it = 0; it < nbIterations; it++) {
+		parse_sal_media_description(offerText);
+	}
+	liblinphone_tester_benchmark_report(&start, "Capability negotiation offer parsing", nbIterations);
+
+	// Walk through the offered configurations to build the answer
+	liblinphone_tester_clock_start(&start);
+	for (int it = 0; it < nbIterations; it++) {
+		auto answer = _linphone_offer_answer_initiate_incoming(factory, localCapabilities, offer, FALSE);
+		BC_ASSERT_EQUAL(answer->getNbStreams(), offer->getNbStreams(), size_t, "%zu");
+		BC_ASSERT_EQUAL(answer->getNbActiveStreams(), nbStreams, int, "%d");
+	}
+	liblinphone_tester_benchmark_report(&start, "Capability negotiation answer", nbIterations);
+
+	// Expansion of the local potential configurations, as done every time a local offer is built
+	liblinphone_tester_clock_start(&start);
+	SalMediaDescription expanded(*offer);
+	for (int it = 0; it < nbIterations; it++) {
+		expanded = *offer;
+		for (unsigned int idx = 0; idx < (unsigned int)nbStreams; idx++) {
+			expanded.createPotentialConfigurationsForStream(idx, false, false);
+		}
+	}
+	liblinphone_tester_benchmark_report(&start, "Potential configuration expansion", nbIterations);
+
+	std::vector<SalMediaDescription::PotentialCfgCache> caches(nbStreams);
+	SalMediaDescription memoized(*offer);
+	liblinphone_tester_clock_start(&start);
+	for (int it = 0; it < nbIterations; it++) {
+		memoized = *offer;
+		for (unsigned int idx = 0; idx < (unsigned int)nbStreams; idx++) {
+			memoized.createPotentialConfigurationsForStream(idx, false, false, &caches[idx]);
+		}
+	}
+	liblinphone_tester_benchmark_report(&start, "Memoized potential configuration expansion", nbIterations);
+
+	// The memoized configurations must be the ones computed without cache
+	for (unsigned int idx = 0; idx < (unsigned int)nbStreams; idx++) {
+		BC_ASSERT_TRUE(expanded.getStreamIdx(idx).sdpEqual(memoized.getStreamIdx(idx)));
+		BC_ASSERT_EQUAL(caches[idx].getMissCount(), 1, size_t, "%zu");
+		BC_ASSERT_EQUAL(caches[idx].getHitCount(), (size_t)nbIterations - 1, size_t, "%zu");
+	}
+
+	linphone_core_manager_destroy(marie);
+}
+
 test_t capability_negotiation_tests[] = {
     TEST_NO_TAG("Call with no encryption", call_with_no_encryption),
     TEST_NO_TAG("Call with 200Ok lost", call_with_200ok_lost),
@@ -3489,7 +3604,8 @@ test_t capability_negotiation_tests[] = {
     TEST_NO_TAG("Unencrypted call with potential configuration same as actual one",
                 unencrypted_call_with_potential_configuration_same_as_actual_configuration),
     TEST_NO_TAG("Back to back call with capability negotiations on one side", back_to_back_calls_cap_neg_one_side),
-    TEST_NO_TAG("Back to back call with capability negotiations on both sides", back_to_back_calls_cap_neg_both_sides)};
+    TEST_NO_TAG("Back to back call with capability negotiations on both sides", back_to_back_calls_cap_neg_both_sides),
+    TEST_NO_TAG("Capability negotiation benchmark", capability_negotiation_benchmark)};
 
 test_t capability_negotiation_parameters_tests[] = {
     TEST_NO_TAG("Call with tcap line merge on caller", call_with_tcap_line_merge_on_caller),
@@ -680,12 +680,90 @@ static void content_public_api(void) {
 	linphone_content_unref(content);
 }
 
+static size_t count_body_storages(const list<ContentBuffer> &buffers) {
+	list<ContentBuffer> storages;
+	for (const auto &buffer : buffers) {
+		if (none_of(storages.cbegin(), storages.cend(),
+		            [&buffer](const ContentBuffer &storage) { return storage.sharesStorageWith(buffer); }))
+			storages.push_back(buffer);
+	}
+	return storages.size();
+}
+
+static void content_body_storage_sharing(void) {
+	const int iterations = 1000;
+	string text;
+	while (text.size() < 64 * 1024)
+		text += "The quick brown fox jumps over the lazy dog. ";
+	const size_t bodySize = text.size();
+
+	// Send path: the body goes through copies of the content as done by the chat message modifiers.
+	Content content;
+	content.setContentType(ContentType::PlainText);
+	content.setBodyFromUtf8(string(text));
+	const char *data = content.getBodyBuffer().data();
+
+	list<ContentBuffer> buffers;
+	buffers.push_back(content.getBodyBuffer());
+	Content copiedContent(content);
+	buffers.push_back(copiedContent.getBodyBuffer());
+	Content internalContent;
+	internalContent.setBody(copiedContent.getBodyBuffer());
+	buffers.push_back(internalContent.getBodyBuffer());
+	BC_ASSERT_EQUAL((int)count_body_storages(buffers), 1, int, "%d");
+	BC_ASSERT_PTR_EQUAL(internalContent.getBodyBuffer().data(), data);
+	BC_ASSERT_TRUE(internalContent == content);
+
+	// Slices share the storage of the whole body until an owned vector is requested.
+	ContentBuffer slice = content.getBodyBuffer().slice(10, 100);
+	BC_ASSERT_TRUE(slice.sharesStorageWith(content.getBodyBuffer()));
+	BC_ASSERT_PTR_EQUAL(slice.data(), data + 10);
+	BC_ASSERT_TRUE(slice.view() == string_view(text).substr(10, 100));
+	Content slicedContent;
+	slicedContent.setBody(slice);
+	BC_ASSERT_EQUAL((int)slicedContent.getBody().size(), 100, int, "%d");
+	BC_ASSERT_FALSE(slicedContent.getBodyBuffer().sharesStorageWith(content.getBodyBuffer()));
+
+	// Receive path: a content built from a body handler references the handler buffer.
+	SalBodyHandler *bodyHandler = Content::getBodyHandlerFromContent(internalContent);
+	BC_ASSERT_EQUAL((int)sal_body_handler_get_size(bodyHandler), (int)bodySize, int, "%d");
+	Content receivedContent(bodyHandler);
+	BC_ASSERT_PTR_EQUAL(receivedContent.getBodyBuffer().data(), sal_body_handler_get_data(bodyHandler));
+	BC_ASSERT_TRUE(receivedContent.getBodyAsUtf8String() == text);
+	BC_ASSERT_PTR_EQUAL(&receivedContent.getBodyAsUtf8String(), &receivedContent.getBodyAsUtf8String());
+	sal_body_handler_unref(bodyHandler);
+
+	size_t storages = 0;
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (int i = 0; i < iterations; i++) {
+		list<ContentBuffer> roundTripBuffers;
+		Content sent(content);
+		Content modified;
+		modified.setContentType(ContentType::PlainText);
+		modified.setBody(sent.getBodyBuffer());
+		roundTripBuffers.push_back(sent.getBodyBuffer());
+		roundTripBuffers.push_back(modified.getBodyBuffer());
+		SalBodyHandler *sbh = Content::getBodyHandlerFromContent(modified);
+		Content received(sbh);
+		Content delivered(received);
+		roundTripBuffers.push_back(received.getBodyBuffer());
+		roundTripBuffers.push_back(delivered.getBodyBuffer());
+		storages += count_body_storages(roundTripBuffers);
+		sal_body_handler_unref(sbh);
+	}
+	liblinphone_tester_benchmark_report(&start, "Content body round trip", iterations);
+	// One storage shared by the sent contents and one body handler buffer shared by the received ones.
+	BC_ASSERT_EQUAL((int)storages, 2 * iterations, int, "%d");
+}
+
 test_t contents_tests[] = {TEST_NO_TAG("Multipart to list", multipart_to_list),
                            TEST_NO_TAG("Multipart parsing", multipart_parsing),
                            TEST_NO_TAG("List to multipart", list_to_multipart),
                            TEST_NO_TAG("Content type parsing", content_type_parsing),
                            TEST_NO_TAG("Content header parsing", content_header_parsing),
-                           TEST_NO_TAG("Content C public API", content_public_api)};
+                           TEST_NO_TAG("Content C public API", content_public_api),
+                           TEST_NO_TAG("Content body storage sharing", content_body_storage_sharing)};
 
 test_suite_t contents_test_suite = {"Contents",
                                     nullptr,
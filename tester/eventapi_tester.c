@@ -571,6 +571,9 @@ static void publish_test_with_args(bool_t refresh, int expires) {
 		BC_ASSERT_TRUE(wait_for_list(lcs, &pauline->stat.number_of_LinphonePublishIncomingReceived, 2, 3000));
 		BC_ASSERT_TRUE(wait_for_list(lcs, &marie->stat.number_of_LinphonePublishOk, 2, 3000));
 		BC_ASSERT_TRUE(wait_for_list(lcs, &pauline->stat.number_of_LinphonePublishOk, 2, 3000));
+		// The refresh replaced the event of the publication, it did not clear it.
+		BC_ASSERT_EQUAL(pauline->stat.number_of_LinphonePublishCleared, 0, int, "%d");
+		BC_ASSERT_EQUAL(linphone_core_get_publication_count(pauline->lc), 1, int, "%d");
 	} else {
 	}
 
@@ -621,6 +624,7 @@ static void publish_expired(void) {
 
 	BC_ASSERT_TRUE(wait_for_list(lcs, &marie->stat.number_of_LinphonePublishOk, 1, 3000));
 	BC_ASSERT_TRUE(wait_for_list(lcs, &pauline->stat.number_of_LinphonePublishOk, 1, 3000));
+	BC_ASSERT_EQUAL(linphone_core_get_publication_count(pauline->lc), 1, int, "%d");
 
 	linphone_core_set_network_reachable(marie->lc, FALSE);
 	lcs = bctbx_list_remove(lcs, marie->lc);
@@ -630,6 +634,8 @@ static void publish_expired(void) {
 	bctbx_free(marie);
 
 	BC_ASSERT_TRUE(wait_for_list(lcs, &pauline->stat.number_of_LinphonePublishCleared, 1, 5000));
+	// The expired publication must not stay in the store.
+	BC_ASSERT_EQUAL(linphone_core_get_publication_count(pauline->lc), 0, int, "%d");
 
 	linphone_content_unref(content);
 	linphone_core_manager_destroy(pauline);
@@ -458,6 +458,101 @@ static void send_conference_invitations_error_2(void) {
 	// send_conference_invitations(TRUE, "dummy subject", 448, TRUE);
 }
 
+struct InvitationsProgress {
+	int calls = 0;
+	int sent = 0;
+	int total = 0;
+};
+
+static InvitationsProgress *get_invitations_progress(LinphoneConferenceScheduler *scheduler) {
+	LinphoneConferenceSchedulerCbs *cbs = linphone_conference_scheduler_get_current_callbacks(scheduler);
+	return static_cast<InvitationsProgress *>(linphone_conference_scheduler_cbs_get_user_data(cbs));
+}
+
+static void conference_scheduler_invitations_progress(LinphoneConferenceScheduler *scheduler, int sent, int total) {
+	InvitationsProgress *progress = get_invitations_progress(scheduler);
+	BC_ASSERT_GREATER_STRICT(sent, progress->sent, int, "%d");
+	progress->calls++;
+	progress->sent = sent;
+	progress->total = total;
+}
+
+static void conference_scheduler_invitations_sent_to_many(LinphoneConferenceScheduler *scheduler,
+                                                          const bctbx_list_t *failed_addresses) {
+	stats *stat = get_stats(linphone_conference_scheduler_get_core(scheduler));
+	stat->number_of_ConferenceSchedulerInvitationsSent++;
+	// The invitees are not registered: only check that the callback comes once everything has been dispatched.
+	InvitationsProgress *progress = get_invitations_progress(scheduler);
+	BC_ASSERT_EQUAL(progress->sent, progress->total, int, "%d");
+	BC_ASSERT_LOWER((int)bctbx_list_size(failed_addresses), progress->total, int, "%d");
+}
+
+static void send_conference_invitations_to_many_participants(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	const int nbParticipants = 1000;
+	InvitationsProgress progress;
+	char uri[64];
+
+	LinphoneConferenceInfo *conf_info = linphone_conference_info_new();
+	linphone_conference_info_set_organizer(conf_info, marie->identity);
+	for (int i = 0; i < nbParticipants; i++) {
+		snprintf(uri, sizeof(uri), "sip:invitee-%i@sip.example.org", i);
+		LinphoneAddress *participant = linphone_address_new(uri);
+		linphone_conference_info_add_participant(conf_info, participant);
+		linphone_address_unref(participant);
+	}
+	linphone_conference_info_set_duration(conf_info, 60);
+	linphone_conference_info_set_date_time(conf_info, ms_time(NULL) + 3600);
+	linphone_conference_info_set_subject(conf_info, "Webinar");
+	LinphoneAddress *conf_uri = linphone_address_new("sip:webinar@sip.linphone.org");
+	linphone_conference_info_set_uri(conf_info, conf_uri);
+
+	LinphoneConferenceScheduler *conference_scheduler = linphone_core_create_conference_scheduler(marie->lc);
+	LinphoneConferenceSchedulerCbs *cbs = linphone_factory_create_conference_scheduler_cbs(linphone_factory_get());
+	linphone_conference_scheduler_cbs_set_invitations_sent(cbs, conference_scheduler_invitations_sent_to_many);
+	linphone_conference_scheduler_cbs_set_invitations_progress(cbs, conference_scheduler_invitations_progress);
+	linphone_conference_scheduler_cbs_set_user_data(cbs, &progress);
+	linphone_conference_scheduler_add_callbacks(conference_scheduler, cbs);
+	linphone_conference_scheduler_cbs_unref(cbs);
+
+	linphone_conference_scheduler_set_info(conference_scheduler, conf_info);
+
+	LinphoneChatRoomParams *chat_room_params = linphone_core_create_default_chat_room_params(marie->lc);
+	linphone_conference_scheduler_send_invitations(conference_scheduler, chat_room_params);
+	linphone_chat_room_params_unref(chat_room_params);
+
+	// All the participants share the same sequence number: a single ICS and a single update of the database.
+	BC_ASSERT_EQUAL(_linphone_conference_scheduler_get_nb_ics_bodies_rendered(conference_scheduler), 1, unsigned int,
+	                "%u");
+	BC_ASSERT_EQUAL(_linphone_conference_scheduler_get_nb_conference_info_stored(conference_scheduler), 1,
+	                unsigned int, "%u");
+	// Only the first chunk is sent right away.
+	BC_ASSERT_EQUAL(progress.calls, 1, int, "%d");
+	BC_ASSERT_LOWER_STRICT(progress.sent, nbParticipants, int, "%d");
+	BC_ASSERT_EQUAL(progress.total, nbParticipants, int, "%d");
+
+	BC_ASSERT_TRUE(wait_for_until(marie->lc, NULL, &progress.sent, nbParticipants, 30000));
+	BC_ASSERT_GREATER_STRICT(progress.calls, 1, int, "%d");
+	BC_ASSERT_TRUE(
+	    wait_for_until(marie->lc, NULL, &marie->stat.number_of_ConferenceSchedulerInvitationsSent, 1, 60000));
+	BC_ASSERT_EQUAL(_linphone_conference_scheduler_get_nb_ics_bodies_rendered(conference_scheduler), 1, unsigned int,
+	                "%u");
+	BC_ASSERT_EQUAL(_linphone_conference_scheduler_get_nb_conference_info_stored(conference_scheduler), 1,
+	                unsigned int, "%u");
+
+	LinphoneConferenceInfo *stored_conf_info = linphone_core_find_conference_information_from_uri(marie->lc, conf_uri);
+	if (BC_ASSERT_PTR_NOT_NULL(stored_conf_info)) {
+		BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_conference_info_get_participant_infos(stored_conf_info)),
+		                nbParticipants, int, "%d");
+		linphone_conference_info_unref(stored_conf_info);
+	}
+
+	linphone_conference_scheduler_unref(conference_scheduler);
+	linphone_conference_info_unref(conf_info);
+	linphone_address_unref(conf_uri);
+	linphone_core_manager_destroy(marie);
+}
+
 test_t ics_tests[] = {
     TEST_NO_TAG("Parse minimal Ics", parse_minimal_ics),
     TEST_NO_TAG("Parse RFC example", parse_rfc_example),
@@ -468,6 +563,7 @@ test_t ics_tests[] = {
     TEST_NO_TAG("Send conference invitations error in basic chat room", send_conference_invitations_error_1),
     TEST_NO_TAG("Send conference invitations error in one-to-one encrypted chat room",
                 send_conference_invitations_error_2),
+    TEST_NO_TAG("Send conference invitations to many participants", send_conference_invitations_to_many_participants),
 };
 
 static int suite_begin(void) {
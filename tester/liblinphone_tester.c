@@ -606,6 +606,12 @@ void liblinphone_tester_add_suites(void) {
 	liblinphone_tester_add_suite_with_default_time(&call_with_rtp_bundle_test_suite, 148);
 	liblinphone_tester_add_suite_with_default_time(&shared_core_test_suite, 22);
 	liblinphone_tester_add_suite_with_default_time(&vfs_encryption_test_suite, 57);
+#ifdef HAVE_SQLITE
+	liblinphone_tester_add_suite_with_default_time(&sqlite_vfs_test_suite, 2);
+#endif
+	liblinphone_tester_add_suite_with_default_time(&stream_event_pump_test_suite, 10);
+	liblinphone_tester_add_suite_with_default_time(&publication_store_test_suite, 6);
+	liblinphone_tester_add_suite_with_default_time(&unread_chat_message_counters_test_suite, 5);
 	liblinphone_tester_add_suite_with_default_time(&external_domain_test_suite, 165);
 	liblinphone_tester_add_suite_with_default_time(&potential_configuration_graph_test_suite, 0);
 	liblinphone_tester_add_suite_with_default_time(&call_race_conditions_suite, 20);
@@ -135,6 +135,10 @@ extern test_suite_t call_with_rtp_bundle_test_suite;
 extern test_suite_t shared_core_test_suite;
 extern test_suite_t lime_server_auth_test_suite;
 extern test_suite_t vfs_encryption_test_suite;
+extern test_suite_t sqlite_vfs_test_suite;
+extern test_suite_t stream_event_pump_test_suite;
+extern test_suite_t publication_store_test_suite;
+extern test_suite_t unread_chat_message_counters_test_suite;
 extern test_suite_t local_conference_test_suite_chat_basic;
 extern test_suite_t local_conference_test_suite_chat_advanced;
 extern test_suite_t local_conference_test_suite_chat_error;
@@ -782,6 +786,15 @@ void liblinphone_tester_check_rtcp(LinphoneCoreManager *caller, LinphoneCoreMana
 void liblinphone_tester_check_rtcp_2(LinphoneCoreManager *caller, LinphoneCoreManager *callee);
 void liblinphone_tester_clock_start(MSTimeSpec *start);
 bool_t liblinphone_tester_clock_elapsed(const MSTimeSpec *start, int value_ms);
+/* Time spent since start, set by liblinphone_tester_clock_start(), in microseconds. */
+uint64_t liblinphone_tester_clock_elapsed_us(const MSTimeSpec *start);
+/*
+ * Logs the time spent since start, set by liblinphone_tester_clock_start(), by a benchmark that did the measured
+ * operation runs times, and returns it in microseconds. Benchmarks only log their timings: they never assert on them.
+ */
+uint64_t liblinphone_tester_benchmark_report(const MSTimeSpec *start, const char *name, int runs);
+/* Same log, for a benchmark that added up the time spent in its runs itself. */
+void liblinphone_tester_benchmark_log(const char *name, int runs, uint64_t elapsed_us);
 
 void linphone_core_manager_check_accounts(LinphoneCoreManager *m);
 void account_manager_destroy(void);
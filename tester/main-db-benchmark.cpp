@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "bctoolbox/defs.h"
+
+#include "address/address.h"
+#include "c-wrapper/internal/c-tools.h"
+#include "chat/chat-message/chat-message-p.h"
+#include "conference/conference-info.h"
+#include "core/core-p.h"
+#include "db/main-db.h"
+#include "event-log/events.h"
+#include "liblinphone_tester.h"
+#include "private.h"
+#include "tester_utils.h"
+#include "tools/tester.h"
+
+// =============================================================================
+
+using namespace std;
+
+using namespace LinphonePrivate;
+
+static int nbChatRooms = 20;
+static int nbParticipants = 5;
+static int nbMessages = 500;
+static int nbConferenceInfos = 5000;
+static int nbConferenceParticipants = 50;
+
+// -----------------------------------------------------------------------------
+
+class OperationStats {
+public:
+	explicit OperationStats(const char *name) : mName(name) {
+	}
+
+	template <typename Function>
+	void measure(Function &&function) {
+		MSTimeSpec start;
+		liblinphone_tester_clock_start(&start);
+		function();
+		mSamples.push_back((long long)liblinphone_tester_clock_elapsed_us(&start));
+	}
+
+	void report(const char *profile) {
+		if (mSamples.empty()) return;
+
+		long long total = 0;
+		for (long long sample : mSamples)
+			total += sample;
+		sort(mSamples.begin(), mSamples.end());
+		long long p50 = mSamples[mSamples.size() / 2];
+		long long p99 = mSamples[min(mSamples.size() - 1, mSamples.size() * 99 / 100)];
+
+		const string name = string(mName) + " (" + profile + ")";
+		liblinphone_tester_benchmark_log(name.c_str(), (int)mSamples.size(), (uint64_t)total);
+		ms_message("[Benchmark] %s: p50 %lld us, p99 %lld us", name.c_str(), p50, p99);
+	}
+
+private:
+	const char *mName;
+	vector<long long> mSamples;
+};
+
+static void main_db_benchmark(const char *profile) {
+	LinphoneCoreManager *manager = linphone_core_manager_create("empty_rc");
+	char *dbPath = bc_tester_file("maindb-benchmark.db");
+	remove(dbPath);
+	LinphoneConfig *config = linphone_core_get_config(manager->lc);
+	linphone_config_set_string(config, "storage", "uri", dbPath);
+	linphone_config_set_string(config, "storage", "durability_profile", profile);
+	linphone_core_manager_start(manager, FALSE);
+
+	shared_ptr<Core> core = manager->lc->cppPtr;
+	MainDb &mainDb = *L_GET_PRIVATE(core)->mainDb;
+	BC_ASSERT_TRUE(mainDb.isInitialized());
+	if (!mainDb.isInitialized()) goto end;
+
+	{
+		OperationStats chatRoomInsert("chat room insert");
+		OperationStats participantInsert("participant event");
+		OperationStats messageInsert("message insert");
+		OperationStats imdnUpdate("imdn state update");
+		OperationStats unreadCount("unread count");
+		OperationStats historyRange("history range");
+		OperationStats chatRoomLoad("chat room load");
+		OperationStats search("search by imdn id");
+		OperationStats messageDelete("message delete");
+
+		auto localAddress = Address::create("sip:bench@sip.example.org");
+		vector<shared_ptr<AbstractChatRoom>> chatRooms;
+		vector<vector<shared_ptr<EventLog>>> chatRoomEvents(nbChatRooms);
+
+		// Fill the database with chat rooms, their participants, messages and IMDN states.
+		time_t now = ms_time(nullptr);
+		for (int i = 0; i < nbChatRooms; i++) {
+			auto peerAddress = Address::create("sip:peer" + to_string(i) + "@sip.example.org");
+			ConferenceId conferenceId(peerAddress, localAddress);
+			chatRoomInsert.measure([&]() { chatRooms.push_back(core->getOrCreateBasicChatRoom(conferenceId)); });
+
+			for (int j = 0; j < nbParticipants; j++) {
+				auto participantAddress =
+				    Address::create("sip:participant" + to_string(j) + "-" + to_string(i) + "@sip.example.org");
+				auto event = make_shared<ConferenceParticipantEvent>(EventLog::Type::ConferenceParticipantAdded,
+				                                                     now, conferenceId, participantAddress);
+				participantInsert.measure([&]() { mainDb.addEvent(event); });
+			}
+
+			for (int j = 0; j < nbMessages; j++) {
+				auto message = chatRooms.back()->createChatMessageFromUtf8("Benchmark message " + to_string(j));
+				ChatMessagePrivate *dMessage = L_GET_PRIVATE(message);
+				bool incoming = j % 2;
+				dMessage->setDirection(incoming ? ChatMessage::Direction::Incoming : ChatMessage::Direction::Outgoing);
+				dMessage->forceFromAddress(incoming ? peerAddress : localAddress);
+				dMessage->forceToAddress(incoming ? localAddress : peerAddress);
+				dMessage->setImdnMessageId("bench-" + to_string(i) + "-" + to_string(j));
+				dMessage->setTime(now + j);
+				auto event = make_shared<ConferenceChatMessageEvent>(now + j, message);
+				messageInsert.measure([&]() { mainDb.addEvent(event); });
+				chatRoomEvents[i].push_back(event);
+
+				if (!incoming) {
+					imdnUpdate.measure([&]() {
+						mainDb.setChatMessageParticipantState(event, peerAddress,
+						                                      ChatMessage::State::DeliveredToUser, now + j);
+					});
+				}
+			}
+		}
+
+		// Read the data back.
+		for (const auto &chatRoom : chatRooms) {
+			const ConferenceId &conferenceId = chatRoom->getConferenceId();
+			unreadCount.measure([&]() { mainDb.getUnreadChatMessageCount(conferenceId); });
+			for (int begin = 0; begin < nbMessages; begin += 50)
+				historyRange.measure([&]() { mainDb.getHistoryRange(conferenceId, begin, begin + 50); });
+		}
+		for (int i = 0; i < 10; i++)
+			chatRoomLoad.measure([&]() { mainDb.getChatRooms(); });
+		for (int i = 0; i < nbChatRooms; i++) {
+			const ConferenceId &conferenceId = chatRooms[i]->getConferenceId();
+			for (int j = 0; j < nbMessages; j += 10) {
+				const string imdnMessageId = "bench-" + to_string(i) + "-" + to_string(j);
+				search.measure([&]() {
+					BC_ASSERT_EQUAL(mainDb.findChatMessages(conferenceId, imdnMessageId).size(), 1, size_t, "%zu");
+				});
+			}
+		}
+
+		// Delete the newest tenth of each conversation.
+		for (auto &events : chatRoomEvents) {
+			for (size_t j = events.size() - events.size() / 10; j < events.size(); j++)
+				messageDelete.measure([&]() { MainDb::deleteEvent(events[j]); });
+		}
+		BC_ASSERT_EQUAL(mainDb.getChatMessageCount(), nbChatRooms * (nbMessages - nbMessages / 10), int, "%d");
+
+		bc_tester_printf(ORTP_MESSAGE,
+		                 "MainDb benchmark with profile [%s]: %d chat rooms, %d participants and %d messages per chat room",
+		                 profile, nbChatRooms, nbParticipants, nbMessages);
+		for (auto *stats : {&chatRoomInsert, &participantInsert, &messageInsert, &imdnUpdate, &unreadCount,
+		                    &historyRange, &chatRoomLoad, &search, &messageDelete})
+			stats->report(profile);
+	}
+
+end:
+	linphone_core_manager_destroy(manager);
+	remove(dbPath);
+	bc_free(dbPath);
+}
+
+static void main_db_benchmark_conference_infos(void) {
+	LinphoneCoreManager *manager = linphone_core_manager_create("empty_rc");
+	char *dbPath = bc_tester_file("maindb-benchmark.db");
+	remove(dbPath);
+	LinphoneConfig *config = linphone_core_get_config(manager->lc);
+	linphone_config_set_string(config, "storage", "uri", dbPath);
+	linphone_config_set_string(config, "storage", "durability_profile", "fast");
+	linphone_core_manager_start(manager, FALSE);
+
+	shared_ptr<Core> core = manager->lc->cppPtr;
+	MainDb &mainDb = *L_GET_PRIVATE(core)->mainDb;
+	BC_ASSERT_TRUE(mainDb.isInitialized());
+	if (!mainDb.isInitialized()) goto end;
+
+	{
+		OperationStats conferenceInfoInsert("conference info insert");
+		OperationStats conferenceInfosLoad("conference infos load");
+		OperationStats localAddressLoad("local address load");
+		OperationStats uriLoad("uri load");
+
+		// Participants are taken from a pool, as in real life where the same people meet often.
+		auto organizerAddress = Address::create("sip:organizer@sip.example.org");
+		vector<shared_ptr<Address>> participantAddresses;
+		for (int i = 0; i < 4 * nbConferenceParticipants; i++)
+			participantAddresses.push_back(Address::create("sip:attendee" + to_string(i) + "@sip.example.org"));
+
+		time_t now = ms_time(nullptr);
+		for (int i = 0; i < nbConferenceInfos; i++) {
+			auto conferenceInfo = ConferenceInfo::create();
+			conferenceInfo->setOrganizer(organizerAddress);
+			for (int j = 0; j < nbConferenceParticipants; j++)
+				conferenceInfo->addParticipant(participantAddresses[(size_t)(i + j) % participantAddresses.size()]);
+			conferenceInfo->setUri(Address::create("sip:conference" + to_string(i) + "@sip.example.org"));
+			conferenceInfo->setDateTime(now + i * 60);
+			conferenceInfo->setDuration(30);
+			conferenceInfo->setUtf8Subject("Benchmark conference " + to_string(i));
+			conferenceInfoInsert.measure([&]() { mainDb.insertConferenceInfo(conferenceInfo); });
+		}
+
+		// The conference infos are no longer referenced, hence no longer cached: each load reads the database.
+		for (int i = 0; i < 5; i++) {
+			conferenceInfosLoad.measure([&]() {
+				auto conferenceInfos = mainDb.getConferenceInfos();
+				BC_ASSERT_EQUAL(conferenceInfos.size(), (size_t)nbConferenceInfos, size_t, "%zu");
+				if (!conferenceInfos.empty()) {
+					BC_ASSERT_EQUAL(conferenceInfos.front()->getParticipants().size(),
+					                (size_t)nbConferenceParticipants, size_t, "%zu");
+				}
+			});
+		}
+		for (int i = 0; i < 5; i++) {
+			localAddressLoad.measure([&]() {
+				BC_ASSERT_EQUAL(mainDb.getConferenceInfosForLocalAddress(organizerAddress).size(),
+				                (size_t)nbConferenceInfos, size_t, "%zu");
+			});
+		}
+		for (int i = 0; i < nbConferenceInfos; i += max(1, nbConferenceInfos / 100)) {
+			auto uri = Address::create("sip:conference" + to_string(i) + "@sip.example.org");
+			uriLoad.measure([&]() {
+				auto conferenceInfo = mainDb.getConferenceInfoFromURI(uri);
+				BC_ASSERT_PTR_NOT_NULL(conferenceInfo);
+				if (conferenceInfo) {
+					BC_ASSERT_EQUAL(conferenceInfo->getParticipants().size(), (size_t)nbConferenceParticipants,
+					                size_t, "%zu");
+				}
+			});
+		}
+
+		bc_tester_printf(ORTP_MESSAGE, "MainDb benchmark: %d conference infos with %d participants each",
+		                 nbConferenceInfos, nbConferenceParticipants);
+		for (auto *stats : {&conferenceInfoInsert, &conferenceInfosLoad, &localAddressLoad, &uriLoad})
+			stats->report("fast");
+	}
+
+end:
+	linphone_core_manager_destroy(manager);
+	remove(dbPath);
+	bc_free(dbPath);
+}
+
+static void main_db_benchmark_default(void) {
+	main_db_benchmark("default");
+}
+
+static void main_db_benchmark_safe(void) {
+	main_db_benchmark("safe");
+}
+
+static void main_db_benchmark_balanced(void) {
+	main_db_benchmark("balanced");
+}
+
+static void main_db_benchmark_fast(void) {
+	main_db_benchmark("fast");
+}
+
+// -----------------------------------------------------------------------------
+
+static void log_handler(int lev, const char *fmt, va_list args) {
+#ifdef _WIN32
+	vfprintf(lev == ORTP_ERROR ? stderr : stdout, fmt, args);
+	fprintf(lev == ORTP_ERROR ? stderr : stdout, "\n");
+#else
+	va_list cap;
+	va_copy(cap, args);
+	vfprintf(lev == ORTP_ERROR ? stderr : stdout, fmt, cap);
+	fprintf(lev == ORTP_ERROR ? stderr : stdout, "\n");
+	va_end(cap);
+#endif
+	bctbx_logv(BCTBX_LOG_DOMAIN, (BctbxLogLevel)lev, fmt, args);
+}
+
+static int silent_arg_func(BCTBX_UNUSED(const char *arg)) {
+	linphone_core_set_log_level(ORTP_FATAL);
+	return 0;
+}
+
+static int verbose_arg_func(BCTBX_UNUSED(const char *arg)) {
+	linphone_core_set_log_level(ORTP_MESSAGE);
+	return 0;
+}
+
+static const char *main_db_benchmark_helper =
+    "\t\t\t--chat-rooms <nb_chat_rooms> (Number of chat rooms to create)\n"
+    "\t\t\t--participants <nb_participants> (Number of participant events for each chat room)\n"
+    "\t\t\t--messages <nb_messages> (Number of messages for each chat room)\n"
+    "\t\t\t--conference-infos <nb_conference_infos> (Number of conference infos to create)\n"
+    "\t\t\t--conference-participants <nb_participants> (Number of participants for each conference info)\n";
+
+int main(int argc, char *argv[]) {
+	int i;
+	int ret;
+
+	bctbx_init_logger(FALSE);
+	bc_tester_set_silent_func(silent_arg_func);
+	bc_tester_set_verbose_func(verbose_arg_func);
+	bc_tester_init(log_handler, ORTP_MESSAGE, ORTP_ERROR, "rcfiles");
+	linphone_core_set_log_level(ORTP_ERROR);
+
+	test_t tests[] = {TEST_NO_TAG("Default profile", main_db_benchmark_default),
+	                  TEST_NO_TAG("Safe profile", main_db_benchmark_safe),
+	                  TEST_NO_TAG("Balanced profile", main_db_benchmark_balanced),
+	                  TEST_NO_TAG("Fast profile", main_db_benchmark_fast),
+	                  TEST_NO_TAG("Conference infos", main_db_benchmark_conference_infos)};
+	test_suite_t test_suite = {"MainDb Benchmark",
+	                           NULL,
+	                           NULL,
+	                           liblinphone_tester_before_each,
+	                           liblinphone_tester_after_each,
+	                           sizeof(tests) / sizeof(tests[0]),
+	                           tests,
+	                           0};
+	bc_tester_add_suite(&test_suite);
+
+	for (i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--chat-rooms") == 0) {
+			CHECK_ARG("--chat-rooms", ++i, argc);
+			nbChatRooms = atoi(argv[i]);
+		} else if (strcmp(argv[i], "--participants") == 0) {
+			CHECK_ARG("--participants", ++i, argc);
+			nbParticipants = atoi(argv[i]);
+		} else if (strcmp(argv[i], "--messages") == 0) {
+			CHECK_ARG("--messages", ++i, argc);
+			nbMessages = atoi(argv[i]);
+		} else if (strcmp(argv[i], "--conference-infos") == 0) {
+			CHECK_ARG("--conference-infos", ++i, argc);
+			nbConferenceInfos = atoi(argv[i]);
+		} else if (strcmp(argv[i], "--conference-participants") == 0) {
+			CHECK_ARG("--conference-participants", ++i, argc);
+			nbConferenceParticipants = atoi(argv[i]);
+		} else {
+			int bret = bc_tester_parse_args(argc, argv, i);
+			if (bret > 0) {
+				i += bret - 1;
+				continue;
+			} else if (bret < 0) {
+				bc_tester_helper(argv[0], main_db_benchmark_helper);
+			}
+			return bret;
+		}
+	}
+
+	if (nbChatRooms < 1 || nbMessages < 10) {
+		bctbx_fatal("There must be at least 1 chat room and 10 messages per chat room!");
+		return -1;
+	}
+	if (nbConferenceInfos < 1 || nbConferenceParticipants < 1) {
+		bctbx_fatal("There must be at least 1 conference info and 1 participant per conference info!");
+		return -1;
+	}
+
+	ret = bc_tester_start(argv[0]);
+	bc_tester_uninit();
+	bctbx_uninit_logger();
+	return ret;
+}
@@ -20,7 +20,14 @@
 
 #include "address/address.h"
 #include "c-wrapper/internal/c-tools.h"
+#include "call/call-history-cache.h"
+#include "call/call-log-iterator.h"
+#include "call/call-log.h"
+#include "chat/chat-message/chat-message-p.h"
+#include "conference/participant-info.h"
 #include "core/core-p.h"
+#include "db/internal/statements.h"
+#include "db/main-db-p.h"
 #include "db/main-db.h"
 #include "event-log/events.h"
 // TODO: Remove me.
@@ -28,6 +35,8 @@
 #include "private.h"
 #include "tools/tester.h"
 
+#include <functional>
+
 #ifndef _WIN32
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -46,11 +55,16 @@ public:
 	MainDbProvider() : MainDbProvider("db/linphone.db") {
 	}
 
-	MainDbProvider(const char *db_file) {
+	MainDbProvider(const char *db_file) : MainDbProvider(db_file, nullptr) {
+	}
+
+	// The copy of the database can be modified by prepare() before the core opens it.
+	MainDbProvider(const char *db_file, const function<void(const string &)> &prepare) {
 		mCoreManager = linphone_core_manager_create("empty_rc");
 		char *roDbPath = bc_tester_res(db_file);
 		char *rwDbPath = bc_tester_file(core_db);
 		BC_ASSERT_FALSE(liblinphone_tester_copy_file(roDbPath, rwDbPath));
+		if (prepare) prepare(rwDbPath);
 		linphone_config_set_string(linphone_core_get_config(mCoreManager->lc), "storage", "uri", rwDbPath);
 		bc_free(roDbPath);
 		bc_free(rwDbPath);
@@ -74,6 +88,10 @@ public:
 		return *L_GET_PRIVATE(mCoreManager->lc->cppPtr)->mainDb;
 	}
 
+	shared_ptr<Core> getCore() {
+		return mCoreManager->lc->cppPtr;
+	}
+
 private:
 	LinphoneCoreManager *mCoreManager;
 	const char *core_db = "linphone.db";
@@ -160,6 +178,103 @@ static void get_history(void) {
 	}
 }
 
+static void get_history_pages(void) {
+	MainDbProvider provider;
+	const MainDb &mainDb = provider.getMainDb();
+	if (mainDb.isInitialized()) {
+		ConferenceId conferenceId(Address::create("sip:test-1@sip.linphone.org")->getSharedFromThis(),
+		                          Address::create("sip:test-1@sip.linphone.org"));
+		list<shared_ptr<EventLog>> reference =
+		    mainDb.getHistoryRange(conferenceId, 0, -1, MainDb::Filter::ConferenceChatMessageFilter);
+
+		long long cursor = 0;
+		int pages = 0;
+		list<shared_ptr<EventLog>> events;
+		for (;;) {
+			list<shared_ptr<EventLog>> page =
+			    mainDb.getHistoryPage(conferenceId, cursor, 50, MainDb::Filter::ConferenceChatMessageFilter);
+			if (page.empty()) break;
+			BC_ASSERT_LOWER((int)page.size(), 50, int, "%d");
+			pages++;
+			// Pages come newest first, the range is sorted from oldest to newest.
+			for (const auto &event : page)
+				events.push_front(event);
+		}
+		BC_ASSERT_EQUAL(pages, 17, int, "%d");
+		BC_ASSERT_EQUAL((int)events.size(), 804, int, "%d");
+		BC_ASSERT_TRUE(events == reference);
+	} else {
+		BC_FAIL("Database not initialized");
+	}
+}
+
+static void call_history_iterators(void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getMainDb();
+	if (!mainDb.isInitialized()) {
+		BC_FAIL("Database not initialized");
+		return;
+	}
+	shared_ptr<Core> core = provider.getCore();
+
+	const int callCount = 250;
+	auto local = Address::create("sip:local@sip.example.org");
+	auto remote = Address::create("sip:remote@sip.example.org");
+	for (int i = 0; i < callCount; i++) {
+		auto callLog = CallLog::create(core, LinphoneCallOutgoing, local, remote);
+		callLog->setCallId("iterated-call-" + to_string(i));
+		callLog->setStatus(LinphoneCallSuccess);
+		mainDb.insertCallLog(callLog);
+	}
+	list<string> reference;
+	for (const auto &callLog : mainDb.getCallHistory())
+		reference.push_back(callLog->getCallId());
+	BC_ASSERT_EQUAL((int)reference.size(), mainDb.getCallHistorySize(), int, "%d");
+	BC_ASSERT_GREATER((int)reference.size(), callCount - 1, int, "%d");
+
+	// The pages end on a partial one, and the iterator stops after it.
+	CallLogIterator iterator(core, 64);
+	list<string> callIds;
+	while (iterator.hasNext())
+		callIds.push_back(iterator.next()->getCallId());
+	BC_ASSERT_TRUE(callIds == reference);
+	BC_ASSERT_PTR_NULL(iterator.next().get());
+	BC_ASSERT_FALSE(iterator.hasNext());
+
+	// Same walk through the C API.
+	LinphoneCallLogIterator *cIterator = linphone_core_create_call_history_iterator(core->getCCore(), 7);
+	BC_ASSERT_EQUAL(linphone_call_log_iterator_get_page_size(cIterator), 7, int, "%d");
+	callIds.clear();
+	while (linphone_call_log_iterator_has_next(cIterator)) {
+		LinphoneCallLog *callLog = linphone_call_log_iterator_next(cIterator);
+		BC_ASSERT_PTR_NOT_NULL(callLog);
+		if (callLog) callIds.push_back(linphone_call_log_get_call_id(callLog));
+	}
+	BC_ASSERT_PTR_NULL(linphone_call_log_iterator_next(cIterator));
+	linphone_call_log_iterator_unref(cIterator);
+	BC_ASSERT_TRUE(callIds == reference);
+
+	// An invalid page size falls back to the default one.
+	cIterator = linphone_core_create_call_history_iterator(core->getCCore(), 0);
+	BC_ASSERT_EQUAL(linphone_call_log_iterator_get_page_size(cIterator), CallLogIterator::DefaultPageSize, int, "%d");
+	linphone_call_log_iterator_unref(cIterator);
+
+	// The chat room history through the C event log iterator.
+	list<shared_ptr<AbstractChatRoom>> chatRooms = core->getChatRooms();
+	BC_ASSERT_FALSE(chatRooms.empty());
+	if (chatRooms.empty()) return;
+	LinphoneChatRoom *cChatRoom = L_GET_C_BACK_PTR(chatRooms.front());
+	LinphoneEventLogIterator *eventIterator = linphone_chat_room_create_history_iterator(cChatRoom, 30);
+	int nbEvents = 0;
+	while (linphone_event_log_iterator_has_next(eventIterator)) {
+		LinphoneEventLog *eventLog = linphone_event_log_iterator_next(eventIterator);
+		BC_ASSERT_EQUAL(linphone_event_log_get_type(eventLog), LinphoneEventLogTypeConferenceChatMessage, int, "%d");
+		nbEvents++;
+	}
+	linphone_event_log_iterator_unref(eventIterator);
+	BC_ASSERT_EQUAL(nbEvents, linphone_chat_room_get_history_size(cChatRoom), int, "%d");
+}
+
 static void get_conference_notified_events(void) {
 	MainDbProvider provider;
 	const MainDb &mainDb = provider.getMainDb();
@@ -410,15 +525,407 @@ static void load_chatroom_conference(void) {
 	}
 }
 
+static shared_ptr<ParticipantInfo> find_participant_info(const shared_ptr<ConferenceInfo> &conferenceInfo,
+                                                         const string &address) {
+	for (const auto &participantInfo : conferenceInfo->getParticipants())
+		if (participantInfo->getAddress()->toStringUriOnlyOrdered() == address) return participantInfo;
+	return nullptr;
+}
+
+static void migrate_legacy_conference_info(void) {
+	// The database has the events schema 1.0.22: the organizer is in table conference_info_organizer, and the
+	// parameters of the organizer and of the participants are strings.
+	MainDbProvider provider("db/chatroom_conference.db", [](const string &path) {
+		DbSession session("sqlite3://db=\"" + path + "\"");
+		BC_ASSERT_TRUE(session);
+		if (!session) return;
+		soci::session *backend = session.getBackendSession();
+		*backend << "UPDATE conference_info_organizer SET params = 'X-ROLE=listener;X-CUSTOM=organizer'";
+		*backend << "UPDATE conference_info_participant SET params = 'X-SEQ=1;X-ROLE=unknown;X-CUSTOM=laure'"
+		            " WHERE participant_sip_address_id = 6";
+		*backend << "UPDATE conference_info_participant SET params = 'X-ROLE=listener'"
+		            " WHERE participant_sip_address_id = 7";
+	});
+	MainDb &mainDb = provider.getMainDb();
+	if (!mainDb.isInitialized()) {
+		BC_FAIL("Database not initialized");
+		return;
+	}
+
+	// Nothing is left in the legacy columns and table.
+	soci::session *session = L_GET_PRIVATE(&mainDb)->dbSession.getBackendSession();
+	int legacyOrganizers = -1, legacyParams = -1;
+	*session << "SELECT COUNT(*) FROM conference_info_organizer", soci::into(legacyOrganizers);
+	*session << "SELECT COUNT(*) FROM conference_info_participant WHERE params <> ''", soci::into(legacyParams);
+	BC_ASSERT_EQUAL(legacyOrganizers, 0, int, "%d");
+	BC_ASSERT_EQUAL(legacyParams, 0, int, "%d");
+
+	list<shared_ptr<ConferenceInfo>> conferenceInfos = mainDb.getConferenceInfos();
+	BC_ASSERT_EQUAL(conferenceInfos.size(), 1, size_t, "%zu");
+	if (conferenceInfos.empty()) return;
+	const auto &conferenceInfo = conferenceInfos.front();
+
+	const auto &organizer = conferenceInfo->getOrganizer();
+	BC_ASSERT_PTR_NOT_NULL(organizer);
+	if (organizer) {
+		BC_ASSERT_STRING_EQUAL(organizer->getAddress()->toStringUriOnlyOrdered().c_str(),
+		                       "sip:marie%20laroueverte_ryaur@sip.example.org");
+		BC_ASSERT_EQUAL(organizer->getSequenceNumber(), 0, int, "%d");
+		BC_ASSERT_TRUE(organizer->getRole() == Participant::Role::Listener);
+		BC_ASSERT_STRING_EQUAL(organizer->getParameterValue("X-CUSTOM").c_str(), "organizer");
+	}
+
+	// The organizer is also a participant.
+	BC_ASSERT_EQUAL(conferenceInfo->getParticipants().size(), 5, size_t, "%zu");
+	BC_ASSERT_PTR_NOT_NULL(find_participant_info(conferenceInfo, "sip:marie%20laroueverte_ryaur@sip.example.org"));
+	auto berthe = find_participant_info(conferenceInfo, "sip:berthe_fmmz-@sip.example.org");
+	if (BC_ASSERT_PTR_NOT_NULL(berthe)) BC_ASSERT_EQUAL(berthe->getSequenceNumber(), 0, int, "%d");
+	// An unknown role used to mean a speaker.
+	auto laure = find_participant_info(conferenceInfo, "sip:laure_bl3w3@sip.example.org");
+	if (BC_ASSERT_PTR_NOT_NULL(laure)) {
+		BC_ASSERT_EQUAL(laure->getSequenceNumber(), 1, int, "%d");
+		BC_ASSERT_TRUE(laure->getRole() == Participant::Role::Speaker);
+		BC_ASSERT_STRING_EQUAL(laure->getParameterValue("X-CUSTOM").c_str(), "laure");
+	}
+	auto michelle = find_participant_info(conferenceInfo, "sip:michelle_m0pns@sip.example.org");
+	if (BC_ASSERT_PTR_NOT_NULL(michelle)) BC_ASSERT_TRUE(michelle->getRole() == Participant::Role::Listener);
+
+	BC_ASSERT_PTR_NOT_NULL(mainDb.getConferenceInfoFromURI(conferenceInfo->getUri()));
+}
+
+static void expire_a_lot_of_ephemeral_messages(void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getMainDb();
+	if (!mainDb.isInitialized()) {
+		BC_FAIL("Database not initialized");
+		return;
+	}
+
+	shared_ptr<Core> core = provider.getCore();
+	list<shared_ptr<AbstractChatRoom>> chatRooms = core->getChatRooms();
+	BC_ASSERT_FALSE(chatRooms.empty());
+	if (chatRooms.empty()) return;
+
+	const int messageCount = 50000;
+	const int storedMessageCount = mainDb.getEventCount(MainDb::ConferenceChatMessageFilter);
+	const int otherEventCount = mainDb.getEventCount() - storedMessageCount;
+	BC_ASSERT_GREATER(storedMessageCount, 0, int, "%d");
+	vector<shared_ptr<ChatMessage>> messages;
+	messages.reserve(messageCount);
+	for (const auto &chatRoom : chatRooms) {
+		for (const auto &event :
+		     mainDb.getHistoryRange(chatRoom->getConferenceId(), 0, -1, MainDb::Filter::ConferenceChatMessageFilter))
+			messages.push_back(static_pointer_cast<ConferenceChatMessageEvent>(event)->getChatMessage());
+	}
+	BC_ASSERT_EQUAL((int)messages.size(), storedMessageCount, int, "%d");
+	// Complete with messages which are not stored, they only go through the scheduler.
+	while (messages.size() < messageCount)
+		messages.push_back(chatRooms.front()->createChatMessageFromUtf8("ephemeral"));
+
+	time_t now = ms_time(NULL);
+	CorePrivate *dCore = L_GET_PRIVATE(core);
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (size_t i = 0; i < messages.size(); i++) {
+		L_GET_PRIVATE(messages[i])->setEphemeralExpireTime(now - 1 - (time_t)((i * 7919) % 3600));
+		dCore->scheduleEphemeralMessage(messages[i]);
+	}
+	liblinphone_tester_benchmark_report(&start, "Ephemeral message scheduling", messageCount);
+	liblinphone_tester_clock_start(&start);
+	dCore->handleEphemeralMessages(now);
+	liblinphone_tester_benchmark_report(&start, "Ephemeral message expiration", messageCount);
+
+	BC_ASSERT_EQUAL(mainDb.getEventCount(MainDb::ConferenceChatMessageFilter), 0, int, "%d");
+	BC_ASSERT_EQUAL(mainDb.getEventCount(), otherEventCount, int, "%d");
+	for (const auto &chatRoom : chatRooms)
+		BC_ASSERT_PTR_NULL(chatRoom->getLastChatMessageInHistory());
+}
+
+static void call_history_cache(void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getMainDb();
+	if (!mainDb.isInitialized()) {
+		BC_FAIL("Database not initialized");
+		return;
+	}
+	shared_ptr<Core> core = provider.getCore();
+
+	const int accountCount = 10;
+	const int peerCount = 200;
+	const int callCount = 100000;
+	vector<shared_ptr<Address>> accounts;
+	vector<shared_ptr<Address>> peers;
+	for (int i = 0; i < accountCount; i++)
+		accounts.push_back(Address::create("sip:account" + to_string(i) + "@sip.example.org"));
+	for (int i = 0; i < peerCount; i++)
+		peers.push_back(Address::create("sip:peer" + to_string(i) + "@sip.example.org"));
+
+	vector<shared_ptr<CallLog>> callLogs;
+	callLogs.reserve(callCount);
+	for (int i = 0; i < callCount; i++) {
+		const auto &account = accounts[i % accountCount];
+		const auto &peer = peers[(i * 7) % peerCount];
+		LinphoneCallDir direction = (i % 3) ? LinphoneCallOutgoing : LinphoneCallIncoming;
+		auto callLog = CallLog::create(core, direction, direction == LinphoneCallOutgoing ? account : peer,
+		                               direction == LinphoneCallOutgoing ? peer : account);
+		callLog->setCallId("call-" + to_string(i));
+		callLog->setStatus((i % 5) ? LinphoneCallSuccess : LinphoneCallMissed);
+		callLog->setDuration(i % 600);
+		callLog->setStartTime(1600000000 + i);
+		callLogs.push_back(callLog);
+	}
+
+	CallHistoryCache cache;
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (int i = 0; i < callCount; i++)
+		_linphone_call_history_cache_update(cache, i, callLogs[i]);
+	liblinphone_tester_benchmark_report(&start, "Call history indexing", callCount);
+	BC_ASSERT_EQUAL(cache.size(), (size_t)callCount, size_t, "%zu");
+
+	// Reference implementation: a full scan of the history, like the database queries.
+	auto scanLocal = [&](const shared_ptr<Address> &local, CallHistoryCache::Stats &stats) {
+		list<long long> ids;
+		for (int i = callCount - 1; i >= 0; i--) {
+			const auto &callLog = callLogs[i];
+			const auto &localAddress = callLog->getDirection() == LinphoneCallOutgoing ? callLog->getFromAddress()
+			                                                                            : callLog->getToAddress();
+			if (!localAddress->weakEqual(*local)) continue;
+			ids.push_back(i);
+			stats.total++;
+			if (callLog->getStatus() == LinphoneCallMissed) stats.missed++;
+			else if (callLog->getStatus() == LinphoneCallSuccess) stats.answered++;
+			stats.totalDuration += callLog->getDuration();
+			stats.lastCallTime = max(stats.lastCallTime, callLog->getStartTime());
+		}
+		return ids;
+	};
+
+	for (const auto &account : accounts) {
+		CallHistoryCache::Stats expectedStats;
+		list<long long> expectedIds = scanLocal(account, expectedStats);
+		list<long long> ids = _linphone_call_history_cache_get_ids_for_local_address(cache, account, -1);
+		CallHistoryCache::Stats stats = _linphone_call_history_cache_get_stats_for_local_address(cache, account);
+
+		BC_ASSERT_TRUE(ids == expectedIds);
+		BC_ASSERT_EQUAL(stats.total, expectedStats.total, int, "%d");
+		BC_ASSERT_EQUAL(stats.missed, expectedStats.missed, int, "%d");
+		BC_ASSERT_EQUAL(stats.answered, expectedStats.answered, int, "%d");
+		BC_ASSERT_EQUAL(stats.totalDuration, expectedStats.totalDuration, long long, "%lld");
+		BC_ASSERT_EQUAL((long long)stats.lastCallTime, (long long)expectedStats.lastCallTime, long long, "%lld");
+	}
+
+	const auto &peer = peers[42];
+	const auto &account = accounts[6];
+	list<long long> ids = _linphone_call_history_cache_get_ids(cache, peer, account, 10);
+	BC_ASSERT_EQUAL(ids.size(), 10, size_t, "%zu");
+	for (long long id : ids) {
+		const auto &callLog = callLogs[(size_t)id];
+		bool outgoing = callLog->getDirection() == LinphoneCallOutgoing;
+		BC_ASSERT_TRUE((outgoing ? callLog->getFromAddress() : callLog->getToAddress())->weakEqual(*account));
+		BC_ASSERT_TRUE((outgoing ? callLog->getToAddress() : callLog->getFromAddress())->weakEqual(*peer));
+	}
+	BC_ASSERT_EQUAL(_linphone_call_history_cache_find_id(cache, "call-1234", -1), 1234, long long, "%lld");
+	BC_ASSERT_EQUAL(_linphone_call_history_cache_find_id(cache, "call-1234", 10), -1, long long, "%lld");
+	BC_ASSERT_EQUAL(_linphone_call_history_cache_get_last_outgoing_call_id(cache), callCount - 1, long long, "%lld");
+
+	// Remove and update calls, the indexes and the statistics must stay coherent with a full scan.
+	for (int i = callCount - 1; i >= 0; i -= 4) {
+		_linphone_call_history_cache_remove(cache, i);
+		callLogs[i]->setFromAddress(peers[0]);
+		callLogs[i]->setToAddress(peers[1]);
+	}
+	for (int i = 0; i < callCount; i += 9) {
+		callLogs[i]->setStatus(LinphoneCallMissed);
+		callLogs[i]->setDuration(0);
+		_linphone_call_history_cache_update(cache, i, callLogs[i]);
+	}
+	for (const auto &account : accounts) {
+		CallHistoryCache::Stats expectedStats;
+		BC_ASSERT_TRUE(_linphone_call_history_cache_get_ids_for_local_address(cache, account, -1) ==
+		               scanLocal(account, expectedStats));
+		CallHistoryCache::Stats stats = _linphone_call_history_cache_get_stats_for_local_address(cache, account);
+		BC_ASSERT_EQUAL(stats.total, expectedStats.total, int, "%d");
+		BC_ASSERT_EQUAL(stats.missed, expectedStats.missed, int, "%d");
+		BC_ASSERT_EQUAL(stats.totalDuration, expectedStats.totalDuration, long long, "%lld");
+		BC_ASSERT_EQUAL((long long)stats.lastCallTime, (long long)expectedStats.lastCallTime, long long, "%lld");
+	}
+
+
+	// The cache kept by the database follows its writes.
+	auto local = Address::create("sip:local@sip.example.org");
+	auto remote = Address::create("sip:remote@sip.example.org");
+
+	int historySize = mainDb.getCallHistorySize();
+	for (int i = 0; i < 3; i++) {
+		auto callLog = CallLog::create(core, LinphoneCallOutgoing, local, remote);
+		callLog->setCallId("db-call-" + to_string(i));
+		callLog->setStatus(LinphoneCallSuccess);
+		callLog->setDuration(10);
+		mainDb.insertCallLog(callLog);
+	}
+	BC_ASSERT_EQUAL(mainDb.getCallHistorySize(), historySize + 3, int, "%d");
+	BC_ASSERT_EQUAL(mainDb.getCallStatsForLocalAddress(local).total, 3, int, "%d");
+	BC_ASSERT_EQUAL(mainDb.getCallStatsForPeerAddress(remote).totalDuration, 30, long long, "%lld");
+	BC_ASSERT_EQUAL(mainDb.getCallHistory(remote, local).size(), 3, size_t, "%zu");
+	CallHistoryCache::Stats localStats = mainDb.getCallStatsForLocalAddress(local);
+	BC_ASSERT_EQUAL(localStats.answered, 3, int, "%d");
+	BC_ASSERT_EQUAL(localStats.missed, 0, int, "%d");
+	BC_ASSERT_EQUAL(localStats.totalDuration, 30, long long, "%lld");
+
+	// Domains are matched case-insensitively, like the LIKE match of the former queries did.
+	auto mixedCaseLocal = Address::create("sip:local@SIP.Example.org");
+	BC_ASSERT_EQUAL(mainDb.getCallHistoryForLocalAddress(mixedCaseLocal).size(), 3, size_t, "%zu");
+	BC_ASSERT_EQUAL(mainDb.getCallHistory(remote, mixedCaseLocal).size(), 3, size_t, "%zu");
+	BC_ASSERT_EQUAL(mainDb.getCallStatsForLocalAddress(mixedCaseLocal).total, 3, int, "%d");
+
+	// Addresses are matched on their username and domain, where the former queries used a LIKE '%uri%' match:
+	// parameters and ports of the stored addresses are still ignored, but a longer domain no longer matches.
+	auto gruu = Address::create("sip:local@sip.example.org:5060;gr=urn:uuid:5e2e2f6c-0d3a-4b7e-8a1f-3c1b2e9d7f10");
+	auto longerDomain = Address::create("sip:local@sip.example.org.example.com");
+	auto missedCallLog = CallLog::create(core, LinphoneCallIncoming, remote, gruu);
+	missedCallLog->setCallId("db-call-gruu");
+	missedCallLog->setStatus(LinphoneCallMissed);
+	mainDb.insertCallLog(missedCallLog);
+	auto otherCallLog = CallLog::create(core, LinphoneCallOutgoing, longerDomain, remote);
+	otherCallLog->setCallId("db-call-longer-domain");
+	otherCallLog->setStatus(LinphoneCallSuccess);
+	mainDb.insertCallLog(otherCallLog);
+	BC_ASSERT_EQUAL(mainDb.getCallHistoryForLocalAddress(local).size(), 4, size_t, "%zu");
+	BC_ASSERT_EQUAL(mainDb.getCallHistory(remote, local).size(), 4, size_t, "%zu");
+	BC_ASSERT_EQUAL(mainDb.getCallHistoryForLocalAddress(longerDomain).size(), 1, size_t, "%zu");
+	BC_ASSERT_EQUAL(mainDb.getCallStatsForLocalAddress(local).missed, 1, int, "%d");
+	mainDb.deleteCallLog(missedCallLog);
+	mainDb.deleteCallLog(otherCallLog);
+
+	auto callLog = mainDb.getCallLog("db-call-1", -1);
+	BC_ASSERT_PTR_NOT_NULL(callLog);
+	if (callLog) mainDb.deleteCallLog(callLog);
+	BC_ASSERT_PTR_NULL(mainDb.getCallLog("db-call-1", -1));
+	BC_ASSERT_EQUAL(mainDb.getCallStatsForLocalAddress(local).total, 2, int, "%d");
+	BC_ASSERT_EQUAL(mainDb.getCallHistoryForLocalAddress(local).size(), 2, size_t, "%zu");
+	BC_ASSERT_EQUAL(mainDb.getCallHistorySize(), historySize + 2, int, "%d");
+
+	mainDb.deleteCallHistoryForLocalAddress(local);
+	BC_ASSERT_EQUAL(mainDb.getCallStatsForLocalAddress(local).total, 0, int, "%d");
+	BC_ASSERT_EQUAL(mainDb.getCallHistorySize(), historySize, int, "%d");
+}
+
+static void prepared_statement_cache(void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getMainDb();
+	if (!mainDb.isInitialized()) {
+		BC_FAIL("Database not initialized");
+		return;
+	}
+
+	list<shared_ptr<AbstractChatRoom>> chatRooms = provider.getCore()->getChatRooms();
+	BC_ASSERT_FALSE(chatRooms.empty());
+	if (chatRooms.empty()) return;
+	const ConferenceId &conferenceId = chatRooms.front()->getConferenceId();
+	const string sipAddress = conferenceId.getPeerAddress()->toStringUriOnlyOrdered();
+
+	DbSession &dbSession = L_GET_PRIVATE(&mainDb)->dbSession;
+	const string selectSipAddressId = Statements::get(Statements::SelectSipAddressId);
+	const int iterations = 20000;
+	const int historyIterations = 500;
+
+	auto run = [&](bool cacheEnabled, long long &sipAddressId, size_t &historySize) {
+		dbSession.enableStatementCache(cacheEnabled);
+		MSTimeSpec start;
+		liblinphone_tester_clock_start(&start);
+		for (int i = 0; i < iterations; i++) {
+			sipAddressId = -1;
+			BC_ASSERT_TRUE(dbSession.execute(selectSipAddressId, soci::use(sipAddress), soci::into(sipAddressId)));
+		}
+		for (int i = 0; i < historyIterations; i++)
+			historySize = mainDb.getHistoryRange(conferenceId, 10, 30).size();
+		liblinphone_tester_benchmark_report(&start,
+		                                    cacheEnabled ? "Hot queries with the prepared statement cache"
+		                                                 : "Hot queries without the prepared statement cache",
+		                                    iterations + historyIterations);
+	};
+
+	long long uncachedSipAddressId, cachedSipAddressId;
+	size_t uncachedHistorySize, cachedHistorySize;
+	run(false, uncachedSipAddressId, uncachedHistorySize);
+	BC_ASSERT_EQUAL(dbSession.getStatementCacheSize(), 0, size_t, "%zu");
+	run(true, cachedSipAddressId, cachedHistorySize);
+	BC_ASSERT_GREATER(dbSession.getStatementCacheSize(), 1, size_t, "%zu");
+
+	// Same results whether statements are prepared again or not.
+	BC_ASSERT_EQUAL(cachedSipAddressId, uncachedSipAddressId, long long, "%lld");
+	BC_ASSERT_EQUAL(cachedHistorySize, uncachedHistorySize, size_t, "%zu");
+
+	// A lookup of an unknown address must not be given the result of the previous one.
+	long long unknownSipAddressId = -1;
+	BC_ASSERT_FALSE(dbSession.execute(selectSipAddressId, soci::use(string("sip:unknown@sip.example.org")),
+	                                  soci::into(unknownSipAddressId)));
+	BC_ASSERT_EQUAL(unknownSipAddressId, -1, long long, "%lld");
+}
+
+static void prepared_statement_cache_concurrent_write(void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getMainDb();
+	if (!mainDb.isInitialized()) {
+		BC_FAIL("Database not initialized");
+		return;
+	}
+
+	list<shared_ptr<AbstractChatRoom>> chatRooms = provider.getCore()->getChatRooms();
+	BC_ASSERT_FALSE(chatRooms.empty());
+	if (chatRooms.empty()) return;
+	const string sipAddress = chatRooms.front()->getConferenceId().getPeerAddress()->toStringUriOnlyOrdered();
+
+	DbSession &dbSession = L_GET_PRIVATE(&mainDb)->dbSession;
+	dbSession.enableStatementCache(true);
+	const string selectSipAddressId = Statements::get(Statements::SelectSipAddressId);
+	long long sipAddressId = -1;
+	BC_ASSERT_TRUE(dbSession.execute(selectSipAddressId, soci::use(sipAddress), soci::into(sipAddressId)));
+	BC_ASSERT_GREATER(dbSession.getStatementCacheSize(), 0, size_t, "%zu");
+
+	// Another connection, as the one of an app extension, must be able to write at once after the cached lookup.
+	char *dbPath = bc_tester_file("linphone.db");
+	DbSession writer(string("sqlite3://db=\"") + dbPath + "\" timeout=1");
+	bc_free(dbPath);
+	BC_ASSERT_TRUE(writer);
+	if (!writer) return;
+
+	const string newSipAddress = "sip:second-connection@sip.example.org";
+	int busy = -1, walFrames = -1, checkpointedFrames = -1;
+	try {
+		*writer.getBackendSession() << "INSERT INTO sip_address (value) VALUES (:value)", soci::use(newSipAddress);
+		// In WAL mode, the checkpoint is only complete once no reader holds an older snapshot of the database.
+		*writer.getBackendSession() << "PRAGMA wal_checkpoint(TRUNCATE)", soci::into(busy), soci::into(walFrames),
+		    soci::into(checkpointedFrames);
+	} catch (const exception &e) {
+		BC_FAIL(e.what());
+	}
+	BC_ASSERT_EQUAL(busy, 0, int, "%d");
+
+	// And the cached statement reads the new state of the database, not the snapshot of its previous execution.
+	long long newSipAddressId = -1;
+	BC_ASSERT_TRUE(dbSession.execute(selectSipAddressId, soci::use(newSipAddress), soci::into(newSipAddressId)));
+	BC_ASSERT_NOT_EQUAL(newSipAddressId, -1, long long, "%lld");
+}
+
 test_t main_db_tests[] = {TEST_NO_TAG("Get events count", get_events_count),
                           TEST_NO_TAG("Get messages count", get_messages_count),
                           TEST_NO_TAG("Get unread messages count", get_unread_messages_count),
                           TEST_NO_TAG("Get history", get_history),
+                          TEST_NO_TAG("Get history pages", get_history_pages),
+                          TEST_NO_TAG("Call history iterators", call_history_iterators),
                           TEST_NO_TAG("Get conference events", get_conference_notified_events),
                           TEST_NO_TAG("Get chat rooms", get_chat_rooms),
                           TEST_NO_TAG("Set/get conference info", set_get_conference_info),
                           TEST_NO_TAG("Load a lot of chatrooms", load_a_lot_of_chatrooms),
-                          TEST_NO_TAG("Load chatroom and conference", load_chatroom_conference)};
+                          TEST_NO_TAG("Load chatroom and conference", load_chatroom_conference),
+                          TEST_NO_TAG("Migrate legacy conference info", migrate_legacy_conference_info),
+                          TEST_NO_TAG("Expire a lot of ephemeral messages", expire_a_lot_of_ephemeral_messages),
+                          TEST_NO_TAG("Call history cache", call_history_cache),
+                          TEST_NO_TAG("Prepared statement cache", prepared_statement_cache),
+                          TEST_NO_TAG("Prepared statement cache and concurrent write",
+                                      prepared_statement_cache_concurrent_write)};
 
 test_suite_t main_db_test_suite = {"MainDb",
                                    NULL,
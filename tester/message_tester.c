@@ -481,6 +481,66 @@ static void create_two_basic_chat_room_with_same_remote(void) {
 	linphone_core_manager_destroy(pauline);
 }
 
+static void search_chat_room_among_many_basic_chat_rooms(void) {
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
+	const int nbChatRooms = 3000;
+	const int nbSearches = 300;
+	LinphoneChatRoom *chat_room;
+	char uri[64];
+	int found = 0;
+	int i;
+
+	LinphoneChatRoomParams *chat_room_params = linphone_core_create_default_chat_room_params(pauline->lc);
+	linphone_chat_room_params_set_backend(chat_room_params, LinphoneChatRoomBackendBasic);
+	linphone_chat_room_params_enable_encryption(chat_room_params, FALSE);
+	linphone_chat_room_params_enable_group(chat_room_params, FALSE);
+	for (i = 0; i < nbChatRooms; i++) {
+		snprintf(uri, sizeof(uri), "sip:contact-%i@sip.example.org", i);
+		LinphoneAddress *remote = linphone_address_new(uri);
+		bctbx_list_t *participants = bctbx_list_append(NULL, remote);
+		chat_room = linphone_core_create_chat_room_6(pauline->lc, chat_room_params, pauline->identity, participants);
+		BC_ASSERT_PTR_NOT_NULL(chat_room);
+		if (chat_room) linphone_chat_room_unref(chat_room);
+		bctbx_list_free_with_data(participants, (bctbx_list_free_func)linphone_address_unref);
+	}
+
+	// Look up the chat rooms of a batch of recipients, as when dispatching invitations.
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (i = 0; i < nbSearches; i++) {
+		snprintf(uri, sizeof(uri), "sip:contact-%i@sip.example.org", (i * 7) % nbChatRooms);
+		LinphoneAddress *remote = linphone_address_new(uri);
+		chat_room = linphone_core_search_chat_room(pauline->lc, NULL, pauline->identity, remote, NULL);
+		if (chat_room && linphone_address_weak_equal(linphone_chat_room_get_peer_address(chat_room), remote)) found++;
+		linphone_address_unref(remote);
+	}
+	liblinphone_tester_benchmark_report(&start, "Chat room search among many basic chat rooms", nbSearches);
+	BC_ASSERT_EQUAL(found, nbSearches, int, "%d");
+
+	// By participant, and for unknown peers.
+	LinphoneAddress *remote = linphone_address_new("sip:contact-42@sip.example.org");
+	bctbx_list_t *participants = bctbx_list_append(NULL, remote);
+	chat_room = linphone_core_search_chat_room(pauline->lc, chat_room_params, pauline->identity, NULL, participants);
+	if (BC_ASSERT_PTR_NOT_NULL(chat_room)) {
+		BC_ASSERT_TRUE(linphone_address_weak_equal(linphone_chat_room_get_peer_address(chat_room), remote));
+	}
+	bctbx_list_free_with_data(participants, (bctbx_list_free_func)linphone_address_unref);
+	remote = linphone_address_new("sip:unknown@sip.example.org");
+	BC_ASSERT_PTR_NULL(linphone_core_search_chat_room(pauline->lc, NULL, pauline->identity, remote, NULL));
+
+	// Deleted chat rooms are not found anymore.
+	linphone_address_set_username(remote, "contact-7");
+	chat_room = linphone_core_search_chat_room(pauline->lc, NULL, pauline->identity, remote, NULL);
+	if (BC_ASSERT_PTR_NOT_NULL(chat_room)) {
+		linphone_core_delete_chat_room(pauline->lc, chat_room);
+		BC_ASSERT_PTR_NULL(linphone_core_search_chat_room(pauline->lc, NULL, pauline->identity, remote, NULL));
+	}
+	linphone_address_unref(remote);
+
+	linphone_chat_room_params_unref(chat_room_params);
+	linphone_core_manager_destroy(pauline);
+}
+
 static void text_message(void) {
 	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
 	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
@@ -3722,6 +3782,19 @@ void im_encryption_engine_b64_async(void) {
 	im_encryption_engine_b64_base(TRUE);
 }
 
+typedef struct {
+	int nb_changes;
+	int last_count;
+} unread_count_changes_t;
+
+static void unread_chat_message_count_changed(LinphoneCore *lc, BCTBX_UNUSED(const LinphoneAddress *local_address),
+                                              int count) {
+	unread_count_changes_t *changes =
+	    (unread_count_changes_t *)linphone_core_cbs_get_user_data(linphone_core_get_current_callbacks(lc));
+	changes->nb_changes++;
+	changes->last_count = count;
+}
+
 void unread_message_count_base(bool_t mute_chat_room) {
 	if (!linphone_factory_is_database_storage_available(linphone_factory_get())) {
 		ms_warning("Test skipped, database storage is not available");
@@ -3731,7 +3804,16 @@ void unread_message_count_base(bool_t mute_chat_room) {
 	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
 	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
 
+	unread_count_changes_t changes = {0, 0};
+	LinphoneCoreCbs *cbs = linphone_factory_create_core_cbs(linphone_factory_get());
+	linphone_core_cbs_set_unread_chat_message_count_changed(cbs, unread_chat_message_count_changed);
+	linphone_core_cbs_set_user_data(cbs, &changes);
+	linphone_core_add_callbacks(marie->lc, cbs);
+
 	text_message_base(marie, pauline);
+	// The totals of a main loop iteration are notified once, after the message is stored.
+	BC_ASSERT_TRUE(wait_for_until(marie->lc, pauline->lc, &changes.nb_changes, 1, 5000));
+	BC_ASSERT_EQUAL(changes.last_count, 1, int, "%d");
 
 	BC_ASSERT_PTR_NOT_NULL(marie->stat.last_received_chat_message);
 	if (marie->stat.last_received_chat_message != NULL) {
@@ -3777,8 +3859,16 @@ void unread_message_count_base(bool_t mute_chat_room) {
 		BC_ASSERT_EQUAL(linphone_core_get_unread_chat_message_count_from_local(
 		                    marie->lc, linphone_chat_room_get_local_address(marie_room)),
 		                0, int, "%d");
+
+		// Muting and marking as read in the same main loop iteration give a single change.
+		BC_ASSERT_TRUE(wait_for_until(marie->lc, pauline->lc, &changes.nb_changes, 2, 5000));
+		wait_for_until(marie->lc, pauline->lc, NULL, 0, 200);
+		BC_ASSERT_EQUAL(changes.nb_changes, 2, int, "%d");
+		BC_ASSERT_EQUAL(changes.last_count, 0, int, "%d");
 	}
 
+	linphone_core_remove_callbacks(marie->lc, cbs);
+	linphone_core_cbs_unref(cbs);
 	linphone_core_manager_destroy(marie);
 	linphone_core_manager_destroy(pauline);
 }
@@ -3923,6 +4013,7 @@ static void received_messages_with_aggregation_enabled(void) {
 test_t message_tests[] = {
     TEST_NO_TAG("File transfer content", file_transfer_content),
     TEST_NO_TAG("Create two basic chat rooms with same remote", create_two_basic_chat_room_with_same_remote),
+    TEST_NO_TAG("Search chat room among many basic chat rooms", search_chat_room_among_many_basic_chat_rooms),
     TEST_NO_TAG("Text message", text_message),
     TEST_NO_TAG("Text forward message", text_forward_message),
     TEST_NO_TAG("Text forward message with CPIM enabled with backward compat",
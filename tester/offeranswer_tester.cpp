@@ -1215,9 +1215,333 @@ end:
 
 #endif
 
+/* SDP of a conference server offering one thumbnail video stream per participant, all in one bundle if requested. */
+static std::string build_multi_stream_sdp(int nbParticipants, bool bundled = false) {
+	std::string sdp = "v=0\r\n"
+	                  "o=bench 1 1 IN IP4 127.0.0.1\r\n"
+	                  "s=bench\r\n"
+	                  "c=IN IP4 127.0.0.1\r\n"
+	                  "t=0 0\r\n";
+	if (bundled) {
+		sdp += "a=group:BUNDLE as";
+		for (int i = 0; i < nbParticipants; i++)
+			sdp += " vs" + std::to_string(i);
+		sdp += "\r\n";
+	}
+	sdp += "m=audio 7078 RTP/AVP 0\r\n"
+	       "a=rtpmap:0 PCMU/8000\r\n";
+	if (bundled) sdp += "a=mid:as\r\n";
+	for (int i = 0; i < nbParticipants; i++) {
+		sdp += "m=video " + std::to_string(9078 + 2 * i) + " RTP/AVP 96\r\n";
+		sdp += "a=rtpmap:96 VP8/90000\r\n";
+		sdp += "a=content:thumbnail\r\n";
+		sdp += "a=label:dev" + std::to_string(i) + "\r\n";
+		if (bundled) sdp += "a=mid:vs" + std::to_string(i) + "\r\n";
+		sdp += "a=sendrecv\r\n";
+	}
+	return sdp;
+}
+
+static void offer_answer_with_many_streams_benchmark(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	MSFactory *factory = linphone_core_get_ms_factory(marie->lc);
+	const int nbParticipants = 200;
+	const int nbIterations = 20;
+	MSTimeSpec start;
+
+	auto offer = parse_sal_media_description(build_multi_stream_sdp(nbParticipants));
+	auto localCapabilities = parse_sal_media_description(build_multi_stream_sdp(nbParticipants));
+	if (BC_ASSERT_PTR_NOT_NULL(offer.get()) && BC_ASSERT_PTR_NOT_NULL(localCapabilities.get())) {
+		BC_ASSERT_EQUAL(offer->getNbStreams(), (size_t)nbParticipants + 1, size_t, "%zu");
+
+		// One lookup per participant, as done when building a conference SDP.
+		const std::string content("thumbnail");
+		std::vector<std::string> labels;
+		for (int i = 0; i < nbParticipants; i++)
+			labels.push_back("dev" + std::to_string(i));
+
+		int nbMismatches = 0;
+		liblinphone_tester_clock_start(&start);
+		for (int it = 0; it < nbIterations; it++) {
+			for (const auto &label : labels) {
+				if (offer->findIdxStreamWithContent(content, label) < 0) nbMismatches++;
+			}
+		}
+		liblinphone_tester_benchmark_report(&start, "Linear stream lookups of a 201 stream SDP", nbIterations);
+
+		// The index must find the same streams as the linear lookups.
+		const auto checkIndex = offer->buildStreamIndex();
+		for (const auto &label : labels) {
+			if (checkIndex.findIdxStreamWithContent(content, label) != offer->findIdxStreamWithContent(content, label))
+				nbMismatches++;
+		}
+
+		liblinphone_tester_clock_start(&start);
+		for (int it = 0; it < nbIterations; it++) {
+			const auto index = offer->buildStreamIndex();
+			for (const auto &label : labels) {
+				if (index.findIdxStreamWithContent(content, label) < 0) nbMismatches++;
+			}
+		}
+		liblinphone_tester_benchmark_report(&start, "Indexed stream lookups of a 201 stream SDP", nbIterations);
+		BC_ASSERT_EQUAL(nbMismatches, 0, int, "%d");
+		BC_ASSERT_EQUAL(offer->findIdxBestStream(SalVideo), 1, int, "%d");
+
+		liblinphone_tester_clock_start(&start);
+		for (int it = 0; it < nbIterations; it++) {
+			auto answer = _linphone_offer_answer_initiate_incoming(factory, localCapabilities, offer, FALSE);
+			BC_ASSERT_EQUAL(answer->getNbStreams(), offer->getNbStreams(), size_t, "%zu");
+		}
+		liblinphone_tester_benchmark_report(&start, "Answer to a 201 stream offer", nbIterations);
+	}
+
+	// With bundles, every stream of the offer and of the answer looks up the owner of its transport.
+	offer = parse_sal_media_description(build_multi_stream_sdp(nbParticipants, true));
+	localCapabilities = parse_sal_media_description(build_multi_stream_sdp(nbParticipants, true));
+	if (BC_ASSERT_PTR_NOT_NULL(offer.get()) && BC_ASSERT_PTR_NOT_NULL(localCapabilities.get())) {
+		localCapabilities->accept_bundles = true;
+
+		// The index must find the same transport owners as the linear lookups.
+		const auto index = offer->buildStreamIndex();
+		int nbMismatches = 0;
+		for (const auto &stream : offer->streams) {
+			if (index.getIndexOfTransportOwner(stream) != offer->getIndexOfTransportOwner(stream)) nbMismatches++;
+		}
+		BC_ASSERT_EQUAL(nbMismatches, 0, int, "%d");
+		BC_ASSERT_EQUAL(index.getIndexOfTransportOwner(offer->streams.back()), 0, int, "%d");
+
+		liblinphone_tester_clock_start(&start);
+		for (int it = 0; it < nbIterations; it++) {
+			auto answer = _linphone_offer_answer_initiate_incoming(factory, localCapabilities, offer, FALSE);
+			BC_ASSERT_EQUAL(answer->getNbStreams(), offer->getNbStreams(), size_t, "%zu");
+			const auto answerIndex = answer->buildStreamIndex();
+			for (const auto &stream : answer->streams) {
+				if (answerIndex.getIndexOfTransportOwner(stream) != answer->getIndexOfTransportOwner(stream))
+					nbMismatches++;
+			}
+		}
+		liblinphone_tester_benchmark_report(&start, "Answer to a 201 stream bundled offer", nbIterations);
+		BC_ASSERT_EQUAL(nbMismatches, 0, int, "%d");
+	}
+
+	linphone_core_manager_destroy(marie);
+}
+
+static std::string media_description_to_sdp_text(const std::shared_ptr<SalMediaDescription> &md) {
+	belle_sdp_session_description_t *sdp = md->toSdp();
+	belle_sip_object_ref(sdp);
+	char *str = belle_sip_object_to_string(sdp);
+	belle_sip_object_unref(sdp);
+	std::string text(str ? str : "");
+	bctbx_free(str);
+	return text;
+}
+
+/* Cost of the SDP of a re-INVITE sent when a participant joins a conference, for a growing number of streams. */
+static void incremental_sdp_generation_benchmark(void) {
+	const int nbIterations = 20;
+	MSTimeSpec start;
+
+	for (int nbParticipants : {25, 50, 100, 200}) {
+		auto before = parse_sal_media_description(build_multi_stream_sdp(nbParticipants));
+		auto after = parse_sal_media_description(build_multi_stream_sdp(nbParticipants + 1));
+		if (!BC_ASSERT_PTR_NOT_NULL(before.get()) || !BC_ASSERT_PTR_NOT_NULL(after.get())) return;
+
+		// The incremental generation must produce the same text as the full one.
+		SalMediaDescription::SdpSectionCache cache;
+		std::string sdp;
+		BC_ASSERT_TRUE(before->toSdpText(cache, sdp));
+		BC_ASSERT_STRING_EQUAL(sdp.c_str(), media_description_to_sdp_text(before).c_str());
+		BC_ASSERT_EQUAL(cache.getReusedSectionCount(), 0, size_t, "%zu");
+		BC_ASSERT_TRUE(after->toSdpText(cache, sdp));
+		BC_ASSERT_STRING_EQUAL(sdp.c_str(), media_description_to_sdp_text(after).c_str());
+		BC_ASSERT_EQUAL(cache.getReusedSectionCount(), (size_t)nbParticipants + 1, size_t, "%zu");
+
+		const std::string name = "SDP generation with " + std::to_string(nbParticipants + 2) + " streams";
+		liblinphone_tester_clock_start(&start);
+		for (int it = 0; it < nbIterations; it++) {
+			media_description_to_sdp_text(after);
+		}
+		liblinphone_tester_benchmark_report(&start, (name + ", full").c_str(), nbIterations);
+
+		// Alternate between both descriptions so that every generation has a participant joining or leaving.
+		liblinphone_tester_clock_start(&start);
+		for (int it = 0; it < nbIterations; it++) {
+			after->toSdpText(cache, sdp);
+			before->toSdpText(cache, sdp);
+		}
+		liblinphone_tester_benchmark_report(&start, (name + ", incremental").c_str(), 2 * nbIterations);
+	}
+}
+
+/*
+ * SDP mixing AVPF, SRTP and SAVPF streams, all with ICE candidates. The ICE password of the stream at index
+ * renewedIdx differs from the other ones.
+ */
+static std::string build_avpf_ice_srtp_sdp(int nbStreams, int renewedIdx) {
+	std::string sdp = "v=0\r\n"
+	                  "o=bench 1 1 IN IP4 127.0.0.1\r\n"
+	                  "s=bench\r\n"
+	                  "c=IN IP4 127.0.0.1\r\n"
+	                  "t=0 0\r\n";
+	for (int i = 0; i < nbStreams; i++) {
+		const auto port = std::to_string(7078 + 2 * i);
+		switch (i % 3) {
+			case 0:
+				sdp += "m=video " + port + " RTP/AVPF 96\r\n";
+				break;
+			case 1:
+				sdp += "m=audio " + port + " RTP/SAVP 96\r\n";
+				break;
+			default:
+				sdp += "m=video " + port + " RTP/SAVPF 96\r\n";
+				break;
+		}
+		sdp += (i % 3 == 1) ? "a=rtpmap:96 opus/48000/2\r\n" : "a=rtpmap:96 VP8/90000\r\n";
+		if (i % 3 != 0) {
+			sdp += "a=crypto:1 AES_CM_128_HMAC_SHA1_80 inline:MTIzNDU2Nzg5QUJDREUwMTIzNDU2Nzg5QUJjZGVm\r\n";
+		}
+		if (i % 3 != 1) {
+			sdp += "a=rtcp-fb:* trr-int 3000\r\n";
+			sdp += "a=rtcp-fb:96 nack pli\r\n";
+			sdp += "a=rtcp-fb:96 ccm fir\r\n";
+		}
+		sdp += "a=ice-ufrag:uf" + std::to_string(i) + "\r\n";
+		sdp += std::string("a=ice-pwd:") + ((i == renewedIdx) ? "renewedpassword" : "initialpassword") + "\r\n";
+		sdp += "a=candidate:1 1 UDP 2130706431 127.0.0.1 " + port + " typ host\r\n";
+		sdp += "a=candidate:2 1 UDP 1694498815 192.0.2.1 " + port + " typ srflx raddr 127.0.0.1 rport " + port +
+		       "\r\n";
+	}
+	return sdp;
+}
+
+/*
+ * Local descriptions are built from payload types on which the serialization enables AVPF, so that flag must not
+ * prevent sections from being reused, and it must be set on the payload types of reused sections as well.
+ */
+static void clear_avpf_flags(const std::shared_ptr<SalMediaDescription> &md) {
+	for (const auto &stream : md->streams) {
+		for (const auto &pt : stream.getActualConfiguration().getPayloads()) {
+			payload_type_unset_flag(pt, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
+		}
+	}
+}
+
+static bool_t avpf_flags_set(const std::shared_ptr<SalMediaDescription> &md) {
+	for (const auto &stream : md->streams) {
+		if (!stream.getActualConfiguration().hasAvpf()) continue;
+		for (const auto &pt : stream.getActualConfiguration().getPayloads()) {
+			if (!(payload_type_get_flags(pt) & PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED)) return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+static void incremental_sdp_generation_with_avpf_ice_and_srtp(void) {
+	const int nbStreams = 12;
+	const int renewedIdx = 4;
+	const auto initialText = build_avpf_ice_srtp_sdp(nbStreams, -1);
+	auto initial = parse_sal_media_description(initialText);
+	auto unchanged = parse_sal_media_description(initialText);
+	auto renewed = parse_sal_media_description(build_avpf_ice_srtp_sdp(nbStreams, renewedIdx));
+	if (!BC_ASSERT_PTR_NOT_NULL(initial.get()) || !BC_ASSERT_PTR_NOT_NULL(unchanged.get()) ||
+	    !BC_ASSERT_PTR_NOT_NULL(renewed.get()))
+		return;
+	BC_ASSERT_EQUAL(initial->getNbStreams(), (size_t)nbStreams, size_t, "%zu");
+	for (const auto &md : {initial, unchanged, renewed})
+		clear_avpf_flags(md);
+
+	SalMediaDescription::SdpSectionCache cache;
+	std::string sdp;
+	BC_ASSERT_TRUE(initial->toSdpText(cache, sdp));
+	BC_ASSERT_EQUAL(cache.getReusedSectionCount(), 0, size_t, "%zu");
+	BC_ASSERT_STRING_EQUAL(sdp.c_str(), media_description_to_sdp_text(initial).c_str());
+
+	// Same streams in a new description: every section is reused, AVPF ones included.
+	BC_ASSERT_TRUE(unchanged->toSdpText(cache, sdp));
+	BC_ASSERT_EQUAL(cache.getReusedSectionCount(), (size_t)nbStreams, size_t, "%zu");
+	BC_ASSERT_TRUE(avpf_flags_set(unchanged));
+	BC_ASSERT_STRING_EQUAL(sdp.c_str(), media_description_to_sdp_text(unchanged).c_str());
+
+	// Only the stream whose ICE credentials changed is serialized again.
+	BC_ASSERT_TRUE(renewed->toSdpText(cache, sdp));
+	BC_ASSERT_EQUAL(cache.getReusedSectionCount(), (size_t)nbStreams - 1, size_t, "%zu");
+	BC_ASSERT_TRUE(avpf_flags_set(renewed));
+	BC_ASSERT_STRING_EQUAL(sdp.c_str(), media_description_to_sdp_text(renewed).c_str());
+	BC_ASSERT_PTR_NOT_NULL(strstr(sdp.c_str(), "a=ice-pwd:renewedpassword"));
+}
+
+/* Call whose offers and answers reuse the sections of unchanged streams, with AVPF, SRTP and ICE. */
+static void call_with_incremental_sdp(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_create("marie_rc");
+	LinphoneCoreManager *pauline = linphone_core_manager_create("pauline_tcp_rc");
+	LinphoneCall *marie_call, *pauline_call;
+
+	for (LinphoneCoreManager *m : {marie, pauline}) {
+		linphone_config_set_int(linphone_core_get_config(m->lc), "sip", "incremental_sdp", 1);
+		linphone_core_manager_start(m, TRUE);
+		linphone_core_set_media_encryption(m->lc, LinphoneMediaEncryptionSRTP);
+
+		LinphoneAccount *account = linphone_core_get_default_account(m->lc);
+		LinphoneAccountParams *account_params = linphone_account_params_clone(linphone_account_get_params(account));
+		LinphoneNatPolicy *nat_policy = linphone_core_create_nat_policy(m->lc);
+		linphone_nat_policy_enable_ice(nat_policy, TRUE);
+		linphone_account_params_set_nat_policy(account_params, nat_policy);
+		linphone_account_params_set_avpf_mode(account_params, LinphoneAVPFEnabled);
+		linphone_account_set_params(account, account_params);
+		linphone_account_params_unref(account_params);
+		linphone_nat_policy_unref(nat_policy);
+	}
+
+	if (!BC_ASSERT_TRUE(call(marie, pauline))) goto end;
+	marie_call = linphone_core_get_current_call(marie->lc);
+	pauline_call = linphone_core_get_current_call(pauline->lc);
+	BC_ASSERT_TRUE(check_ice(marie, pauline, LinphoneIceStateHostConnection));
+
+	// Re-INVITEs with unchanged streams, then with the audio stream paused
+	for (int i = 0; i < 3; i++) {
+		int marieStreamsRunning = marie->stat.number_of_LinphoneCallStreamsRunning;
+		int paulineStreamsRunning = pauline->stat.number_of_LinphoneCallStreamsRunning;
+		if (i < 2) {
+			LinphoneCallParams *params = linphone_core_create_call_params(marie->lc, marie_call);
+			linphone_call_update(marie_call, params);
+			linphone_call_params_unref(params);
+		} else {
+			linphone_call_pause(marie_call);
+			BC_ASSERT_TRUE(wait_for(marie->lc, pauline->lc, &marie->stat.number_of_LinphoneCallPaused, 1));
+			BC_ASSERT_TRUE(wait_for(marie->lc, pauline->lc, &pauline->stat.number_of_LinphoneCallPausedByRemote, 1));
+			linphone_call_resume(marie_call);
+		}
+		BC_ASSERT_TRUE(wait_for(marie->lc, pauline->lc, &marie->stat.number_of_LinphoneCallStreamsRunning,
+		                        marieStreamsRunning + 1));
+		BC_ASSERT_TRUE(wait_for(marie->lc, pauline->lc, &pauline->stat.number_of_LinphoneCallStreamsRunning,
+		                        paulineStreamsRunning + 1));
+
+		for (LinphoneCall *c : {marie_call, pauline_call}) {
+			const LinphoneCallParams *params = linphone_call_get_current_params(c);
+			BC_ASSERT_EQUAL(linphone_call_params_get_media_encryption(params), LinphoneMediaEncryptionSRTP, int,
+			                "%d");
+			BC_ASSERT_TRUE(linphone_call_params_avpf_enabled(params));
+			BC_ASSERT_STRING_EQUAL(linphone_call_params_get_rtp_profile(params), "RTP/SAVPF");
+		}
+		BC_ASSERT_TRUE(check_ice(marie, pauline, LinphoneIceStateHostConnection));
+	}
+	liblinphone_tester_check_rtcp(marie, pauline);
+	end_call(marie, pauline);
+
+end:
+	linphone_core_manager_destroy(pauline);
+	linphone_core_manager_destroy(marie);
+}
+
 static test_t offeranswer_tests[] = {
     TEST_NO_TAG("Start with no config", start_with_no_config),
     TEST_NO_TAG("Call failed because of codecs", call_failed_because_of_codecs),
+    TEST_NO_TAG("Offer answer with many streams benchmark", offer_answer_with_many_streams_benchmark),
+    TEST_NO_TAG("Incremental SDP generation benchmark", incremental_sdp_generation_benchmark),
+    TEST_NO_TAG("Incremental SDP generation with AVPF, ICE and SRTP",
+                incremental_sdp_generation_with_avpf_ice_and_srtp),
+    TEST_ONE_TAG("Call with incremental SDP", call_with_incremental_sdp, "ICE"),
     TEST_NO_TAG("Simple call with different codec mappings and config-supplied sdp address",
                 simple_call_with_different_codec_mappings_and_config_supplied_sdp_addresses),
     TEST_NO_TAG("Simple call with fmtps", simple_call_with_fmtps),
@@ -1650,6 +1650,50 @@ static void publish_with_expires(void) {
 	simple_publish_with_expire(2);
 }
 
+static void publish_only_changed_presence(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	LinphoneCoreCbs *cbs = linphone_factory_create_core_cbs(linphone_factory_get());
+	int changes = 0;
+	int i;
+
+	linphone_core_cbs_set_publish_state_changed(cbs, linphone_publish_state_changed);
+	_linphone_core_add_callbacks(marie->lc, cbs, TRUE);
+	linphone_core_cbs_unref(cbs);
+	linphone_config_set_bool(linphone_core_get_config(marie->lc), "sip", "publish_presence_only_when_changed", TRUE);
+
+	/* Going online enables the publication. */
+	linphone_core_set_consolidated_presence(marie->lc, LinphoneConsolidatedPresenceOnline);
+	BC_ASSERT_TRUE(wait_for(marie->lc, marie->lc, &marie->stat.number_of_LinphonePublishOutgoingProgress, 1));
+	BC_ASSERT_TRUE(wait_for(marie->lc, marie->lc, &marie->stat.number_of_LinphonePublishOk, 1));
+
+	/* Toggle between new presence models: only those that change the document are serialized and published, each
+	 * document built is sent. */
+	for (i = 0; i < 10000; i++) {
+		bool_t busy = (i / 1000) % 2 == 1;
+		if (i % 1000 == 0 && i > 0) changes++;
+		linphone_core_set_consolidated_presence(marie->lc, busy ? LinphoneConsolidatedPresenceBusy
+		                                                        : LinphoneConsolidatedPresenceOnline);
+		if (i % 1000 == 0) {
+			BC_ASSERT_TRUE(wait_for(marie->lc, marie->lc, &marie->stat.number_of_LinphonePublishOk, 1 + changes));
+		} else if (i % 100 == 0) {
+			linphone_core_iterate(marie->lc);
+		}
+	}
+	BC_ASSERT_FALSE(wait_for_until(marie->lc, marie->lc, &marie->stat.number_of_LinphonePublishOutgoingProgress,
+	                               2 + changes, 1000));
+	BC_ASSERT_EQUAL(marie->stat.number_of_LinphonePublishOutgoingProgress, 1 + changes, int, "%i");
+	ms_message("10000 presence updates with %d changes: %d presence documents published", changes,
+	           marie->stat.number_of_LinphonePublishOutgoingProgress - 1);
+
+	/* By default, the same presence is published again, with a new document. */
+	linphone_config_set_bool(linphone_core_get_config(marie->lc), "sip", "publish_presence_only_when_changed", FALSE);
+	linphone_core_set_consolidated_presence(marie->lc, LinphoneConsolidatedPresenceBusy);
+	BC_ASSERT_TRUE(
+	    wait_for(marie->lc, marie->lc, &marie->stat.number_of_LinphonePublishOutgoingProgress, 2 + changes));
+
+	linphone_core_manager_destroy(marie);
+}
+
 static void publish_with_expire_timestamp_refresh_base(bool_t refresh_timestamps,
                                                        bool_t each_friend_subscribes_to_the_other) {
 	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
@@ -2616,6 +2660,7 @@ test_t presence_server_tests[] = {
     TEST_NO_TAG("Simple Publish", simple_publish),
     TEST_NO_TAG("Publish with 2 identities", publish_with_dual_identity),
     TEST_NO_TAG("Simple Publish with expires", publish_with_expires),
+    TEST_NO_TAG("Publish only changed presence", publish_only_changed_presence),
     TEST_ONE_TAG(
         "Publish presence refresher without updated timestamps", publish_without_expire_timestamp_refresh, "presence"),
     TEST_ONE_TAG(
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "event/publication-store.h"
+#include "liblinphone_tester.h"
+#include "tester_utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+using namespace LinphonePrivate;
+
+static PublicationStore::Publication make_publication(
+    const string &eTag, const string &entity, const string &event, const string &body, uint64_t expiresAt) {
+	PublicationStore::Publication publication;
+	publication.eTag = eTag;
+	publication.entity = entity;
+	publication.event = event;
+	publication.contentType = "application/pidf+xml";
+	publication.body = body;
+	publication.expiresAt = expiresAt;
+	return publication;
+}
+
+static void indexes_and_composition(void) {
+	PublicationStore store;
+	int nbCompositions = 0;
+	string lastComposition;
+	store.setComposeHandler([&](const string &entity, const string &event,
+	                            const vector<const PublicationStore::Publication *> &publications) {
+		nbCompositions++;
+		lastComposition = entity + " " + event + " " + to_string(publications.size());
+	});
+
+	BC_ASSERT_TRUE(store.put(make_publication("a", "sip:marie@sip.example.org", "presence", "open", 1000)));
+	BC_ASSERT_TRUE(store.put(make_publication("b", "sip:marie@sip.example.org", "presence", "closed", 2000)));
+	BC_ASSERT_TRUE(store.put(make_publication("c", "sip:marie@sip.example.org", "dialog", "idle", 3000)));
+	BC_ASSERT_TRUE(store.put(make_publication("d", "sip:pauline@sip.example.org", "presence", "open", 4000)));
+	BC_ASSERT_EQUAL(nbCompositions, 4, int, "%d");
+	BC_ASSERT_STRING_EQUAL(lastComposition.c_str(), "sip:pauline@sip.example.org presence 1");
+	BC_ASSERT_EQUAL((int)store.findByEntity("sip:marie@sip.example.org").size(), 3, int, "%d");
+	BC_ASSERT_EQUAL((int)store.findByEntity("sip:marie@sip.example.org", "presence").size(), 2, int, "%d");
+	BC_ASSERT_EQUAL((int)store.findByEvent("presence").size(), 3, int, "%d");
+
+	// A refresh without body changes the ETag and the expiry, but keeps the state: nothing to compose.
+	BC_ASSERT_TRUE(store.put(make_publication("a2", "sip:marie@sip.example.org", "presence", "", 5000), "a", false));
+	BC_ASSERT_EQUAL(nbCompositions, 4, int, "%d");
+	BC_ASSERT_PTR_NULL(store.find("a"));
+	const PublicationStore::Publication *refreshed = store.find("a2");
+	BC_ASSERT_PTR_NOT_NULL(refreshed);
+	if (refreshed) BC_ASSERT_STRING_EQUAL(refreshed->body.c_str(), "open");
+	BC_ASSERT_EQUAL((int)store.size(), 4, int, "%d");
+
+	// The expiry of "a" is outdated and must be ignored.
+	store.removeExpired(2500);
+	BC_ASSERT_PTR_NOT_NULL(store.find("a2"));
+	BC_ASSERT_PTR_NULL(store.find("b"));
+	BC_ASSERT_EQUAL(nbCompositions, 5, int, "%d");
+	BC_ASSERT_STRING_EQUAL(lastComposition.c_str(), "sip:marie@sip.example.org presence 1");
+
+	store.remove("c");
+	BC_ASSERT_STRING_EQUAL(lastComposition.c_str(), "sip:marie@sip.example.org dialog 0");
+	BC_ASSERT_EQUAL((int)store.findByEvent("dialog").size(), 0, int, "%d");
+	store.removeExpired(10000);
+	BC_ASSERT_TRUE(store.empty());
+	BC_ASSERT_EQUAL((int)store.getStats().bytes, 0, int, "%d");
+	BC_ASSERT_EQUAL((int)store.getStats().expired, 3, int, "%d");
+	BC_ASSERT_EQUAL((int)store.getStats().removed, 1, int, "%d");
+	BC_ASSERT_EQUAL((int)store.getStats().refreshed, 1, int, "%d");
+}
+
+static void limits(void) {
+	PublicationStore store;
+	store.setLimits(2, 64 * 1024);
+	BC_ASSERT_TRUE(store.put(make_publication("a", "sip:marie@sip.example.org", "presence", "open", 1000)));
+	BC_ASSERT_TRUE(store.put(make_publication("b", "sip:pauline@sip.example.org", "presence", "open", 1000)));
+	BC_ASSERT_FALSE(store.accepts("", 4));
+	BC_ASSERT_FALSE(store.put(make_publication("c", "sip:laure@sip.example.org", "presence", "open", 1000)));
+	// Replacing a publication does not need more room.
+	BC_ASSERT_TRUE(store.accepts("a", 6));
+	BC_ASSERT_TRUE(store.put(make_publication("a2", "sip:marie@sip.example.org", "presence", "closed", 1000), "a"));
+	// Neither the count nor the memory can be exceeded.
+	BC_ASSERT_FALSE(store.accepts("a2", 128 * 1024));
+	string hugeBody(128 * 1024, 'x');
+	BC_ASSERT_FALSE(store.put(make_publication("a3", "sip:marie@sip.example.org", "presence", hugeBody, 1000), "a2"));
+	BC_ASSERT_PTR_NOT_NULL(store.find("a2"));
+	BC_ASSERT_EQUAL((int)store.getStats().rejected, 4, int, "%d");
+	BC_ASSERT_TRUE(store.getStats().bytes <= 64 * 1024);
+}
+
+static void publishers_stress(void) {
+	const int nbPublishers = 50000;
+	const uint64_t duration = 2 * 3600 * 1000;
+	const uint64_t step = 10000;
+	PublicationStore store;
+	store.setLimits((size_t)nbPublishers, 256 * 1024 * 1024);
+	unsigned long long nbCompositions = 0;
+	store.setComposeHandler([&](const string &, const string &, const vector<const PublicationStore::Publication *> &) {
+		nbCompositions++;
+	});
+
+	// Each publisher publishes with a random lifetime, then either refreshes, unpublishes or disappears.
+	struct Publisher {
+		string eTag;
+		uint64_t expiresAt = 0;
+		uint64_t nextAction = 0;
+		int generation = 0;
+	};
+	mt19937 random(4242);
+	uniform_int_distribution<int> lifetimes(1, 3600);
+	uniform_int_distribution<int> actions(0, 9);
+	vector<Publisher> publishers((size_t)nbPublishers);
+	unordered_map<string, size_t> alive;
+	for (size_t i = 0; i < publishers.size(); i++)
+		publishers[i].nextAction = (uint64_t)(random() % 60000);
+
+	int nbErrors = 0;
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (uint64_t now = 0; now < duration; now += step) {
+		for (size_t i = 0; i < publishers.size(); i++) {
+			Publisher &publisher = publishers[i];
+			if (publisher.nextAction > now) continue;
+			int action = actions(random);
+			bool published = !publisher.eTag.empty() && store.find(publisher.eTag);
+			if (published && action == 0) {
+				store.remove(publisher.eTag);
+				alive.erase(publisher.eTag);
+				publisher.eTag.clear();
+			} else if (!published || action < 7) {
+				string eTag = to_string(i) + "-" + to_string(publisher.generation++);
+				uint64_t expiresAt = now + (uint64_t)lifetimes(random) * 1000;
+				string entity = "sip:user" + to_string(i % 10000) + "@sip.example.org";
+				const char *event = (i % 3) ? "presence" : "dialog";
+				bool hasBody = action < 4 || !published;
+				if (!store.put(make_publication(eTag, entity, event, "<presence/>", expiresAt),
+				               published ? publisher.eTag : string(), hasBody))
+					nbErrors++;
+				if (published) alive.erase(publisher.eTag);
+				alive[eTag] = i;
+				publisher.eTag = eTag;
+				publisher.expiresAt = expiresAt;
+			}
+			// Otherwise the publisher disappears and lets its publication expire.
+			publisher.nextAction = now + (uint64_t)lifetimes(random) * 1000;
+		}
+		store.removeExpired(now);
+		for (auto it = alive.begin(); it != alive.end();) {
+			if (publishers[it->second].expiresAt <= now) {
+				if (store.find(it->first)) nbErrors++;
+				it = alive.erase(it);
+			} else ++it;
+		}
+		if (store.size() != alive.size()) nbErrors++;
+	}
+	liblinphone_tester_benchmark_report(&start, "Publishers step of 10 simulated s", (int)(duration / step));
+
+	const auto &stats = store.getStats();
+	BC_ASSERT_EQUAL(nbErrors, 0, int, "%d");
+	BC_ASSERT_GREATER((int)stats.expired, 0, int, "%d");
+	BC_ASSERT_GREATER((int)stats.refreshed, 0, int, "%d");
+	BC_ASSERT_GREATER((int)stats.removed, 0, int, "%d");
+	bc_tester_printf(ORTP_MESSAGE,
+	                 "%d publishers for %d simulated s: %llu added, %llu refreshed, %llu removed, %llu expired, "
+	                 "%llu compositions, %zu publications left using %zu bytes",
+	                 nbPublishers, (int)(duration / 1000), stats.added, stats.refreshed, stats.removed, stats.expired,
+	                 nbCompositions, store.size(), stats.bytes);
+
+	store.removeExpired(duration + 3600 * 1000);
+	BC_ASSERT_TRUE(store.empty());
+	BC_ASSERT_EQUAL((int)stats.bytes, 0, int, "%d");
+}
+
+test_t publication_store_tests[] = {TEST_NO_TAG("Indexes and composition", indexes_and_composition),
+                                    TEST_NO_TAG("Limits", limits),
+                                    TEST_NO_TAG("Publishers stress", publishers_stress)};
+
+test_suite_t publication_store_test_suite = {"Publication store",
+                                             NULL,
+                                             NULL,
+                                             liblinphone_tester_before_each,
+                                             liblinphone_tester_after_each,
+                                             sizeof(publication_store_tests) / sizeof(publication_store_tests[0]),
+                                             publication_store_tests,
+                                             0};
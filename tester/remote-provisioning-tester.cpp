@@ -18,6 +18,21 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #include "bctoolbox/defs.h"
 
 #include "c-wrapper/c-wrapper.h"
@@ -443,6 +458,217 @@ static void remote_provisioning_check_push_params(void) {
 	linphone_core_manager_destroy(marie);
 }
 
+#ifndef _WIN32
+/*
+ * Minimal HTTP/1.1 server on the loopback interface, standing in for a provisioning server that supports conditional
+ * requests. Connections are kept alive, as the belle-sip HTTP provider reuses them.
+ */
+class ProvisioningHttpServer {
+public:
+	ProvisioningHttpServer() {
+		mListenSocket = socket(AF_INET, SOCK_STREAM, 0);
+		struct sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		addr.sin_port = 0;
+		socklen_t addrLen = sizeof(addr);
+		if (bind(mListenSocket, (struct sockaddr *)&addr, sizeof(addr)) == 0 && listen(mListenSocket, 8) == 0 &&
+		    getsockname(mListenSocket, (struct sockaddr *)&addr, &addrLen) == 0) {
+			mPort = ntohs(addr.sin_port);
+			mThread = std::thread(&ProvisioningHttpServer::run, this);
+		}
+	}
+
+	~ProvisioningHttpServer() {
+		mStop = true;
+		if (mThread.joinable()) mThread.join();
+		close(mListenSocket);
+	}
+
+	std::string getUri() const {
+		return "http://127.0.0.1:" + std::to_string(mPort) + "/provisioning";
+	}
+
+	void setContent(const std::string &body, const std::string &etag) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mBody = body;
+		mEtag = etag;
+	}
+
+	// Behave as a server without conditional request support: the content is always sent.
+	void ignoreValidators(bool ignore) {
+		mIgnoreValidators = ignore;
+	}
+
+	int getRequestCount() const {
+		return mRequestCount;
+	}
+
+	int getNotModifiedCount() const {
+		return mNotModifiedCount;
+	}
+
+	std::string getLastIfNoneMatch() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mLastIfNoneMatch;
+	}
+
+private:
+	struct Connection {
+		int fd;
+		std::string buffer;
+	};
+
+	static std::string getHeader(const std::string &request, const std::string &name) {
+		std::string lowerRequest = request;
+		for (auto &c : lowerRequest)
+			c = (char)tolower(c);
+		size_t pos = lowerRequest.find("\r\n" + name + ":");
+		if (pos == std::string::npos) return std::string();
+		pos += name.size() + 3;
+		size_t end = request.find("\r\n", pos);
+		while (pos < end && request[pos] == ' ')
+			pos++;
+		return request.substr(pos, end - pos);
+	}
+
+	std::string answer(const std::string &request) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mRequestCount++;
+		mLastIfNoneMatch = getHeader(request, "if-none-match");
+		if (!mIgnoreValidators && !mLastIfNoneMatch.empty() && mLastIfNoneMatch == mEtag) {
+			mNotModifiedCount++;
+			return "HTTP/1.1 304 Not Modified\r\nETag: " + mEtag + "\r\nContent-Length: 0\r\n\r\n";
+		}
+		return "HTTP/1.1 200 OK\r\nContent-Type: text/xml\r\nETag: " + mEtag +
+		       "\r\nContent-Length: " + std::to_string(mBody.size()) + "\r\n\r\n" + mBody;
+	}
+
+	void run() {
+		std::vector<Connection> connections;
+		while (!mStop) {
+			std::vector<struct pollfd> fds(1 + connections.size());
+			fds[0] = {mListenSocket, POLLIN, 0};
+			for (size_t i = 0; i < connections.size(); i++)
+				fds[i + 1] = {connections[i].fd, POLLIN, 0};
+			if (poll(fds.data(), fds.size(), 50) <= 0) continue;
+
+			for (size_t i = connections.size(); i > 0; i--) {
+				if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+				Connection &connection = connections[i - 1];
+				char data[4096];
+				ssize_t size = recv(connection.fd, data, sizeof(data), 0);
+				if (size <= 0) {
+					close(connection.fd);
+					connections.erase(connections.begin() + (long)(i - 1));
+					continue;
+				}
+				connection.buffer.append(data, (size_t)size);
+				// The provisioning requests are GETs, without body.
+				size_t end;
+				while ((end = connection.buffer.find("\r\n\r\n")) != std::string::npos) {
+					std::string response = answer(connection.buffer.substr(0, end + 2));
+					connection.buffer.erase(0, end + 4);
+					send(connection.fd, response.data(), response.size(), 0);
+				}
+			}
+			if (fds[0].revents & POLLIN) {
+				int fd = accept(mListenSocket, NULL, NULL);
+				if (fd >= 0) connections.push_back({fd, std::string()});
+			}
+		}
+		for (auto &connection : connections)
+			close(connection.fd);
+	}
+
+	int mListenSocket = -1;
+	int mPort = 0;
+	std::thread mThread;
+	std::atomic<bool> mStop{false};
+	std::atomic<bool> mIgnoreValidators{false};
+	std::mutex mMutex;
+	std::string mBody;
+	std::string mEtag;
+	std::string mLastIfNoneMatch;
+	std::atomic<int> mRequestCount{0};
+	std::atomic<int> mNotModifiedCount{0};
+};
+
+static std::string provisioning_xml(const char *value) {
+	return std::string("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	                   "<config xmlns=\"http://www.linphone.org/xsds/lpconfig.xsd\" "
+	                   "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+	                   "xsi:schemaLocation=\"http://www.linphone.org/xsds/lpconfig.xsd lpconfig.xsd\">\n"
+	                   "  <section name=\"app\">\n"
+	                   "    <entry name=\"provisioned_key\" overwrite=\"true\">") +
+	       value +
+	       "</entry>\n"
+	       "  </section>\n"
+	       "  <section name=\"provisioning_tester\">\n"
+	       "    <entry name=\"stable_key\" overwrite=\"true\">stable</entry>\n"
+	       "  </section>\n"
+	       "</config>\n";
+}
+
+static bool changed_sections_contain(const LinphoneCore *lc, const char *section) {
+	for (const bctbx_list_t *it = linphone_core_get_provisioning_changed_sections(lc); it != NULL; it = it->next)
+		if (strcmp((const char *)it->data, section) == 0) return true;
+	return false;
+}
+
+static void restart_core_for_provisioning(LinphoneCoreManager *mgr, int expectedSuccesses) {
+	linphone_core_stop(mgr->lc);
+	linphone_core_start(mgr->lc);
+	BC_ASSERT_TRUE(wait_for(mgr->lc, NULL, &mgr->stat.number_of_LinphoneConfiguringSuccessful, expectedSuccesses));
+}
+
+static void remote_provisioning_conditional_and_incremental(void) {
+	ProvisioningHttpServer server;
+	server.setContent(provisioning_xml("1"), "\"v1\"");
+
+	LinphoneCoreManager *marie = linphone_core_manager_create("marie_rc");
+	LinphoneConfig *config = linphone_core_get_config(marie->lc);
+	linphone_core_set_provisioning_uri(marie->lc, server.getUri().c_str());
+	linphone_core_manager_start(marie, FALSE);
+
+	// First download: the content is applied, both sections are new.
+	BC_ASSERT_TRUE(wait_for(marie->lc, NULL, &marie->stat.number_of_LinphoneConfiguringSuccessful, 1));
+	BC_ASSERT_EQUAL(server.getRequestCount(), 1, int, "%d");
+	BC_ASSERT_TRUE(server.getLastIfNoneMatch().empty());
+	BC_ASSERT_STRING_EQUAL(linphone_config_get_string(config, "app", "provisioned_key", ""), "1");
+	BC_ASSERT_STRING_EQUAL(linphone_config_get_string(config, "misc", "config-uri-etag", ""), "\"v1\"");
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_core_get_provisioning_changed_sections(marie->lc)), 2, int, "%d");
+	BC_ASSERT_TRUE(changed_sections_contain(marie->lc, "app"));
+	BC_ASSERT_TRUE(changed_sections_contain(marie->lc, "provisioning_tester"));
+
+	// Same content on the server: the request is conditional, and answered with 304.
+	restart_core_for_provisioning(marie, 2);
+	BC_ASSERT_EQUAL(server.getRequestCount(), 2, int, "%d");
+	BC_ASSERT_STRING_EQUAL(server.getLastIfNoneMatch().c_str(), "\"v1\"");
+	BC_ASSERT_EQUAL(server.getNotModifiedCount(), 1, int, "%d");
+	BC_ASSERT_PTR_NULL(linphone_core_get_provisioning_changed_sections(marie->lc));
+
+	// Only one key changed: only its section is reported.
+	server.setContent(provisioning_xml("2"), "\"v2\"");
+	restart_core_for_provisioning(marie, 3);
+	BC_ASSERT_EQUAL(server.getNotModifiedCount(), 1, int, "%d");
+	BC_ASSERT_STRING_EQUAL(linphone_config_get_string(config, "app", "provisioned_key", ""), "2");
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_core_get_provisioning_changed_sections(marie->lc)), 1, int, "%d");
+	BC_ASSERT_TRUE(changed_sections_contain(marie->lc, "app"));
+
+	// A server ignoring the validators sends the same content again: it is recognized by its hash.
+	server.ignoreValidators(true);
+	restart_core_for_provisioning(marie, 4);
+	BC_ASSERT_EQUAL(server.getRequestCount(), 4, int, "%d");
+	BC_ASSERT_EQUAL(server.getNotModifiedCount(), 1, int, "%d");
+	BC_ASSERT_PTR_NULL(linphone_core_get_provisioning_changed_sections(marie->lc));
+	BC_ASSERT_STRING_EQUAL(linphone_config_get_string(config, "app", "provisioned_key", ""), "2");
+
+	linphone_core_manager_destroy(marie);
+}
+#endif
+
 test_t remote_provisioning_tests[] = {
     TEST_NO_TAG("Remote provisioning skipped", remote_provisioning_skipped),
     TEST_NO_TAG("Remote provisioning successful behind http", remote_provisioning_http),
@@ -454,6 +680,10 @@ test_t remote_provisioning_tests[] = {
     TEST_NO_TAG("Remote provisioning from file", remote_provisioning_file),
     TEST_NO_TAG("Remote provisioning invalid URI", remote_provisioning_invalid_uri),
     TEST_NO_TAG("Remote provisioning check if push tokens are not lost", remote_provisioning_check_push_params)
+#ifndef _WIN32
+        ,
+    TEST_NO_TAG("Remote provisioning conditional and incremental", remote_provisioning_conditional_and_incremental)
+#endif
 #ifdef HAVE_FLEXIAPI
         ,
     TEST_NO_TAG("Remote Provisioning Flow", flexiapi_remote_provisioning_flow),
@@ -3090,6 +3090,55 @@ static void ldap_features_delay(void) {
 	linphone_core_manager_destroy(manager);
 }
 
+static void ldap_results_on_connection_readable(void) {
+	LinphoneCoreManager *manager = linphone_core_manager_new("marie_rc");
+	LinphoneLdap *ldap;
+
+	prepare_friends(manager, &ldap);
+
+	LinphoneMagicSearchCbs *searchHandler = linphone_factory_create_magic_search_cbs(linphone_factory_get());
+	linphone_magic_search_cbs_set_search_results_received(searchHandler, _onMagicSearchResultsReceived);
+	LinphoneMagicSearch *magicSearch = linphone_magic_search_new(manager->lc);
+	linphone_magic_search_add_callbacks(magicSearch, searchHandler);
+	stats *stat = get_stats(manager->lc);
+	linphone_magic_search_cbs_set_user_data(searchHandler, stat);
+
+	if (linphone_core_ldap_available(manager->lc)) {
+		// Without cache nor delay, each search is a round trip whose answer wakes the provider up.
+		LinphoneLdapParams *params = linphone_ldap_params_clone(linphone_ldap_get_params(ldap));
+		linphone_ldap_params_set_delay(params, 0);
+		linphone_ldap_params_set_custom_value(params, "cache_ttl", "0");
+		linphone_ldap_set_params(ldap, params);
+		linphone_ldap_params_unref(params);
+
+		for (int i = 0; i < 3; ++i) {
+			MSTimeSpec start;
+			liblinphone_tester_clock_start(&start);
+			linphone_magic_search_reset_search_cache(magicSearch);
+			linphone_magic_search_get_contacts_list_async(magicSearch, "u", "", LinphoneMagicSearchSourceLdapServers,
+			                                              LinphoneMagicSearchAggregationNone);
+			BC_ASSERT_TRUE(wait_for(manager->lc, NULL, &stat->number_of_LinphoneMagicSearchResultReceived, i + 1));
+			// Each search connects to the server at the active pace of its provider. Once it is sent, the iteration
+			// timer only checks for timeouts every second: the results come with the connection being readable.
+			BC_ASSERT_FALSE(liblinphone_tester_clock_elapsed(&start, 800));
+			bctbx_list_t *resultList = linphone_magic_search_get_last_search(magicSearch);
+			BC_ASSERT_EQUAL((int)bctbx_list_size(resultList), 3, int, "%d");
+			bctbx_list_free_with_data(resultList, (bctbx_list_free_func)linphone_search_result_unref);
+		}
+	}
+
+	linphone_magic_search_cbs_unref(searchHandler);
+	linphone_magic_search_unref(magicSearch);
+
+	if (ldap) {
+		linphone_core_clear_ldaps(manager->lc);
+		BC_ASSERT_PTR_NULL(linphone_core_get_ldap_list(manager->lc));
+		linphone_ldap_unref(ldap);
+	}
+
+	linphone_core_manager_destroy(manager);
+}
+
 static void ldap_features_min_characters(void) {
 	// Prepare datas : Friends, Call logs, Chat rooms, ldap
 	LinphoneCoreManager *manager = linphone_core_manager_new("marie_rc");
@@ -3519,6 +3568,97 @@ static void friend_phone_number_lookup_without_plus(void) {
 	linphone_core_manager_destroy(manager);
 }
 
+static void friend_phone_number_lookup_benchmark(void) {
+	LinphoneCoreManager *manager = linphone_core_manager_new_with_proxies_check("chloe_rc", FALSE);
+	LinphoneCore *core = manager->lc;
+	LinphoneAccount *account = linphone_core_get_default_account(core);
+	LinphoneFriendList *lfl = linphone_core_create_friend_list(core);
+	const int nbFriends = 20000;
+	LinphoneFriend *lf = NULL;
+	char number[32];
+	int found = 0;
+	int i;
+
+	BC_ASSERT_PTR_NOT_NULL(account);
+	if (account) {
+		LinphoneAccountParams *params = linphone_account_params_clone(linphone_account_get_params(account));
+		linphone_account_params_set_international_prefix(params, "33");
+		linphone_account_set_params(account, params);
+		linphone_account_params_unref(params);
+	}
+
+	linphone_friend_list_set_display_name(lfl, "Address book");
+	linphone_friend_list_enable_subscriptions(lfl, FALSE);
+	linphone_core_add_friend_list(core, lfl);
+	for (i = 0; i < nbFriends; i++) {
+		LinphoneFriend *contact = linphone_core_create_friend(core);
+		snprintf(number, sizeof(number), "Contact %i", i);
+		linphone_friend_set_name(contact, number);
+		// Stored in international and national formats.
+		snprintf(number, sizeof(number), (i % 2) ? "+33 6 1%07i" : "061%07i", i);
+		linphone_friend_add_phone_number(contact, number);
+		linphone_friend_list_add_friend(lfl, contact);
+		linphone_friend_unref(contact);
+	}
+
+	// Resolve incoming numbers, as they may be received, against the whole address book.
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (i = 0; i < nbFriends; i++) {
+		const char *formats[] = {"+3361%07i", "061%07i", "0033 61%07i"};
+		snprintf(number, sizeof(number), formats[i % 3], i);
+		lf = linphone_friend_list_find_friend_by_phone_number(lfl, number);
+		if (lf) found++;
+	}
+	liblinphone_tester_benchmark_report(&start, "Phone number lookup among the friends", nbFriends);
+	BC_ASSERT_EQUAL(found, nbFriends, int, "%d");
+
+	lf = linphone_core_find_friend_by_phone_number(core, "+33610012345");
+	if (BC_ASSERT_PTR_NOT_NULL(lf)) {
+		BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(lf), "Contact 12345");
+	}
+	lf = linphone_friend_list_find_friend_by_phone_number(lfl, "+33620000000");
+	BC_ASSERT_PTR_NULL(lf);
+
+	// The index follows the changes of the friends.
+	lf = linphone_friend_list_find_friend_by_phone_number(lfl, "0610000042");
+	if (BC_ASSERT_PTR_NOT_NULL(lf)) {
+		linphone_friend_remove_phone_number(lf, "0610000042");
+		BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "0610000042"));
+		linphone_friend_add_phone_number(lf, "+33 7 00 00 00 42");
+		BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "0700000042"), lf);
+		linphone_friend_list_remove_friend(lfl, lf);
+		BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "0700000042"));
+	}
+
+	// Of two friends sharing a number, the first one of the list is found, even after the other one is edited.
+	LinphoneFriend *first = linphone_core_create_friend(core);
+	LinphoneFriend *second = linphone_core_create_friend(core);
+	linphone_friend_set_name(first, "First");
+	linphone_friend_add_phone_number(first, "+33 6 99 99 99 99");
+	linphone_friend_set_name(second, "Second");
+	linphone_friend_add_phone_number(second, "06 99 99 99 99");
+	// Friends are added at the front of the list.
+	linphone_friend_list_add_friend(lfl, second);
+	linphone_friend_list_add_friend(lfl, first);
+	BC_ASSERT_PTR_EQUAL(bctbx_list_get_data(linphone_friend_list_get_friends(lfl)), first);
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "0699999999"), first);
+	linphone_friend_edit(second);
+	linphone_friend_add_phone_number(second, "+33 7 99 99 99 99");
+	linphone_friend_done(second);
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "0699999999"), first);
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "0799999999"), second);
+	linphone_friend_remove_phone_number(second, "+33 7 99 99 99 99");
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "0699999999"), first);
+	linphone_friend_list_remove_friend(lfl, first);
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "0699999999"), second);
+	linphone_friend_unref(first);
+	linphone_friend_unref(second);
+
+	linphone_friend_list_unref(lfl);
+	linphone_core_manager_destroy(manager);
+}
+
 static void audio_devices(void) {
 	LinphoneCoreManager *manager = linphone_core_manager_new("marie_rc");
 	LinphoneCore *core = manager->lc;
@@ -3763,6 +3903,7 @@ test_t setup_tests[] = {
     TEST_ONE_TAG("Async search friend in sources", async_search_friend_in_sources, "MagicSearch"),
     TEST_ONE_TAG("Ldap search", ldap_search, "MagicSearch"),
     TEST_ONE_TAG("Ldap features delay", ldap_features_delay, "MagicSearch"),
+    TEST_ONE_TAG("Ldap results on connection readable", ldap_results_on_connection_readable, "MagicSearch"),
     TEST_ONE_TAG("Ldap features min characters", ldap_features_min_characters, "MagicSearch"),
     TEST_ONE_TAG("Ldap features more results", ldap_features_more_results, "MagicSearch"),
     TEST_NO_TAG("Ldap params edition with check", ldap_params_edition_with_check),
@@ -3771,6 +3912,7 @@ test_t setup_tests[] = {
     TEST_NO_TAG("Store friends list in DB without setting path to db file", friend_list_db_storage_without_db),
     TEST_NO_TAG("Dialplan", dial_plan),
     TEST_NO_TAG("Friend phone number lookup without plus", friend_phone_number_lookup_without_plus),
+    TEST_NO_TAG("Friend phone number lookup benchmark", friend_phone_number_lookup_benchmark),
     TEST_NO_TAG("Audio devices", audio_devices),
     TEST_NO_TAG("Migrate from call history database", migration_from_call_history_db),
 };
@@ -902,3 +902,12 @@ void check_chat_message_properties(LinphoneChatMessage *msg) {
 		BC_ASSERT_TRUE(contentList.isValid());
 	}
 }
+
+std::shared_ptr<SalMediaDescription> parse_sal_media_description(const std::string &text) {
+	belle_sdp_session_description_t *sdp = belle_sdp_session_description_parse(text.c_str());
+	if (!sdp) return nullptr;
+	belle_sip_object_ref(sdp);
+	auto md = std::make_shared<SalMediaDescription>(sdp);
+	belle_sip_object_unref(sdp);
+	return md;
+}
@@ -92,6 +92,13 @@ void check_chat_message_properties(LinphoneChatMessage *msg);
 
 #ifdef __cplusplus
 }
+
+#include <string>
+
+#include "tester_utils.h"
+
+// Media description of a SDP text, or nullptr if the text can't be parsed
+std::shared_ptr<LinphonePrivate::SalMediaDescription> parse_sal_media_description(const std::string &text);
 #endif
 
 #endif // _SHARED_TESTER_FUNCTIONS_H_
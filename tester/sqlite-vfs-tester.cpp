@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#ifdef __APPLE__
+#include "TargetConditionals.h"
+#endif
+
+// The concurrent writer is another process where the tester may create one, another thread otherwise.
+#if !defined(_WIN32) && !defined(__ANDROID__) && !TARGET_OS_IPHONE
+#define SQLITE_VFS_TESTER_WRITER_PROCESS
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "liblinphone_tester.h"
+#include "linphone/core.h"
+#include "sqlite3_bctbx_vfs.h"
+#include "tester_utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+static const int nbWrites = 2000;
+
+static void remove_database(const string &path) {
+	remove(path.c_str());
+	remove((path + "-journal").c_str());
+	remove((path + "-wal").c_str());
+	remove((path + "-shm").c_str());
+}
+
+static sqlite3 *open_database(const string &path) {
+	sqlite3 *db = nullptr;
+	// The factory registers the VFS.
+	linphone_factory_get();
+	int ret = sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, BCTBX_SQLITE3_VFS);
+	BC_ASSERT_EQUAL(ret, SQLITE_OK, int, "%d");
+	if (ret != SQLITE_OK) {
+		sqlite3_close(db);
+		return nullptr;
+	}
+	sqlite3_busy_timeout(db, 5000);
+	return db;
+}
+
+static string query_string(sqlite3 *db, const char *query) {
+	string result;
+	sqlite3_stmt *stmt = nullptr;
+	if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+		const unsigned char *text = sqlite3_column_text(stmt, 0);
+		if (text) result = reinterpret_cast<const char *>(text);
+	}
+	sqlite3_finalize(stmt);
+	return result;
+}
+
+// The statement is finalized after its first row: left unreset, it would keep its read transaction open, and the
+// writers of the other connections would wait for the busy timeout before failing with SQLITE_BUSY.
+static int query_int(sqlite3 *db, const char *query) {
+	int result = -1;
+	sqlite3_stmt *stmt = nullptr;
+	if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW)
+		result = sqlite3_column_int(stmt, 0);
+	sqlite3_finalize(stmt);
+	return result;
+}
+
+// One transaction per row, so that the reader sees the table grow.
+static int write_rows(const string &path) {
+	sqlite3 *db = nullptr;
+	int ret = sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE, BCTBX_SQLITE3_VFS);
+	if (ret == SQLITE_OK) {
+		sqlite3_busy_timeout(db, 5000);
+		for (int i = 0; i < nbWrites && ret == SQLITE_OK; i++)
+			ret = sqlite3_exec(db, "INSERT INTO item (value) VALUES ('written by another connection')", nullptr,
+			                   nullptr, nullptr);
+	}
+	sqlite3_close(db);
+	return ret;
+}
+
+static void wal_with_a_concurrent_writer(void) {
+	char *dbPath = bc_tester_file("sqlite-vfs-wal.db");
+	const string path = dbPath;
+	bc_free(dbPath);
+	remove_database(path);
+
+	sqlite3 *db = open_database(path);
+	if (!db) return;
+	// WAL journaling needs the shared memory of the VFS, SQLite silently keeps the previous mode otherwise.
+	BC_ASSERT_STRING_EQUAL(query_string(db, "PRAGMA journal_mode = WAL").c_str(), "wal");
+	BC_ASSERT_EQUAL(
+	    sqlite3_exec(db, "CREATE TABLE item (id INTEGER PRIMARY KEY, value TEXT)", nullptr, nullptr, nullptr), SQLITE_OK,
+	    int, "%d");
+
+	// The reader must never see a smaller table, nor fail to read while the other connection writes.
+	int nbReads = 0;
+	int nbErrors = 0;
+	int lastCount = 0;
+	auto readCount = [&]() {
+		int count = query_int(db, "SELECT COUNT(*) FROM item");
+		if (count < lastCount) nbErrors++;
+		else lastCount = count;
+		nbReads++;
+	};
+
+#ifdef SQLITE_VFS_TESTER_WRITER_PROCESS
+	pid_t writer = fork();
+	BC_ASSERT_TRUE(writer >= 0);
+	if (writer == 0) _exit(write_rows(path) == SQLITE_OK ? 0 : 1);
+
+	int status = 0;
+	while (writer > 0 && waitpid(writer, &status, WNOHANG) == 0)
+		readCount();
+	BC_ASSERT_TRUE(WIFEXITED(status));
+	BC_ASSERT_EQUAL(WEXITSTATUS(status), 0, int, "%d");
+	const char *writerName = "process";
+#else
+	atomic<bool> written{false};
+	int writerRet = SQLITE_ERROR;
+	thread writer([&]() {
+		writerRet = write_rows(path);
+		written = true;
+	});
+	while (!written)
+		readCount();
+	writer.join();
+	BC_ASSERT_EQUAL(writerRet, SQLITE_OK, int, "%d");
+	const char *writerName = "thread";
+#endif
+	BC_ASSERT_EQUAL(nbErrors, 0, int, "%d");
+	BC_ASSERT_EQUAL(query_int(db, "SELECT COUNT(*) FROM item"), nbWrites, int, "%d");
+	bc_tester_printf(ORTP_MESSAGE, "%d reads while another %s wrote %d rows", nbReads, writerName, nbWrites);
+
+	sqlite3_close(db);
+	remove_database(path);
+}
+
+// The standard bctbx VFS under another address: while it is the default one, the SQLite VFS opens the plain files
+// through the bctbx files, with its version 1 io methods, as it did before it used the native SQLite VFS.
+static int bctbx_file_vfs_open(BCTBX_UNUSED(bctbx_vfs_t *pVfs), bctbx_vfs_file_t *pFile, const char *fName, int flags) {
+	bctbx_vfs_t *standard = bctbx_vfs_get_standard();
+	return standard->pFuncOpen(standard, pFile, fName, flags);
+}
+
+static bctbx_vfs_t bctbxFileVfs = {"bctbx file", bctbx_file_vfs_open};
+
+static void read_throughput(const char *name, const string &path, long long mmapSize, int &checksum) {
+	sqlite3 *db = open_database(path);
+	if (!db) return;
+	sqlite3_exec(db, ("PRAGMA mmap_size = " + to_string(mmapSize)).c_str(), nullptr, nullptr, nullptr);
+	// Keep the page cache small so that the reads reach the VFS.
+	sqlite3_exec(db, "PRAGMA cache_size = -1024", nullptr, nullptr, nullptr);
+
+	const int nbScans = 20;
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (int i = 0; i < nbScans; i++)
+		checksum = query_int(db, "SELECT SUM(LENGTH(value)) FROM item");
+	liblinphone_tester_benchmark_report(&start, name, nbScans);
+	sqlite3_close(db);
+}
+
+static void read_throughput_with_mmap(void) {
+	char *dbPath = bc_tester_file("sqlite-vfs-read.db");
+	const string path = dbPath;
+	bc_free(dbPath);
+	remove_database(path);
+
+	sqlite3 *db = open_database(path);
+	if (!db) return;
+	BC_ASSERT_EQUAL(sqlite3_exec(db,
+	                             "CREATE TABLE item (id INTEGER PRIMARY KEY, value BLOB);"
+	                             "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 50000)"
+	                             " INSERT INTO item (value) SELECT RANDOMBLOB(200) FROM n",
+	                             nullptr, nullptr, nullptr),
+	                SQLITE_OK, int, "%d");
+	sqlite3_close(db);
+
+	// Through the bctbx files every page is copied by bctbx_file_read(), as the VFS always did before. Through the
+	// native VFS, the pages are copied by its xRead without mmap, and xFetch gives the mapped pages to SQLite with it.
+	int bctbxChecksum = 0;
+	int copiedChecksum = 0;
+	int mappedChecksum = 0;
+	bctbx_vfs_set_default(&bctbxFileVfs);
+	read_throughput("Scan of 50000 rows through the bctbx files", path, 256 * 1024 * 1024, bctbxChecksum);
+	bctbx_vfs_set_default(bctbx_vfs_get_standard());
+	read_throughput("Scan of 50000 rows with the native xRead", path, 0, copiedChecksum);
+	read_throughput("Scan of 50000 rows with the native xFetch", path, 256 * 1024 * 1024, mappedChecksum);
+	BC_ASSERT_EQUAL(bctbxChecksum, 50000 * 200, int, "%d");
+	BC_ASSERT_EQUAL(copiedChecksum, bctbxChecksum, int, "%d");
+	BC_ASSERT_EQUAL(mappedChecksum, bctbxChecksum, int, "%d");
+
+	remove_database(path);
+}
+
+static void encrypted_files_keep_bctbx_vfs(void) {
+	uint8_t evfs_key[16] = {0xaa, 0x55, 0xFF, 0xFF, 0x12, 0x34, 0x56, 0x78,
+	                        0x9a, 0xbc, 0xde, 0xf0, 0x11, 0x22, 0x33, 0x44};
+	char *dbPath = bc_tester_file("sqlite-vfs-encrypted.db");
+	const string path = dbPath;
+	bc_free(dbPath);
+	remove_database(path);
+
+	linphone_factory_set_vfs_encryption(linphone_factory_get(), LINPHONE_VFS_ENCRYPTION_DUMMY, evfs_key, 16);
+	sqlite3 *db = open_database(path);
+	if (db) {
+		// Encrypted files go through the bctbx VFS, which has no shared memory: SQLite keeps its rollback journal.
+		BC_ASSERT_STRING_NOT_EQUAL(query_string(db, "PRAGMA journal_mode = WAL").c_str(), "wal");
+		BC_ASSERT_EQUAL(sqlite3_exec(db,
+		                             "CREATE TABLE item (id INTEGER PRIMARY KEY, value TEXT);"
+		                             "INSERT INTO item (value) VALUES ('encrypted')",
+		                             nullptr, nullptr, nullptr),
+		                SQLITE_OK, int, "%d");
+		BC_ASSERT_STRING_EQUAL(query_string(db, "SELECT value FROM item").c_str(), "encrypted");
+		sqlite3_close(db);
+	}
+	linphone_factory_set_vfs_encryption(linphone_factory_get(), LINPHONE_VFS_ENCRYPTION_UNSET, NULL, 0);
+
+	// The file is not readable without the encryption.
+	db = open_database(path);
+	if (db) {
+		BC_ASSERT_NOT_EQUAL(sqlite3_exec(db, "SELECT * FROM item", nullptr, nullptr, nullptr), SQLITE_OK, int, "%d");
+		sqlite3_close(db);
+	}
+
+	remove_database(path);
+}
+
+test_t sqlite_vfs_tests[] = {
+    TEST_NO_TAG("WAL with a concurrent writer", wal_with_a_concurrent_writer),
+    TEST_NO_TAG("Read throughput with mmap", read_throughput_with_mmap),
+    TEST_ONE_TAG("Encrypted files keep the bctbx VFS", encrypted_files_keep_bctbx_vfs, "CRYPTO")};
+
+test_suite_t sqlite_vfs_test_suite = {"SQLite VFS",
+                                      NULL,
+                                      NULL,
+                                      liblinphone_tester_before_each,
+                                      liblinphone_tester_after_each,
+                                      sizeof(sqlite_vfs_tests) / sizeof(sqlite_vfs_tests[0]),
+                                      sqlite_vfs_tests,
+                                      0};
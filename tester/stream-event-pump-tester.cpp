@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "conference/session/stream-event-pump.h"
+#include "core/core-p.h"
+#include "core/core.h"
+#include "liblinphone_tester.h"
+#include "tester_utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+using namespace LinphonePrivate;
+
+namespace {
+
+class FakeStream : public StreamEventPump::Client {
+public:
+	FakeStream() : mQueue(ortp_ev_queue_new()) {
+	}
+	~FakeStream() {
+		if (mSession) {
+			rtp_session_unregister_event_queue(mSession, mQueue);
+			rtp_session_destroy(mSession);
+		}
+		ortp_ev_queue_destroy(mQueue);
+	}
+
+	// What MS2Stream::handleEvents() does, without handling the events.
+	void pumpEvents() override {
+		OrtpEvent *ev;
+		while ((ev = ortp_ev_queue_get(mQueue)) != nullptr) {
+			ortp_event_destroy(ev);
+			nbDrained++;
+		}
+		nbEvents++;
+		if (onEvents) onEvents();
+	}
+	// An active stream receives RTCP packets, which its RTP session queues as events.
+	void feed() {
+		if (!mSession) {
+			mSession = rtp_session_new(RTP_SESSION_SENDRECV);
+			rtp_session_register_event_queue(mSession, mQueue);
+		}
+		rtp_session_dispatch_event(mSession, ortp_event_new(ORTP_EVENT_RTCP_PACKET_RECEIVED));
+	}
+	void pumpMonitors() override {
+		nbMonitors++;
+	}
+
+	int nbEvents = 0;
+	int nbDrained = 0;
+	int nbMonitors = 0;
+	function<void()> onEvents;
+
+private:
+	OrtpEvQueue *mQueue;
+	RtpSession *mSession = nullptr;
+};
+
+// The previous design: each stream with its own pair of main loop timers.
+class TimedStream {
+public:
+	TimedStream(Core &core, FakeStream &stream) : mCore(core) {
+		mTimer = core.createTimer(
+		    [&stream]() {
+			    stream.pumpEvents();
+			    return true;
+		    },
+		    20, "Stream event processing timer");
+		mMonitorTimer = core.createTimer(
+		    [&stream]() {
+			    stream.pumpMonitors();
+			    return true;
+		    },
+		    1000, "Stream monitor check");
+	}
+	~TimedStream() {
+		mCore.destroyTimer(mTimer);
+		mCore.destroyTimer(mMonitorTimer);
+	}
+
+private:
+	Core &mCore;
+	belle_sip_source_t *mTimer;
+	belle_sip_source_t *mMonitorTimer;
+};
+
+} // namespace
+
+// Returns the time spent in the main loop iterations, without the sleeps between them.
+static uint64_t iterate_for(LinphoneCore *lc, int durationMs, const function<void()> &onIteration = nullptr) {
+	MSTimeSpec start, iterationStart;
+	uint64_t iteratingUs = 0;
+	liblinphone_tester_clock_start(&start);
+	while (!liblinphone_tester_clock_elapsed(&start, durationMs)) {
+		if (onIteration) onIteration();
+		liblinphone_tester_clock_start(&iterationStart);
+		linphone_core_iterate(lc);
+		iteratingUs += liblinphone_tester_clock_elapsed_us(&iterationStart);
+		ms_usleep(10000);
+	}
+	return iteratingUs;
+}
+
+static void clients_changed_while_dispatching(void) {
+	LinphoneCoreManager *mgr = linphone_core_manager_new("empty_rc");
+	{
+		Core &core = *L_GET_CPP_PTR_FROM_C_OBJECT(mgr->lc);
+		StreamEventPump pump(core, 20, 200);
+
+		FakeStream first, second, third, added;
+		pump.add(&first);
+		pump.add(&second);
+		pump.add(&third);
+		pump.add(&first);
+		BC_ASSERT_EQUAL((int)pump.size(), 3, int, "%d");
+
+		// The first stream removes itself and the third one, and adds another stream, from its callback.
+		first.onEvents = [&]() {
+			pump.remove(&first);
+			pump.remove(&third);
+			pump.add(&added);
+		};
+		iterate_for(mgr->lc, 1000);
+
+		BC_ASSERT_EQUAL(first.nbEvents, 1, int, "%d");
+		BC_ASSERT_TRUE(third.nbEvents <= 1);
+		BC_ASSERT_GREATER(second.nbEvents, 10, int, "%d");
+		BC_ASSERT_GREATER(added.nbEvents, 10, int, "%d");
+		BC_ASSERT_TRUE(added.nbEvents <= second.nbEvents);
+		// The monitors run at their own, slower pace.
+		BC_ASSERT_GREATER(second.nbMonitors, 1, int, "%d");
+		BC_ASSERT_LOWER(second.nbMonitors, second.nbEvents, int, "%d");
+		BC_ASSERT_FALSE(pump.contains(&first));
+		BC_ASSERT_TRUE(pump.contains(&added));
+		BC_ASSERT_EQUAL((int)pump.size(), 2, int, "%d");
+
+		// Without clients, there is nothing left to run.
+		pump.remove(&second);
+		pump.remove(&added);
+		int nbEvents = second.nbEvents;
+		iterate_for(mgr->lc, 200);
+		BC_ASSERT_EQUAL(second.nbEvents, nbEvents, int, "%d");
+	}
+	linphone_core_manager_destroy(mgr);
+}
+
+struct StreamsRun {
+	uint64_t iteratingUs = 0;
+	int nbIterations = 0;
+	int nbEvents = 0;
+	int nbDrained = 0;
+};
+
+// The first nbIdle streams receive nothing, the nbActive next ones receive events on each main loop iteration.
+static StreamsRun run_streams(LinphoneCore *lc, bool shared, int nbIdle, int nbActive, int durationMs) {
+	Core &core = *L_GET_CPP_PTR_FROM_C_OBJECT(lc);
+	vector<unique_ptr<FakeStream>> streams;
+	vector<unique_ptr<TimedStream>> timedStreams;
+	StreamEventPump pump(core);
+	for (int i = 0; i < nbIdle + nbActive; i++) {
+		streams.emplace_back(new FakeStream());
+		if (shared) pump.add(streams.back().get());
+		else timedStreams.emplace_back(new TimedStream(core, *streams.back()));
+	}
+
+	StreamsRun run;
+	run.iteratingUs = iterate_for(lc, durationMs, [&]() {
+		run.nbIterations++;
+		for (size_t i = (size_t)nbIdle; i < streams.size(); i++)
+			streams[i]->feed();
+	});
+
+	for (const auto &stream : streams) {
+		run.nbEvents += stream->nbEvents;
+		run.nbDrained += stream->nbDrained;
+	}
+	timedStreams.clear();
+	return run;
+}
+
+static void idle_and_active_streams_benchmark(void) {
+	LinphoneCoreManager *mgr = linphone_core_manager_new("empty_rc");
+	const int nbIdle = 500;
+	const int nbActive = 500;
+	const int durationMs = 3000;
+
+	StreamsRun timed = run_streams(mgr->lc, false, nbIdle, nbActive, durationMs);
+	StreamsRun shared = run_streams(mgr->lc, true, nbIdle, nbActive, durationMs);
+
+	// Both must poll the streams at the same pace and drain the events of the active ones, only the cost of the main
+	// loop differs.
+	BC_ASSERT_GREATER(timed.nbEvents, nbIdle + nbActive, int, "%d");
+	BC_ASSERT_GREATER(shared.nbEvents, nbIdle + nbActive, int, "%d");
+	BC_ASSERT_GREATER(timed.nbDrained, nbActive, int, "%d");
+	BC_ASSERT_GREATER(shared.nbDrained, nbActive, int, "%d");
+	liblinphone_tester_benchmark_log("Main loop iteration with a timer pair per stream", timed.nbIterations,
+	                                 timed.iteratingUs);
+	liblinphone_tester_benchmark_log("Main loop iteration with the shared pump", shared.nbIterations,
+	                                 shared.iteratingUs);
+
+	linphone_core_manager_destroy(mgr);
+}
+
+test_t stream_event_pump_tests[] = {
+    TEST_NO_TAG("Clients changed while dispatching", clients_changed_while_dispatching),
+    TEST_NO_TAG("Idle and active streams benchmark", idle_and_active_streams_benchmark)};
+
+test_suite_t stream_event_pump_test_suite = {"Stream event pump",
+                                             NULL,
+                                             NULL,
+                                             liblinphone_tester_before_each,
+                                             liblinphone_tester_after_each,
+                                             sizeof(stream_event_pump_tests) / sizeof(stream_event_pump_tests[0]),
+                                             stream_event_pump_tests,
+                                             0};
@@ -187,6 +187,23 @@ bool_t liblinphone_tester_clock_elapsed(const MSTimeSpec *start, int value_ms) {
 	return FALSE;
 }
 
+uint64_t liblinphone_tester_clock_elapsed_us(const MSTimeSpec *start) {
+	MSTimeSpec current;
+	ms_get_cur_time(&current);
+	return (uint64_t)(((current.tv_sec - start->tv_sec) * 1000000LL) + ((current.tv_nsec - start->tv_nsec) / 1000LL));
+}
+
+void liblinphone_tester_benchmark_log(const char *name, int runs, uint64_t elapsed_us) {
+	ms_message("[Benchmark] %s: %d runs in %llu us, %.1f us per run", name, runs, (unsigned long long)elapsed_us,
+	           runs > 0 ? (double)elapsed_us / runs : 0.);
+}
+
+uint64_t liblinphone_tester_benchmark_report(const MSTimeSpec *start, const char *name, int runs) {
+	uint64_t elapsed_us = liblinphone_tester_clock_elapsed_us(start);
+	liblinphone_tester_benchmark_log(name, runs, elapsed_us);
+	return elapsed_us;
+}
+
 LinphoneAddress *create_linphone_address(const char *domain) {
 	return create_linphone_address_for_algo(domain, NULL);
 }
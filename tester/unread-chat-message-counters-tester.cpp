@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "address/address.h"
+#include "chat/chat-room/unread-chat-message-counters.h"
+#include "liblinphone_tester.h"
+#include "tester_utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+using namespace LinphonePrivate;
+
+static int get_change(const vector<pair<shared_ptr<const Address>, int>> &changes, const Address &localAddress) {
+	for (const auto &change : changes)
+		if (change.first->weakEqual(localAddress)) return change.second;
+	return -1;
+}
+
+static void totals_and_changes(void) {
+	auto marie = Address::create("sip:marie@sip.example.org");
+	auto marieGruu = Address::create("sip:marie@sip.example.org;gr=urn:uuid:1234");
+	auto pauline = Address::create("sip:pauline@sip.example.org");
+	auto laure = Address::create("sip:laure@sip.example.org");
+	auto chloe = Address::create("sip:chloe@sip.example.org");
+
+	UnreadChatMessageCounters counters;
+	ConferenceId withLaure(laure, marie);
+	ConferenceId withChloe(chloe, marieGruu);
+	ConferenceId paulineWithLaure(laure, pauline);
+
+	counters.invalidate(withLaure);
+	counters.invalidate(withChloe);
+	BC_ASSERT_TRUE(counters.hasInvalidated());
+	BC_ASSERT_EQUAL((int)counters.takeInvalidated().size(), 2, int, "%d");
+	BC_ASSERT_FALSE(counters.hasInvalidated());
+
+	// The GRUU of a local address counts with it, like Address::weakEqual().
+	counters.set(withLaure, marie, 3);
+	counters.set(withChloe, marieGruu, 2);
+	counters.set(paulineWithLaure, pauline, 0);
+	BC_ASSERT_EQUAL(counters.get(*marie), 5, int, "%d");
+	BC_ASSERT_EQUAL(counters.get(*marieGruu), 5, int, "%d");
+	BC_ASSERT_EQUAL(counters.get(*pauline), 0, int, "%d");
+	BC_ASSERT_EQUAL(counters.get(*laure), 0, int, "%d");
+
+	auto changes = counters.takeChanges();
+	BC_ASSERT_EQUAL((int)changes.size(), 1, int, "%d");
+	BC_ASSERT_EQUAL(get_change(changes, *marie), 5, int, "%d");
+	BC_ASSERT_TRUE(counters.takeChanges().empty());
+
+	// A muted chat room is set to 0, and setting the same count again is not a change.
+	counters.set(withLaure, marie, 0);
+	counters.set(withChloe, marieGruu, 2);
+	changes = counters.takeChanges();
+	BC_ASSERT_EQUAL((int)changes.size(), 1, int, "%d");
+	BC_ASSERT_EQUAL(get_change(changes, *marie), 2, int, "%d");
+
+	// A chat room whose local address changes moves its count.
+	counters.set(withChloe, pauline, 2);
+	BC_ASSERT_EQUAL(counters.get(*marie), 0, int, "%d");
+	BC_ASSERT_EQUAL(counters.get(*pauline), 2, int, "%d");
+	changes = counters.takeChanges();
+	BC_ASSERT_EQUAL((int)changes.size(), 2, int, "%d");
+	BC_ASSERT_EQUAL(get_change(changes, *marie), 0, int, "%d");
+	BC_ASSERT_EQUAL(get_change(changes, *pauline), 2, int, "%d");
+
+	// Removed chat rooms no longer count, and an invalidated one is forgotten.
+	counters.invalidate(withChloe);
+	counters.remove(withChloe);
+	BC_ASSERT_FALSE(counters.hasInvalidated());
+	BC_ASSERT_EQUAL(counters.get(*pauline), 0, int, "%d");
+	counters.remove(withChloe);
+	changes = counters.takeChanges();
+	BC_ASSERT_EQUAL((int)changes.size(), 1, int, "%d");
+	BC_ASSERT_EQUAL(get_change(changes, *pauline), 0, int, "%d");
+
+	counters.set(withLaure, marie, 4);
+	counters.takeChanges();
+	counters.clear();
+	BC_ASSERT_EQUAL(counters.get(*marie), 0, int, "%d");
+	changes = counters.takeChanges();
+	BC_ASSERT_EQUAL((int)changes.size(), 1, int, "%d");
+	BC_ASSERT_EQUAL(get_change(changes, *marie), 0, int, "%d");
+	BC_ASSERT_TRUE(counters.takeChanges().empty());
+}
+
+static void many_chat_rooms_and_accounts(void) {
+	const int nbAccounts = 20;
+	const int nbChatRooms = 20000;
+	const int nbScans = 5;
+	const int nbQueries = 1000;
+
+	vector<shared_ptr<Address>> identities;
+	for (int i = 0; i < nbAccounts; i++)
+		identities.push_back(Address::create("sip:account" + to_string(i) + "@sip.example.org"));
+
+	struct ChatRoom {
+		ConferenceId conferenceId;
+		shared_ptr<Address> localAddress;
+		int count;
+	};
+	vector<ChatRoom> chatRooms;
+	UnreadChatMessageCounters counters;
+	mt19937 generator(42);
+	for (int i = 0; i < nbChatRooms; i++) {
+		auto localAddress = identities[(size_t)i % identities.size()];
+		auto peerAddress = Address::create("sip:peer" + to_string(i) + "@sip.example.org");
+		chatRooms.push_back({ConferenceId(peerAddress, localAddress), localAddress, (int)(generator() % 3)});
+		counters.set(chatRooms.back().conferenceId, localAddress, chatRooms.back().count);
+	}
+	counters.takeChanges();
+
+	// What getUnreadChatMessageCountFromActiveLocals() did on each call: every chat room against every account.
+	int scanned = 0;
+	MSTimeSpec start;
+	liblinphone_tester_clock_start(&start);
+	for (int i = 0; i < nbScans; i++) {
+		scanned = 0;
+		for (const auto &chatRoom : chatRooms)
+			for (const auto &identity : identities)
+				if (identity->weakEqual(*chatRoom.localAddress)) scanned += chatRoom.count;
+	}
+	liblinphone_tester_benchmark_report(&start, "Unread count scanning the chat rooms", nbScans);
+
+	// Now a new message updates one chat room, and the query reads one total per account.
+	int kept = 0;
+	liblinphone_tester_clock_start(&start);
+	for (int i = 0; i < nbQueries; i++) {
+		auto &chatRoom = chatRooms[generator() % chatRooms.size()];
+		chatRoom.count++;
+		scanned++;
+		counters.set(chatRoom.conferenceId, chatRoom.localAddress, chatRoom.count);
+		kept = 0;
+		for (const auto &identity : identities)
+			kept += counters.get(*identity);
+	}
+	liblinphone_tester_benchmark_report(&start, "Unread count update and query with the totals", nbQueries);
+
+	// The scan total did not see the updates made after it, they were added to it.
+	BC_ASSERT_EQUAL(kept, scanned, int, "%d");
+	BC_ASSERT_TRUE(counters.takeChanges().size() <= (size_t)nbAccounts);
+}
+
+test_t unread_chat_message_counters_tests[] = {
+    TEST_NO_TAG("Totals and changes", totals_and_changes),
+    TEST_NO_TAG("Many chat rooms and accounts", many_chat_rooms_and_accounts)};
+
+test_suite_t unread_chat_message_counters_test_suite = {
+    "Unread chat message counters",
+    NULL,
+    NULL,
+    liblinphone_tester_before_each,
+    liblinphone_tester_after_each,
+    sizeof(unread_chat_message_counters_tests) / sizeof(unread_chat_message_counters_tests[0]),
+    unread_chat_message_counters_tests,
+    0};
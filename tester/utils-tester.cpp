@@ -18,10 +18,13 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <random>
+
 #include "bctoolbox/utils.hh"
 
 #include "address/address.h"
 #include "conference/conference-id.h"
+#include "ldap/ldap-result-cache.h"
 #include "liblinphone_tester.h"
 #include "linphone/utils/utils.h"
 #include "tester_utils.h"
@@ -139,6 +142,209 @@ static void conferenceId_comparisons(void) {
 	BC_ASSERT_FALSE(c7 == c5);
 }
 
+static bool check_sip_uri_fast_path(const string &input) {
+	SalAddress *fastAddress = _linphone_address_parse_sip_uri(input.c_str());
+	if (!fastAddress) return false;
+
+	// Whatever the fast path accepts must be parsed the same way by belle-sip.
+	SalAddress *fullAddress = sal_address_new(input.c_str());
+	if (!BC_ASSERT_PTR_NOT_NULL(fullAddress)) {
+		ms_error("Fast path accepted [%s], rejected by the full parser", input.c_str());
+		sal_address_unref(fastAddress);
+		return true;
+	}
+
+	Address fast(fastAddress, true);
+	Address full(fullAddress, true);
+	bool equivalent = fast == full && fast.asString() == full.asString() && fast.getUsername() == full.getUsername() &&
+	                  fast.getDomain() == full.getDomain() && fast.getPort() == full.getPort() &&
+	                  fast.getSecure() == full.getSecure() && fast.getUriParams() == full.getUriParams();
+	if (!BC_ASSERT_TRUE(equivalent)) {
+		ms_error("Fast path and full parser differ for [%s]: [%s] vs [%s]", input.c_str(), fast.asString().c_str(),
+		         full.asString().c_str());
+	}
+	return true;
+}
+
+static void sip_uri_fast_path_equivalence(void) {
+	const vector<string> seeds = {"sip:toto@sip.example.org",
+	                              "sips:toto@sip.example.org",
+	                              "sip:sip.example.org",
+	                              "sip:toto@192.168.0.1:5060",
+	                              "sip:+33612345678@sip.example.org;user=phone",
+	                              "sip:toto@sip.example.org;transport=tcp;lr",
+	                              "sip:toto@sip.example.org;gr=urn:uuid:6a6b4d1b-0ae2-4e59-b2b4-5e4ce6c7d0c4",
+	                              "sip:conference-factory@conf.example.org;conf-id=aBcD12",
+	                              "sip:first.last-name_(x)@sub-domain.example.org:5061;a=b;c",
+	                              "sip:toto:secret@sip.example.org",
+	                              "\"Toto\" <sip:toto@sip.example.org>",
+	                              "sip:toto@[::1]:5060",
+	                              "sip:to%20to@sip.example.org",
+	                              "sip:toto@sip.example.org?subject=hello"};
+
+	for (const auto &seed : seeds)
+		check_sip_uri_fast_path(seed);
+	BC_ASSERT_TRUE(check_sip_uri_fast_path("sip:toto@sip.example.org;transport=tcp;lr"));
+	BC_ASSERT_TRUE(check_sip_uri_fast_path("sip:toto@sip.example.org;gr=urn:uuid:6a6b4d1b-0ae2-4e59-b2b4-5e4ce6c7d0c4"));
+	BC_ASSERT_FALSE(check_sip_uri_fast_path("sip:toto:secret@sip.example.org"));
+	BC_ASSERT_FALSE(check_sip_uri_fast_path("sip:to%20to@sip.example.org"));
+	BC_ASSERT_FALSE(check_sip_uri_fast_path("sip:toto@sip.example.org;a=1;a=2"));
+
+	// Random mutations of the seeds, with a fixed seed so that failures can be reproduced.
+	static const string alphabet = "sip:@.;=-_+%[]<>\"?&/!~*'() abzAZ0159";
+	mt19937 generator(0x5eed);
+	int accepted = 0;
+	for (int i = 0; i < 20000; i++) {
+		string input = seeds[generator() % seeds.size()];
+		int nbMutations = 1 + (int)(generator() % 3);
+		for (int j = 0; j < nbMutations && !input.empty(); j++) {
+			size_t pos = generator() % input.size();
+			char c = alphabet[generator() % alphabet.size()];
+			switch (generator() % 3) {
+				case 0:
+					input[pos] = c;
+					break;
+				case 1:
+					input.insert(pos, 1, c);
+					break;
+				default:
+					input.erase(pos, 1);
+					break;
+			}
+		}
+		if (check_sip_uri_fast_path(input)) accepted++;
+	}
+	ms_message("SIP URI fast path accepted %d of 20000 mutated inputs", accepted);
+	BC_ASSERT_GREATER(accepted, 0, int, "%d");
+}
+
+static void address_cache(void) {
+	Address::clearSipAddressesCache();
+	size_t capacity = _linphone_address_cache_get_capacity();
+	_linphone_address_cache_set_capacity(100);
+	unsigned long long hits = _linphone_address_cache_get_hits();
+	for (int i = 0; i < 200; i++)
+		BC_ASSERT_TRUE(Address("sip:user" + to_string(i) + "@sip.example.org").isValid());
+	BC_ASSERT_EQUAL(_linphone_address_cache_get_hits() - hits, 0, unsigned long long, "%llu");
+
+	// The cache is bounded, and keeps the most recently used addresses.
+	BC_ASSERT_EQUAL(_linphone_address_cache_get_size(), 100, size_t, "%zu");
+	for (int i = 199; i >= 100; i--)
+		BC_ASSERT_TRUE(Address("sip:user" + to_string(i) + "@sip.example.org").isValid());
+	BC_ASSERT_EQUAL(_linphone_address_cache_get_hits() - hits, 100, unsigned long long, "%llu");
+	BC_ASSERT_TRUE(Address("sip:user0@sip.example.org").isValid());
+	BC_ASSERT_EQUAL(_linphone_address_cache_get_hits() - hits, 100, unsigned long long, "%llu");
+
+	_linphone_address_cache_set_capacity(10);
+	BC_ASSERT_EQUAL(_linphone_address_cache_get_size(), 10, size_t, "%zu");
+	_linphone_address_cache_set_capacity(capacity);
+	Address::clearSipAddressesCache();
+	BC_ASSERT_EQUAL(_linphone_address_cache_get_size(), 0, size_t, "%zu");
+}
+
+static void ldap_result_cache(void) {
+	LdapResultCache::Attributes marie = {{"cn", "Marie Laroueverte"}, {"sn", "Laroueverte"}, {"mobile", "06-12 34"}};
+	LdapResultCache::Attributes pauline = {{"cn", "Pauline Lapin"}, {"sn", "Lapin"}, {"mobile", "07 11 22"}};
+	bool supported;
+	const auto matchFilter = _linphone_ldap_result_cache_match_filter;
+
+	BC_ASSERT_TRUE(matchFilter("(sn=*rouev*)", marie, supported) && supported);
+	BC_ASSERT_TRUE(matchFilter("(|(sn=*x*)(cn=*marie*la*))", marie, supported) && supported);
+	BC_ASSERT_TRUE(matchFilter("(&(sn=*)(mobile=*061234*))", marie, supported) && supported);
+	BC_ASSERT_TRUE(matchFilter("(sn=\\4car*)", marie, supported) && supported);
+	BC_ASSERT_FALSE(matchFilter("(!(sn=lar*))", marie, supported));
+	BC_ASSERT_TRUE(supported);
+	matchFilter("(sn~=laroueverte)", marie, supported);
+	BC_ASSERT_FALSE(supported);
+
+	// Values are compared as the server would, or not at all: names ignore case and repeated spaces, telephone
+	// numbers ignore spaces and hyphens.
+	BC_ASSERT_FALSE(matchFilter("(cn=*marielaroue*)", marie, supported));
+	BC_ASSERT_TRUE(supported);
+	BC_ASSERT_TRUE(matchFilter("(cn=  marie   laroueverte )", marie, supported) && supported);
+	BC_ASSERT_TRUE(matchFilter("(mobile=*1 2-3 4*)", marie, supported) && supported);
+	matchFilter("(cn=*e la*)", marie, supported);
+	BC_ASSERT_TRUE(supported);
+	matchFilter("(cn=* la*)", marie, supported);
+	BC_ASSERT_FALSE(supported);
+	matchFilter("(customattribute=*la*)", marie, supported);
+	BC_ASSERT_FALSE(supported);
+	LdapResultCache::Attributes custom = {{"customattribute", "x"}};
+	BC_ASSERT_TRUE(matchFilter("(customattribute=*)", custom, supported) && supported);
+	matchFilter("(cn=*\\c3\\a9*)", marie, supported);
+	BC_ASSERT_FALSE(supported);
+	LdapResultCache::Attributes irene = {{"cn", "Ir\xc3\xa8ne"}};
+	matchFilter("(cn=*e*)", irene, supported);
+	BC_ASSERT_FALSE(supported);
+
+	// Simulate the searches of someone typing "lar" with the filter of the LDAP tests.
+	auto cache = _linphone_ldap_result_cache_new();
+	auto makeQuery = [](const string &filterTemplate, const string &predicate) {
+		LdapResultCache::Query query;
+		query.server = "ldap://ldap.example.org/";
+		query.bindIdentity = "cn=Marie Laroueverte,ou=people,dc=bc,dc=com";
+		query.baseObject = "ou=people,dc=bc,dc=com";
+		query.attributes = "*";
+		query.sizeLimit = 6;
+		query.filterTemplate = filterTemplate;
+		query.predicate = predicate;
+		query.filter = filterTemplate;
+		bctoolbox::Utils::replace(query.filter, "%s", predicate, false);
+		return query;
+	};
+	auto query = makeQuery("(|(sn=*%s*)(cn=*%s*))", "la");
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, query));
+	LdapResultCache::Result result;
+	result.entries = {marie, pauline};
+	_linphone_ldap_result_cache_insert(*cache, query, result, 60000);
+	auto cached = _linphone_ldap_result_cache_find(*cache, query);
+	if (BC_ASSERT_PTR_NOT_NULL(cached)) BC_ASSERT_EQUAL(cached->entries.size(), 2, size_t, "%zu");
+	cached = _linphone_ldap_result_cache_find(*cache, makeQuery("(|(sn=*%s*)(cn=*%s*))", "lar"));
+	if (BC_ASSERT_PTR_NOT_NULL(cached)) BC_ASSERT_EQUAL(cached->entries.size(), 1, size_t, "%zu");
+	BC_ASSERT_PTR_NOT_NULL(_linphone_ldap_result_cache_find(*cache, makeQuery("(|(sn=*%s*)(cn=*%s*))", "lar")));
+	BC_ASSERT_EQUAL(cache->getHits(), 2, unsigned long long, "%llu");
+	BC_ASSERT_EQUAL(cache->getRefinements(), 1, unsigned long long, "%llu");
+	BC_ASSERT_EQUAL(cache->getMisses(), 1, unsigned long long, "%llu");
+	BC_ASSERT_EQUAL(cache->getRoundTripsSaved(), 3, unsigned long long, "%llu");
+
+	// Another server, or a predicate that does not extend a cached one, needs a round trip.
+	auto otherServer = makeQuery("(|(sn=*%s*)(cn=*%s*))", "lar");
+	otherServer.server = "ldap://other.example.org/";
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, otherServer));
+	// The results of another user, who may not have the same access rights, are not shared either.
+	auto otherUser = makeQuery("(|(sn=*%s*)(cn=*%s*))", "la");
+	otherUser.bindIdentity = "cn=Pauline Lapin,ou=people,dc=bc,dc=com";
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, otherUser));
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, makeQuery("(|(sn=*%s*)(cn=*%s*))", "ma")));
+
+	// Exact matches cannot be refined: "(sn=lar)" does not only match entries that "(sn=la)" matches.
+	_linphone_ldap_result_cache_insert(*cache, makeQuery("(sn=%s)", "la"), result, 60000);
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, makeQuery("(sn=%s)", "lar")));
+	// Nor negated items: "(!(sn=*lar*))" matches the entries that "(!(sn=*la*))" matches, and more.
+	_linphone_ldap_result_cache_insert(*cache, makeQuery("(&(cn=*%s*)(!(sn=*%s*)))", "la"), result, 60000);
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, makeQuery("(&(cn=*%s*)(!(sn=*%s*)))", "lar")));
+
+	// Neither can truncated result sets.
+	result.haveMoreResults = true;
+	_linphone_ldap_result_cache_insert(*cache, makeQuery("(cn=*%s*)", "a"), result, 60000);
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, makeQuery("(cn=*%s*)", "ap")));
+	result.haveMoreResults = false;
+
+	// Expired result sets are neither returned nor refined.
+	_linphone_ldap_result_cache_clear(*cache);
+	_linphone_ldap_result_cache_insert(*cache, query, result, 1);
+	ms_usleep(20000);
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, query));
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, makeQuery("(|(sn=*%s*)(cn=*%s*))", "lar")));
+
+	// The cache is bounded.
+	_linphone_ldap_result_cache_set_capacity(*cache, 2);
+	for (const char *predicate : {"a", "b", "c"})
+		_linphone_ldap_result_cache_insert(*cache, makeQuery("(sn=%s)", predicate), result, 60000);
+	BC_ASSERT_EQUAL(cache->size(), 2, size_t, "%zu");
+	BC_ASSERT_PTR_NULL(_linphone_ldap_result_cache_find(*cache, makeQuery("(sn=%s)", "a")));
+}
+
 static void parse_capabilities(void) {
 	auto caps = Utils::parseCapabilityDescriptor("groupchat,lime,ephemeral");
 	BC_ASSERT_TRUE(caps.find("groupchat") != caps.end());
@@ -158,7 +364,10 @@ test_t utils_tests[] = {
     TEST_NO_TAG("Version comparisons", version_comparisons),
     TEST_NO_TAG("Address comparisons", address_comparisons),
     TEST_NO_TAG("Conference ID comparisons", conferenceId_comparisons),
-    TEST_NO_TAG("Parse capabilities", parse_capabilities)
+    TEST_NO_TAG("Parse capabilities", parse_capabilities),
+    TEST_NO_TAG("SIP URI fast path equivalence", sip_uri_fast_path_equivalence),
+    TEST_NO_TAG("Address cache", address_cache),
+    TEST_NO_TAG("LDAP result cache", ldap_result_cache)
 };
 // clang-format on
 